@@ -20,6 +20,9 @@ limitations under the License.
 #include "aeongames/Utilities.hpp"
 #include "aeongames/LogLevel.hpp"
 #include "aeongames/Frustum.hpp"
+#include "aeongames/FrameArena.hpp"
+#include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceStreamer.hpp"
 #include "aeongames/Scene.hpp"
 #include "aeongames/Node.hpp"
 #include "aeongames/GuiOverlay.hpp"
@@ -845,6 +848,12 @@ namespace AeonGames
             // recentre and InputSystem::Update() below, otherwise the mouse
             // delta would be zeroed out before any component could read it
             // and edge-triggered key queries would always miss.
+            // Last frame's transient allocations are dead by now.
+            ResetFrameArenas();
+            // Streamed resources become visible between frames, never mid frame.
+            CommitStreamedResources();
+            // Over budget, drop least recently used resources nobody holds on to.
+            TrimResources();
             aScene.Update ( delta.count() );
             last_time = current_time;
             if ( mRenderer )
@@ -20,8 +20,11 @@ limitations under the License.
 #include "aeongames/LogLevel.hpp"
 #include "aeongames/Utilities.hpp"
 #include "aeongames/Frustum.hpp"
+#include "aeongames/FrameArena.hpp"
 #include "aeongames/Scene.hpp"
 #include "aeongames/Node.hpp"
+#include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceStreamer.hpp"
 #include "aeongames/GuiOverlay.hpp"
 #include "aeongames/InputSystem.hpp"
 #include "aeongames/KeyCode.hpp"
@@ -680,6 +683,12 @@ namespace AeonGames
                             previous_cursor_captured = cursor_captured;
                         }
                     }
+                    // Last frame's transient allocations are dead by now.
+                    ResetFrameArenas();
+                    // Streamed resources become visible between frames, never mid frame.
+                    CommitStreamedResources();
+                    // Over budget, drop least recently used resources nobody holds on to.
+                    TrimResources();
                     aScene.Update ( delta.count() );
                     last_time = current_time;
 
@@ -0,0 +1,382 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "aeongames/AABB.hpp"
+#include "aeongames/Animation.hpp"
+#include "aeongames/AnimationLod.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/PoseCache.hpp"
+#include "aeongames/ProtoBufClasses.hpp"
+#include "aeongames/Skeleton.hpp"
+#include "animation.pb.h"
+#include "skeleton.pb.h"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        constexpr uint32_t kClipBones = 200;
+        constexpr uint32_t kClipFrames = 600;
+
+        /** A 30 fps clip shaped like mocap: still scales, every bone rotating
+            with a little per frame noise and bones drifting. */
+        AnimationMsg MakeMocapClip ( uint32_t aBoneCount, uint32_t aFrameCount )
+        {
+            AnimationMsg message;
+            message.set_version ( 1 );
+            message.set_framerate ( 30 );
+            message.set_duration ( static_cast<float> ( aFrameCount ) / 30.0f );
+            uint32_t noise = 12345;
+            for ( uint32_t frame = 0; frame < aFrameCount; ++frame )
+            {
+                FrameMsg* frame_msg = message.add_frame();
+                const float phase = static_cast<float> ( frame ) / 30.0f;
+                for ( uint32_t bone = 0; bone < aBoneCount; ++bone )
+                {
+                    noise = noise * 1664525u + 1013904223u;
+                    const float jitter = static_cast<float> ( noise >> 16 ) / 65535.0f * 0.0004f;
+                    BoneMsg* bone_msg = frame_msg->add_bone();
+                    bone_msg->mutable_scale()->set_x ( 1.0f );
+                    bone_msg->mutable_scale()->set_y ( 1.0f );
+                    bone_msg->mutable_scale()->set_z ( 1.0f );
+                    const float half_angle = 0.4f * std::sin ( phase * ( 1.0f + bone % 7 ) + bone ) + jitter;
+                    bone_msg->mutable_rotation()->set_w ( std::cos ( half_angle ) );
+                    bone_msg->mutable_rotation()->set_x ( std::sin ( half_angle ) * 0.6f );
+                    bone_msg->mutable_rotation()->set_y ( std::sin ( half_angle ) * 0.8f );
+                    bone_msg->mutable_rotation()->set_z ( 0.0f );
+                    bone_msg->mutable_translation()->set_x ( 0.1f * std::cos ( phase + bone ) );
+                    bone_msg->mutable_translation()->set_y ( static_cast<float> ( bone % 20 ) * 0.1f );
+                    bone_msg->mutable_translation()->set_z ( 0.0f );
+                }
+            }
+            return message;
+        }
+
+        const AnimationMsg& GetClipMsg()
+        {
+            static const AnimationMsg message = MakeMocapClip ( kClipBones, kClipFrames );
+            return message;
+        }
+
+        /** A 61 joint humanoid: a spine up to the head, ten face joints, arms
+            ending in five three joint fingers and legs ending in toes. */
+        const Skeleton& GetHumanoid()
+        {
+            static const std::unique_ptr<Skeleton> skeleton = []
+            {
+                std::vector<int32_t> parents { -1, 0, 1, 2, 3 };
+                parents.insert ( parents.end(), 10, 4 );
+                for ( int side = 0; side < 2; ++side )
+                {
+                    const auto shoulder = static_cast<int32_t> ( parents.size() );
+                    parents.insert ( parents.end(), { 2, shoulder, shoulder + 1, shoulder + 2 } );
+                    for ( int finger = 0; finger < 5; ++finger )
+                    {
+                        const auto base = static_cast<int32_t> ( parents.size() );
+                        parents.insert ( parents.end(), { shoulder + 3, base, base + 1 } );
+                    }
+                    const auto thigh = static_cast<int32_t> ( parents.size() );
+                    parents.insert ( parents.end(), { 0, thigh, thigh + 1, thigh + 2 } );
+                }
+                SkeletonMsg message;
+                for ( int32_t parent : parents )
+                {
+                    JointMsg* joint = message.add_joint();
+                    joint->set_parentindex ( parent );
+                    joint->mutable_scale()->set_x ( 1.0f );
+                    joint->mutable_scale()->set_y ( 1.0f );
+                    joint->mutable_scale()->set_z ( 1.0f );
+                    joint->mutable_rotation()->set_w ( 1.0f );
+                    joint->mutable_invertedscale()->set_x ( 1.0f );
+                    joint->mutable_invertedscale()->set_y ( 1.0f );
+                    joint->mutable_invertedscale()->set_z ( 1.0f );
+                    joint->mutable_invertedrotation()->set_w ( 1.0f );
+                }
+                auto humanoid = std::make_unique<Skeleton>();
+                humanoid->LoadFromPBMsg ( message );
+                return humanoid;
+            }
+            ();
+            return *skeleton;
+        }
+
+        /** A four second clip of GetHumanoid. */
+        const Animation& GetHumanoidClip()
+        {
+            static const Animation clip = []
+            {
+                Animation animation;
+                animation.LoadFromPBMsg ( MakeMocapClip ( static_cast<uint32_t> ( GetHumanoid().GetJoints().size() ), 120 ) );
+                return animation;
+            }
+            ();
+            return clip;
+        }
+
+        const Animation& GetClip ( bool aCompressed )
+        {
+            const AnimationMsg& message = GetClipMsg();
+            static const Animation raw = [&message]
+            {
+                Animation animation;
+                animation.LoadFromPBMsg ( message );
+                return animation;
+            }
+            ();
+            static const Animation compressed = [&message]
+            {
+                Animation animation;
+                animation.LoadFromPBMsg ( message );
+                animation.Compress();
+                return animation;
+            }
+            ();
+            return aCompressed ? compressed : raw;
+        }
+    }
+
+    /** Sampling every bone of a 200 bone, 600 frame clip, raw (0) and
+     *  compressed (1), with the clip's size in memory as a counter. */
+    static void BM_AnimationSample ( benchmark::State& state )
+    {
+        const Animation& animation = GetClip ( state.range ( 0 ) != 0 );
+        double sample = 0.0;
+        for ( auto _ : state )
+        {
+            for ( size_t bone = 0; bone < kClipBones; ++bone )
+            {
+                benchmark::DoNotOptimize ( animation.GetTransform ( bone, sample ) );
+            }
+            sample = animation.AddTimeToSample ( sample, 1.0 / 60.0 );
+        }
+        state.SetItemsProcessed ( state.iterations() * kClipBones );
+        state.counters["bytes"] = static_cast<double> ( animation.GetMemoryUsage() );
+    }
+    BENCHMARK ( BM_AnimationSample )->Arg ( 0 )->Arg ( 1 );
+
+    /** Sampling 16 characters, each playing its own copy of the clip, raw (0)
+     *  and compressed (1), so the clips compete for cache the way a crowd does. */
+    static void BM_AnimationSampleCrowd ( benchmark::State& state )
+    {
+        constexpr size_t kCharacters = 16;
+        std::vector<Animation> animations ( kCharacters );
+        size_t bytes = 0;
+        for ( Animation& animation : animations )
+        {
+            animation.LoadFromPBMsg ( GetClipMsg() );
+            if ( state.range ( 0 ) != 0 )
+            {
+                animation.Compress();
+            }
+            bytes += animation.GetMemoryUsage();
+        }
+        double sample = 0.0;
+        for ( auto _ : state )
+        {
+            for ( size_t character = 0; character < kCharacters; ++character )
+            {
+                const double offset = animations[character].AddTimeToSample ( sample, static_cast<double> ( character ) * 1.3 );
+                for ( size_t bone = 0; bone < kClipBones; ++bone )
+                {
+                    benchmark::DoNotOptimize ( animations[character].GetTransform ( bone, offset ) );
+                }
+            }
+            sample = animations[0].AddTimeToSample ( sample, 1.0 / 60.0 );
+        }
+        state.SetItemsProcessed ( state.iterations() * kCharacters * kClipBones );
+        state.counters["bytes"] = static_cast<double> ( bytes );
+    }
+    BENCHMARK ( BM_AnimationSampleCrowd )->Arg ( 0 )->Arg ( 1 )->Unit ( benchmark::kMicrosecond );
+
+    /// Compressing the 200 bone, 600 frame clip, the aeontool convert --compress cost.
+    static void BM_AnimationCompress ( benchmark::State& state )
+    {
+        for ( auto _ : state )
+        {
+            Animation animation;
+            animation.LoadFromPBMsg ( GetClipMsg() );
+            animation.Compress();
+            benchmark::DoNotOptimize ( animation.GetMemoryUsage() );
+        }
+    }
+    BENCHMARK ( BM_AnimationCompress )->Unit ( benchmark::kMillisecond );
+
+    /** Sampling a whole skeleton of 50, 200 or 500 bones from a 4 second clip,
+     *  bone by bone with GetTransform (0) or all at once with SamplePose (1),
+     *  from raw or compressed frames. */
+    static void BM_AnimationSamplePose ( benchmark::State& state )
+    {
+        const auto bone_count = static_cast<uint32_t> ( state.range ( 0 ) );
+        const bool compressed = state.range ( 2 ) != 0;
+        static std::map<std::pair<uint32_t, bool>, Animation> clips;
+        auto clip = clips.find ( { bone_count, compressed } );
+        if ( clip == clips.end() )
+        {
+            clip = clips.try_emplace ( { bone_count, compressed } ).first;
+            clip->second.LoadFromPBMsg ( MakeMocapClip ( bone_count, 120 ) );
+            if ( compressed )
+            {
+                clip->second.Compress();
+            }
+        }
+        const Animation& animation = clip->second;
+        std::vector<Transform> pose ( bone_count );
+        double sample = 0.0;
+        for ( auto _ : state )
+        {
+            if ( state.range ( 1 ) != 0 )
+            {
+                animation.SamplePose ( sample, pose );
+            }
+            else
+            {
+                for ( size_t bone = 0; bone < bone_count; ++bone )
+                {
+                    pose[bone] = animation.GetTransform ( bone, sample );
+                }
+            }
+            benchmark::DoNotOptimize ( pose.data() );
+            benchmark::ClobberMemory();
+            sample = animation.AddTimeToSample ( sample, 1.0 / 60.0 );
+        }
+        state.SetItemsProcessed ( state.iterations() * bone_count );
+    }
+    BENCHMARK ( BM_AnimationSamplePose )->ArgNames ( { "bones", "pose", "compressed" } )->ArgsProduct ( { { 50, 200, 500 }, { 0, 1 }, { 0, 1 } } );
+
+    /** The CPU animation update of 64 humanoids standing 2 to 128 units in
+     *  front of the camera, at full detail (0) or with the recommended animation
+     *  LOD (1), with the fraction of updates that sampled the clip as a counter. */
+    static void BM_AnimationLodCrowd ( benchmark::State& state )
+    {
+        constexpr size_t kCharacters = 64;
+        const Skeleton& skeleton = GetHumanoid();
+        const std::vector<Skeleton::Joint>& joints = skeleton.GetJoints();
+        const Animation& clip = GetHumanoidClip();
+        std::vector<AnimationLod> lods ( kCharacters );
+        if ( state.range ( 0 ) != 0 )
+        {
+            for ( AnimationLod& lod : lods )
+            {
+                lod.SetLevels ( AnimationLod::GetRecommendedLevels() );
+            }
+        }
+        std::vector<std::vector<float>> matrices ( kCharacters, std::vector<float> ( joints.size() * 16 ) );
+        std::vector<Transform> pose ( joints.size() );
+        const Matrix4x4 view{};
+        double sample = 0.0;
+        size_t sampled = 0;
+        for ( auto _ : state )
+        {
+            for ( size_t character = 0; character < kCharacters; ++character )
+            {
+                const AABB bounds { Vector3{ 0.0f, 1.0f, -2.0f - 2.0f * static_cast<float> ( character ) }, Vector3{ 0.5f, 1.0f, 0.3f } };
+                AnimationLod& lod = lods[character];
+                float* skinning = matrices[character].data();
+                if ( !lod.Advance ( GetProjectedSize ( bounds, view, 60.0f ), 1.0 / 60.0 ) )
+                {
+                    lod.Extrapolate ( matrices[character] );
+                    continue;
+                }
+                ++sampled;
+                clip.SamplePose ( clip.AddTimeToSample ( sample, static_cast<double> ( character ) * 0.37 ), pose );
+                const std::span<const uint16_t> bone_map = lod.GetBoneMap ( skeleton );
+                for ( size_t i = 0; i < joints.size(); ++i )
+                {
+                    if ( bone_map[i] == i )
+                    {
+                        const Matrix4x4 matrix{ pose[i] * joints[i].GetInvertedTransform() };
+                        memcpy ( skinning + i * 16, matrix.GetMatrix4x4(), sizeof ( float ) * 16 );
+                    }
+                }
+                for ( size_t i = 0; i < joints.size(); ++i )
+                {
+                    if ( bone_map[i] != i )
+                    {
+                        memcpy ( skinning + i * 16, skinning + bone_map[i] * 16, sizeof ( float ) * 16 );
+                    }
+                }
+                lod.Store ( matrices[character] );
+            }
+            benchmark::ClobberMemory();
+            sample = clip.AddTimeToSample ( sample, 1.0 / 60.0 );
+        }
+        state.SetItemsProcessed ( state.iterations() * kCharacters );
+        state.counters["sampled"] = static_cast<double> ( sampled ) / static_cast<double> ( state.iterations() * kCharacters );
+    }
+    BENCHMARK ( BM_AnimationLodCrowd )->Arg ( 0 )->Arg ( 1 )->Unit ( benchmark::kMicrosecond );
+
+    /** The CPU animation update of 1000 humanoids playing the same clip at
+     *  1, 16 or 1000 different phases, without (0) or with (1) the pose cache,
+     *  with the fraction of instances that sampled the clip as a counter. */
+    static void BM_PoseCacheCrowd ( benchmark::State& state )
+    {
+        constexpr size_t kCharacters = 1000;
+        const size_t phases = static_cast<size_t> ( state.range ( 0 ) );
+        const bool cached = state.range ( 1 ) != 0;
+        const Skeleton& skeleton = GetHumanoid();
+        const std::vector<Skeleton::Joint>& joints = skeleton.GetJoints();
+        const Animation& clip = GetHumanoidClip();
+        PoseCache cache;
+        std::vector<std::vector<float>> matrices ( kCharacters, std::vector<float> ( joints.size() * 16 ) );
+        std::vector<Transform> pose ( joints.size() );
+        double sample = 0.0;
+        size_t sampled = 0;
+        for ( auto _ : state )
+        {
+            cache.BeginFrame();
+            for ( size_t character = 0; character < kCharacters; ++character )
+            {
+                double character_sample = clip.AddTimeToSample ( sample, static_cast<double> ( character % phases ) * 0.37 );
+                const std::span<float> skinning = matrices[character];
+                PoseCacheKey key{};
+                if ( cached )
+                {
+                    character_sample = cache.Quantize ( character_sample );
+                    key = PoseCacheKey{ &skeleton, &clip, character_sample, 0 };
+                    if ( const PoseCacheEntry* entry = cache.Find ( key ) )
+                    {
+                        memcpy ( skinning.data(), entry->mMatrices.data(), skinning.size_bytes() );
+                        continue;
+                    }
+                }
+                ++sampled;
+                clip.SamplePose ( character_sample, pose );
+                for ( size_t i = 0; i < joints.size(); ++i )
+                {
+                    const Matrix4x4 matrix{ pose[i] * joints[i].GetInvertedTransform() };
+                    memcpy ( skinning.data() + i * 16, matrix.GetMatrix4x4(), sizeof ( float ) * 16 );
+                }
+                if ( cached )
+                {
+                    cache.Insert ( key, skinning );
+                }
+            }
+            benchmark::ClobberMemory();
+            sample = clip.AddTimeToSample ( sample, 1.0 / 60.0 );
+        }
+        state.SetItemsProcessed ( state.iterations() * kCharacters );
+        state.counters["sampled"] = static_cast<double> ( sampled ) / static_cast<double> ( state.iterations() * kCharacters );
+    }
+    BENCHMARK ( BM_PoseCacheCrowd )->ArgNames ( { "phases", "cached" } )->ArgsProduct ( { { 1, 16, 1000 }, { 0, 1 } } )->Unit ( benchmark::kMicrosecond );
+}
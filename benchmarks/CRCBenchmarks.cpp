@@ -0,0 +1,115 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <vector>
+#include "aeongames/CRC.hpp"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        std::vector<char> MakeMessage ( size_t aSize )
+        {
+            std::vector<char> message ( aSize );
+            uint32_t state = 11u;
+            for ( char& byte : message )
+            {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<char> ( state >> 24 );
+            }
+            return message;
+        }
+
+        /// The byte at a time table walk crc32i used before slicing, kept as the baseline.
+        uint32_t BytewiseCrc32 ( const char* aMessage, size_t aSize, uint32_t aPreviousCrc )
+        {
+            static const auto table = []()
+            {
+                std::vector<uint32_t> entries ( 256 );
+                for ( uint32_t i = 0; i < 256; ++i )
+                {
+                    uint32_t crc = i;
+                    for ( int bit = 0; bit < 8; ++bit )
+                    {
+                        crc = ( crc & 1 ) ? ( crc >> 1 ) ^ 0xEDB88320u : crc >> 1;
+                    }
+                    entries[i] = crc;
+                }
+                return entries;
+            }();
+            uint32_t crc = ~aPreviousCrc;
+            for ( size_t i = 0; i < aSize; ++i )
+            {
+                crc = ( crc >> 8 ) ^ table[ ( crc ^ static_cast<uint8_t> ( aMessage[i] ) ) & 0xFF];
+            }
+            return ~crc;
+        }
+
+        template<uint32_t ( *Crc ) ( const char*, size_t, uint32_t ) >
+        void RunCrc32 ( benchmark::State& state )
+        {
+            const std::vector<char> message = MakeMessage ( static_cast<size_t> ( state.range ( 0 ) ) );
+            uint32_t crc = 0;
+            for ( auto _ : state )
+            {
+                crc = Crc ( message.data(), message.size(), crc );
+                benchmark::DoNotOptimize ( crc );
+            }
+            state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( message.size() ) );
+        }
+    }
+
+    /// Arg 0 is the message size in bytes; throughput is reported as bytes per second.
+    static void BM_CRC32Bytewise ( benchmark::State& state )
+    {
+        RunCrc32<BytewiseCrc32> ( state );
+    }
+    BENCHMARK ( BM_CRC32Bytewise )->Arg ( 16 )->Arg ( 64 )->Arg ( 4 << 10 )->Arg ( 1 << 20 );
+
+    static void BM_CRC32Slice8 ( benchmark::State& state )
+    {
+        RunCrc32<crc32i_slice8> ( state );
+    }
+    BENCHMARK ( BM_CRC32Slice8 )->Arg ( 16 )->Arg ( 64 )->Arg ( 4 << 10 )->Arg ( 1 << 20 );
+
+    static void BM_CRC32Clmul ( benchmark::State& state )
+    {
+        RunCrc32<crc32i_clmul> ( state );
+        state.SetLabel ( crc32_has_clmul() ? "PCLMULQDQ" : "Slice8 fallback" );
+    }
+    BENCHMARK ( BM_CRC32Clmul )->Arg ( 16 )->Arg ( 64 )->Arg ( 4 << 10 )->Arg ( 1 << 20 );
+
+    static void BM_CRC32Dispatch ( benchmark::State& state )
+    {
+        RunCrc32<crc32i> ( state );
+    }
+    BENCHMARK ( BM_CRC32Dispatch )->Arg ( 16 )->Arg ( 64 )->Arg ( 4 << 10 )->Arg ( 1 << 20 );
+
+    static void BM_CRC64 ( benchmark::State& state )
+    {
+        const std::vector<char> message = MakeMessage ( static_cast<size_t> ( state.range ( 0 ) ) );
+        uint64_t crc = 0;
+        for ( auto _ : state )
+        {
+            crc = crc64i ( message.data(), message.size(), crc );
+            benchmark::DoNotOptimize ( crc );
+        }
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( message.size() ) );
+    }
+    BENCHMARK ( BM_CRC64 )->Arg ( 64 )->Arg ( 4 << 10 )->Arg ( 1 << 20 );
+}
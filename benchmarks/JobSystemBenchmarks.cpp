@@ -0,0 +1,93 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "aeongames/JobSystem.hpp"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    /// Empty jobs measure pure scheduling overhead: create, queue, steal, finish.
+    static void BM_JobSystemEmptyJobs ( benchmark::State& state )
+    {
+        JobSystem job_system{static_cast<size_t> ( state.range ( 0 ) ) };
+        constexpr size_t kJobCount = 4096;
+        for ( auto _ : state )
+        {
+            auto root = job_system.CreateJob ( {} );
+            for ( size_t i = 0; i < kJobCount; ++i )
+            {
+                job_system.Submit ( job_system.CreateJob ( root, {} ) );
+            }
+            job_system.Submit ( root );
+            job_system.Wait ( root );
+        }
+        state.SetItemsProcessed ( state.iterations() * kJobCount );
+    }
+    BENCHMARK ( BM_JobSystemEmptyJobs )->Arg ( 0 )->Arg ( 1 )->Arg ( 3 )->Arg ( 7 )->UseRealTime();
+
+    /// ParallelFor over a cheap per element kernel at different grain sizes.
+    static void BM_JobSystemParallelFor ( benchmark::State& state )
+    {
+        JobSystem job_system{static_cast<size_t> ( state.range ( 0 ) ) };
+        const size_t grain = static_cast<size_t> ( state.range ( 1 ) );
+        std::vector<float> data ( 1 << 20, 1.0f );
+        for ( auto _ : state )
+        {
+            job_system.ParallelFor ( 0, data.size(), grain, [&data] ( size_t aBegin, size_t aEnd )
+            {
+                for ( size_t i = aBegin; i < aEnd; ++i )
+                {
+                    data[i] = std::sqrt ( data[i] * 1.0001f + 0.5f );
+                }
+            } );
+            benchmark::DoNotOptimize ( data.data() );
+        }
+        state.SetItemsProcessed ( state.iterations() * data.size() );
+    }
+    BENCHMARK ( BM_JobSystemParallelFor )
+    ->ArgsProduct ( {{0, 1, 3, 7}, {0, 1024, 16384}} )
+    ->ArgNames ( {"workers", "grain"} )
+    ->UseRealTime();
+
+    /// A long dependency chain exercises the continuation path.
+    static void BM_JobSystemDependencyChain ( benchmark::State& state )
+    {
+        JobSystem job_system{static_cast<size_t> ( state.range ( 0 ) ) };
+        constexpr size_t kChainLength = 1024;
+        std::vector<JobSystem::JobHandle> chain ( kChainLength );
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < kChainLength; ++i )
+            {
+                chain[i] = job_system.CreateJob ( {} );
+                if ( i > 0 )
+                {
+                    job_system.AddDependency ( chain[i], chain[i - 1] );
+                }
+            }
+            for ( auto& job : chain )
+            {
+                job_system.Submit ( job );
+            }
+            job_system.Wait ( chain.back() );
+        }
+        state.SetItemsProcessed ( state.iterations() * kChainLength );
+    }
+    BENCHMARK ( BM_JobSystemDependencyChain )->Arg ( 0 )->Arg ( 3 )->UseRealTime();
+}
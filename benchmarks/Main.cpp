@@ -0,0 +1,32 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "benchmark/benchmark.h"
+#include "aeongames/AeonEngine.hpp"
+
+int main ( int argc, char **argv )
+{
+    benchmark::Initialize ( &argc, argv );
+    if ( benchmark::ReportUnrecognizedArguments ( argc, argv ) )
+    {
+        return 1;
+    }
+    AeonGames::InitializeGlobalEnvironment();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    AeonGames::FinalizeGlobalEnvironment();
+    return 0;
+}
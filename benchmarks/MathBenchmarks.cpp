@@ -0,0 +1,228 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <vector>
+#include "aeongames/AABB.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Transform.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/Vector3.hpp"
+#include "../engine/math/SIMD.h"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// Enough independent inputs that the loop measures throughput
+        /// rather than one dependency chain.
+        constexpr size_t kMathBatch = 1024;
+
+        std::vector<float> MakeInputs ( size_t aCount, float aRange )
+        {
+            std::vector<float> values ( aCount );
+            uint32_t state = 7u;
+            for ( float& value : values )
+            {
+                state = state * 1664525u + 1013904223u;
+                value = ( static_cast<float> ( state >> 8 ) / static_cast<float> ( 1u << 24 ) * 2.0f - 1.0f ) * aRange;
+            }
+            return values;
+        }
+
+        void Label ( benchmark::State& state, bool aSimd )
+        {
+            state.SetLabel ( aSimd ? GetSimdInstructionSet() : "Scalar" );
+            state.SetItemsProcessed ( state.iterations() * kMathBatch );
+        }
+    }
+
+    /// Arg 0 selects the scalar reference (0) or the SIMD kernel (1).
+    static void BM_MathMultiply4x4Matrix ( benchmark::State& state )
+    {
+        const std::vector<float> inputs = MakeInputs ( kMathBatch * 16 + 16, 10.0f );
+        std::vector<float> outputs ( kMathBatch * 16 );
+        const bool simd = state.range ( 0 ) != 0;
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < kMathBatch; ++i )
+            {
+                const float* a = inputs.data() + i * 16;
+                if ( simd )
+                {
+                    SimdMultiply4x4Matrix ( a, a + 16, outputs.data() + i * 16 );
+                }
+                else
+                {
+                    Multiply4x4Matrix ( a, a + 16, outputs.data() + i * 16 );
+                }
+            }
+            benchmark::DoNotOptimize ( outputs.data() );
+            benchmark::ClobberMemory();
+        }
+        Label ( state, simd );
+    }
+    BENCHMARK ( BM_MathMultiply4x4Matrix )->Arg ( 0 )->Arg ( 1 )->ArgName ( "simd" );
+
+    static void BM_MathMultQuats ( benchmark::State& state )
+    {
+        const std::vector<float> inputs = MakeInputs ( kMathBatch * 4 + 4, 1.0f );
+        std::vector<float> outputs ( kMathBatch * 4 );
+        const bool simd = state.range ( 0 ) != 0;
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < kMathBatch; ++i )
+            {
+                const float* q = inputs.data() + i * 4;
+                if ( simd )
+                {
+                    SimdMultQuats ( q, q + 4, outputs.data() + i * 4 );
+                }
+                else
+                {
+                    MultQuats ( q, q + 4, outputs.data() + i * 4 );
+                }
+            }
+            benchmark::DoNotOptimize ( outputs.data() );
+            benchmark::ClobberMemory();
+        }
+        Label ( state, simd );
+    }
+    BENCHMARK ( BM_MathMultQuats )->Arg ( 0 )->Arg ( 1 )->ArgName ( "simd" );
+
+    static void BM_MathTransformBox ( benchmark::State& state )
+    {
+        const std::vector<float> matrices = MakeInputs ( kMathBatch * 9, 2.0f );
+        const std::vector<float> boxes = MakeInputs ( kMathBatch * 9, 100.0f );
+        std::vector<float> outputs ( kMathBatch * 6 );
+        const bool simd = state.range ( 0 ) != 0;
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < kMathBatch; ++i )
+            {
+                const float* box = boxes.data() + i * 9;
+                float* out = outputs.data() + i * 6;
+                if ( simd )
+                {
+                    SimdTransformBox ( matrices.data() + i * 9, box, box + 3, box + 6, out, out + 3 );
+                }
+                else
+                {
+                    TransformBox ( matrices.data() + i * 9, box, box + 3, box + 6, out, out + 3 );
+                }
+            }
+            benchmark::DoNotOptimize ( outputs.data() );
+            benchmark::ClobberMemory();
+        }
+        Label ( state, simd );
+    }
+    BENCHMARK ( BM_MathTransformBox )->Arg ( 0 )->Arg ( 1 )->ArgName ( "simd" );
+
+    /// Six frustum planes against a batch of boxes, about half of them visible.
+    static void BM_MathPlanesIntersectBox ( benchmark::State& state )
+    {
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 16.0f / 9.0f, 1.0f, 200.0f );
+        const float* m = projection.GetMatrix4x4();
+        const float planes[6 * 4]
+        {
+            - ( m[3] + m[0] ), - ( m[7] + m[4] ), - ( m[11] + m[8] ), ( m[15] + m[12] ),
+            - ( m[3] - m[0] ), - ( m[7] - m[4] ), - ( m[11] - m[8] ), ( m[15] - m[12] ),
+            - ( m[3] + m[1] ), - ( m[7] + m[5] ), - ( m[11] + m[9] ), ( m[15] + m[13] ),
+            - ( m[3] - m[1] ), - ( m[7] - m[5] ), - ( m[11] - m[9] ), ( m[15] - m[13] ),
+            - ( m[3] + m[2] ), - ( m[7] + m[6] ), - ( m[11] + m[10] ), ( m[15] + m[14] ),
+            - ( m[3] - m[2] ), - ( m[7] - m[6] ), - ( m[11] - m[10] ), ( m[15] - m[14] )
+        };
+        float lanes[kSimdPlaneLanes * 4];
+        PackPlaneLanes ( planes, 6, lanes );
+        // Spread around the view volume (Y forward) so both outcomes are common.
+        std::vector<float> boxes = MakeInputs ( kMathBatch * 6, 1.0f );
+        for ( size_t i = 0; i < kMathBatch; ++i )
+        {
+            float* box = boxes.data() + i * 6;
+            box[0] *= 120.0f;
+            box[1] = box[1] * 120.0f + 100.0f;
+            box[2] *= 70.0f;
+        }
+        const bool simd = state.range ( 0 ) != 0;
+        size_t visible = 0;
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < kMathBatch; ++i )
+            {
+                const float* box = boxes.data() + i * 6;
+                const float radii[3] { 5.0f, 5.0f, 5.0f };
+                visible += ( simd ? SimdPlanesIntersectBox ( lanes, box, radii ) : PlanesIntersectBox ( planes, 6, box, radii ) ) ? 1 : 0;
+            }
+        }
+        benchmark::DoNotOptimize ( visible );
+        Label ( state, simd );
+        state.counters["visible"] = static_cast<double> ( visible ) / static_cast<double> ( state.iterations() * kMathBatch );
+    }
+    BENCHMARK ( BM_MathPlanesIntersectBox )->Arg ( 0 )->Arg ( 1 )->ArgName ( "simd" );
+
+    /// The engine entry points the kernels sit behind.
+    static void BM_MathTransformCompose ( benchmark::State& state )
+    {
+        const std::vector<float> inputs = MakeInputs ( kMathBatch * 3 + 3, 10.0f );
+        std::vector<Transform> transforms;
+        transforms.reserve ( kMathBatch );
+        for ( size_t i = 0; i < kMathBatch; ++i )
+        {
+            const float* v = inputs.data() + i * 3;
+            transforms.emplace_back ( Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion { 1.0f, v[0] * 0.01f, v[1] * 0.01f, v[2] * 0.01f }.Normalize(), Vector3 { v } );
+        }
+        std::vector<Transform> outputs ( kMathBatch );
+        for ( auto _ : state )
+        {
+            for ( size_t i = 1; i < kMathBatch; ++i )
+            {
+                outputs[i] = transforms[i - 1] * transforms[i];
+            }
+            benchmark::DoNotOptimize ( outputs.data() );
+            benchmark::ClobberMemory();
+        }
+        Label ( state, true );
+    }
+    BENCHMARK ( BM_MathTransformCompose );
+
+    static void BM_MathFrustumIntersects ( benchmark::State& state )
+    {
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 16.0f / 9.0f, 1.0f, 200.0f );
+        const Frustum frustum { projection };
+        const std::vector<float> centers = MakeInputs ( kMathBatch * 3, 150.0f );
+        std::vector<AABB> boxes;
+        boxes.reserve ( kMathBatch );
+        for ( size_t i = 0; i < kMathBatch; ++i )
+        {
+            boxes.emplace_back ( Vector3 { centers.data() + i * 3 }, Vector3 { 5.0f, 5.0f, 5.0f } );
+        }
+        size_t visible = 0;
+        for ( auto _ : state )
+        {
+            for ( const AABB& box : boxes )
+            {
+                visible += frustum.Intersects ( box ) ? 1 : 0;
+            }
+        }
+        benchmark::DoNotOptimize ( visible );
+        Label ( state, true );
+    }
+    BENCHMARK ( BM_MathFrustumIntersects );
+}
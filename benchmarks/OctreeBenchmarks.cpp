@@ -0,0 +1,140 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aeongames/Octree.hpp"
+#include "aeongames/LinearOctree.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Vector3.hpp"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        constexpr float kWorldExtent = 1000.0f;
+        const AABB kWorldBounds { Vector3 {}, Vector3 { kWorldExtent, kWorldExtent, kWorldExtent } };
+        constexpr uint32_t kOctreeDepth = 8;
+
+        /** Shared pool of scattered unit-ish nodes; the largest benchmark size
+         *  is built once and smaller sizes use a prefix of it. */
+        const std::vector<std::unique_ptr<Node >>& GetNodePool ( size_t aCount )
+        {
+            static std::vector<std::unique_ptr<Node >> pool;
+            uint32_t state = static_cast<uint32_t> ( pool.size() ) * 2654435761u + 1u;
+            auto next = [&state]()
+            {
+                state = state * 1664525u + 1013904223u;
+                return static_cast<float> ( state >> 8 ) / static_cast<float> ( 1u << 24 );
+            };
+            while ( pool.size() < aCount )
+            {
+                auto node = std::make_unique<Node>();
+                const Vector3 center { ( next() * 2.0f - 1.0f ) * kWorldExtent,
+                                       ( next() * 2.0f - 1.0f ) * kWorldExtent,
+                                       ( next() * 2.0f - 1.0f ) * kWorldExtent };
+                const float radius = 0.5f + next() * 4.0f;
+                node->SetAABB ( AABB { center, Vector3 { radius, radius, radius } } );
+                pool.emplace_back ( std::move ( node ) );
+            }
+            return pool;
+        }
+
+        template<class Tree>
+        void FillTree ( Tree& aTree, size_t aCount )
+        {
+            const auto& pool = GetNodePool ( aCount );
+            for ( size_t i = 0; i < aCount; ++i )
+            {
+                aTree.AddNode ( pool[i].get() );
+            }
+        }
+    }
+
+    template<class Tree>
+    static void BM_OctreeBuild ( benchmark::State& state )
+    {
+        const size_t count = static_cast<size_t> ( state.range ( 0 ) );
+        GetNodePool ( count );
+        for ( auto _ : state )
+        {
+            Tree tree { kWorldBounds, kOctreeDepth };
+            FillTree ( tree, count );
+            // Counting cells forces the linear tree to settle its pending sort.
+            benchmark::DoNotOptimize ( tree.GetCellCount() );
+        }
+        state.SetItemsProcessed ( state.iterations() * count );
+    }
+    BENCHMARK_TEMPLATE ( BM_OctreeBuild, Octree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 )->Unit ( benchmark::kMillisecond );
+    BENCHMARK_TEMPLATE ( BM_OctreeBuild, LinearOctree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 )->Unit ( benchmark::kMillisecond );
+
+    /// Small box queries, roughly a collision broad phase.
+    template<class Tree>
+    static void BM_OctreeQueryAABB ( benchmark::State& state )
+    {
+        const size_t count = static_cast<size_t> ( state.range ( 0 ) );
+        Tree tree { kWorldBounds, kOctreeDepth };
+        FillTree ( tree, count );
+        tree.GetCellCount();
+        uint32_t seed = 1;
+        size_t hits = 0;
+        for ( auto _ : state )
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const float x = ( static_cast<float> ( seed >> 8 ) / static_cast<float> ( 1u << 24 ) * 2.0f - 1.0f ) * kWorldExtent;
+            tree.QueryAABB ( AABB { Vector3 { x, -x * 0.5f, x * 0.25f }, Vector3 { 50.0f, 50.0f, 50.0f } }, [&hits] ( const Node* )
+            {
+                ++hits;
+            } );
+        }
+        benchmark::DoNotOptimize ( hits );
+        state.SetItemsProcessed ( state.iterations() );
+        state.counters["hits/query"] = benchmark::Counter ( static_cast<double> ( hits ) / static_cast<double> ( state.iterations() ) );
+    }
+    BENCHMARK_TEMPLATE ( BM_OctreeQueryAABB, Octree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 );
+    BENCHMARK_TEMPLATE ( BM_OctreeQueryAABB, LinearOctree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 );
+
+    /// A camera frustum from the world centre, roughly a view cull.
+    template<class Tree>
+    static void BM_OctreeQueryFrustum ( benchmark::State& state )
+    {
+        const size_t count = static_cast<size_t> ( state.range ( 0 ) );
+        Tree tree { kWorldBounds, kOctreeDepth };
+        FillTree ( tree, count );
+        tree.GetCellCount();
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 16.0f / 9.0f, 1.0f, 400.0f );
+        const Frustum frustum { projection };
+        size_t hits = 0;
+        for ( auto _ : state )
+        {
+            tree.QueryFrustum ( frustum, [&hits] ( const Node* )
+            {
+                ++hits;
+            } );
+        }
+        benchmark::DoNotOptimize ( hits );
+        state.SetItemsProcessed ( state.iterations() );
+        state.counters["hits/query"] = benchmark::Counter ( static_cast<double> ( hits ) / static_cast<double> ( state.iterations() ) );
+    }
+    BENCHMARK_TEMPLATE ( BM_OctreeQueryFrustum, Octree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 );
+    BENCHMARK_TEMPLATE ( BM_OctreeQueryFrustum, LinearOctree )->RangeMultiplier ( 10 )->Range ( 10000, 1000000 );
+}
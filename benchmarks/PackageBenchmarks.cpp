@@ -0,0 +1,618 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#include "aeongames/AeonEngine.hpp"
+#include "aeongames/CRC.hpp"
+#include "aeongames/Package.hpp"
+#include "BatchRead.h"
+#include "Compression.h"
+#include "ResourceDirectory.h"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// Large enough that the package does not fit in any CPU cache and
+        /// that mapping it is a real commitment of address space.
+        constexpr uint64_t kPackageSize = uint64_t{2} << 30;
+
+        /// A level's worth of assets, each loaded on its own or all in one batch.
+        constexpr uint64_t kLevelSize = uint64_t{64} << 20;
+
+        /** An uncompressed AEONPKG split in entries of one size, written to
+            the temporary directory on first use and removed when the
+            benchmarks exit. */
+        class BenchmarkPackage
+        {
+        public:
+            BenchmarkPackage ( size_t aEntrySize, uint64_t aPackageSize ) :
+                mPath{std::filesystem::temp_directory_path() / ( "aeon_benchmark_" + std::to_string ( aEntrySize ) + "_" + std::to_string ( aPackageSize ) + ".pkg" ) }
+            {
+                const size_t count = static_cast<size_t> ( aPackageSize / aEntrySize );
+                std::vector<char> blob;
+                std::vector<PKGDirectoryEntry> entries ( count );
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    const std::string path = "entry" + std::to_string ( i );
+                    entries[i].crc = crc32i ( path.data(), path.size() );
+                    entries[i].path_offset = static_cast<uint32_t> ( blob.size() );
+                    entries[i].compressed_size = aEntrySize;
+                    entries[i].uncompressed_size = aEntrySize;
+                    entries[i].compression = NONE;
+                    blob.insert ( blob.end(), path.begin(), path.end() );
+                    blob.push_back ( '\0' );
+                }
+                std::sort ( entries.begin(), entries.end(), [] ( const PKGDirectoryEntry & a, const PKGDirectoryEntry & b )
+                {
+                    return a.crc < b.crc;
+                } );
+                PKGHeader header{};
+                std::memcpy ( header.id, "AEONPKG", 8 );
+                header.version[0] = 1;
+                header.file_count = static_cast<uint32_t> ( count );
+                header.index_offset = sizeof ( PKGHeader );
+                header.strings_offset = static_cast<uint32_t> ( header.index_offset + count * sizeof ( PKGDirectoryEntry ) );
+                uint64_t cursor = header.strings_offset + blob.size();
+                for ( PKGDirectoryEntry& entry : entries )
+                {
+                    entry.data_offset = cursor;
+                    cursor += aEntrySize;
+                    mEntries.emplace_back ( entry.crc, entry.data_offset );
+                }
+                std::ofstream file ( mPath, std::ios::out | std::ios::binary | std::ios::trunc );
+                file.write ( reinterpret_cast<const char*> ( &header ), sizeof ( header ) );
+                file.write ( reinterpret_cast<const char*> ( entries.data() ), static_cast<std::streamsize> ( entries.size() * sizeof ( PKGDirectoryEntry ) ) );
+                file.write ( blob.data(), static_cast<std::streamsize> ( blob.size() ) );
+                std::vector<char> payload ( aEntrySize, 'A' );
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    std::memcpy ( payload.data(), &i, sizeof ( i ) );
+                    file.write ( payload.data(), static_cast<std::streamsize> ( payload.size() ) );
+                }
+                file.close();
+                mPackage = std::make_unique<Package> ( mPath.string() );
+            }
+            ~BenchmarkPackage()
+            {
+                mPackage.reset();
+                std::error_code ec;
+                std::filesystem::remove ( mPath, ec );
+            }
+            const Package& Get() const
+            {
+                return *mPackage;
+            }
+            const std::filesystem::path& GetPath() const
+            {
+                return mPath;
+            }
+            /// CRC and data offset of an entry, cycling through them in file order.
+            const std::pair<uint32_t, uint64_t>& GetEntry ( size_t aIndex ) const
+            {
+                return mEntries[aIndex % mEntries.size()];
+            }
+            size_t GetEntryCount() const
+            {
+                return mEntries.size();
+            }
+        private:
+            std::filesystem::path mPath;
+            std::vector<std::pair<uint32_t, uint64_t >> mEntries{};
+            std::unique_ptr<Package> mPackage{};
+        };
+
+        BenchmarkPackage& GetBenchmarkPackage ( size_t aEntrySize, uint64_t aPackageSize = kPackageSize )
+        {
+            static std::map<std::pair<size_t, uint64_t>, std::unique_ptr<BenchmarkPackage >> packages;
+            std::unique_ptr<BenchmarkPackage>& package = packages[ {aEntrySize, aPackageSize}];
+            if ( !package )
+            {
+                package = std::make_unique<BenchmarkPackage> ( aEntrySize, aPackageSize );
+            }
+            return *package;
+        }
+
+        /// Read and write system calls made by this process so far, zero where unavailable.
+        uint64_t GetSyscallCount()
+        {
+#if defined(__linux__)
+            std::ifstream io ( "/proc/self/io" );
+            std::string key;
+            uint64_t value{};
+            uint64_t count{};
+            while ( io >> key >> value )
+            {
+                if ( key == "syscr:" || key == "syscw:" )
+                {
+                    count += value;
+                }
+            }
+            return count;
+#else
+            return 0;
+#endif
+        }
+
+        uint64_t GetPageFaultCount()
+        {
+#if defined(__linux__)
+            rusage usage{};
+            getrusage ( RUSAGE_SELF, &usage );
+            return static_cast<uint64_t> ( usage.ru_minflt + usage.ru_majflt );
+#else
+            return 0;
+#endif
+        }
+
+        /// Drops a file's clean pages from the page cache, where the platform allows it.
+        void EvictFromPageCache ( const std::filesystem::path& aPath )
+        {
+#if defined(__linux__)
+            const int file = open ( aPath.c_str(), O_RDONLY | O_CLOEXEC );
+            if ( file >= 0 )
+            {
+                posix_fadvise ( file, 0, 0, POSIX_FADV_DONTNEED );
+                close ( file );
+            }
+#else
+            ( void ) aPath;
+#endif
+        }
+
+        /// What a decoder does at the least: look at every page of the bytes it was handed.
+        uint64_t Consume ( const uint8_t* aData, size_t aSize )
+        {
+            uint64_t sum{};
+            for ( size_t i = 0; i < aSize; i += 4096 )
+            {
+                sum += aData[i];
+            }
+            return sum + aData[aSize - 1];
+        }
+
+        template<class Load>
+        void RunPackageLoad ( benchmark::State& state, Load&& aLoad )
+        {
+            const size_t entry_size = static_cast<size_t> ( state.range ( 0 ) );
+            const BenchmarkPackage& package = GetBenchmarkPackage ( entry_size );
+            size_t index = 0;
+            uint64_t sum = 0;
+            const uint64_t syscalls = GetSyscallCount();
+            const uint64_t faults = GetPageFaultCount();
+            for ( auto _ : state )
+            {
+                sum += aLoad ( package, package.GetEntry ( index++ ), entry_size );
+            }
+            benchmark::DoNotOptimize ( sum );
+            state.counters["syscalls"] = benchmark::Counter ( static_cast<double> ( GetSyscallCount() - syscalls ), benchmark::Counter::kAvgIterations );
+            state.counters["faults"] = benchmark::Counter ( static_cast<double> ( GetPageFaultCount() - faults ), benchmark::Counter::kAvgIterations );
+            state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( entry_size ) );
+        }
+    }
+
+    /// Arg 0 is the entry size; what LoadFile did before packages were mapped: a fresh stream per load.
+    static void BM_PackageStreamRead ( benchmark::State& state )
+    {
+        std::vector<uint8_t> buffer ( static_cast<size_t> ( state.range ( 0 ) ) );
+        RunPackageLoad ( state, [&buffer] ( const BenchmarkPackage & aPackage, const std::pair<uint32_t, uint64_t>& aEntry, size_t aSize )
+        {
+            std::ifstream file ( aPackage.GetPath(), std::ios::in | std::ios::binary );
+            file.seekg ( static_cast<std::streamoff> ( aEntry.second ), std::ios::beg );
+            file.read ( reinterpret_cast<char*> ( buffer.data() ), static_cast<std::streamsize> ( aSize ) );
+            return Consume ( buffer.data(), aSize );
+        } );
+    }
+    BENCHMARK ( BM_PackageStreamRead )->Arg ( 64 << 10 )->Arg ( 4 << 20 )->ArgName ( "entry" );
+
+    /// Arg 0 is the entry size; LoadFile copying out of the mapping into a caller buffer.
+    static void BM_PackageLoadFile ( benchmark::State& state )
+    {
+        std::vector<uint8_t> buffer ( static_cast<size_t> ( state.range ( 0 ) ) );
+        RunPackageLoad ( state, [&buffer] ( const BenchmarkPackage & aPackage, const std::pair<uint32_t, uint64_t>& aEntry, size_t aSize )
+        {
+            aPackage.Get().LoadFile ( aEntry.first, buffer.data(), aSize );
+            return Consume ( buffer.data(), aSize );
+        } );
+    }
+    BENCHMARK ( BM_PackageLoadFile )->Arg ( 64 << 10 )->Arg ( 4 << 20 )->ArgName ( "entry" );
+
+    /// Arg 0 is the entry size; the bytes are used in place from the package mapping.
+    static void BM_PackageFileView ( benchmark::State& state )
+    {
+        RunPackageLoad ( state, [] ( const BenchmarkPackage & aPackage, const std::pair<uint32_t, uint64_t>& aEntry, size_t )
+        {
+            const std::span<const uint8_t> view = aPackage.Get().GetFileView ( aEntry.first );
+            return Consume ( view.data(), view.size() );
+        } );
+    }
+    BENCHMARK ( BM_PackageFileView )->Arg ( 64 << 10 )->Arg ( 4 << 20 )->ArgName ( "entry" );
+
+    namespace
+    {
+        /** Loads every asset of a 64 MiB package of 64 KiB assets per iteration,
+            on the resource path so the engine entry points are measured.
+            Arg 0 evicts the package from the page cache before each level (1)
+            or leaves it warm (0). */
+        template<class Load>
+        void RunLevelLoad ( benchmark::State& state, Load&& aLoad )
+        {
+            const BenchmarkPackage& package = GetBenchmarkPackage ( 64 << 10, kLevelSize );
+            const bool cold = state.range ( 0 ) != 0;
+            const std::vector<std::string> previous_path = GetResourcePath();
+            std::vector<std::vector<uint8_t >> buffers ( package.GetEntryCount(), std::vector<uint8_t> ( 64 << 10 ) );
+            std::vector<ResourceRead> reads;
+            for ( size_t i = 0; i < package.GetEntryCount(); ++i )
+            {
+                // Directory order rather than file order, like a level's asset list.
+                reads.push_back ( ResourceRead{package.GetEntry ( i * 7919 ).first, buffers[i].data(), buffers[i].size() } );
+            }
+            SetResourcePath ( { package.GetPath().string() } );
+            for ( auto _ : state )
+            {
+                if ( cold )
+                {
+                    state.PauseTiming();
+                    // A fresh Package, so no mapping keeps pages resident, then drop them.
+                    SetResourcePath ( { package.GetPath().string() } );
+                    EvictFromPageCache ( package.GetPath() );
+                    state.ResumeTiming();
+                }
+                aLoad ( reads );
+                benchmark::DoNotOptimize ( buffers.front().data() );
+            }
+            SetResourcePath ( previous_path );
+            state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( kLevelSize ) );
+            state.SetItemsProcessed ( state.iterations() * static_cast<int64_t> ( reads.size() ) );
+        }
+    }
+
+    /// What level loads did so far: LoadResource asset after asset.
+    static void BM_PackageLevelLoadResource ( benchmark::State& state )
+    {
+        RunLevelLoad ( state, [] ( std::vector<ResourceRead>& aReads )
+        {
+            for ( ResourceRead& read : aReads )
+            {
+                LoadResource ( read.mCrc, read.mBuffer, read.mBufferSize );
+            }
+        } );
+    }
+    BENCHMARK ( BM_PackageLevelLoadResource )->Arg ( 0 )->Arg ( 1 )->ArgName ( "cold" )->UseRealTime();
+
+    /// Arg 1 selects the backend: 0 io_uring, 1 preadv on the job system.
+    static void BM_PackageLevelLoadResources ( benchmark::State& state )
+    {
+        SetBatchReadBackend ( state.range ( 1 ) ? BatchReadBackend::Preadv : BatchReadBackend::IoUring );
+        state.SetLabel ( GetBatchReadBackend() == BatchReadBackend::IoUring ? "io_uring" : "preadv" );
+        RunLevelLoad ( state, [] ( std::vector<ResourceRead>& aReads )
+        {
+            LoadResources ( aReads );
+        } );
+        SetBatchReadBackend ( BatchReadBackend::IoUring );
+    }
+    BENCHMARK ( BM_PackageLevelLoadResources )->ArgsProduct ( { {0, 1}, {0, 1} } )->ArgNames ( { "cold", "backend" } )->UseRealTime();
+
+    namespace
+    {
+        /// Levels aeontool pack uses by default, decode speed barely depends on them.
+        int GetPackLevel ( uint8_t aCompression )
+        {
+            switch ( aCompression )
+            {
+            case ZSTD:
+                return 12;
+            case LZ4:
+                return 9;
+            default:
+                return 5;
+            }
+        }
+
+        /// A text asset like the material and scene files packages are full of.
+        std::string MakeTextAsset ( size_t aIndex )
+        {
+            return "name: \"material" + std::to_string ( aIndex ) + "\"\n"
+                   "property { name: \"Diffuse\" vector4 { x: " + std::to_string ( aIndex % 7 ) + " y: 0.5 z: 0.25 w: 1 } }\n"
+                   "property { name: \"Roughness\" scalar_float: 0." + std::to_string ( aIndex % 10 ) + " }\n"
+                   "sampler { name: \"DiffuseMap\" image: \"textures/material" + std::to_string ( aIndex ) + ".png\" }\n"
+                   "pipeline: \"shaders/lit.prg\"\n";
+        }
+
+        /** 4 MiB of mesh-like data: interleaved float positions, normals and
+            texture coordinates on a smooth surface, the bulk of a package. */
+        std::vector<uint8_t> MakeMeshAsset()
+        {
+            std::vector<float> vertices;
+            for ( size_t i = 0; vertices.size() * sizeof ( float ) < ( 4 << 20 ); ++i )
+            {
+                const float u = static_cast<float> ( i % 512 ) / 512.0f;
+                const float v = static_cast<float> ( i / 512 ) / 512.0f;
+                vertices.insert ( vertices.end(), { u, v, u * v, 0.0f, 0.0f, 1.0f, u, v } );
+            }
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*> ( vertices.data() );
+            return { bytes, bytes + vertices.size() * sizeof ( float ) };
+        }
+    }
+
+    /// Arg 0 is the PKGCompressionTypes codec; decoding one 4 MiB mesh.
+    static void BM_PackageDecode ( benchmark::State& state )
+    {
+        const uint8_t codec = static_cast<uint8_t> ( state.range ( 0 ) );
+        state.SetLabel ( GetCompressionName ( codec ) );
+        if ( !IsCompressionSupported ( codec ) )
+        {
+            state.SkipWithError ( "Codec not built in." );
+            return;
+        }
+        const std::vector<uint8_t> mesh = MakeMeshAsset();
+        std::vector<uint8_t> compressed;
+        CompressBuffer ( codec, mesh, GetPackLevel ( codec ), compressed );
+        std::vector<uint8_t> buffer ( mesh.size() );
+        for ( auto _ : state )
+        {
+            if ( !DecompressBuffer ( codec, compressed, buffer.data(), buffer.size() ) )
+            {
+                state.SkipWithError ( "Decode failed." );
+                break;
+            }
+            benchmark::DoNotOptimize ( buffer.data() );
+        }
+        state.counters["ratio"] = static_cast<double> ( mesh.size() ) / static_cast<double> ( compressed.size() );
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( mesh.size() ) );
+    }
+    BENCHMARK ( BM_PackageDecode )->Arg ( ZLIB )->Arg ( ZSTD )->Arg ( LZ4 )->ArgName ( "codec" );
+
+    /** Arg 0 is the codec, arg 1 compresses against a trained dictionary;
+        decoding 256 small text assets, where per call setup shows. */
+    static void BM_PackageDecodeSmallAssets ( benchmark::State& state )
+    {
+        const uint8_t codec = static_cast<uint8_t> ( state.range ( 0 ) );
+        const bool with_dictionary = state.range ( 1 ) != 0;
+        state.SetLabel ( std::string ( GetCompressionName ( codec ) ) + ( with_dictionary ? "+dictionary" : "" ) );
+        if ( !IsCompressionSupported ( codec ) || ( with_dictionary && codec != ZSTD ) )
+        {
+            state.SkipWithError ( "Codec not built in or without dictionaries." );
+            return;
+        }
+        std::vector<std::string> samples;
+        std::vector<std::span<const uint8_t>> views;
+        for ( size_t i = 0; i < 1024; ++i )
+        {
+            samples.push_back ( MakeTextAsset ( i ) );
+        }
+        for ( const std::string& sample : samples )
+        {
+            views.emplace_back ( reinterpret_cast<const uint8_t*> ( sample.data() ), sample.size() );
+        }
+        const std::vector<uint8_t> dictionary = with_dictionary ? TrainCompressionDictionary ( views, 8192 ) : std::vector<uint8_t> {};
+        const std::unique_ptr<CompressionDictionary> digested = with_dictionary ? std::make_unique<CompressionDictionary> ( dictionary ) : nullptr;
+        // Decode assets the dictionary was not trained on.
+        std::vector<std::string> assets;
+        std::vector<std::vector<uint8_t>> compressed ( 256 );
+        size_t uncompressed_size = 0;
+        size_t compressed_size = 0;
+        for ( size_t i = 0; i < compressed.size(); ++i )
+        {
+            assets.push_back ( MakeTextAsset ( 100000 + i ) );
+            const std::span<const uint8_t> asset ( reinterpret_cast<const uint8_t*> ( assets.back().data() ), assets.back().size() );
+            CompressBuffer ( codec, asset, GetPackLevel ( codec ), compressed[i], dictionary );
+            uncompressed_size += asset.size();
+            compressed_size += compressed[i].size();
+        }
+        std::vector<uint8_t> buffer ( 4096 );
+        for ( auto _ : state )
+        {
+            for ( size_t i = 0; i < compressed.size(); ++i )
+            {
+                DecompressBuffer ( codec, compressed[i], buffer.data(), assets[i].size(), digested.get() );
+                benchmark::DoNotOptimize ( buffer.data() );
+            }
+        }
+        state.counters["ratio"] = static_cast<double> ( uncompressed_size ) / static_cast<double> ( compressed_size );
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( uncompressed_size ) );
+        state.SetItemsProcessed ( state.iterations() * static_cast<int64_t> ( compressed.size() ) );
+    }
+    BENCHMARK ( BM_PackageDecodeSmallAssets )->Args ( {ZLIB, 0} )->Args ( {ZSTD, 0} )->Args ( {ZSTD, 1} )->Args ( {LZ4, 0} )->ArgNames ( { "codec", "dictionary" } );
+
+    namespace
+    {
+        /** Packages of small entries with disjoint ids, like a base game
+            split in chunks plus DLCs and patches. Entry names cycle through
+            @p aExtensions when given. */
+        class MountedPackages
+        {
+        public:
+            MountedPackages ( size_t aCount, size_t aEntries, std::span<const char* const> aExtensions = {} )
+            {
+                for ( size_t p = 0; p < aCount; ++p )
+                {
+                    const std::filesystem::path path = std::filesystem::temp_directory_path() / ( "aeon_benchmark_mount" + std::to_string ( p ) + ".pkg" );
+                    std::vector<char> blob;
+                    std::vector<PKGDirectoryEntry> entries ( aEntries );
+                    for ( size_t i = 0; i < aEntries; ++i )
+                    {
+                        const std::string basename = "chunk" + std::to_string ( p ) + "/asset" + std::to_string ( i );
+                        const std::string name = aExtensions.empty() ? basename : basename + aExtensions[i % aExtensions.size()];
+                        entries[i].crc = crc32i ( name.data(), name.size() );
+                        entries[i].path_offset = static_cast<uint32_t> ( blob.size() );
+                        entries[i].compressed_size = entries[i].uncompressed_size = sizeof ( uint64_t );
+                        entries[i].compression = NONE;
+                        blob.insert ( blob.end(), name.begin(), name.end() );
+                        blob.push_back ( '\0' );
+                        mCrcs.push_back ( entries[i].crc );
+                        mNames.push_back ( name );
+                        mBasenames.push_back ( basename );
+                    }
+                    std::sort ( entries.begin(), entries.end(), [] ( const PKGDirectoryEntry & a, const PKGDirectoryEntry & b )
+                    {
+                        return a.crc < b.crc;
+                    } );
+                    PKGHeader header{};
+                    std::memcpy ( header.id, "AEONPKG", 8 );
+                    header.version[0] = 1;
+                    header.file_count = static_cast<uint32_t> ( aEntries );
+                    header.index_offset = sizeof ( PKGHeader );
+                    header.strings_offset = static_cast<uint32_t> ( header.index_offset + aEntries * sizeof ( PKGDirectoryEntry ) );
+                    uint64_t cursor = header.strings_offset + blob.size();
+                    for ( PKGDirectoryEntry& entry : entries )
+                    {
+                        entry.data_offset = cursor;
+                        cursor += sizeof ( uint64_t );
+                    }
+                    std::ofstream file ( path, std::ios::out | std::ios::binary | std::ios::trunc );
+                    file.write ( reinterpret_cast<const char*> ( &header ), sizeof ( header ) );
+                    file.write ( reinterpret_cast<const char*> ( entries.data() ), static_cast<std::streamsize> ( entries.size() * sizeof ( PKGDirectoryEntry ) ) );
+                    file.write ( blob.data(), static_cast<std::streamsize> ( blob.size() ) );
+                    const std::vector<char> payload ( aEntries * sizeof ( uint64_t ), 'A' );
+                    file.write ( payload.data(), static_cast<std::streamsize> ( payload.size() ) );
+                    file.close();
+                    mPackages.push_back ( std::make_unique<Package> ( path.string() ) );
+                    mPaths.push_back ( path );
+                }
+                // Look resources up in no particular order, as scene loads do.
+                std::shuffle ( mCrcs.begin(), mCrcs.end(), std::mt19937 { 5489u } );
+                std::shuffle ( mNames.begin(), mNames.end(), std::mt19937 { 5489u } );
+                std::shuffle ( mBasenames.begin(), mBasenames.end(), std::mt19937 { 5489u } );
+            }
+            ~MountedPackages()
+            {
+                mPackages.clear();
+                for ( const std::filesystem::path& path : mPaths )
+                {
+                    std::error_code ec;
+                    std::filesystem::remove ( path, ec );
+                }
+            }
+            const std::vector<std::unique_ptr<Package >> & GetPackages() const
+            {
+                return mPackages;
+            }
+            std::vector<std::unique_ptr<Package >> TakePackages()
+            {
+                return std::move ( mPackages );
+            }
+            const std::vector<uint32_t>& GetCrcs() const
+            {
+                return mCrcs;
+            }
+            std::vector<std::string> GetPaths() const
+            {
+                std::vector<std::string> paths;
+                for ( const std::filesystem::path& path : mPaths )
+                {
+                    paths.push_back ( path.string() );
+                }
+                return paths;
+            }
+            /// Entry names with and without their extension, in the same shuffled order.
+            const std::vector<std::string>& GetNames ( bool aBasenames ) const
+            {
+                return aBasenames ? mBasenames : mNames;
+            }
+        private:
+            std::vector<std::unique_ptr<Package >> mPackages{};
+            std::vector<std::filesystem::path> mPaths{};
+            std::vector<uint32_t> mCrcs{};
+            std::vector<std::string> mNames{};
+            std::vector<std::string> mBasenames{};
+        };
+    }
+
+    /** Arg 0 is the number of mounted packages of 2048 entries each, arg 1
+        selects the lookup: 0 asks every package in path order, 1 probes the
+        merged ResourceDirectory. */
+    static void BM_ResourceLookup ( benchmark::State& state )
+    {
+        MountedPackages mounted ( static_cast<size_t> ( state.range ( 0 ) ), 2048 );
+        const std::vector<uint32_t>& crcs = mounted.GetCrcs();
+        if ( state.range ( 1 ) == 0 )
+        {
+            state.SetLabel ( "per package" );
+            const std::vector<std::unique_ptr<Package >> & packages = mounted.GetPackages();
+            size_t i = 0;
+            for ( auto _ : state )
+            {
+                const uint32_t crc = crcs[i++ % crcs.size()];
+                const Package* found = nullptr;
+                for ( const auto& package : packages )
+                {
+                    if ( package->GetIndexTable().find ( crc ) != package->GetIndexTable().end() )
+                    {
+                        found = package.get();
+                        break;
+                    }
+                }
+                benchmark::DoNotOptimize ( found );
+            }
+        }
+        else
+        {
+            state.SetLabel ( "directory" );
+            ResourceDirectory directory;
+            for ( auto& package : mounted.TakePackages() )
+            {
+                directory.Mount ( std::move ( package ), false );
+            }
+            size_t i = 0;
+            for ( auto _ : state )
+            {
+                benchmark::DoNotOptimize ( directory.Find ( crcs[i++ % crcs.size()] ) );
+            }
+        }
+        state.SetItemsProcessed ( state.iterations() );
+    }
+    BENCHMARK ( BM_ResourceLookup )->ArgsProduct ( { {1, 8, 32}, {0, 1} } )->ArgNames ( { "packages", "lookup" } );
+
+    /** Arg 0 looks 100k assets up by their full name when 0, by basename when
+        1; basenames resolve through the extension preference, the later
+        extensions costing a probe for each one before them. */
+    static void BM_ResourceLookupByName ( benchmark::State& state )
+    {
+        static constexpr const char* const kExtensions[] { ".txt", ".msh", ".mtl", ".anm", ".cln" };
+        MountedPackages mounted ( 4, 25000, kExtensions );
+        const std::vector<std::string> previous = GetResourcePath();
+        SetResourcePath ( mounted.GetPaths() );
+        const bool basenames = state.range ( 0 ) != 0;
+        state.SetLabel ( basenames ? "basename" : "full name" );
+        const std::vector<std::string>& names = mounted.GetNames ( basenames );
+        size_t i = 0;
+        for ( auto _ : state )
+        {
+            benchmark::DoNotOptimize ( GetResourceSize ( names[i++ % names.size()] ) );
+        }
+        state.SetItemsProcessed ( state.iterations() );
+        SetResourcePath ( previous );
+    }
+    BENCHMARK ( BM_ResourceLookupByName )->Arg ( 0 )->Arg ( 1 )->ArgName ( "basename" );
+}
@@ -0,0 +1,169 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "aeongames/Scene.hpp"
+#include "aeongames/Octree.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Transform.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/Vector3.hpp"
+#include "benchmark/benchmark.h"
+
+/* Per-object callback cost of the spatial queries: the std::function overloads
+   against the template visitor overloads, on the same tree and the same query.
+   Both report items/s as visited objects per second, so the difference between
+   the two rows is the type-erased call overhead. The callbacks escape each node
+   pointer so the visitor loop cannot be folded into a single add. */
+
+namespace AeonGames
+{
+    namespace
+    {
+        constexpr size_t kQueryNodeCount = 100000;
+        constexpr float kQueryExtent = 1000.0f;
+
+        float QueryScatter ( uint32_t& aState )
+        {
+            aState = aState * 1664525u + 1013904223u;
+            return ( static_cast<float> ( aState >> 8 ) / static_cast<float> ( 1u << 24 ) * 2.0f - 1.0f ) * kQueryExtent;
+        }
+
+        /// A scene of small scattered nodes, built once and shared by every benchmark.
+        const Scene& GetQueryScene()
+        {
+            static const std::unique_ptr<Scene> scene = []()
+            {
+                auto result = std::make_unique<Scene>();
+                uint32_t state = 7u;
+                for ( size_t i = 0; i < kQueryNodeCount; ++i )
+                {
+                    Node* node = result->Add ( std::make_unique<Node>() );
+                    node->SetAABB ( AABB { Vector3 {}, Vector3 { 1.0f, 1.0f, 1.0f } } );
+                    const Vector3 position { QueryScatter ( state ), QueryScatter ( state ), QueryScatter ( state ) };
+                    node->SetGlobalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, position } );
+                }
+                // Any query builds the spatial index, keep that out of the timings.
+                result->QueryAABB ( AABB {}, [] ( const Node& ) {} );
+                return result;
+            }();
+            return *scene;
+        }
+
+        /** A bare octree over the scene's nodes, so the octree rows exclude the
+         *  exact per-node test. A shallow tree keeps few large cells, so nearly
+         *  all of the time goes to the per-object callback; a deep one shows how
+         *  much of that survives next to the cell walk. */
+        Octree MakeQueryOctree ( uint32_t aMaxDepth )
+        {
+            Octree octree { AABB { Vector3 {}, Vector3 { kQueryExtent + 2.0f, kQueryExtent + 2.0f, kQueryExtent + 2.0f } }, aMaxDepth };
+            GetQueryScene().LoopTraverseDFSPreOrder ( [&octree] ( const Node & aNode )
+            {
+                octree.AddNode ( &aNode );
+            } );
+            return octree;
+        }
+
+        Frustum MakeQueryFrustum()
+        {
+            Matrix4x4 projection {};
+            projection.Perspective ( 60.0f, 16.0f / 9.0f, 1.0f, kQueryExtent );
+            return Frustum { projection };
+        }
+
+        void ReportVisits ( benchmark::State& aState, size_t aVisits )
+        {
+            benchmark::DoNotOptimize ( aVisits );
+            aState.SetItemsProcessed ( static_cast<int64_t> ( aVisits ) );
+            aState.counters["visits/query"] = benchmark::Counter ( static_cast<double> ( aVisits ) / static_cast<double> ( aState.iterations() ) );
+        }
+    }
+
+    static void BM_OctreeQueryFrustumFunction ( benchmark::State& state )
+    {
+        const Octree octree = MakeQueryOctree ( static_cast<uint32_t> ( state.range ( 0 ) ) );
+        const Frustum frustum = MakeQueryFrustum();
+        size_t visits = 0;
+        const std::function<void ( const Node* ) > callback = [&visits] ( const Node * aNode )
+        {
+            benchmark::DoNotOptimize ( aNode );
+            ++visits;
+        };
+        for ( auto _ : state )
+        {
+            octree.QueryFrustum ( frustum, callback );
+        }
+        ReportVisits ( state, visits );
+    }
+    BENCHMARK ( BM_OctreeQueryFrustumFunction )->Arg ( 1 )->Arg ( 8 )->ArgName ( "depth" );
+
+    static void BM_OctreeQueryFrustumVisitor ( benchmark::State& state )
+    {
+        const Octree octree = MakeQueryOctree ( static_cast<uint32_t> ( state.range ( 0 ) ) );
+        const Frustum frustum = MakeQueryFrustum();
+        size_t visits = 0;
+        for ( auto _ : state )
+        {
+            octree.QueryFrustum ( frustum, [&visits] ( const Node * aNode )
+            {
+                benchmark::DoNotOptimize ( aNode );
+                ++visits;
+            } );
+        }
+        ReportVisits ( state, visits );
+    }
+    BENCHMARK ( BM_OctreeQueryFrustumVisitor )->Arg ( 1 )->Arg ( 8 )->ArgName ( "depth" );
+
+    static void BM_SceneCullVisibleFunction ( benchmark::State& state )
+    {
+        const Scene& scene = GetQueryScene();
+        const Frustum frustum = MakeQueryFrustum();
+        size_t visits = 0;
+        const std::function<void ( const Node& ) > callback = [&visits] ( const Node & aNode )
+        {
+            benchmark::DoNotOptimize ( &aNode );
+            ++visits;
+        };
+        for ( auto _ : state )
+        {
+            scene.CullVisible ( frustum, callback );
+        }
+        ReportVisits ( state, visits );
+    }
+    BENCHMARK ( BM_SceneCullVisibleFunction );
+
+    static void BM_SceneCullVisibleVisitor ( benchmark::State& state )
+    {
+        const Scene& scene = GetQueryScene();
+        const Frustum frustum = MakeQueryFrustum();
+        size_t visits = 0;
+        for ( auto _ : state )
+        {
+            scene.CullVisible ( frustum, [&visits] ( const Node & aNode )
+            {
+                benchmark::DoNotOptimize ( &aNode );
+                ++visits;
+            } );
+        }
+        ReportVisits ( state, visits );
+    }
+    BENCHMARK ( BM_SceneCullVisibleVisitor );
+}
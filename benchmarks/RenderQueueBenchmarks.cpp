@@ -0,0 +1,127 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "aeongames/RenderItem.hpp"
+#include "aeongames/RadixSort.hpp"
+#include "benchmark/benchmark.h"
+
+/* Render queue ordering: the pointer-comparing std::sort the queue used to
+   use, against packed 64-bit keys radix sorted and then applied to the items,
+   the way Scene::SortRenderQueue does it. The item mix is 16 pipelines, 64
+   materials and 512 meshes in random order. */
+
+namespace AeonGames
+{
+    namespace
+    {
+        std::vector<RenderItem> MakeRenderItems ( size_t aCount )
+        {
+            std::vector<RenderItem> items ( aCount );
+            uint32_t state = 1u;
+            auto next = [&state] ( uint32_t aRange )
+            {
+                state = state * 1664525u + 1013904223u;
+                return ( state >> 8 ) % aRange;
+            };
+            for ( RenderItem& item : items )
+            {
+                item.mPipeline = reinterpret_cast<const Pipeline*> ( 0x100000 + next ( 16 ) * 0x40 );
+                item.mMaterial = reinterpret_cast<const Material*> ( 0x200000 + next ( 64 ) * 0x40 );
+                item.mMesh = reinterpret_cast<const Mesh*> ( 0x300000 + next ( 512 ) * 0x40 );
+            }
+            return items;
+        }
+
+        uint64_t InternId ( std::unordered_map<const void*, uint32_t>& aTable, const void* aPointer )
+        {
+            auto found = aTable.try_emplace ( aPointer, static_cast<uint32_t> ( aTable.size() ) + 1u );
+            return found.first->second;
+        }
+    }
+
+    static void BM_RenderQueueComparatorSort ( benchmark::State& state )
+    {
+        const std::vector<RenderItem> source = MakeRenderItems ( static_cast<size_t> ( state.range ( 0 ) ) );
+        std::vector<RenderItem> items;
+        for ( auto _ : state )
+        {
+            state.PauseTiming();
+            items = source;
+            state.ResumeTiming();
+            std::sort ( items.begin(), items.end(), [] ( const RenderItem & aLhs, const RenderItem & aRhs )
+            {
+                if ( aLhs.mPipeline != aRhs.mPipeline )
+                {
+                    return aLhs.mPipeline < aRhs.mPipeline;
+                }
+                if ( aLhs.mMaterial != aRhs.mMaterial )
+                {
+                    return aLhs.mMaterial < aRhs.mMaterial;
+                }
+                if ( aLhs.mMesh != aRhs.mMesh )
+                {
+                    return aLhs.mMesh < aRhs.mMesh;
+                }
+                return aLhs.mSkinnedVertices < aRhs.mSkinnedVertices;
+            } );
+            benchmark::DoNotOptimize ( items.data() );
+        }
+        state.SetItemsProcessed ( state.iterations() * state.range ( 0 ) );
+    }
+    BENCHMARK ( BM_RenderQueueComparatorSort )->Arg ( 10000 )->Arg ( 50000 )->Arg ( 200000 )->Unit ( benchmark::kMicrosecond );
+
+    static void BM_RenderQueueRadixSort ( benchmark::State& state )
+    {
+        const std::vector<RenderItem> source = MakeRenderItems ( static_cast<size_t> ( state.range ( 0 ) ) );
+        std::vector<RenderItem> items;
+        std::vector<RenderItem> sorted;
+        std::vector<SortKey> keys;
+        std::vector<SortKey> scratch;
+        std::unordered_map<const void*, uint32_t> pipelines;
+        std::unordered_map<const void*, uint32_t> materials;
+        std::unordered_map<const void*, uint32_t> meshes;
+        for ( auto _ : state )
+        {
+            state.PauseTiming();
+            items = source;
+            state.ResumeTiming();
+            keys.clear();
+            for ( size_t i = 0; i < items.size(); ++i )
+            {
+                const RenderItem& item = items[i];
+                uint64_t key = InternId ( pipelines, item.mPipeline );
+                key = ( key << 18 ) | InternId ( materials, item.mMaterial );
+                key = ( key << 18 ) | InternId ( meshes, item.mMesh );
+                key = ( key << 1 ) | ( item.mSkinnedVertices != nullptr ? 1u : 0u );
+                keys.push_back ( SortKey{ key << 15, static_cast<uint32_t> ( i ) } );
+            }
+            RadixSort ( keys, scratch );
+            sorted.clear();
+            for ( const SortKey& key : keys )
+            {
+                sorted.push_back ( items[key.mIndex] );
+            }
+            items.swap ( sorted );
+            benchmark::DoNotOptimize ( items.data() );
+        }
+        state.SetItemsProcessed ( state.iterations() * state.range ( 0 ) );
+    }
+    BENCHMARK ( BM_RenderQueueRadixSort )->Arg ( 10000 )->Arg ( 50000 )->Arg ( 200000 )->Unit ( benchmark::kMicrosecond );
+}
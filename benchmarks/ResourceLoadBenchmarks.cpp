@@ -0,0 +1,151 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "aeongames/Mesh.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/Scene.hpp"
+#include "aeongames/Transform.hpp"
+#include "aeongames/Vector3.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/ProtoBufClasses.hpp"
+#include "mesh.pb.h"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// A binary AEONMSH of @p aVertexCount interleaved position, normal and uv vertices.
+        std::string MakeMeshBuffer ( uint32_t aVertexCount )
+        {
+            MeshMsg message;
+            message.set_version ( 1 );
+            for ( auto [semantic, size] :
+                  {
+                      std::pair{AttributeMsg_AttributeSemantic_POSITION, 3u},
+                      std::pair{AttributeMsg_AttributeSemantic_NORMAL, 3u},
+                      std::pair{AttributeMsg_AttributeSemantic_TEXCOORD, 2u}
+                  } )
+            {
+                AttributeMsg* attribute = message.add_attribute();
+                attribute->set_semantic ( semantic );
+                attribute->set_size ( size );
+                attribute->set_type ( AttributeMsg_AttributeType_FLOAT );
+            }
+            std::vector<float> vertices ( aVertexCount * 8u );
+            for ( size_t i = 0; i < vertices.size(); ++i )
+            {
+                vertices[i] = static_cast<float> ( i % 97 ) / 97.0f;
+            }
+            std::vector<uint32_t> indices ( aVertexCount * 3u );
+            for ( size_t i = 0; i < indices.size(); ++i )
+            {
+                indices[i] = static_cast<uint32_t> ( ( i * 7u ) % aVertexCount );
+            }
+            message.set_vertexcount ( aVertexCount );
+            message.set_indexsize ( 4 );
+            message.set_indexcount ( static_cast<uint32_t> ( indices.size() ) );
+            message.set_vertexbuffer ( vertices.data(), vertices.size() * sizeof ( float ) );
+            message.set_indexbuffer ( indices.data(), indices.size() * sizeof ( uint32_t ) );
+            std::string buffer ( "AEONMSH\0", 8 );
+            message.AppendToString ( &buffer );
+            return buffer;
+        }
+
+        /// A binary AEONSCN of @p aNodeCount nodes, a few levels deep.
+        std::string MakeSceneBuffer ( size_t aNodeCount )
+        {
+            Scene scene;
+            std::vector<Node*> parents;
+            for ( size_t i = 0; i < aNodeCount; ++i )
+            {
+                auto node = std::make_unique<Node>();
+                node->SetName ( "node" + std::to_string ( i ) );
+                node->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {},
+                                                      Vector3 { static_cast<float> ( i ), 0.0f, static_cast<float> ( i % 13 ) } } );
+                Node* added = ( i % 8 == 0 ) ? scene.Add ( std::move ( node ) ) : parents.back()->Add ( std::move ( node ) );
+                parents.push_back ( added );
+            }
+            return scene.Serialize ( true );
+        }
+    }
+
+    /** Decoding a 16k vertex mesh, run on 1 to 4 threads at once to show
+     *  whether loads of the same resource type overlap. */
+    static void BM_MeshLoad ( benchmark::State& state )
+    {
+        static const std::string buffer = MakeMeshBuffer ( 16384 );
+        for ( auto _ : state )
+        {
+            Mesh mesh;
+            mesh.LoadFromMemory ( buffer.data(), buffer.size() );
+            benchmark::DoNotOptimize ( mesh.GetVertexCount() );
+        }
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( buffer.size() ) );
+    }
+    BENCHMARK ( BM_MeshLoad )->ThreadRange ( 1, 4 )->UseRealTime();
+
+    /** The same 16k vertex mesh loaded as protobuf (0), as a flat copy (1)
+     *  and as a flat view used in place the way mapped packages hand it out (2). */
+    static void BM_MeshLoadFormat ( benchmark::State& state )
+    {
+        static const std::string buffer = MakeMeshBuffer ( 16384 );
+        static const std::shared_ptr<const std::vector<uint8_t>> flat = []
+        {
+            Mesh mesh;
+            mesh.LoadFromMemory ( buffer.data(), buffer.size() );
+            return std::make_shared<const std::vector<uint8_t>> ( mesh.SaveToFlat() );
+        }
+        ();
+        for ( auto _ : state )
+        {
+            Mesh mesh;
+            switch ( state.range ( 0 ) )
+            {
+            case 0:
+                mesh.LoadFromMemory ( buffer.data(), buffer.size() );
+                break;
+            case 1:
+                mesh.LoadFromMemory ( flat->data(), flat->size() );
+                break;
+            default:
+                mesh.LoadFromView ( *flat, flat );
+                break;
+            }
+            benchmark::DoNotOptimize ( mesh.GetVertexBuffer().data() );
+        }
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( state.range ( 0 ) == 0 ? buffer.size() : flat->size() ) );
+    }
+    BENCHMARK ( BM_MeshLoadFormat )->DenseRange ( 0, 2 );
+
+    /// Deserializing a 2000 node scene, run on 1 to 4 threads at once.
+    static void BM_SceneLoad ( benchmark::State& state )
+    {
+        static const std::string buffer = MakeSceneBuffer ( 2000 );
+        for ( auto _ : state )
+        {
+            Scene scene;
+            scene.Deserialize ( buffer );
+            benchmark::DoNotOptimize ( scene.GetChildrenCount() );
+        }
+        state.SetBytesProcessed ( state.iterations() * static_cast<int64_t> ( buffer.size() ) );
+    }
+    BENCHMARK ( BM_SceneLoad )->ThreadRange ( 1, 4 )->UseRealTime();
+}
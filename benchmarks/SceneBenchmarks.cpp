@@ -0,0 +1,147 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aeongames/Scene.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Transform.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/Vector3.hpp"
+#include "benchmark/benchmark.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        constexpr size_t kSceneNodeCount = 10000;
+        constexpr float kSceneExtent = 500.0f;
+
+        /// Deterministic pseudo random coordinate in [-kSceneExtent, kSceneExtent).
+        float Scatter ( uint32_t aSeed )
+        {
+            aSeed = aSeed * 1664525u + 1013904223u;
+            aSeed ^= aSeed >> 16;
+            return ( static_cast<float> ( aSeed & 0xffffu ) / 65536.0f * 2.0f - 1.0f ) * kSceneExtent;
+        }
+
+        Transform MakePlacement ( uint32_t aSeed )
+        {
+            return Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {},
+                               Vector3 { Scatter ( aSeed * 3u ), Scatter ( aSeed * 3u + 1u ), Scatter ( aSeed * 3u + 2u ) } };
+        }
+
+        std::vector<Node*> PopulateScene ( Scene& aScene )
+        {
+            std::vector<Node*> nodes;
+            nodes.reserve ( kSceneNodeCount );
+            for ( uint32_t i = 0; i < kSceneNodeCount; ++i )
+            {
+                Node* node = aScene.Add ( std::make_unique<Node>() );
+                node->SetAABB ( AABB { Vector3 {}, Vector3 { 1.0f, 1.0f, 1.0f } } );
+                node->SetGlobalTransform ( MakePlacement ( i ) );
+                nodes.push_back ( node );
+            }
+            // Corner markers keep the root bounds fixed as nodes wander.
+            for ( float corner : { -kSceneExtent - 2.0f, kSceneExtent + 2.0f } )
+            {
+                Node* node = aScene.Add ( std::make_unique<Node>() );
+                node->SetAABB ( AABB { Vector3 {}, Vector3 { 1.0f, 1.0f, 1.0f } } );
+                node->SetGlobalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { corner, corner, corner } } );
+            }
+            return nodes;
+        }
+    }
+
+    /** Per-frame spatial index maintenance cost as a function of how many nodes
+     *  moved. Arg 0 is the number of movers out of kSceneNodeCount, arg 1
+     *  selects incremental maintenance (1) or a forced full rebuild (0). */
+    static void BM_SceneSpatialIndexMaintenance ( benchmark::State& state )
+    {
+        Scene scene;
+        std::vector<Node*> nodes = PopulateScene ( scene );
+        const size_t moving = static_cast<size_t> ( state.range ( 0 ) );
+        scene.SetSpatialIndexRebuildThreshold ( state.range ( 1 ) ? 1.0f : 0.0f );
+        const AABB probe { Vector3 {}, Vector3 { 1.0f, 1.0f, 1.0f } };
+        auto refresh = [&scene, &probe]()
+        {
+            size_t hits = 0;
+            scene.QueryAABB ( probe, [&hits] ( const Node& )
+            {
+                ++hits;
+            } );
+            benchmark::DoNotOptimize ( hits );
+        };
+        refresh();
+        uint32_t frame = 0;
+        for ( auto _ : state )
+        {
+            ++frame;
+            for ( size_t i = 0; i < moving; ++i )
+            {
+                nodes[i]->SetGlobalTransform ( MakePlacement ( static_cast<uint32_t> ( i ) + frame * kSceneNodeCount ) );
+            }
+            refresh();
+        }
+        state.counters["moving"] = static_cast<double> ( moving );
+    }
+    BENCHMARK ( BM_SceneSpatialIndexMaintenance )
+    ->ArgsProduct ( {{0, 10, 100, 1000, 5000}, {0, 1}} )
+    ->ArgNames ( {"moving", "incremental"} );
+
+    /** Culling every view of a frame (eight shadow views plus the camera):
+     *  arg 0 selects one BuildRenderQueue per view (0) or a single
+     *  BuildRenderQueues walk for all of them (1). */
+    static void BM_SceneBuildRenderQueues ( benchmark::State& state )
+    {
+        Scene scene;
+        PopulateScene ( scene );
+        std::vector<Frustum> views;
+        for ( uint32_t i = 0; i < 8; ++i )
+        {
+            const float x = Scatter ( i * 7u ) * 0.5f;
+            const float z = Scatter ( i * 7u + 1u ) * 0.5f;
+            Matrix4x4 box {};
+            box.Ortho ( x - 100.0f, x + 100.0f, z - 100.0f, z + 100.0f, -kSceneExtent, kSceneExtent );
+            views.emplace_back ( box );
+        }
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 16.0f / 9.0f, 1.0f, kSceneExtent );
+        views.emplace_back ( projection );
+        const bool single_pass = state.range ( 0 ) != 0;
+        for ( auto _ : state )
+        {
+            if ( single_pass )
+            {
+                scene.BuildRenderQueues ( views );
+            }
+            else
+            {
+                for ( const Frustum& view : views )
+                {
+                    scene.BuildRenderQueue ( view );
+                }
+            }
+            benchmark::DoNotOptimize ( scene.GetRenderQueue().data() );
+        }
+        state.counters["views"] = static_cast<double> ( views.size() );
+    }
+    BENCHMARK ( BM_SceneBuildRenderQueues )->Arg ( 0 )->Arg ( 1 )->ArgName ( "single_pass" )->Unit ( benchmark::kMicrosecond );
+}
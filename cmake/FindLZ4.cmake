@@ -0,0 +1,41 @@
+# Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+
+# * Try to find the LZ4 library. Once done this will define
+#
+# LZ4_FOUND - system has lz4 LZ4_INCLUDE_DIR - the lz4 include directory
+# LZ4_LIBRARIES - Link these to use lz4
+
+if(PKG_CONFIG_FOUND)
+  pkg_check_modules(PC_LZ4 QUIET liblz4)
+endif()
+
+find_path(LZ4_INCLUDE_DIR
+          NAMES lz4.h
+          HINTS ${PC_LZ4_INCLUDE_DIRS})
+find_library(LZ4_LIBRARY
+             NAMES lz4 liblz4
+             HINTS ${PC_LZ4_LIBRARY_DIRS})
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4
+                                  REQUIRED_VARS
+                                  LZ4_LIBRARY
+                                  LZ4_INCLUDE_DIR)
+
+if(LZ4_FOUND)
+  set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+endif()
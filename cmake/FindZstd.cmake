@@ -0,0 +1,41 @@
+# Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+
+# * Try to find the Zstandard library. Once done this will define
+#
+# ZSTD_FOUND - system has zstd ZSTD_INCLUDE_DIR - the zstd include directory
+# ZSTD_LIBRARIES - Link these to use zstd
+
+if(PKG_CONFIG_FOUND)
+  pkg_check_modules(PC_ZSTD QUIET libzstd)
+endif()
+
+find_path(ZSTD_INCLUDE_DIR
+          NAMES zstd.h
+          HINTS ${PC_ZSTD_INCLUDE_DIRS})
+find_library(ZSTD_LIBRARY
+             NAMES zstd zstd_static libzstd
+             HINTS ${PC_ZSTD_LIBRARY_DIRS})
+
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd
+                                  REQUIRED_VARS
+                                  ZSTD_LIBRARY
+                                  ZSTD_INCLUDE_DIR)
+
+if(ZSTD_FOUND)
+  set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+endif()
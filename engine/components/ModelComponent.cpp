@@ -15,6 +15,7 @@ limitations under the License.
 */
 
 #include <array>
+#include <utility>
 #include <cstring>
 #include <cmath>
 #include <cassert>
@@ -24,13 +25,18 @@ limitations under the License.
 #include "aeongames/Pipeline.hpp"
 #include "aeongames/Skeleton.hpp"
 #include "aeongames/Animation.hpp"
+#include "aeongames/AnimationLod.hpp"
+#include "aeongames/PoseCache.hpp"
 #include "aeongames/Matrix4x4.hpp"
 #include "aeongames/Vector3.hpp"
 #include "aeongames/Quaternion.hpp"
 #include "aeongames/Transform.hpp"
+#include "aeongames/FrameArena.hpp"
 #include "aeongames/Buffer.hpp"
 #include "aeongames/Renderer.hpp"
 #include "aeongames/Node.hpp"
+#include "aeongames/Scene.hpp"
+#include "aeongames/Frustum.hpp"
 #include "aeongames/Model.hpp"
 #include "ModelComponent.h"
 
@@ -72,6 +78,25 @@ namespace
             AeonGames::SlerpQuats ( a.GetRotation(), b.GetRotation(), t );
         return AeonGames::Transform{ scale, rotation, translation };
     }
+
+    // The skinning kernel assumes the canonical 64-byte skinned vertex
+    // layout with packed weight indices/values in the last two words;
+    // meshes not authored that way draw their rest pose.
+    bool IsSkinnable ( const AeonGames::Mesh& aMesh )
+    {
+        if ( aMesh.GetVertexCount() == 0 || aMesh.GetStride() != 64 )
+        {
+            return false;
+        }
+        for ( const auto& attribute : aMesh.GetAttributes() )
+        {
+            if ( std::get<0> ( attribute ) == AeonGames::Mesh::WEIGHT_INDEX )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
 }
 
 namespace AeonGames
@@ -83,19 +108,26 @@ namespace AeonGames
     }
 
     ModelComponent::ModelComponent() = default;
-    ModelComponent::~ModelComponent() = default;
+    ModelComponent::~ModelComponent()
+    {
+        if ( mModel.GetPath() )
+        {
+            mModel.Release();
+        }
+    }
 
     const StringId& ModelComponent::GetId() const
     {
         return ModelStringId;
     }
 
-    static constexpr std::array<const StringId, 3> ModelComponentPropertyIds
+    static constexpr std::array<const StringId, 4> ModelComponentPropertyIds
     {
         {
             {"Model"},
             {"Active Animation"},
             {"Starting Frame"},
+            {"Animation LOD"},
         }
     };
 
@@ -119,6 +151,8 @@ namespace AeonGames
             return GetActiveAnimation();
         case ModelComponentPropertyIds[2]:
             return GetStartingFrame();
+        case ModelComponentPropertyIds[3]:
+            return static_cast<unsigned> ( !GetAnimationLod().empty() );
         }
         return Property{};
     }
@@ -153,6 +187,13 @@ namespace AeonGames
                 SetStartingFrame ( std::get<double> ( aProperty ) );
             }
             break;
+        case ModelComponentPropertyIds[3]:
+            // On picks the default levels, off animates at full detail.
+            if ( std::holds_alternative<unsigned> ( aProperty ) )
+            {
+                SetAnimationLod ( std::get<unsigned> ( aProperty ) ? AnimationLod::GetRecommendedLevels() : std::vector<AnimationLodLevel> {} );
+            }
+            break;
         }
     }
 
@@ -171,8 +212,14 @@ namespace AeonGames
 
     void ModelComponent::SetModel ( const ResourceId& aModel )
     {
+        if ( mModel.GetPath() )
+        {
+            mModel.Release();
+        }
         mModel = aModel;
         mModel.Store();
+        // Rendered every frame through a raw pointer, keep it in the cache.
+        mModel.Acquire();
         mLastResolvedModel = nullptr;
         mActiveAnimationIndex = Model::INVALID_ANIMATION_INDEX;
     }
@@ -209,6 +256,8 @@ namespace AeonGames
             mPendingAnimationSwitch = false;
             mHasBlendSnapshot = false;
             mBlendElapsed = 0.0f;
+            // The pose jumps, there is nothing to extrapolate from.
+            mAnimationLod.Reset();
             return;
         }
         // Defer the actual swap until Update() so we can first capture
@@ -243,8 +292,30 @@ namespace AeonGames
         return mBlendDuration;
     }
 
+    void ModelComponent::SetAnimationLod ( std::vector<AnimationLodLevel> aLevels )
+    {
+        mAnimationLod.SetLevels ( std::move ( aLevels ) );
+    }
+
+    const std::vector<AnimationLodLevel>& ModelComponent::GetAnimationLod() const noexcept
+    {
+        return mAnimationLod.GetLevels();
+    }
+
+    std::span<const float> ModelComponent::GetSkinningMatrices() const
+    {
+        const Model* model = mModel.Cast<Model>();
+        const Skeleton* skeleton = ( model != nullptr ) ? model->GetSkeleton() : nullptr;
+        if ( skeleton == nullptr )
+        {
+            return {};
+        }
+        return { reinterpret_cast<const float*> ( mSkeleton.data() ), skeleton->GetJoints().size() * 16 };
+    }
+
     void ModelComponent::Update ( Node& aNode, double aDelta )
     {
+        mPoseCacheEntry = nullptr;
         if ( auto model = mModel.Cast<Model>() )
         {
             // Refresh the cached animation index when either the model or
@@ -264,6 +335,21 @@ namespace AeonGames
                 }
             }
             aNode.SetAABB ( aabb );
+            // Sampling and blending the pose only touch this component, so
+            // it is left to the scene's animation phase, which evaluates
+            // every queued component in parallel once all nodes updated.
+            Scene* scene = aNode.GetScene();
+            if ( model->GetSkeleton() != nullptr && ( scene == nullptr || !scene->QueueAnimation ( aNode, *this ) ) )
+            {
+                Animate ( aNode, aDelta );
+            }
+        }
+    }
+
+    void ModelComponent::Animate ( const Node& aNode, double aDelta )
+    {
+        if ( auto model = mModel.Cast<Model>() )
+        {
             const Skeleton* skeleton{ model->GetSkeleton() };
             if ( skeleton )
             {
@@ -296,22 +382,59 @@ namespace AeonGames
                         }
                     }
 
+                    // Instances no view collected last frame animate at the
+                    // coarsest level, crossfades and switches always sample.
+                    float screen_size = 0.0f;
+                    Scene* scene = aNode.GetScene();
+                    if ( mCollected && scene != nullptr )
+                    {
+                        screen_size = GetProjectedSize ( aNode.GetGlobalTransform() * aNode.GetAABB(), scene->GetViewMatrix(), scene->GetFieldOfView() );
+                    }
+                    if ( !mAnimationLod.Advance ( screen_size, aDelta, snapshot_active || mPendingAnimationSwitch ) )
+                    {
+                        mAnimationLod.Extrapolate ( std::span<float> ( skeleton_buffer, joint_count * 16 ) );
+                        return;
+                    }
+                    const std::span<const uint16_t> bone_map = mAnimationLod.GetBoneMap ( *skeleton );
+                    const std::span<float> matrices ( skeleton_buffer, joint_count * 16 );
+
+                    // Instances playing the same clip at the same time, as
+                    // quantized by the cache, share one sampled pose per frame. Crossfades and
+                    // switches depend on per instance state, so they sample
+                    // on their own.
+                    PoseCache* pose_cache = ( scene != nullptr && scene->GetPoseCache().IsEnabled() && !snapshot_active && !mPendingAnimationSwitch ) ?
+                                            &scene->GetPoseCache() : nullptr;
+                    PoseCacheKey pose_key{};
+                    double sample = mCurrentSample;
+                    if ( pose_cache != nullptr )
+                    {
+                        sample = pose_cache->Quantize ( mCurrentSample );
+                        pose_key = PoseCacheKey{ skeleton, animation, sample, mAnimationLod.GetCulledBoneHeight() };
+                        mPoseCacheEntry = pose_cache->Find ( pose_key );
+                        if ( mPoseCacheEntry != nullptr )
+                        {
+                            assert ( mPoseCacheEntry->mMatrices.size() == matrices.size() );
+                            memcpy ( skeleton_buffer, mPoseCacheEntry->mMatrices.data(), matrices.size_bytes() );
+                            mAnimationLod.Store ( matrices );
+                            return;
+                        }
+                    }
+
                     // Compute the per-bone pose for this frame. We keep it
                     // in a small local buffer so the same poses can be
                     // captured into mBlendSnapshot if a pending switch was
-                    // queued via SetActiveAnimation().
-                    std::vector<Transform> frame_pose;
-                    frame_pose.resize ( joint_count );
-                    for ( size_t i = 0; i < joint_count; ++i )
+                    // queued via SetActiveAnimation(). The buffer only lives
+                    // for this call, so it comes from the frame arena.
+                    FrameVector<Transform> frame_pose ( joint_count );
+                    animation->SamplePose ( sample, frame_pose );
+                    if ( snapshot_active )
                     {
-                        Transform current_xform = animation->GetTransform ( i, mCurrentSample );
-                        if ( snapshot_active )
-                        {
-                            frame_pose[i] = BlendTransform ( mBlendSnapshot[i], current_xform, blend_weight );
-                        }
-                        else
+                        for ( size_t i = 0; i < joint_count; ++i )
                         {
-                            frame_pose[i] = current_xform;
+                            if ( bone_map[i] == i )
+                            {
+                                frame_pose[i] = BlendTransform ( mBlendSnapshot[i], frame_pose[i], blend_weight );
+                            }
                         }
                     }
 
@@ -322,7 +445,7 @@ namespace AeonGames
                     // we're about to render this frame -> no pop.
                     if ( mPendingAnimationSwitch )
                     {
-                        mBlendSnapshot = std::move ( frame_pose );
+                        mBlendSnapshot.assign ( frame_pose.begin(), frame_pose.end() );
                         mHasBlendSnapshot = true;
                         mBlendElapsed = 0.0f;
 
@@ -332,24 +455,32 @@ namespace AeonGames
                         mActiveAnimationIndex = model->GetAnimationIndexByName ( mActiveAnimation );
                         mLastResolvedModel = model;
                         mCurrentSample = mStartingFrame;
+                    }
 
-                        // Write the snapshot pose itself for this frame.
-                        for ( size_t i = 0; i < joint_count; ++i )
+                    // Write this frame's pose, which is the snapshot itself
+                    // on a switch. Culled joints follow their nearest kept
+                    // ancestor, which bone_map points at.
+                    for ( size_t i = 0; i < joint_count; ++i )
+                    {
+                        if ( bone_map[i] == i )
                         {
-                            Matrix4x4 matrix{ mBlendSnapshot[i] *
+                            Matrix4x4 matrix{ frame_pose[i] *
                                               skeleton->GetJoints() [i].GetInvertedTransform() };
                             memcpy ( skeleton_buffer + ( i * 16 ), matrix.GetMatrix4x4(), sizeof ( float ) * 16 );
                         }
                     }
-                    else
+                    for ( size_t i = 0; i < joint_count; ++i )
                     {
-                        for ( size_t i = 0; i < joint_count; ++i )
+                        if ( bone_map[i] != i )
                         {
-                            Matrix4x4 matrix{ frame_pose[i] *
-                                              skeleton->GetJoints() [i].GetInvertedTransform() };
-                            memcpy ( skeleton_buffer + ( i * 16 ), matrix.GetMatrix4x4(), sizeof ( float ) * 16 );
+                            memcpy ( skeleton_buffer + ( i * 16 ), skeleton_buffer + ( bone_map[i] * 16 ), sizeof ( float ) * 16 );
                         }
                     }
+                    mAnimationLod.Store ( matrices );
+                    if ( pose_cache != nullptr )
+                    {
+                        mPoseCacheEntry = pose_cache->Insert ( pose_key, matrices );
+                    }
                 }
                 else
                 {
@@ -371,6 +502,7 @@ namespace AeonGames
         {
             return;
         }
+        mCollected = true;
         const auto& assemblies = model->GetAssemblies();
         for ( size_t index = 0; index < assemblies.size(); ++index )
         {
@@ -385,6 +517,14 @@ namespace AeonGames
             {
                 skinned_vertices_ptr = &mSkinnedVertices[index];
             }
+            else if ( mSkinSkipped && std::get<0> ( i ).Cast<Mesh>() != nullptr && IsSkinnable ( *std::get<0> ( i ).Cast<Mesh>() ) )
+            {
+                // Skin skipped this instance, so a view the camera frustum
+                // test could not foresee (a shadow map, another window) found
+                // it. Drawing the rest pose would pop, leave it out this
+                // frame; being collected makes Skin pose it from the next.
+                continue;
+            }
             aQueue.push_back ( RenderItem
             {
                 std::get<0> ( i ).Cast<Mesh>(),
@@ -398,18 +538,40 @@ namespace AeonGames
 
     void ModelComponent::Skin ( const Node& aNode, Renderer& aRenderer, void* aWindowId )
     {
-        ( void ) aNode;
         mSkinnedVertices.clear();
+        mSkinSkipped = false;
         auto model = mModel.Cast<Model>();
         if ( !model )
         {
             return;
         }
+        // Views other than the camera's are only known once the renderer
+        // culls, so skip instances no view collected last frame unless the
+        // camera sees them now. Collect drops the skinned assemblies of
+        // skipped instances rather than draw them in their rest pose.
+        if ( !std::exchange ( mCollected, false ) &&
+             !aRenderer.GetFrustum ( aWindowId ).Intersects ( aNode.GetGlobalTransform() * aNode.GetAABB() ) )
+        {
+            mSkinSkipped = true;
+            return;
+        }
         const Skeleton* skeleton{ model->GetSkeleton() };
         if ( !skeleton )
         {
             return;
         }
+        // Instances that shared this frame's pose share the vertices the
+        // first of them skinned too.
+        PoseCache* pose_cache = ( mPoseCacheEntry != nullptr ) ? &aNode.GetScene()->GetPoseCache() : nullptr;
+        if ( pose_cache != nullptr )
+        {
+            const std::span<const BufferAccessor> shared = pose_cache->FindSkin ( *mPoseCacheEntry, model, aWindowId );
+            if ( !shared.empty() )
+            {
+                mSkinnedVertices.assign ( shared.begin(), shared.end() );
+                return;
+            }
+        }
         // The skinning compute pipeline is renderer-agnostic and shared across
         // every skinned model; fetch (and cache) it from the resource store.
         static const ResourceId skinning_pipeline_id{ "Pipeline", "shaders/skinning.txt" };
@@ -431,23 +593,7 @@ namespace AeonGames
         for ( size_t i = 0; i < assemblies.size(); ++i )
         {
             Mesh* mesh = std::get<0> ( assemblies[i] ).Cast<Mesh>();
-            if ( mesh == nullptr || mesh->GetVertexCount() == 0 )
-            {
-                continue;
-            }
-            // The skinning kernel assumes the canonical 64-byte skinned vertex
-            // layout with packed weight indices/values in the last two words;
-            // skip assemblies whose meshes are not authored that way.
-            bool has_weights = false;
-            for ( const auto& attribute : mesh->GetAttributes() )
-            {
-                if ( std::get<0> ( attribute ) == Mesh::WEIGHT_INDEX )
-                {
-                    has_weights = true;
-                    break;
-                }
-            }
-            if ( !has_weights || mesh->GetStride() != 64 )
+            if ( mesh == nullptr || !IsSkinnable ( *mesh ) )
             {
                 continue;
             }
@@ -463,6 +609,10 @@ namespace AeonGames
         if ( dispatched )
         {
             aRenderer.Barrier ( aWindowId );
+            if ( pose_cache != nullptr )
+            {
+                pose_cache->InsertSkin ( *mPoseCacheEntry, model, aWindowId, mSkinnedVertices );
+            }
         }
     }
 
@@ -20,6 +20,7 @@ limitations under the License.
 #include <string>
 #include <string_view>
 #include <vector>
+#include "aeongames/AnimationLod.hpp"
 #include "aeongames/Component.hpp"
 #include "aeongames/ResourceId.hpp"
 #include "aeongames/BufferAccessor.hpp"
@@ -32,12 +33,16 @@ namespace AeonGames
     class Window;
     class Buffer;
     class Model;
+    struct PoseCacheEntry;
     /** @brief Component that attaches a 3D model with skeletal animation support to a scene node. */
     class ModelComponent final : public Component
     {
     public:
         /** @brief Default constructor. */
         ModelComponent();
+        /** Holds a reference on its model, released on destruction. */
+        ModelComponent ( const ModelComponent& ) = delete;
+        ModelComponent& operator= ( const ModelComponent& ) = delete;
         /** @name Overrides */
         ///@{
         ~ModelComponent() final;
@@ -48,6 +53,7 @@ namespace AeonGames
         void SetProperty ( uint32_t, const Property& aProperty ) final;
         const std::vector<std::string>& GetPropertyEnumValues ( const StringId& aId ) const final;
         void Update ( Node& aNode, double aDelta ) final;
+        void Animate ( const Node& aNode, double aDelta ) final;
         void Collect ( const Node& aNode, std::vector<RenderItem>& aQueue ) const final;
         void Skin ( const Node& aNode, Renderer& aRenderer, void* aWindowId ) final;
         void ProcessMessage ( Node& aNode, uint32_t aMessageType, const void* aMessageData ) final;
@@ -76,7 +82,16 @@ namespace AeonGames
         void SetBlendDuration ( float aSeconds ) noexcept;
         /** @brief Returns the crossfade duration in seconds. */
         float GetBlendDuration() const noexcept;
+        /** @brief Sets the animation levels of detail.
+            @param aLevels Levels from finest to coarsest, an empty list,
+            the default, animates every joint at full rate. See AnimationLod. */
+        void SetAnimationLod ( std::vector<AnimationLodLevel> aLevels );
+        /** @brief Returns the animation levels of detail. */
+        const std::vector<AnimationLodLevel>& GetAnimationLod() const noexcept;
         ///@}
+        /** @brief Returns the skinning matrices of the last animated pose,
+            sixteen floats per joint, empty if the model has no skeleton. */
+        std::span<const float> GetSkinningMatrices() const;
         /** @brief Returns the class identifier for the ModelComponent. */
         static const StringId& GetClassId();
     private:
@@ -102,6 +117,18 @@ namespace AeonGames
         bool mHasBlendSnapshot{false};
         float mBlendDuration{0.25f};
         float mBlendElapsed{0.0f};
+        // Sampling rate and culled joints by projected size, full detail
+        // until levels are set through SetAnimationLod. Collect flags
+        // the instance as seen by some view, Skin consumes the flag a frame
+        // later, so instances nothing saw skip skinning and animate coarsely.
+        AnimationLod mAnimationLod{};
+        mutable bool mCollected{false};
+        // Set when Skin skipped the instance, Collect then leaves out the
+        // assemblies that would have drawn in their rest pose.
+        bool mSkinSkipped{false};
+        // Scene pose cache entry this frame's pose came from or went into,
+        // Skin reuses the vertices skinned for it when there are any.
+        PoseCacheEntry* mPoseCacheEntry{nullptr};
         // 128 is the maximum number of bones per model
         std::array<uint8_t, 16 * 128 * sizeof ( float ) > mSkeleton{};
         // Per-assembly skinned output vertex buffers produced by the compute
@@ -14,11 +14,13 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <stdexcept>
 #include "aeongames/ProtoBufClasses.hpp"
@@ -51,7 +53,10 @@ limitations under the License.
 #include "aeongames/LogLevel.hpp"
 #include "aeongames/Utilities.hpp"
 #include "aeongames/Resource.hpp"
+#include "aeongames/JobSystem.hpp"
+#include "aeongames/ResourceStreamer.hpp"
 #include "Factory.h"
+#include "ResourceDirectory.h"
 #ifdef __unix__
 #include <X11/Xlib.h>
 #include <X11/X.h>
@@ -254,6 +259,12 @@ namespace AeonGames
             std::cerr << LogLevel::Warning << e.what() << std::endl;
         }
 
+        if ( gConfigurationMsg.has_jobworkercount() )
+        {
+            InitializeJobSystem ( gConfigurationMsg.jobworkercount() );
+        }
+        SetResourceBudget ( static_cast<size_t> ( gConfigurationMsg.resourcebudget() ) );
+
         gPlugInCache.reserve ( gConfigurationMsg.plugin_size() );
         for ( auto& i : gConfigurationMsg.plugin() )
         {
@@ -278,7 +289,7 @@ namespace AeonGames
             auto model = std::make_unique<Model>();
             model->LoadFromId ( aPath );
             return model;
-        } );
+        }, nullptr, GetResourceMemoryUsage<Model> );
 
         RegisterResourceConstructor ( "Skeleton"_crc32,
                                       [] ( uint32_t aPath )
@@ -293,7 +304,7 @@ namespace AeonGames
             auto animation = std::make_unique<Animation>();
             animation->LoadFromId ( aPath );
             return animation;
-        } );
+        }, nullptr, GetResourceMemoryUsage<Animation> );
 
         RegisterResourceConstructor ( "Texture"_crc32,
                                       [] ( uint32_t aPath )
@@ -301,7 +312,7 @@ namespace AeonGames
             auto texture = std::make_unique<Texture>();
             texture->LoadFromId ( aPath );
             return texture;
-        } );
+        }, nullptr, GetResourceMemoryUsage<Texture> );
 
         RegisterResourceConstructor ( "Mesh"_crc32,
                                       [] ( uint32_t aPath )
@@ -309,7 +320,7 @@ namespace AeonGames
             auto mesh = std::make_unique<Mesh>();
             mesh->LoadFromId ( aPath );
             return mesh;
-        } );
+        }, nullptr, GetResourceMemoryUsage<Mesh> );
 
         RegisterResourceConstructor ( "Pipeline"_crc32,
                                       [] ( uint32_t aPath )
@@ -355,6 +366,8 @@ namespace AeonGames
         {
             return;
         }
+        // Loaders construct through the registered constructors, stop them first.
+        FinalizeResourceStreamer();
         ClearAllResources();
         // Register default resource constructors related to renderer
         UnregisterResourceConstructor ( "Texture"_crc32 );
@@ -374,6 +387,7 @@ namespace AeonGames
             dlclose ( std::get<0> ( i ) );
 #endif
         }
+        FinalizeJobSystem();
 #if defined(__linux__) && GOOGLE_PROTOBUF_VERSION > 3006001
         // protobuf 3.6.1 on Linux has a bug in the Shutdown code
         google::protobuf::ShutdownProtobufLibrary();
@@ -381,7 +395,10 @@ namespace AeonGames
         gInitialized = false;
     }
 
-    static std::vector<Package> gResourcePath{};
+    /** Every mounted package merged in one lookup. Loads hold the lock
+        shared so packages cannot be unmounted under them. */
+    static ResourceDirectory gResourceDirectory{};
+    static std::shared_mutex gResourceDirectoryMutex{};
 
     /** Reverse lookup of CRC32 -> original string for resource type names and
         loose-file resource paths, used purely for diagnostics. */
@@ -419,24 +436,27 @@ namespace AeonGames
 
     std::vector<std::string> GetResourcePath()
     {
+        std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+        const std::vector<const Package*> packages = gResourceDirectory.GetPackages();
         std::vector<std::string> path;
-        path.reserve ( gResourcePath.size() );
-        for ( auto& i : gResourcePath )
+        path.reserve ( packages.size() );
+        for ( const Package* i : packages )
         {
-            path.emplace_back ( i.GetPath().string() );
+            path.emplace_back ( i->GetPath().string() );
         }
         return path;
     }
     void SetResourcePath ( const std::vector<std::string>& aPath )
     {
-        gResourcePath.clear();
-        gResourcePath.reserve ( aPath.size() );
+        // Open the packages before taking the lock, loads keep going meanwhile.
+        std::vector<std::unique_ptr<Package >> packages;
+        packages.reserve ( aPath.size() );
         std::ostringstream stream;
         for ( auto& i : aPath )
         {
             try
             {
-                gResourcePath.emplace_back ( i );
+                packages.emplace_back ( std::make_unique<Package> ( i ) );
             }
             catch ( const std::runtime_error& e )
             {
@@ -447,12 +467,32 @@ namespace AeonGames
                 throw;
             }
         }
+        {
+            std::unique_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+            gResourceDirectory.Clear();
+            for ( auto& i : packages )
+            {
+                gResourceDirectory.Mount ( std::move ( i ), false );
+            }
+        }
         if ( stream.rdbuf()->in_avail() > 0 )
         {
             std::cout << LogLevel::Error << stream.str() << std::endl;
             throw std::runtime_error ( stream.str().c_str() );
         }
     }
+    void MountResourcePackage ( const std::string& aPath )
+    {
+        auto package = std::make_unique<Package> ( aPath );
+        std::unique_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+        gResourceDirectory.Unmount ( package->GetPath() );
+        gResourceDirectory.Mount ( std::move ( package ), true );
+    }
+    bool UnmountResourcePackage ( const std::string& aPath )
+    {
+        std::unique_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+        return gResourceDirectory.Unmount ( aPath );
+    }
 
     // Candidate file extensions tried when a resource is referenced by a bare
     // basename (no extension). Ordered by preference: the text form is tried
@@ -466,14 +506,7 @@ namespace AeonGames
 
     static bool ResourceInPackages ( uint32_t crc )
     {
-        for ( const auto& package : gResourcePath )
-        {
-            if ( package.GetIndexTable().find ( crc ) != package.GetIndexTable().end() )
-            {
-                return true;
-            }
-        }
-        return false;
+        return gResourceDirectory.Find ( crc ).mPackage != nullptr;
     }
 
     // True when the last path component carries an extension (a '.' after the
@@ -491,52 +524,65 @@ namespace AeonGames
     // is used as-is. Otherwise, when the crc came from a bare basename, try the
     // candidate extensions in preference order and use the first that exists.
     // Falls back to the original crc (which then fails to load with a
-    // descriptive error) when nothing matches.
+    // descriptive error) when nothing matches. Callers hold the directory lock.
+    // Outcomes, misses included, are cached in the directory until the next
+    // mount change, so repeated lookups by basename cost two probes.
     static uint32_t ResolveResourceCrc ( uint32_t crc )
     {
         if ( ResourceInPackages ( crc ) )
         {
             return crc;
         }
+        uint32_t resolved;
+        if ( gResourceDirectory.FindAlias ( crc, resolved ) )
+        {
+            return resolved;
+        }
         const std::string referenced = GetResourceString ( crc );
-        if ( referenced.empty() || HasPathExtension ( referenced ) )
+        if ( referenced.empty() )
         {
+            // Not cached, the string may be registered later on.
             return crc;
         }
-        for ( const char * extension : kResourceExtensionPreference )
+        resolved = crc;
+        if ( !HasPathExtension ( referenced ) )
         {
-            const std::string candidate = referenced + extension;
-            const uint32_t candidate_crc = crc32i ( candidate.data(), candidate.size() );
-            if ( ResourceInPackages ( candidate_crc ) )
+            std::string candidate;
+            candidate.reserve ( referenced.size() + 4 );
+            for ( const char * extension : kResourceExtensionPreference )
             {
-                return candidate_crc;
+                candidate.assign ( referenced ).append ( extension );
+                const uint32_t candidate_crc = crc32i ( candidate.data(), candidate.size() );
+                if ( ResourceInPackages ( candidate_crc ) )
+                {
+                    resolved = candidate_crc;
+                    break;
+                }
             }
         }
-        return crc;
+        gResourceDirectory.CacheAlias ( crc, resolved );
+        return resolved;
     }
 
     size_t GetResourceSize ( uint32_t crc )
     {
+        std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
         crc = ResolveResourceCrc ( crc );
-        for ( auto &i : gResourcePath )
+        const ResourceDirectory::Location location = gResourceDirectory.Find ( crc );
+        if ( location.mPackage == nullptr )
         {
-            auto resource = i.GetIndexTable().find ( crc );
-            if ( resource != i.GetIndexTable().end() )
-            {
-                return i.GetFileSize ( crc );
-            }
+            return 0;
         }
-        return 0;
+        return ( location.mEntry != Package::NoEntry ) ? location.mPackage->GetEntrySize ( location.mEntry ) : location.mPackage->GetFileSize ( crc );
     }
 
     std::string GetResourcePath ( uint32_t crc )
     {
-        for ( auto &i : gResourcePath )
         {
-            auto resource = i.GetIndexTable().find ( crc );
-            if ( resource != i.GetIndexTable().end() )
+            std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+            if ( const Package * package = gResourceDirectory.Find ( crc ).mPackage )
             {
-                return resource->second;
+                return package->GetIndexTable().at ( crc );
             }
         }
         // Fall back to the reverse string registry: loose-file resources are
@@ -553,13 +599,20 @@ namespace AeonGames
     }
     void LoadResource ( uint32_t crc, void* buffer, size_t buffer_size )
     {
-        crc = ResolveResourceCrc ( crc );
-        for ( auto &i : gResourcePath )
         {
-            auto resource = i.GetIndexTable().find ( crc );
-            if ( resource != i.GetIndexTable().end() )
+            std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+            crc = ResolveResourceCrc ( crc );
+            const ResourceDirectory::Location location = gResourceDirectory.Find ( crc );
+            if ( location.mPackage != nullptr )
             {
-                i.LoadFile ( crc, buffer, buffer_size );
+                if ( location.mEntry != Package::NoEntry )
+                {
+                    location.mPackage->LoadEntry ( location.mEntry, buffer, buffer_size );
+                }
+                else
+                {
+                    location.mPackage->LoadFile ( crc, buffer, buffer_size );
+                }
                 return;
             }
         }
@@ -568,6 +621,69 @@ namespace AeonGames
         std::cout << LogLevel::Error << oss.str() << std::endl;
         throw std::runtime_error ( oss.str() );
     }
+    std::span<const uint8_t> GetResourceView ( uint32_t crc, std::shared_ptr<const void>& aOwner )
+    {
+        std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+        crc = ResolveResourceCrc ( crc );
+        const ResourceDirectory::Location location = gResourceDirectory.Find ( crc );
+        const std::span<const uint8_t> view = ( location.mPackage != nullptr ) ? location.mPackage->GetEntryView ( location.mEntry ) : std::span<const uint8_t> {};
+        aOwner = view.empty() ? nullptr : location.mPackage->GetMappingOwner();
+        return view;
+    }
+    void LoadResources ( std::span<ResourceRead> aReads )
+    {
+        struct Batch
+        {
+            const Package* mPackage;
+            std::vector<ResourceRead> mReads;
+            std::vector<ResourceRead*> mOrigins;
+        };
+        std::vector<Batch> batches;
+        size_t missing = 0;
+        uint32_t first_missing = 0;
+        {
+            std::shared_lock<std::shared_mutex> lock ( gResourceDirectoryMutex );
+            for ( ResourceRead& read : aReads )
+            {
+                read.mBytesRead = 0;
+                const uint32_t crc = ResolveResourceCrc ( read.mCrc );
+                const Package* package = gResourceDirectory.Find ( crc ).mPackage;
+                if ( package == nullptr )
+                {
+                    if ( missing++ == 0 )
+                    {
+                        first_missing = read.mCrc;
+                    }
+                    continue;
+                }
+                auto batch = std::find_if ( batches.begin(), batches.end(), [package] ( const Batch & aBatch )
+                {
+                    return aBatch.mPackage == package;
+                } );
+                if ( batch == batches.end() )
+                {
+                    batch = batches.insert ( batches.end(), Batch{package, {}, {}} );
+                }
+                batch->mReads.push_back ( ResourceRead{crc, read.mBuffer, read.mBufferSize, 0} );
+                batch->mOrigins.push_back ( &read );
+            }
+            for ( Batch& batch : batches )
+            {
+                batch.mPackage->LoadFiles ( batch.mReads );
+                for ( size_t j = 0; j < batch.mReads.size(); ++j )
+                {
+                    batch.mOrigins[j]->mBytesRead = batch.mReads[j].mBytesRead;
+                }
+            }
+        }
+        if ( missing != 0 )
+        {
+            std::ostringstream oss;
+            oss << missing << " resource(s) not found (first crc 0x" << std::hex << std::setw ( 8 ) << std::setfill ( '0' ) << first_missing << ").";
+            std::cout << LogLevel::Error << oss.str() << std::endl;
+            throw std::runtime_error ( oss.str() );
+        }
+    }
     void LoadResource ( const std::string& aFileName, void* buffer, size_t buffer_size )
     {
         try
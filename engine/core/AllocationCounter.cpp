@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "aeongames/AllocationCounter.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        // Plain integers and atomics only: these are touched from inside
+        // operator new, so nothing here may allocate or need construction.
+        std::atomic<uint64_t> gAllocationCount{0};
+        std::atomic<uint64_t> gFrameStartCount{0};
+        thread_local uint64_t tAllocationCount{0};
+    }
+
+#ifdef AEONGAMES_COUNT_ALLOCATIONS
+    namespace
+    {
+        void CountAllocation()
+        {
+            gAllocationCount.fetch_add ( 1, std::memory_order_relaxed );
+            ++tAllocationCount;
+        }
+
+        void* CountedAllocate ( size_t aSize )
+        {
+            CountAllocation();
+            return std::malloc ( aSize ? aSize : 1 );
+        }
+
+        void* CountedAllocate ( size_t aSize, std::align_val_t aAlignment )
+        {
+            CountAllocation();
+            const size_t alignment = static_cast<size_t> ( aAlignment );
+            // aligned_alloc wants the size to be a multiple of the alignment.
+            return std::aligned_alloc ( alignment, ( ( aSize ? aSize : 1 ) + alignment - 1 ) & ~ ( alignment - 1 ) );
+        }
+    }
+#endif
+
+    bool IsAllocationCountingEnabled()
+    {
+#ifdef AEONGAMES_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint64_t GetThreadAllocationCount()
+    {
+        return tAllocationCount;
+    }
+
+    uint64_t GetFrameAllocationCount()
+    {
+        return gAllocationCount.load ( std::memory_order_relaxed ) - gFrameStartCount.load ( std::memory_order_relaxed );
+    }
+
+    void BeginAllocationFrame()
+    {
+        gFrameStartCount.store ( gAllocationCount.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+    }
+}
+
+#ifdef AEONGAMES_COUNT_ALLOCATIONS
+// Replacements of the global allocation functions. Every form is replaced
+// so counted and uncounted memory never cross between new and delete.
+void* operator new ( size_t aSize )
+{
+    if ( void* pointer = AeonGames::CountedAllocate ( aSize ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+void* operator new[] ( size_t aSize )
+{
+    return operator new ( aSize );
+}
+void* operator new ( size_t aSize, const std::nothrow_t& ) noexcept
+{
+    return AeonGames::CountedAllocate ( aSize );
+}
+void* operator new[] ( size_t aSize, const std::nothrow_t& ) noexcept
+{
+    return AeonGames::CountedAllocate ( aSize );
+}
+void* operator new ( size_t aSize, std::align_val_t aAlignment )
+{
+    if ( void* pointer = AeonGames::CountedAllocate ( aSize, aAlignment ) )
+    {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+void* operator new[] ( size_t aSize, std::align_val_t aAlignment )
+{
+    return operator new ( aSize, aAlignment );
+}
+void* operator new ( size_t aSize, std::align_val_t aAlignment, const std::nothrow_t& ) noexcept
+{
+    return AeonGames::CountedAllocate ( aSize, aAlignment );
+}
+void* operator new[] ( size_t aSize, std::align_val_t aAlignment, const std::nothrow_t& ) noexcept
+{
+    return AeonGames::CountedAllocate ( aSize, aAlignment );
+}
+void operator delete ( void* aPointer ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete ( void* aPointer, size_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer, size_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete ( void* aPointer, const std::nothrow_t& ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer, const std::nothrow_t& ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete ( void* aPointer, std::align_val_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer, std::align_val_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete ( void* aPointer, size_t, std::align_val_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer, size_t, std::align_val_t ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete ( void* aPointer, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+    std::free ( aPointer );
+}
+void operator delete[] ( void* aPointer, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+    std::free ( aPointer );
+}
+#endif
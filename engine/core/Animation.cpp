@@ -1,5 +1,5 @@
 /*
-Copyright (C) 2017-2019,2021,2025 Rodrigo Jose Hernandez Cordoba
+Copyright (C) 2017-2019,2021,2025,2026 Rodrigo Jose Hernandez Cordoba
 
 Licensed under the Apache License, Version 2.0 (the "License");
 you may not use this file except in compliance with the License.
@@ -16,16 +16,24 @@ limitations under the License.
 
 #include <exception>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <iostream>
 #include <mutex>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include "aeongames/AeonEngine.hpp"
 #include "aeongames/ProtoBufHelpers.hpp"
 #include "aeongames/ProtoBufUtils.hpp"
 #include "aeongames/Utilities.hpp"
+#include "aeongames/LogLevel.hpp"
 #include "aeongames/Animation.hpp"
 #include "aeongames/ProtoBufClasses.hpp"
+#include "math/SIMD.h"
 #ifdef _MSC_VER
 #pragma warning( push )
 #pragma warning( disable : PROTOBUF_WARNINGS )
@@ -37,6 +45,208 @@ limitations under the License.
 
 namespace AeonGames
 {
+    namespace
+    {
+        /// Scale, rotation and translation.
+        constexpr size_t kBoneTracks = 3;
+        constexpr size_t kRotationTrack = 1;
+        constexpr uint32_t kConstantTrack = ~0u;
+        /// Frames per segment, a segment also holds the first frame of the next.
+        constexpr uint32_t kSegmentFrames = 32;
+        /// Range of the three smallest components of a unit quaternion.
+        constexpr float kSmallestThreeRange = 0.70710678f;
+        constexpr float kSmallestThreeSteps = 32767.0f;
+        constexpr float kRangeSteps = 65535.0f;
+        /// Floats per bone per frame, as Transform ( const float* ) reads them.
+        constexpr size_t kTransformFloats = 10;
+        /// First float of each track among a bone's kTransformFloats.
+        constexpr size_t kTrackOffsets[kBoneTracks] { 0, 3, 7 };
+
+        using Value = std::array<float, 4>;
+        using Code = std::array<uint16_t, 3>;
+
+        /** Pack a wxyz rotation into 48 bits: the index of the largest
+            component in the top two bits, then the other three at 15 bits
+            each, negated when needed so the dropped component is positive. */
+        Code EncodeRotation ( const Value& aRotation )
+        {
+            size_t largest = 0;
+            for ( size_t i = 1; i < 4; ++i )
+            {
+                if ( std::fabs ( aRotation[i] ) > std::fabs ( aRotation[largest] ) )
+                {
+                    largest = i;
+                }
+            }
+            const float sign = aRotation[largest] < 0.0f ? -1.0f : 1.0f;
+            uint64_t bits = largest;
+            for ( size_t i = 0; i < 4; ++i )
+            {
+                if ( i != largest )
+                {
+                    const float normalized = ( aRotation[i] * sign + kSmallestThreeRange ) / ( 2.0f * kSmallestThreeRange );
+                    bits = ( bits << 15 ) | static_cast<uint64_t> ( std::lround ( std::clamp ( normalized, 0.0f, 1.0f ) * kSmallestThreeSteps ) );
+                }
+            }
+            return Code{ static_cast<uint16_t> ( bits >> 32 ), static_cast<uint16_t> ( bits >> 16 ), static_cast<uint16_t> ( bits ) };
+        }
+
+        Value DecodeRotation ( const uint16_t* aCode )
+        {
+            // Components stored for each dropped one, in storage order.
+            static constexpr uint8_t kStored[4][3] { { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 0, 1, 2 } };
+            constexpr float kScale = 2.0f * kSmallestThreeRange / kSmallestThreeSteps;
+            const uint64_t bits = ( uint64_t{aCode[0]} << 32 ) | ( uint64_t{aCode[1]} << 16 ) | aCode[2];
+            const size_t largest = static_cast<size_t> ( ( bits >> 45 ) & 3 );
+            const float a = static_cast<float> ( ( bits >> 30 ) & 0x7FFF ) * kScale - kSmallestThreeRange;
+            const float b = static_cast<float> ( ( bits >> 15 ) & 0x7FFF ) * kScale - kSmallestThreeRange;
+            const float c = static_cast<float> ( bits & 0x7FFF ) * kScale - kSmallestThreeRange;
+            Value rotation;
+            rotation[kStored[largest][0]] = a;
+            rotation[kStored[largest][1]] = b;
+            rotation[kStored[largest][2]] = c;
+            rotation[largest] = std::sqrt ( std::max ( 0.0f, 1.0f - a * a - b * b - c * c ) );
+            return rotation;
+        }
+
+        Code EncodeVector ( const Value& aVector, const float* aMin, const float* aExtent )
+        {
+            Code code{};
+            for ( size_t i = 0; i < 3; ++i )
+            {
+                if ( aExtent[i] > 0.0f )
+                {
+                    code[i] = static_cast<uint16_t> ( std::lround ( std::clamp ( ( aVector[i] - aMin[i] ) / aExtent[i], 0.0f, 1.0f ) * kRangeSteps ) );
+                }
+            }
+            return code;
+        }
+
+        Value DecodeVector ( const uint16_t* aCode, const float* aMin, const float* aExtent )
+        {
+            return Value
+            {
+                aMin[0] + static_cast<float> ( aCode[0] ) * ( aExtent[0] / kRangeSteps ),
+                aMin[1] + static_cast<float> ( aCode[1] ) * ( aExtent[1] / kRangeSteps ),
+                aMin[2] + static_cast<float> ( aCode[2] ) * ( aExtent[2] / kRangeSteps ),
+                0.0f
+            };
+        }
+
+        Value LerpVector ( const Value& aFrom, const Value& aTo, float aInterpolation )
+        {
+            return Value
+            {
+                aFrom[0] + ( aTo[0] - aFrom[0] ) * aInterpolation,
+                aFrom[1] + ( aTo[1] - aFrom[1] ) * aInterpolation,
+                aFrom[2] + ( aTo[2] - aFrom[2] ) * aInterpolation,
+                0.0f
+            };
+        }
+
+        /// Normalized lerp along the shorter arc.
+        Value NlerpRotation ( const Value& aFrom, const Value& aTo, float aInterpolation )
+        {
+            const float dot = aFrom[0] * aTo[0] + aFrom[1] * aTo[1] + aFrom[2] * aTo[2] + aFrom[3] * aTo[3];
+            const float to = dot < 0.0f ? -aInterpolation : aInterpolation;
+            const float from = 1.0f - aInterpolation;
+            Value rotation
+            {
+                aFrom[0] * from + aTo[0] * to,
+                aFrom[1] * from + aTo[1] * to,
+                aFrom[2] * from + aTo[2] * to,
+                aFrom[3] * from + aTo[3] * to
+            };
+            const float length = std::sqrt ( rotation[0] * rotation[0] + rotation[1] * rotation[1] + rotation[2] * rotation[2] + rotation[3] * rotation[3] );
+            for ( float& component : rotation )
+            {
+                component /= length;
+            }
+            return rotation;
+        }
+
+        /// Angle between two rotations, or distance between two vectors.
+        float Error ( const Value& aLhs, const Value& aRhs, bool aRotation )
+        {
+            if ( aRotation )
+            {
+                // From the chord between the quaternions, acos of their dot product is too coarse near 1.
+                const float sign = ( aLhs[0] * aRhs[0] + aLhs[1] * aRhs[1] + aLhs[2] * aRhs[2] + aLhs[3] * aRhs[3] ) < 0.0f ? -1.0f : 1.0f;
+                float chord = 0.0f;
+                for ( size_t i = 0; i < 4; ++i )
+                {
+                    chord += ( aLhs[i] - sign * aRhs[i] ) * ( aLhs[i] - sign * aRhs[i] );
+                }
+                return 4.0f * std::asin ( std::min ( std::sqrt ( chord ) * 0.5f, 1.0f ) );
+            }
+            const float x = aLhs[0] - aRhs[0];
+            const float y = aLhs[1] - aRhs[1];
+            const float z = aLhs[2] - aRhs[2];
+            return std::sqrt ( x * x + y * y + z * z );
+        }
+
+        /** Append to @p aKeys the frames after @p aFirst up to @p aLast to keep
+            so that interpolating the quantized values of neighbouring keys stays
+            within @p aTolerance of every raw frame. @p aLast is always kept. */
+        void ReduceKeys ( const std::vector<Value>& aRaw, const std::vector<Value>& aQuantized, size_t aFirst, size_t aLast, bool aRotation, float aTolerance, std::vector<uint16_t>& aKeys )
+        {
+            auto spans = [&] ( size_t aFrom, size_t aTo )
+            {
+                for ( size_t k = aFrom + 1; k < aTo; ++k )
+                {
+                    const float interpolation = static_cast<float> ( k - aFrom ) / static_cast<float> ( aTo - aFrom );
+                    const Value value = aRotation ?
+                                        NlerpRotation ( aQuantized[aFrom], aQuantized[aTo], interpolation ) :
+                                        LerpVector ( aQuantized[aFrom], aQuantized[aTo], interpolation );
+                    if ( Error ( value, aRaw[k], aRotation ) > aTolerance )
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            size_t first = aFirst;
+            while ( first < aLast )
+            {
+                size_t last = first + 1;
+                while ( last < aLast && spans ( first, last + 1 ) )
+                {
+                    ++last;
+                }
+                aKeys.push_back ( static_cast<uint16_t> ( last ) );
+                first = last;
+            }
+        }
+
+        uint32_t GetSegmentCount ( uint32_t aFrameCount )
+        {
+            return aFrameCount <= 1 ? 1 : ( aFrameCount - 2 ) / kSegmentFrames + 1;
+        }
+
+        /// Frames around a sample, returns the interpolation between the middle two.
+        double GetSampleFrames ( double aSample, uint32_t aFrameCount, std::array<uint32_t, 4>& aFrames )
+        {
+            double frame;
+            double interpolation = modf ( aSample, &frame );
+            auto frame1 = static_cast<uint32_t> ( frame );
+            aFrames[0] = frame1 == 0 ? aFrameCount - 1 : ( ( frame1 - 1 ) % aFrameCount );
+            aFrames[1] = frame1;
+            aFrames[2] = ( ( frame1 + 1 ) % aFrameCount );
+            aFrames[3] = ( ( frame1 + 2 ) % aFrameCount );
+            /// modf should guarantee interpolation to be in the range [0.0,1.0)
+            assert ( ( interpolation >= 0.0 ) && ( interpolation < 1.0 ) && "Interpolation out of range [0.0,1.0)." );
+            return interpolation;
+        }
+
+        [[noreturn]] void ThrowMalformedAnimation ( const char* aReason )
+        {
+            std::ostringstream stream;
+            stream << "Malformed compressed animation: " << aReason;
+            std::cout << LogLevel::Error << stream.str() << std::endl;
+            throw std::runtime_error ( stream.str() );
+        }
+    }
+
     Animation::Animation()
         = default;
     void Animation::LoadFromMemory ( const void* aBuffer, size_t aBufferSize )
@@ -46,49 +256,347 @@ namespace AeonGames
 
     void Animation::LoadFromPBMsg ( const AnimationMsg& aAnimationMsg )
     {
+        Unload();
         mVersion = aAnimationMsg.version();
         mFrameRate = aAnimationMsg.framerate();
         mDuration = aAnimationMsg.duration();
-        mFrames.reserve ( aAnimationMsg.frame_size() );
-        for ( auto& frame : aAnimationMsg.frame() )
+        if ( aAnimationMsg.track_size() > 0 )
         {
-            mFrames.emplace_back();
-            mFrames.back().reserve ( frame.bone_size() );
-            for ( auto& joint : frame.bone() )
+            if ( aAnimationMsg.track_size() % kBoneTracks != 0 )
             {
-                mFrames.back().emplace_back (
-                           Transform
+                ThrowMalformedAnimation ( "track count is not a multiple of three." );
+            }
+            if ( aAnimationMsg.framecount() == 0 || aAnimationMsg.framecount() > 65536 )
+            {
+                ThrowMalformedAnimation ( "frame count out of range." );
+            }
+            mFrameCount = aAnimationMsg.framecount();
+            mBoneCount = static_cast<uint32_t> ( aAnimationMsg.track_size() / kBoneTracks );
+            mTracks.resize ( aAnimationMsg.track_size() );
+            std::vector<std::vector<uint16_t>> keys;
+            std::vector<std::vector<uint16_t>> codes;
+            for ( int i = 0; i < aAnimationMsg.track_size(); ++i )
+            {
+                const AnimationTrackMsg& track_msg = aAnimationMsg.track ( i );
+                const bool rotation = ( i % kBoneTracks ) == kRotationTrack;
+                Track& track = mTracks[i];
+                if ( track_msg.keys().empty() )
                 {
-                    Vector3
+                    if ( track_msg.constant_size() != ( rotation ? 4 : 3 ) )
                     {
-                        joint.scale().x(),
-                             joint.scale().y(),
-                             joint.scale().z()
-                    },
-                    Quaternion
+                        ThrowMalformedAnimation ( "constant track of the wrong size." );
+                    }
+                    track.mAnimated = kConstantTrack;
+                    std::copy ( track_msg.constant().begin(), track_msg.constant().end(), track.mBase );
+                    continue;
+                }
+                const size_t key_count = track_msg.keys().size() / sizeof ( uint16_t );
+                if ( track_msg.keys().size() % sizeof ( uint16_t ) != 0 ||
+                     track_msg.values().size() != key_count * sizeof ( Code ) ||
+                     ( !rotation && track_msg.range_size() != 6 ) )
+                {
+                    ThrowMalformedAnimation ( "key, value and range sizes disagree." );
+                }
+                track.mAnimated = static_cast<uint32_t> ( keys.size() );
+                if ( !rotation )
+                {
+                    std::copy ( track_msg.range().begin(), track_msg.range().begin() + 3, track.mBase );
+                    std::copy ( track_msg.range().begin() + 3, track_msg.range().end(), track.mExtent );
+                }
+                std::vector<uint16_t>& track_keys = keys.emplace_back ( key_count );
+                std::memcpy ( track_keys.data(), track_msg.keys().data(), track_msg.keys().size() );
+                std::vector<uint16_t>& track_codes = codes.emplace_back ( key_count * 3 );
+                std::memcpy ( track_codes.data(), track_msg.values().data(), track_msg.values().size() );
+                if ( track_keys.front() != 0 || track_keys.back() != mFrameCount - 1 ||
+                     !std::is_sorted ( track_keys.begin(), track_keys.end(), std::less_equal<uint16_t>() ) )
+                {
+                    ThrowMalformedAnimation ( "keys must ascend from the first to the last frame." );
+                }
+                for ( uint32_t frame = kSegmentFrames; frame < mFrameCount; frame += kSegmentFrames )
+                {
+                    if ( !std::binary_search ( track_keys.begin(), track_keys.end(), static_cast<uint16_t> ( frame ) ) )
                     {
-                        joint.rotation().w(),
-                             joint.rotation().x(),
-                             joint.rotation().y(),
-                             joint.rotation().z()
-                    },
-                    Vector3
+                        ThrowMalformedAnimation ( "every 32nd frame must be a key." );
+                    }
+                }
+            }
+            BuildSegments ( keys, codes );
+            return;
+        }
+        mFrameCount = static_cast<uint32_t> ( aAnimationMsg.frame_size() );
+        mBoneCount = mFrameCount == 0 ? 0 : static_cast<uint32_t> ( aAnimationMsg.frame ( 0 ).bone_size() );
+        mBoneStride = static_cast<uint32_t> ( ( mBoneCount + kSimdPoseLanes - 1 ) / kSimdPoseLanes * kSimdPoseLanes );
+        mPoses.assign ( mFrameCount * kTransformFloats * mBoneStride, 0.0f );
+        for ( uint32_t frame = 0; frame < mFrameCount; ++frame )
+        {
+            const FrameMsg& frame_msg = aAnimationMsg.frame ( frame );
+            if ( static_cast<uint32_t> ( frame_msg.bone_size() ) != mBoneCount )
+            {
+                std::ostringstream stream;
+                stream << "Malformed animation: frame " << frame << " animates " << frame_msg.bone_size() << " bones, the first frame " << mBoneCount << ".";
+                std::cout << LogLevel::Error << stream.str() << std::endl;
+                throw std::runtime_error ( stream.str() );
+            }
+            float* pose = mPoses.data() + frame * kTransformFloats * mBoneStride;
+            for ( uint32_t bone = 0; bone < mBoneCount; ++bone )
+            {
+                const BoneMsg& joint = frame_msg.bone ( bone );
+                const float values[kTransformFloats]
+                {
+                    joint.scale().x(), joint.scale().y(), joint.scale().z(),
+                    joint.rotation().w(), joint.rotation().x(), joint.rotation().y(), joint.rotation().z(),
+                    joint.translation().x(), joint.translation().y(), joint.translation().z()
+                };
+                for ( size_t i = 0; i < kTransformFloats; ++i )
+                {
+                    pose[i * mBoneStride + bone] = values[i];
+                }
+            }
+            // Padding bones are identities so whole blocks of lanes interpolate cleanly.
+            for ( uint32_t bone = mBoneCount; bone < mBoneStride; ++bone )
+            {
+                // Scale xyz and rotation w.
+                for ( size_t i = 0; i < 4; ++i )
+                {
+                    pose[i * mBoneStride + bone] = 1.0f;
+                }
+            }
+        }
+    }
+
+    void Animation::Serialize ( AnimationMsg& aAnimationMsg ) const
+    {
+        aAnimationMsg.set_version ( mVersion );
+        aAnimationMsg.set_framerate ( mFrameRate );
+        aAnimationMsg.set_duration ( static_cast<float> ( mDuration ) );
+        if ( !mTracks.empty() )
+        {
+            aAnimationMsg.set_framecount ( mFrameCount );
+            const uint32_t segment_count = GetSegmentCount ( mFrameCount );
+            for ( size_t i = 0; i < mTracks.size(); ++i )
+            {
+                const Track& track = mTracks[i];
+                const bool rotation = ( i % kBoneTracks ) == kRotationTrack;
+                AnimationTrackMsg* track_msg = aAnimationMsg.add_track();
+                if ( track.mAnimated == kConstantTrack )
+                {
+                    for ( size_t j = 0; j < ( rotation ? 4u : 3u ); ++j )
+                    {
+                        track_msg->add_constant ( track.mBase[j] );
+                    }
+                    continue;
+                }
+                if ( !rotation )
+                {
+                    for ( size_t j = 0; j < 3; ++j )
+                    {
+                        track_msg->add_range ( track.mBase[j] );
+                    }
+                    for ( size_t j = 0; j < 3; ++j )
+                    {
+                        track_msg->add_range ( track.mExtent[j] );
+                    }
+                }
+                std::vector<uint16_t> keys;
+                std::vector<uint16_t> codes;
+                for ( uint32_t segment = 0; segment < segment_count; ++segment )
+                {
+                    const uint16_t* record = mSegmentData.data() + mRecords[segment * mAnimatedTracks + track.mAnimated];
+                    const uint16_t count = record[0];
+                    const uint8_t* record_keys = reinterpret_cast<const uint8_t*> ( record + 1 );
+                    const uint16_t* record_codes = record + 1 + ( count + 1 ) / 2;
+                    // Segments share their boundary keys.
+                    for ( uint16_t k = segment == 0 ? 0 : 1; k < count; ++k )
+                    {
+                        keys.push_back ( static_cast<uint16_t> ( segment * kSegmentFrames + record_keys[k] ) );
+                        codes.insert ( codes.end(), record_codes + k * 3, record_codes + k * 3 + 3 );
+                    }
+                }
+                track_msg->set_keys ( keys.data(), keys.size() * sizeof ( uint16_t ) );
+                track_msg->set_values ( codes.data(), codes.size() * sizeof ( uint16_t ) );
+            }
+            return;
+        }
+        for ( uint32_t frame = 0; frame < mFrameCount; ++frame )
+        {
+            FrameMsg* frame_msg = aAnimationMsg.add_frame();
+            const float* pose = mPoses.data() + frame * kTransformFloats * mBoneStride;
+            for ( uint32_t i = 0; i < mBoneCount; ++i )
+            {
+                auto value = [pose, i, this] ( size_t aFloat )
+                {
+                    return pose[aFloat * mBoneStride + i];
+                };
+                BoneMsg* bone = frame_msg->add_bone();
+                bone->mutable_scale()->set_x ( value ( 0 ) );
+                bone->mutable_scale()->set_y ( value ( 1 ) );
+                bone->mutable_scale()->set_z ( value ( 2 ) );
+                bone->mutable_rotation()->set_w ( value ( 3 ) );
+                bone->mutable_rotation()->set_x ( value ( 4 ) );
+                bone->mutable_rotation()->set_y ( value ( 5 ) );
+                bone->mutable_rotation()->set_z ( value ( 6 ) );
+                bone->mutable_translation()->set_x ( value ( 7 ) );
+                bone->mutable_translation()->set_y ( value ( 8 ) );
+                bone->mutable_translation()->set_z ( value ( 9 ) );
+            }
+        }
+    }
+
+    void Animation::Compress ( const AnimationCompression& aCompression )
+    {
+        if ( mPoses.empty() )
+        {
+            return;
+        }
+        if ( mFrameCount > 65536 )
+        {
+            std::ostringstream stream;
+            stream << "Cannot compress an animation of " << mFrameCount << " frames, keys are 16 bit.";
+            std::cout << LogLevel::Error << stream.str() << std::endl;
+            throw std::runtime_error ( stream.str() );
+        }
+        const float tolerances[kBoneTracks] { aCompression.mScaleTolerance, aCompression.mRotationTolerance, aCompression.mTranslationTolerance };
+        const uint32_t frame_count = mFrameCount;
+        std::vector<Track> tracks ( mBoneCount * kBoneTracks );
+        std::vector<std::vector<uint16_t>> keys;
+        std::vector<std::vector<uint16_t>> codes;
+        std::vector<Value> raw ( frame_count );
+        std::vector<Value> quantized ( frame_count );
+        std::vector<Code> frame_codes ( frame_count );
+        for ( size_t i = 0; i < tracks.size(); ++i )
+        {
+            const size_t bone = i / kBoneTracks;
+            const size_t channel = i % kBoneTracks;
+            const bool rotation = channel == kRotationTrack;
+            for ( size_t frame = 0; frame < frame_count; ++frame )
+            {
+                const float* track_values = mPoses.data() + ( frame * kTransformFloats + kTrackOffsets[channel] ) * mBoneStride + bone;
+                raw[frame] = Value{};
+                for ( size_t j = 0; j < ( rotation ? 4u : 3u ); ++j )
+                {
+                    raw[frame][j] = track_values[j * mBoneStride];
+                }
+            }
+            Track& track = tracks[i];
+            if ( std::all_of ( raw.begin(), raw.end(), [&] ( const Value & aValue )
+        {
+            return Error ( aValue, raw.front(), rotation ) <= tolerances[channel];
+            } ) )
+            {
+                track.mAnimated = kConstantTrack;
+                std::copy ( raw.front().begin(), raw.front().end(), track.mBase );
+                continue;
+            }
+            if ( !rotation )
+            {
+                for ( size_t j = 0; j < 3; ++j )
+                {
+                    const auto [min, max] = std::minmax_element ( raw.begin(), raw.end(), [j] ( const Value & aLhs, const Value & aRhs )
                     {
-                        joint.translation().x(),
-                             joint.translation().y(),
-                             joint.translation().z()
-                    }                   }
-                       );
+                        return aLhs[j] < aRhs[j];
+                    } );
+                    track.mBase[j] = ( *min ) [j];
+                    track.mExtent[j] = ( *max ) [j] - ( *min ) [j];
+                }
+            }
+            for ( size_t frame = 0; frame < frame_count; ++frame )
+            {
+                frame_codes[frame] = rotation ? EncodeRotation ( raw[frame] ) : EncodeVector ( raw[frame], track.mBase, track.mExtent );
+                quantized[frame] = rotation ? DecodeRotation ( frame_codes[frame].data() ) : DecodeVector ( frame_codes[frame].data(), track.mBase, track.mExtent );
+            }
+            track.mAnimated = static_cast<uint32_t> ( keys.size() );
+            std::vector<uint16_t>& track_keys = keys.emplace_back ( 1, uint16_t{0} );
+            for ( uint32_t first = 0; first + 1 < frame_count; first += kSegmentFrames )
+            {
+                ReduceKeys ( raw, quantized, first, std::min ( first + kSegmentFrames, frame_count - 1 ), rotation, tolerances[channel], track_keys );
+            }
+            std::vector<uint16_t>& track_codes = codes.emplace_back();
+            track_codes.reserve ( track_keys.size() * 3 );
+            for ( uint16_t key : track_keys )
+            {
+                track_codes.insert ( track_codes.end(), frame_codes[key].begin(), frame_codes[key].end() );
+            }
+        }
+        mTracks = std::move ( tracks );
+        BuildSegments ( keys, codes );
+        mPoses.clear();
+        mPoses.shrink_to_fit();
+        mBoneStride = 0;
+    }
+
+    void Animation::BuildSegments ( const std::vector<std::vector<uint16_t>>& aKeys, const std::vector<std::vector<uint16_t>>& aCodes )
+    {
+        mAnimatedTracks = static_cast<uint32_t> ( aKeys.size() );
+        const uint32_t segment_count = GetSegmentCount ( mFrameCount );
+        mRecords.assign ( static_cast<size_t> ( segment_count ) * mAnimatedTracks, 0 );
+        mSegmentData.clear();
+        std::vector<size_t> first_keys ( mAnimatedTracks, 0 );
+        for ( uint32_t segment = 0; segment < segment_count; ++segment )
+        {
+            const uint32_t first_frame = segment * kSegmentFrames;
+            const uint32_t last_frame = std::min ( first_frame + kSegmentFrames, mFrameCount - 1 );
+            for ( uint32_t track = 0; track < mAnimatedTracks; ++track )
+            {
+                const std::vector<uint16_t>& keys = aKeys[track];
+                const size_t first = first_keys[track];
+                size_t last = first;
+                while ( keys[last] < last_frame )
+                {
+                    ++last;
+                }
+                const auto count = static_cast<uint16_t> ( last - first + 1 );
+                mRecords[segment * mAnimatedTracks + track] = static_cast<uint32_t> ( mSegmentData.size() );
+                mSegmentData.push_back ( count );
+                for ( size_t k = first; k <= last; k += 2 )
+                {
+                    const auto low = static_cast<uint16_t> ( keys[k] - first_frame );
+                    const auto high = static_cast<uint16_t> ( k + 1 <= last ? keys[k + 1] - first_frame : 0 );
+                    // Little-endian, so record_keys[k] reads back the low byte first.
+                    mSegmentData.push_back ( static_cast<uint16_t> ( low | ( high << 8 ) ) );
+                }
+                mSegmentData.insert ( mSegmentData.end(), aCodes[track].begin() + first * 3, aCodes[track].begin() + ( last + 1 ) * 3 );
+                first_keys[track] = last;
             }
         }
     }
 
+    bool Animation::IsCompressed() const
+    {
+        return !mTracks.empty();
+    }
+
+    uint32_t Animation::GetFrameCount() const
+    {
+        return mFrameCount;
+    }
+
+    uint32_t Animation::GetBoneCount() const
+    {
+        return mBoneCount;
+    }
+
+    size_t Animation::GetMemoryUsage() const
+    {
+        size_t size = mPoses.capacity() * sizeof ( float );
+        size += mTracks.capacity() * sizeof ( Track );
+        size += mRecords.capacity() * sizeof ( uint32_t );
+        size += mSegmentData.capacity() * sizeof ( uint16_t );
+        return size;
+    }
+
     void Animation::Unload()
     {
         mVersion = 0;
         mFrameRate = 0;
         mDuration = 0;
-        mFrames.clear();
+        mFrameCount = 0;
+        mBoneCount = 0;
+        mBoneStride = 0;
+        mPoses.clear();
+        mTracks.clear();
+        mAnimatedTracks = 0;
+        mRecords.clear();
+        mSegmentData.clear();
     }
 
     Animation::~Animation() = default;
@@ -110,24 +618,170 @@ namespace AeonGames
          * the fractional part is the interpolation between the initial frame
          * and the next.
         */
-        return fmod ( mFrameRate * fmod ( aTime, mDuration ), mFrames.size() );
+        return fmod ( mFrameRate * fmod ( aTime, mDuration ), mFrameCount );
     }
 
     double Animation::AddTimeToSample ( double aSample, double aTime ) const
     {
-        return fmod ( aSample + ( mFrameRate * fmod ( aTime, mDuration ) ), mFrames.size() );
+        return fmod ( aSample + ( mFrameRate * fmod ( aTime, mDuration ) ), mFrameCount );
+    }
+
+    void Animation::SampleTrack ( const Track& aTrack, bool aRotation, std::span<const uint32_t> aFrames, float* aValues, size_t aFrameStride, size_t aComponentStride ) const
+    {
+        const size_t size = aRotation ? 4 : 3;
+        auto store = [&] ( size_t aFrame, const float* aValue )
+        {
+            for ( size_t j = 0; j < size; ++j )
+            {
+                aValues[aFrame * aFrameStride + j * aComponentStride] = aValue[j];
+            }
+        };
+        if ( aTrack.mAnimated == kConstantTrack )
+        {
+            for ( size_t i = 0; i < aFrames.size(); ++i )
+            {
+                store ( i, aTrack.mBase );
+            }
+            return;
+        }
+        const uint32_t segment_count = GetSegmentCount ( mFrameCount );
+        uint32_t segment = segment_count;
+        uint16_t count{};
+        const uint8_t* keys{};
+        const uint16_t* codes{};
+        auto decode = [&] ( size_t aKey )
+        {
+            return aRotation ? DecodeRotation ( codes + aKey * 3 ) : DecodeVector ( codes + aKey * 3, aTrack.mBase, aTrack.mExtent );
+        };
+        // The frames are consecutive but for wrapping around, so they mostly
+        // share a segment and a key pair or move on to the next key.
+        size_t key{};
+        Value from{};
+        Value to{};
+        bool decoded_to = false;
+        for ( size_t i = 0; i < aFrames.size(); ++i )
+        {
+            const uint32_t frame_segment = std::min ( aFrames[i] / kSegmentFrames, segment_count - 1 );
+            const auto frame = static_cast<uint8_t> ( aFrames[i] - frame_segment * kSegmentFrames );
+            size_t next = key;
+            if ( frame_segment != segment || frame < keys[key] )
+            {
+                segment = frame_segment;
+                const uint16_t* record = mSegmentData.data() + mRecords[segment * mAnimatedTracks + aTrack.mAnimated];
+                count = record[0];
+                keys = reinterpret_cast<const uint8_t*> ( record + 1 );
+                codes = record + 1 + ( count + 1 ) / 2;
+                key = count;
+                // Keys spread evenly over a segment, so start from where the frame would be.
+                next = frame * ( count - 1u ) / kSegmentFrames;
+            }
+            while ( keys[next] > frame )
+            {
+                --next;
+            }
+            while ( next + 1 < count && keys[next + 1] <= frame )
+            {
+                ++next;
+            }
+            if ( next != key )
+            {
+                from = ( next == key + 1 && decoded_to ) ? to : decode ( next );
+                key = next;
+                decoded_to = false;
+            }
+            if ( keys[key] == frame )
+            {
+                store ( i, from.data() );
+                continue;
+            }
+            if ( !decoded_to )
+            {
+                to = decode ( key + 1 );
+                decoded_to = true;
+            }
+            const float interpolation = static_cast<float> ( frame - keys[key] ) / static_cast<float> ( keys[key + 1] - keys[key] );
+            const Value value = aRotation ? NlerpRotation ( from, to, interpolation ) : LerpVector ( from, to, interpolation );
+            store ( i, value.data() );
+        }
     }
 
     const Transform Animation::GetTransform ( size_t aBoneIndex, double aSample ) const
     {
-        double frame;
-        double interpolation = modf ( aSample, &frame );
-        auto frame1 = static_cast<size_t> ( frame );
-        size_t frame2 = ( ( frame1 + 1 ) % mFrames.size() );
-        size_t frame0 = frame1 == 0 ? mFrames.size() - 1 : ( ( frame1 - 1 ) % mFrames.size() );
-        size_t frame3 = ( ( frame1 + 2 ) % mFrames.size() );
-        /// modf should guarantee interpolation to be in the range [0.0,1.0)
-        assert ( ( interpolation >= 0.0 ) && ( interpolation < 1.0 ) && "Interpolation out of range [0.0,1.0)." );
-        return Interpolate ( mFrames[frame0][aBoneIndex], mFrames[frame1][aBoneIndex], mFrames[frame2][aBoneIndex], mFrames[frame3][aBoneIndex], interpolation );
+        std::array<uint32_t, 4> frames;
+        const double interpolation = GetSampleFrames ( aSample, mFrameCount, frames );
+        // Scale, rotation and translation of each frame, as Transform ( const float* ) reads them.
+        float transforms[4][kTransformFloats];
+        if ( !mTracks.empty() )
+        {
+            const Track* tracks = mTracks.data() + aBoneIndex * kBoneTracks;
+            SampleTrack ( tracks[0], false, frames, &transforms[0][0], kTransformFloats, 1 );
+            // Rotations blend between the middle frames only, the outer two reuse theirs.
+            SampleTrack ( tracks[1], true, std::span<const uint32_t> ( frames ).subspan ( 1, 2 ), &transforms[1][3], kTransformFloats, 1 );
+            std::copy_n ( &transforms[1][3], 4, &transforms[0][3] );
+            std::copy_n ( &transforms[2][3], 4, &transforms[3][3] );
+            SampleTrack ( tracks[2], false, frames, &transforms[0][7], kTransformFloats, 1 );
+        }
+        else
+        {
+            for ( size_t i = 0; i < frames.size(); ++i )
+            {
+                const float* pose = mPoses.data() + frames[i] * kTransformFloats * mBoneStride + aBoneIndex;
+                for ( size_t j = 0; j < kTransformFloats; ++j )
+                {
+                    transforms[i][j] = pose[j * mBoneStride];
+                }
+            }
+        }
+        return Interpolate ( Transform{ transforms[0] }, Transform{ transforms[1] }, Transform{ transforms[2] }, Transform{ transforms[3] }, interpolation );
+    }
+
+    void Animation::SamplePose ( double aSample, std::span<Transform> aPose ) const
+    {
+        std::array<uint32_t, 4> frames;
+        const double interpolation = GetSampleFrames ( aSample, mFrameCount, frames );
+        const size_t bone_count = std::min<size_t> ( aPose.size(), mBoneCount );
+        // Compressed tracks decode a block of bones at a time into the raw layout.
+        float block[4][kTransformFloats * kSimdPoseLanes] {};
+        float pose[kTransformFloats * kSimdPoseLanes];
+        for ( size_t first = 0; first < bone_count; first += kSimdPoseLanes )
+        {
+            const size_t lanes = std::min ( kSimdPoseLanes, bone_count - first );
+            const float* rows[4];
+            size_t stride;
+            if ( !mTracks.empty() )
+            {
+                for ( size_t lane = 0; lane < lanes; ++lane )
+                {
+                    const Track* tracks = mTracks.data() + ( first + lane ) * kBoneTracks;
+                    SampleTrack ( tracks[0], false, frames, &block[0][lane], kTransformFloats * kSimdPoseLanes, kSimdPoseLanes );
+                    // Only the second frame's rotation is blended.
+                    SampleTrack ( tracks[1], true, std::span<const uint32_t> ( frames ).subspan ( 1, 1 ), &block[1][3 * kSimdPoseLanes + lane], kTransformFloats * kSimdPoseLanes, kSimdPoseLanes );
+                    SampleTrack ( tracks[2], false, frames, &block[0][7 * kSimdPoseLanes + lane], kTransformFloats * kSimdPoseLanes, kSimdPoseLanes );
+                }
+                for ( size_t i = 0; i < frames.size(); ++i )
+                {
+                    rows[i] = block[i];
+                }
+                stride = kSimdPoseLanes;
+            }
+            else
+            {
+                for ( size_t i = 0; i < frames.size(); ++i )
+                {
+                    rows[i] = mPoses.data() + frames[i] * kTransformFloats * mBoneStride + first;
+                }
+                stride = mBoneStride;
+            }
+            SimdInterpolatePose ( rows, stride, interpolation, pose );
+            for ( size_t lane = 0; lane < lanes; ++lane )
+            {
+                float transform[kTransformFloats];
+                for ( size_t j = 0; j < kTransformFloats; ++j )
+                {
+                    transform[j] = pose[j * kSimdPoseLanes + lane];
+                }
+                aPose[first + lane] = Transform{ transform };
+            }
+        }
     }
 }
@@ -0,0 +1,169 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include "aeongames/AnimationLod.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Skeleton.hpp"
+#include "aeongames/Vector3.hpp"
+
+namespace AeonGames
+{
+    AnimationLod::AnimationLod() = default;
+    AnimationLod::~AnimationLod() = default;
+
+    const std::vector<AnimationLodLevel>& AnimationLod::GetRecommendedLevels()
+    {
+        // Full rate while a quarter of the view tall, then halving the rate
+        // and shedding a joint per leaf chain as the instance shrinks.
+        static const std::vector<AnimationLodLevel> levels
+        {
+            { 0.25f, 1, 0 },
+            { 0.1f, 2, 1 },
+            { 0.03f, 4, 2 },
+            { 0.0f, 8, 3 },
+        };
+        return levels;
+    }
+
+    void AnimationLod::SetLevels ( std::vector<AnimationLodLevel> aLevels )
+    {
+        mLevels = std::move ( aLevels );
+        mLevel = 0;
+        Reset();
+    }
+
+    const std::vector<AnimationLodLevel>& AnimationLod::GetLevels() const
+    {
+        return mLevels;
+    }
+
+    bool AnimationLod::Advance ( float aScreenSize, double aDelta, bool aSample )
+    {
+        mTimeSinceSample += aDelta;
+        if ( mLevels.empty() )
+        {
+            return true;
+        }
+        mLevel = 0;
+        while ( mLevel + 1 < mLevels.size() && aScreenSize < mLevels[mLevel].mScreenSize )
+        {
+            ++mLevel;
+        }
+        ++mUpdatesSinceSample;
+        if ( aSample || mStoredSamples < 2 || mUpdatesSinceSample >= mLevels[mLevel].mUpdateInterval )
+        {
+            mUpdatesSinceSample = 0;
+            return true;
+        }
+        return false;
+    }
+
+    size_t AnimationLod::GetLevel() const
+    {
+        return mLevel;
+    }
+
+    uint32_t AnimationLod::GetCulledBoneHeight() const
+    {
+        return mLevels.empty() ? 0 : mLevels[mLevel].mCulledBoneHeight;
+    }
+
+    std::span<const uint16_t> AnimationLod::GetBoneMap ( const Skeleton& aSkeleton )
+    {
+        const std::vector<Skeleton::Joint>& joints = aSkeleton.GetJoints();
+        const uint32_t height = GetCulledBoneHeight();
+        if ( &aSkeleton != mMappedSkeleton || joints.size() != mJointHeights.size() )
+        {
+            // Joints may come in any order, so walk up from every joint
+            // rather than relying on parents preceding their children.
+            mJointHeights.assign ( joints.size(), 0 );
+            for ( const Skeleton::Joint& joint : joints )
+            {
+                uint16_t links = 1;
+                for ( const Skeleton::Joint* parent = joint.GetParent(); parent != nullptr; parent = parent->GetParent(), ++links )
+                {
+                    uint16_t& parent_height = mJointHeights[parent - joints.data()];
+                    parent_height = std::max ( parent_height, links );
+                }
+            }
+            mMappedSkeleton = &aSkeleton;
+            mMappedHeight = ~0u;
+        }
+        if ( height != mMappedHeight )
+        {
+            mBoneMap.resize ( joints.size() );
+            for ( size_t i = 0; i < joints.size(); ++i )
+            {
+                // Roots are always kept so every joint has somewhere to go.
+                const Skeleton::Joint* kept = &joints[i];
+                while ( kept->GetParent() != nullptr && mJointHeights[kept - joints.data()] < height )
+                {
+                    kept = kept->GetParent();
+                }
+                mBoneMap[i] = static_cast<uint16_t> ( kept - joints.data() );
+            }
+            mMappedHeight = height;
+        }
+        return mBoneMap;
+    }
+
+    void AnimationLod::Store ( std::span<const float> aMatrices )
+    {
+        if ( mLevels.empty() )
+        {
+            return;
+        }
+        mPreviousSample.swap ( mLastSample );
+        mLastSample.assign ( aMatrices.begin(), aMatrices.end() );
+        // A sample of a different skeleton does not extrapolate from the last one.
+        mStoredSamples = ( mPreviousSample.size() == mLastSample.size() ) ? std::min ( mStoredSamples + 1, 2u ) : 1u;
+        mSampleInterval = mTimeSinceSample;
+        mTimeSinceSample = 0.0;
+    }
+
+    void AnimationLod::Extrapolate ( std::span<float> aMatrices ) const
+    {
+        assert ( mStoredSamples == 2 && aMatrices.size() == mLastSample.size() );
+        const float step = ( mSampleInterval > 0.0 ) ? static_cast<float> ( std::min ( mTimeSinceSample / mSampleInterval, 1.0 ) ) : 0.0f;
+        for ( size_t i = 0; i < aMatrices.size(); ++i )
+        {
+            aMatrices[i] = mLastSample[i] + ( mLastSample[i] - mPreviousSample[i] ) * step;
+        }
+    }
+
+    void AnimationLod::Reset()
+    {
+        mStoredSamples = 0;
+        mUpdatesSinceSample = 0;
+        mTimeSinceSample = 0.0;
+        mSampleInterval = 0.0;
+    }
+
+    float GetProjectedSize ( const AABB& aBounds, const Matrix4x4& aView, float aFieldOfView )
+    {
+        const float radius = aBounds.GetRadii().GetLength();
+        const float distance = ( aView * aBounds.GetCenter() ).GetLength();
+        if ( distance <= radius )
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        return radius / ( distance * std::tan ( aFieldOfView * static_cast<float> ( M_PI ) / 360.0f ) );
+    }
+}
@@ -0,0 +1,441 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+#include <vector>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <climits>
+#endif
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define AEONGAMES_HAS_IO_URING 1
+#endif
+#include "BatchRead.h"
+#include "aeongames/JobSystem.hpp"
+
+namespace AeonGames
+{
+#if defined(AEONGAMES_HAS_IO_URING)
+    static constexpr BatchReadBackend kBestBackend = BatchReadBackend::IoUring;
+#elif !defined(_WIN32)
+    static constexpr BatchReadBackend kBestBackend = BatchReadBackend::Preadv;
+#else
+    static constexpr BatchReadBackend kBestBackend = BatchReadBackend::Stream;
+#endif
+    static std::atomic<BatchReadBackend> gBatchReadBackend{kBestBackend};
+
+#if !defined(_WIN32)
+    namespace
+    {
+        /** Ranges adjacent on disk, read by one vectored call. Reads past
+            0x7ffff000 bytes come back short on Linux, which is handled like
+            any other short read. */
+        struct ReadRun
+        {
+            uint64_t mOffset;
+            size_t mFirstVector;
+            size_t mVectorCount;
+            size_t mSize;
+        };
+
+        /// Splits sorted ranges into runs; every range gets one iovec.
+        void BuildRuns ( std::span<const FileRange> aRanges, std::vector<iovec>& aVectors, std::vector<ReadRun>& aRuns )
+        {
+            aVectors.reserve ( aRanges.size() );
+            for ( const FileRange& range : aRanges )
+            {
+                if ( range.mSize == 0 )
+                {
+                    continue;
+                }
+                ReadRun* run = aRuns.empty() ? nullptr : &aRuns.back();
+                if ( run == nullptr || run->mOffset + run->mSize != range.mOffset || run->mVectorCount == IOV_MAX )
+                {
+                    run = &aRuns.emplace_back ( ReadRun{range.mOffset, aVectors.size(), 0, 0} );
+                }
+                aVectors.push_back ( iovec{range.mBuffer, range.mSize} );
+                ++run->mVectorCount;
+                run->mSize += range.mSize;
+            }
+        }
+
+        /** Reads what is left of a run after @p aDone bytes, looping over short reads.
+            @return 0 on success or an errno value. */
+        int FinishRun ( int aFile, const ReadRun& aRun, const iovec* aVectors, size_t aDone )
+        {
+            std::vector<iovec> remaining{};
+            size_t first = 0;
+            size_t skip = aDone;
+            while ( aDone < aRun.mSize )
+            {
+                const iovec* vectors = aVectors;
+                int count = static_cast<int> ( aRun.mVectorCount );
+                if ( aDone != 0 )
+                {
+                    // Short read: drop what arrived from the front of a copy of the vectors.
+                    if ( remaining.empty() )
+                    {
+                        remaining.assign ( aVectors, aVectors + aRun.mVectorCount );
+                    }
+                    while ( skip >= remaining[first].iov_len )
+                    {
+                        skip -= remaining[first].iov_len;
+                        ++first;
+                    }
+                    remaining[first].iov_base = static_cast<uint8_t*> ( remaining[first].iov_base ) + skip;
+                    remaining[first].iov_len -= skip;
+                    vectors = remaining.data() + first;
+                    count = static_cast<int> ( remaining.size() - first );
+                }
+                skip = 0;
+                const ssize_t result = preadv ( aFile, vectors, count, static_cast<off_t> ( aRun.mOffset + aDone ) );
+                if ( result < 0 )
+                {
+                    if ( errno == EINTR )
+                    {
+                        continue;
+                    }
+                    return errno;
+                }
+                if ( result == 0 )
+                {
+                    // The package is shorter than its directory claims.
+                    return EIO;
+                }
+                aDone += static_cast<size_t> ( result );
+                skip = static_cast<size_t> ( result );
+            }
+            return 0;
+        }
+
+        void ReadRunsWithPreadv ( int aFile, const std::vector<iovec>& aVectors, const std::vector<ReadRun>& aRuns )
+        {
+            std::atomic<int> error{0};
+            // A level load is not a frame, blocking the workers on disk is what it is for.
+            GetJobSystem().ParallelFor ( 0, aRuns.size(), 1, [&] ( size_t aBegin, size_t aEnd )
+            {
+                for ( size_t i = aBegin; i < aEnd; ++i )
+                {
+                    if ( const int result = FinishRun ( aFile, aRuns[i], aVectors.data() + aRuns[i].mFirstVector, 0 ) )
+                    {
+                        int expected = 0;
+                        error.compare_exchange_strong ( expected, result );
+                    }
+                }
+            } );
+            if ( error.load() != 0 )
+            {
+                throw std::system_error ( error.load(), std::generic_category(), "Package read failed" );
+            }
+        }
+    }
+#endif
+
+#if defined(AEONGAMES_HAS_IO_URING)
+    namespace
+    {
+        /** Minimal io_uring submission and completion rings, set up with the
+            raw system calls so there is no liburing dependency. */
+        class IoUring
+        {
+        public:
+            explicit IoUring ( unsigned aEntries )
+            {
+                Setup ( aEntries );
+            }
+            ~IoUring()
+            {
+                Release ( mSqes ? static_cast<void*> ( mSqes ) : MAP_FAILED );
+            }
+            IoUring ( const IoUring& ) = delete;
+            IoUring& operator= ( const IoUring& ) = delete;
+
+            bool IsValid() const
+            {
+                return mSqes != nullptr;
+            }
+
+            /** Keeps up to the ring size of runs in flight until all completed.
+                Short or failed reads are finished with preadv. Never returns
+                while a read is in flight, the kernel writes into aVectors.
+                @return 0 on success or an errno value. */
+            int Read ( int aFile, const std::vector<iovec>& aVectors, const std::vector<ReadRun>& aRuns )
+            {
+                size_t next = 0;
+                size_t completed = 0;
+                unsigned in_flight = 0;
+                unsigned unsubmitted = 0;
+                int error = 0;
+                while ( completed < aRuns.size() )
+                {
+                    unsigned tail = *mSqTail;
+                    while ( next < aRuns.size() && in_flight < mEntries )
+                    {
+                        const unsigned index = tail & mSqMask;
+                        io_uring_sqe& sqe = mSqes[index];
+                        sqe = io_uring_sqe{};
+                        sqe.opcode = IORING_OP_READV;
+                        sqe.fd = aFile;
+                        sqe.off = aRuns[next].mOffset;
+                        sqe.addr = reinterpret_cast<uint64_t> ( aVectors.data() + aRuns[next].mFirstVector );
+                        sqe.len = static_cast<uint32_t> ( aRuns[next].mVectorCount );
+                        sqe.user_data = next;
+                        mSqArray[index] = index;
+                        ++tail;
+                        ++next;
+                        ++in_flight;
+                        ++unsubmitted;
+                    }
+                    std::atomic_ref<unsigned> ( *mSqTail ).store ( tail, std::memory_order_release );
+                    const long submitted = syscall ( __NR_io_uring_enter, mFile, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0 );
+                    if ( submitted < 0 )
+                    {
+                        if ( errno == EINTR || errno == EAGAIN || errno == EBUSY )
+                        {
+                            continue;
+                        }
+                        return Abort ( errno, in_flight );
+                    }
+                    unsubmitted -= static_cast<unsigned> ( submitted );
+                    Reap ( [&] ( const io_uring_cqe & cqe )
+                    {
+                        const ReadRun& run = aRuns[static_cast<size_t> ( cqe.user_data )];
+                        if ( cqe.res < 0 || static_cast<size_t> ( cqe.res ) != run.mSize )
+                        {
+                            const int result = FinishRun ( aFile, run, aVectors.data() + run.mFirstVector, cqe.res < 0 ? 0 : static_cast<size_t> ( cqe.res ) );
+                            error = error ? error : result;
+                        }
+                        --in_flight;
+                        ++completed;
+                    } );
+                }
+                return error;
+            }
+        private:
+            void Setup ( unsigned aEntries )
+            {
+                mRequestedEntries = aEntries;
+                io_uring_params params{};
+                mFile = static_cast<int> ( syscall ( __NR_io_uring_setup, aEntries, &params ) );
+                if ( mFile < 0 )
+                {
+                    // Old kernel, or disabled by a seccomp policy.
+                    return;
+                }
+                mEntries = params.sq_entries;
+                mSqRingSize = params.sq_off.array + params.sq_entries * sizeof ( unsigned );
+                mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof ( io_uring_cqe );
+                if ( params.features & IORING_FEAT_SINGLE_MMAP )
+                {
+                    mSqRingSize = mCqRingSize = std::max ( mSqRingSize, mCqRingSize );
+                }
+                mSqRing = mmap ( nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFile, IORING_OFF_SQ_RING );
+                mCqRing = ( params.features & IORING_FEAT_SINGLE_MMAP ) ? mSqRing :
+                          mmap ( nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFile, IORING_OFF_CQ_RING );
+                mSqesSize = params.sq_entries * sizeof ( io_uring_sqe );
+                void* sqes = mmap ( nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFile, IORING_OFF_SQES );
+                if ( mSqRing == MAP_FAILED || mCqRing == MAP_FAILED || sqes == MAP_FAILED )
+                {
+                    Release ( sqes );
+                    return;
+                }
+                uint8_t* sq = static_cast<uint8_t*> ( mSqRing );
+                uint8_t* cq = static_cast<uint8_t*> ( mCqRing );
+                mSqHead = reinterpret_cast<unsigned*> ( sq + params.sq_off.head );
+                mSqTail = reinterpret_cast<unsigned*> ( sq + params.sq_off.tail );
+                mSqMask = *reinterpret_cast<unsigned*> ( sq + params.sq_off.ring_mask );
+                mSqArray = reinterpret_cast<unsigned*> ( sq + params.sq_off.array );
+                mCqHead = reinterpret_cast<unsigned*> ( cq + params.cq_off.head );
+                mCqTail = reinterpret_cast<unsigned*> ( cq + params.cq_off.tail );
+                mCqMask = *reinterpret_cast<unsigned*> ( cq + params.cq_off.ring_mask );
+                mCqes = reinterpret_cast<io_uring_cqe*> ( cq + params.cq_off.cqes );
+                mSqes = static_cast<io_uring_sqe*> ( sqes );
+            }
+
+            /// Calls @p aCompletion for every completion posted so far and retires them.
+            template<class F>
+            void Reap ( F&& aCompletion )
+            {
+                unsigned head = *mCqHead;
+                const unsigned cq_tail = std::atomic_ref<unsigned> ( *mCqTail ).load ( std::memory_order_acquire );
+                for ( ; head != cq_tail; ++head )
+                {
+                    aCompletion ( mCqes[head & mCqMask] );
+                }
+                std::atomic_ref<unsigned> ( *mCqHead ).store ( head, std::memory_order_release );
+            }
+
+            /** Stops submitting after io_uring_enter failed and waits out the
+                reads already in flight, so none outlives the batch and no stale
+                completion reaches the next one. If the ring cannot even be
+                waited on it is torn down, which cancels what it still holds,
+                and set up anew.
+                @return @p aError. */
+            int Abort ( int aError, unsigned aInFlight )
+            {
+                // Take back what the kernel has not consumed, it never will be now.
+                const unsigned head = std::atomic_ref<unsigned> ( *mSqHead ).load ( std::memory_order_acquire );
+                const unsigned tail = *mSqTail;
+                aInFlight -= tail - head;
+                std::atomic_ref<unsigned> ( *mSqTail ).store ( head, std::memory_order_release );
+                while ( aInFlight != 0 )
+                {
+                    if ( syscall ( __NR_io_uring_enter, mFile, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0 ) < 0 &&
+                         errno != EINTR && errno != EAGAIN && errno != EBUSY )
+                    {
+                        Release ( mSqes );
+                        Setup ( mRequestedEntries );
+                        return aError;
+                    }
+                    Reap ( [&aInFlight] ( const io_uring_cqe & )
+                    {
+                        --aInFlight;
+                    } );
+                }
+                return aError;
+            }
+
+            void Release ( void* aSqes )
+            {
+                if ( aSqes != MAP_FAILED && aSqes != nullptr )
+                {
+                    munmap ( aSqes, mSqesSize );
+                }
+                if ( mCqRing != MAP_FAILED && mCqRing != nullptr && mCqRing != mSqRing )
+                {
+                    munmap ( mCqRing, mCqRingSize );
+                }
+                if ( mSqRing != MAP_FAILED && mSqRing != nullptr )
+                {
+                    munmap ( mSqRing, mSqRingSize );
+                }
+                if ( mFile >= 0 )
+                {
+                    close ( mFile );
+                }
+                mSqRing = mCqRing = nullptr;
+                mSqes = nullptr;
+                mFile = -1;
+            }
+            int mFile{-1};
+            unsigned mRequestedEntries{0};
+            unsigned mEntries{0};
+            size_t mSqRingSize{0};
+            size_t mCqRingSize{0};
+            size_t mSqesSize{0};
+            void* mSqRing{nullptr};
+            void* mCqRing{nullptr};
+            unsigned* mSqHead{nullptr};
+            unsigned* mSqTail{nullptr};
+            unsigned mSqMask{0};
+            unsigned* mSqArray{nullptr};
+            unsigned* mCqHead{nullptr};
+            unsigned* mCqTail{nullptr};
+            unsigned mCqMask{0};
+            io_uring_cqe* mCqes{nullptr};
+            io_uring_sqe* mSqes{nullptr};
+        };
+
+        /// Enough requests in flight to keep an NVMe queue busy.
+        constexpr unsigned kIoUringEntries = 64;
+
+        /// One ring per thread, created on the first batch; null if the kernel refused.
+        IoUring* GetThreadIoUring()
+        {
+            thread_local IoUring ring{kIoUringEntries};
+            return ring.IsValid() ? &ring : nullptr;
+        }
+    }
+#endif
+
+    BatchReadBackend GetBatchReadBackend()
+    {
+        return gBatchReadBackend.load ( std::memory_order_relaxed );
+    }
+
+    void SetBatchReadBackend ( BatchReadBackend aBackend )
+    {
+        gBatchReadBackend.store ( std::max ( aBackend, kBestBackend ), std::memory_order_relaxed );
+    }
+
+    void ReadFileRanges ( const std::filesystem::path& aPath, std::span<FileRange> aRanges )
+    {
+        std::sort ( aRanges.begin(), aRanges.end(), [] ( const FileRange & a, const FileRange & b )
+        {
+            return a.mOffset < b.mOffset;
+        } );
+        const BatchReadBackend backend = GetBatchReadBackend();
+#if !defined(_WIN32)
+        if ( backend != BatchReadBackend::Stream )
+        {
+            const int file = open ( aPath.c_str(), O_RDONLY | O_CLOEXEC );
+            if ( file < 0 )
+            {
+                throw std::system_error ( errno, std::generic_category(), "Could not open " + aPath.string() );
+            }
+            std::vector<iovec> vectors;
+            std::vector<ReadRun> runs;
+            BuildRuns ( aRanges, vectors, runs );
+            try
+            {
+#if defined(AEONGAMES_HAS_IO_URING)
+                IoUring* ring = ( backend == BatchReadBackend::IoUring ) ? GetThreadIoUring() : nullptr;
+                if ( ring != nullptr )
+                {
+                    if ( const int error = ring->Read ( file, vectors, runs ) )
+                    {
+                        throw std::system_error ( error, std::generic_category(), "Package read failed" );
+                    }
+                }
+                else
+#endif
+                {
+                    ReadRunsWithPreadv ( file, vectors, runs );
+                }
+            }
+            catch ( ... )
+            {
+                close ( file );
+                throw;
+            }
+            close ( file );
+            return;
+        }
+#endif
+        std::ifstream file ( aPath, std::ios::in | std::ios::binary );
+        if ( !file.is_open() )
+        {
+            throw std::system_error ( std::make_error_code ( std::errc::no_such_file_or_directory ), "Could not open " + aPath.string() );
+        }
+        for ( const FileRange& range : aRanges )
+        {
+            file.seekg ( static_cast<std::streamoff> ( range.mOffset ), std::ios::beg );
+            file.read ( static_cast<char*> ( range.mBuffer ), static_cast<std::streamsize> ( range.mSize ) );
+            if ( !file )
+            {
+                throw std::system_error ( std::make_error_code ( std::errc::io_error ), "Package read failed" );
+            }
+        }
+    }
+}
@@ -0,0 +1,358 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "zlib.h"
+#if defined(AEONGAMES_HAS_ZSTD)
+#include "zstd.h"
+#include "zdict.h"
+#endif
+#if defined(AEONGAMES_HAS_LZ4)
+#include "lz4.h"
+#include "lz4hc.h"
+#endif
+#include "Compression.h"
+#include "aeongames/Package.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /** Inflate a whole zlib stream into `aBuffer`. The input is usually
+            a view into the package mapping, so it is inflated in place
+            without staging. */
+        bool InflateBuffer ( std::span<const uint8_t> aInput, void* aBuffer, size_t aBufferSize )
+        {
+            z_stream strm{};
+            strm.zalloc = Z_NULL;
+            strm.zfree = Z_NULL;
+            strm.opaque = Z_NULL;
+            int ret = inflateInit ( &strm );
+            if ( ret != Z_OK )
+            {
+                return false;
+            }
+            strm.next_out = static_cast<Bytef*> ( aBuffer );
+            strm.avail_out = static_cast<uInt> ( std::min<uint64_t> ( aBufferSize, std::numeric_limits<uInt>::max() ) );
+            uint64_t remaining = aInput.size();
+            do
+            {
+                // zlib counts in uInt, feed payloads over 4 GiB piecewise.
+                if ( strm.avail_in == 0 )
+                {
+                    strm.next_in = const_cast<Bytef*> ( aInput.data() + ( aInput.size() - remaining ) );
+                    strm.avail_in = static_cast<uInt> ( std::min<uint64_t> ( remaining, std::numeric_limits<uInt>::max() ) );
+                    remaining -= strm.avail_in;
+                }
+                ret = inflate ( &strm, ( remaining == 0 ) ? Z_FINISH : Z_NO_FLUSH );
+                if ( ret == Z_OK && strm.avail_out == 0 && ( strm.avail_in > 0 || remaining > 0 ) )
+                {
+                    // Caller buffer is full but more compressed input remains.
+                    ret = Z_BUF_ERROR;
+                }
+            }
+            while ( ret == Z_OK && ( strm.avail_in > 0 || remaining > 0 ) );
+            inflateEnd ( &strm );
+            return ret == Z_STREAM_END || ret == Z_OK;
+        }
+
+        bool DeflateBuffer ( std::span<const uint8_t> aInput, int aLevel, std::vector<uint8_t>& aOutput )
+        {
+            z_stream strm{};
+            strm.zalloc = Z_NULL;
+            strm.zfree = Z_NULL;
+            strm.opaque = Z_NULL;
+            if ( deflateInit ( &strm, aLevel ) != Z_OK )
+            {
+                return false;
+            }
+            aOutput.resize ( std::max<size_t> ( aInput.size() / 2, 4096 ) );
+            size_t produced = 0;
+            uint64_t remaining = aInput.size();
+            int ret = Z_OK;
+            do
+            {
+                if ( strm.avail_in == 0 && remaining > 0 )
+                {
+                    strm.next_in = const_cast<Bytef*> ( aInput.data() + ( aInput.size() - remaining ) );
+                    strm.avail_in = static_cast<uInt> ( std::min<uint64_t> ( remaining, std::numeric_limits<uInt>::max() ) );
+                    remaining -= strm.avail_in;
+                }
+                if ( produced == aOutput.size() )
+                {
+                    aOutput.resize ( aOutput.size() * 2 );
+                }
+                strm.next_out = aOutput.data() + produced;
+                strm.avail_out = static_cast<uInt> ( std::min<size_t> ( aOutput.size() - produced, std::numeric_limits<uInt>::max() ) );
+                const uInt available = strm.avail_out;
+                ret = deflate ( &strm, ( remaining == 0 ) ? Z_FINISH : Z_NO_FLUSH );
+                produced += available - strm.avail_out;
+            }
+            while ( ret == Z_OK || ret == Z_BUF_ERROR );
+            deflateEnd ( &strm );
+            aOutput.resize ( produced );
+            return ret == Z_STREAM_END;
+        }
+
+#if defined(AEONGAMES_HAS_ZSTD)
+        using ZstdDecompressionContext = std::unique_ptr<ZSTD_DCtx, decltype ( &ZSTD_freeDCtx ) >;
+        using ZstdCompressionContext = std::unique_ptr<ZSTD_CCtx, decltype ( &ZSTD_freeCCtx ) >;
+        using ZstdCompressionDictionary = std::unique_ptr<ZSTD_CDict, decltype ( &ZSTD_freeCDict ) >;
+
+        /** Dictionary digested for the last CompressBuffer call on this
+            thread; a pack compresses every small entry with the same one. */
+        struct ZstdCompressionDictionaryCache
+        {
+            const uint8_t* mData{};
+            size_t mSize{};
+            int mLevel{};
+            ZstdCompressionDictionary mDictionary{nullptr, &ZSTD_freeCDict};
+        };
+
+        bool ZstdCompress ( std::span<const uint8_t> aInput, int aLevel, std::vector<uint8_t>& aOutput, std::span<const uint8_t> aDictionary )
+        {
+            thread_local ZstdCompressionContext context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+            thread_local ZstdCompressionDictionaryCache cache{};
+            if ( !context )
+            {
+                return false;
+            }
+            aOutput.resize ( ZSTD_compressBound ( aInput.size() ) );
+            size_t result;
+            if ( aDictionary.empty() )
+            {
+                result = ZSTD_compressCCtx ( context.get(), aOutput.data(), aOutput.size(), aInput.data(), aInput.size(), aLevel );
+            }
+            else
+            {
+                if ( !cache.mDictionary || cache.mData != aDictionary.data() || cache.mSize != aDictionary.size() || cache.mLevel != aLevel )
+                {
+                    cache.mDictionary.reset ( ZSTD_createCDict ( aDictionary.data(), aDictionary.size(), aLevel ) );
+                    cache.mData = aDictionary.data();
+                    cache.mSize = aDictionary.size();
+                    cache.mLevel = aLevel;
+                }
+                if ( !cache.mDictionary )
+                {
+                    return false;
+                }
+                result = ZSTD_compress_usingCDict ( context.get(), aOutput.data(), aOutput.size(), aInput.data(), aInput.size(), cache.mDictionary.get() );
+            }
+            if ( ZSTD_isError ( result ) )
+            {
+                return false;
+            }
+            aOutput.resize ( result );
+            return true;
+        }
+
+        bool ZstdDecompress ( std::span<const uint8_t> aInput, void* aBuffer, size_t aBufferSize, const CompressionDictionary* aDictionary )
+        {
+            thread_local ZstdDecompressionContext context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+            if ( !context )
+            {
+                return false;
+            }
+            size_t result;
+            if ( const unsigned dictionary_id = ZSTD_getDictID_fromFrame ( aInput.data(), aInput.size() ) )
+            {
+                if ( aDictionary == nullptr || aDictionary->GetId() != dictionary_id )
+                {
+                    return false;
+                }
+                result = ZSTD_decompress_usingDDict ( context.get(), aBuffer, aBufferSize, aInput.data(), aInput.size(),
+                                                      static_cast<const ZSTD_DDict*> ( aDictionary->GetHandle() ) );
+            }
+            else
+            {
+                result = ZSTD_decompressDCtx ( context.get(), aBuffer, aBufferSize, aInput.data(), aInput.size() );
+            }
+            return !ZSTD_isError ( result );
+        }
+#endif
+
+#if defined(AEONGAMES_HAS_LZ4)
+        bool Lz4Compress ( std::span<const uint8_t> aInput, int aLevel, std::vector<uint8_t>& aOutput )
+        {
+            // The block format counts in int, larger entries need another codec.
+            if ( aInput.size() > LZ4_MAX_INPUT_SIZE )
+            {
+                return false;
+            }
+            const int input_size = static_cast<int> ( aInput.size() );
+            aOutput.resize ( static_cast<size_t> ( LZ4_compressBound ( input_size ) ) );
+            const char* source = reinterpret_cast<const char*> ( aInput.data() );
+            char* destination = reinterpret_cast<char*> ( aOutput.data() );
+            const int capacity = static_cast<int> ( aOutput.size() );
+            const int result = ( aLevel > 0 ) ?
+                               LZ4_compress_HC ( source, destination, input_size, capacity, aLevel ) :
+                               LZ4_compress_default ( source, destination, input_size, capacity );
+            if ( result <= 0 && input_size > 0 )
+            {
+                return false;
+            }
+            aOutput.resize ( static_cast<size_t> ( result ) );
+            return true;
+        }
+
+        bool Lz4Decompress ( std::span<const uint8_t> aInput, void* aBuffer, size_t aBufferSize )
+        {
+            if ( aInput.size() > static_cast<size_t> ( INT_MAX ) )
+            {
+                return false;
+            }
+            return LZ4_decompress_safe ( reinterpret_cast<const char*> ( aInput.data() ), static_cast<char*> ( aBuffer ),
+                                         static_cast<int> ( aInput.size() ), static_cast<int> ( std::min<size_t> ( aBufferSize, INT_MAX ) ) ) >= 0;
+        }
+#endif
+    }
+
+    CompressionDictionary::CompressionDictionary ( std::span<const uint8_t> aDictionary )
+    {
+#if defined(AEONGAMES_HAS_ZSTD)
+        ZSTD_DDict* dictionary = ZSTD_createDDict ( aDictionary.data(), aDictionary.size() );
+        if ( dictionary == nullptr )
+        {
+            throw std::runtime_error ( "Invalid zstd dictionary." );
+        }
+        mHandle = dictionary;
+        mId = ZSTD_getDictID_fromDDict ( dictionary );
+#else
+        ( void ) aDictionary;
+        throw std::runtime_error ( "zstd dictionaries are not supported by this build." );
+#endif
+    }
+
+    CompressionDictionary::~CompressionDictionary()
+    {
+#if defined(AEONGAMES_HAS_ZSTD)
+        ZSTD_freeDDict ( static_cast<ZSTD_DDict*> ( mHandle ) );
+#endif
+    }
+
+    uint32_t CompressionDictionary::GetId() const
+    {
+        return mId;
+    }
+
+    bool IsCompressionSupported ( uint8_t aCompression )
+    {
+        switch ( aCompression )
+        {
+        case NONE:
+        case ZLIB:
+            return true;
+#if defined(AEONGAMES_HAS_ZSTD)
+        case ZSTD:
+            return true;
+#endif
+#if defined(AEONGAMES_HAS_LZ4)
+        case LZ4:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    const char* GetCompressionName ( uint8_t aCompression )
+    {
+        switch ( aCompression )
+        {
+        case NONE:
+            return "raw";
+        case ZLIB:
+            return "zlib";
+        case ZSTD:
+            return "zstd";
+        case LZ4:
+            return "lz4";
+        default:
+            return "unknown";
+        }
+    }
+
+    bool CompressBuffer ( uint8_t aCompression, std::span<const uint8_t> aInput, int aLevel,
+                          std::vector<uint8_t>& aOutput, std::span<const uint8_t> aDictionary )
+    {
+        switch ( aCompression )
+        {
+        case NONE:
+            aOutput.assign ( aInput.begin(), aInput.end() );
+            return true;
+        case ZLIB:
+            return aDictionary.empty() && DeflateBuffer ( aInput, aLevel, aOutput );
+#if defined(AEONGAMES_HAS_ZSTD)
+        case ZSTD:
+            return ZstdCompress ( aInput, aLevel, aOutput, aDictionary );
+#endif
+#if defined(AEONGAMES_HAS_LZ4)
+        case LZ4:
+            return aDictionary.empty() && Lz4Compress ( aInput, aLevel, aOutput );
+#endif
+        default:
+            return false;
+        }
+    }
+
+    bool DecompressBuffer ( uint8_t aCompression, std::span<const uint8_t> aInput,
+                            void* aBuffer, size_t aBufferSize,
+                            const CompressionDictionary* aDictionary )
+    {
+        switch ( aCompression )
+        {
+        case ZLIB:
+            return InflateBuffer ( aInput, aBuffer, aBufferSize );
+#if defined(AEONGAMES_HAS_ZSTD)
+        case ZSTD:
+            return ZstdDecompress ( aInput, aBuffer, aBufferSize, aDictionary );
+#endif
+#if defined(AEONGAMES_HAS_LZ4)
+        case LZ4:
+            return Lz4Decompress ( aInput, aBuffer, aBufferSize );
+#endif
+        default:
+            ( void ) aDictionary;
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> TrainCompressionDictionary ( std::span<const std::span<const uint8_t>> aSamples, size_t aCapacity )
+    {
+        std::vector<uint8_t> dictionary;
+#if defined(AEONGAMES_HAS_ZSTD)
+        std::vector<uint8_t> samples;
+        std::vector<size_t> sizes;
+        sizes.reserve ( aSamples.size() );
+        for ( const std::span<const uint8_t>& sample : aSamples )
+        {
+            samples.insert ( samples.end(), sample.begin(), sample.end() );
+            sizes.push_back ( sample.size() );
+        }
+        dictionary.resize ( aCapacity );
+        const size_t size = ZDICT_trainFromBuffer ( dictionary.data(), dictionary.size(), samples.data(), sizes.data(), static_cast<unsigned> ( sizes.size() ) );
+        dictionary.resize ( ZDICT_isError ( size ) ? 0 : size );
+#else
+        ( void ) aSamples;
+        ( void ) aCapacity;
+#endif
+        return dictionary;
+    }
+}
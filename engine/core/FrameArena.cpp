@@ -0,0 +1,142 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "aeongames/FrameArena.hpp"
+#include "aeongames/AllocationCounter.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// @brief Main block size of arenas created from now on.
+        std::atomic<size_t> gFrameArenaCapacity{ 1024 * 1024 };
+        /// @brief Every live thread arena, so ResetFrameArenas can reach them all.
+        std::mutex gFrameArenasMutex{};
+        std::vector<FrameArena*> gFrameArenas{};
+
+        /// @brief Owns a thread's arena and keeps it registered while the thread lives.
+        struct ThreadFrameArena
+        {
+            ThreadFrameArena() : mArena{ gFrameArenaCapacity.load() }
+            {
+                std::lock_guard<std::mutex> lock ( gFrameArenasMutex );
+                gFrameArenas.push_back ( &mArena );
+            }
+            ~ThreadFrameArena()
+            {
+                std::lock_guard<std::mutex> lock ( gFrameArenasMutex );
+                gFrameArenas.erase ( std::find ( gFrameArenas.begin(), gFrameArenas.end(), &mArena ) );
+            }
+            FrameArena mArena;
+        };
+
+        size_t AlignUp ( size_t aValue, size_t aAlignment )
+        {
+            return ( aValue + aAlignment - 1 ) & ~ ( aAlignment - 1 );
+        }
+    }
+
+    FrameArena::FrameArena ( size_t aCapacity ) :
+        mBlock{ std::make_unique<std::byte[]> ( aCapacity ) },
+        mCapacity{aCapacity}
+    {
+    }
+
+    FrameArena::~FrameArena() = default;
+
+    void* FrameArena::Allocate ( size_t aSize, size_t aAlignment )
+    {
+        // The block comes from operator new[], aligned for any fundamental
+        // type, so aligning the offset aligns the address.
+        const size_t offset = AlignUp ( mOffset, aAlignment );
+        if ( offset + aSize <= mCapacity && aAlignment <= alignof ( std::max_align_t ) )
+        {
+            mOffset = offset + aSize;
+            mHighWater = std::max ( mHighWater, mOffset );
+            return mBlock.get() + offset;
+        }
+        // Overflow: serve the request from its own heap block, padded so the
+        // alignment can be met, and remember the size for the next Reset.
+        mOverflow.emplace_back ( std::make_unique<std::byte[]> ( aSize + aAlignment ) );
+        mOverflowBytes += aSize + aAlignment;
+        const uintptr_t address = reinterpret_cast<uintptr_t> ( mOverflow.back().get() );
+        return reinterpret_cast<void*> ( AlignUp ( address, aAlignment ) );
+    }
+
+    void FrameArena::Deallocate ( void* aPointer, size_t aSize )
+    {
+        std::byte* const block = static_cast<std::byte*> ( aPointer );
+        if ( block >= mBlock.get() && block + aSize == mBlock.get() + mOffset )
+        {
+            mOffset = static_cast<size_t> ( block - mBlock.get() );
+        }
+    }
+
+    void FrameArena::Reset()
+    {
+        if ( !mOverflow.empty() )
+        {
+            // Grow to this frame's high-water mark so it fits next time,
+            // never shrinking even if deallocations rolled mOffset back.
+            mCapacity = std::max ( mCapacity, mHighWater + mOverflowBytes );
+            mBlock = std::make_unique<std::byte[]> ( mCapacity );
+            mOverflow.clear();
+            mOverflowBytes = 0;
+        }
+        mOffset = 0;
+        mHighWater = 0;
+    }
+
+    size_t FrameArena::GetCapacity() const
+    {
+        return mCapacity;
+    }
+
+    size_t FrameArena::GetUsed() const
+    {
+        return mOffset + mOverflowBytes;
+    }
+
+    size_t FrameArena::GetOverflowCount() const
+    {
+        return mOverflow.size();
+    }
+
+    FrameArena& GetFrameArena()
+    {
+        thread_local ThreadFrameArena tFrameArena{};
+        return tFrameArena.mArena;
+    }
+
+    void ResetFrameArenas()
+    {
+        {
+            std::lock_guard<std::mutex> lock ( gFrameArenasMutex );
+            for ( FrameArena* arena : gFrameArenas )
+            {
+                arena->Reset();
+            }
+        }
+        BeginAllocationFrame();
+    }
+
+    void SetFrameArenaCapacity ( size_t aCapacity )
+    {
+        gFrameArenaCapacity.store ( aCapacity );
+    }
+}
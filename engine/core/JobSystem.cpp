@@ -0,0 +1,355 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <exception>
+#include <utility>
+#include "aeongames/JobSystem.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// @brief Scheduler the calling thread works for, null on non worker threads.
+        thread_local const JobSystem* tCurrentJobSystem{nullptr};
+        /// @brief Queue index of the calling worker thread within tCurrentJobSystem.
+        thread_local size_t tCurrentThreadIndex{0};
+    }
+
+    class JobSystem::Job
+    {
+    public:
+        Job ( std::function<void() > aFunction, JobHandle aParent ) :
+            mFunction{std::move ( aFunction ) },
+            mParent{std::move ( aParent ) }
+        {
+        }
+        std::function<void() > mFunction;
+        JobHandle mParent;
+        /// The job itself plus each child that has not finished yet.
+        std::atomic<int32_t> mUnfinished{1};
+        /// Unmet prerequisites plus one hold released by Submit.
+        std::atomic<int32_t> mBlockers{1};
+        std::atomic<bool> mComplete{false};
+        /// Guards mContinuations, mException and the transition to complete.
+        std::mutex mMutex{};
+        std::vector<JobHandle> mContinuations{};
+        std::exception_ptr mException{};
+    };
+
+    JobSystem::JobSystem ( size_t aWorkerCount )
+    {
+        mQueues.reserve ( aWorkerCount + 1 );
+        for ( size_t i = 0; i <= aWorkerCount; ++i )
+        {
+            mQueues.emplace_back ( std::make_unique<WorkQueue>() );
+        }
+        mWorkers.reserve ( aWorkerCount );
+        for ( size_t i = 1; i <= aWorkerCount; ++i )
+        {
+            mWorkers.emplace_back ( &JobSystem::WorkerLoop, this, i );
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock ( mSleepMutex );
+            mStop.store ( true );
+        }
+        mSleepCondition.notify_all();
+        for ( auto& worker : mWorkers )
+        {
+            worker.join();
+        }
+        // Without workers nobody drained the injection queue.
+        while ( JobHandle job = Dequeue ( 0 ) )
+        {
+            Execute ( job );
+        }
+    }
+
+    size_t JobSystem::GetDefaultWorkerCount()
+    {
+        const size_t hardware_threads = std::thread::hardware_concurrency();
+        return ( hardware_threads > 1 ) ? hardware_threads - 1 : 0;
+    }
+
+    size_t JobSystem::GetWorkerCount() const
+    {
+        return mWorkers.size();
+    }
+
+    size_t JobSystem::GetThreadCount() const
+    {
+        return mWorkers.size() + 1;
+    }
+
+    size_t JobSystem::GetCurrentThreadIndex() const
+    {
+        return ( tCurrentJobSystem == this ) ? tCurrentThreadIndex : 0;
+    }
+
+    JobSystem::JobHandle JobSystem::CreateJob ( std::function<void() > aFunction )
+    {
+        return std::make_shared<Job> ( std::move ( aFunction ), nullptr );
+    }
+
+    JobSystem::JobHandle JobSystem::CreateJob ( const JobHandle& aParent, std::function<void() > aFunction )
+    {
+        if ( aParent )
+        {
+            aParent->mUnfinished.fetch_add ( 1 );
+        }
+        return std::make_shared<Job> ( std::move ( aFunction ), aParent );
+    }
+
+    void JobSystem::AddDependency ( const JobHandle& aJob, const JobHandle& aPrerequisite )
+    {
+        if ( !aJob || !aPrerequisite || aJob == aPrerequisite )
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock ( aPrerequisite->mMutex );
+        if ( aPrerequisite->mComplete.load() )
+        {
+            return;
+        }
+        aJob->mBlockers.fetch_add ( 1 );
+        aPrerequisite->mContinuations.emplace_back ( aJob );
+    }
+
+    void JobSystem::Submit ( const JobHandle& aJob )
+    {
+        if ( aJob && aJob->mBlockers.fetch_sub ( 1 ) == 1 )
+        {
+            Enqueue ( aJob );
+        }
+    }
+
+    JobSystem::JobHandle JobSystem::Run ( std::function<void() > aFunction )
+    {
+        JobHandle job = CreateJob ( std::move ( aFunction ) );
+        Submit ( job );
+        return job;
+    }
+
+    bool JobSystem::IsComplete ( const JobHandle& aJob ) const
+    {
+        return !aJob || aJob->mComplete.load ( std::memory_order_acquire );
+    }
+
+    void JobSystem::Wait ( const JobHandle& aJob )
+    {
+        if ( !aJob )
+        {
+            return;
+        }
+        const size_t thread_index = GetCurrentThreadIndex();
+        while ( !IsComplete ( aJob ) )
+        {
+            // Help out instead of blocking; this is what lets jobs wait on
+            // other jobs without fibers or a risk of starving the pool.
+            if ( JobHandle job = Dequeue ( thread_index ) )
+            {
+                Execute ( job );
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock ( aJob->mMutex );
+            exception = aJob->mException;
+        }
+        if ( exception )
+        {
+            std::rethrow_exception ( exception );
+        }
+    }
+
+    void JobSystem::WorkerLoop ( size_t aIndex )
+    {
+        tCurrentJobSystem = this;
+        tCurrentThreadIndex = aIndex;
+        for ( ;; )
+        {
+            if ( JobHandle job = Dequeue ( aIndex ) )
+            {
+                Execute ( job );
+                continue;
+            }
+            std::unique_lock<std::mutex> lock ( mSleepMutex );
+            mSleepingWorkers.fetch_add ( 1 );
+            mSleepCondition.wait ( lock, [this]
+            {
+                return mStop.load() || mQueuedJobs.load() != 0;
+            } );
+            mSleepingWorkers.fetch_sub ( 1 );
+            if ( mStop.load() && mQueuedJobs.load() == 0 )
+            {
+                break;
+            }
+        }
+        tCurrentJobSystem = nullptr;
+        tCurrentThreadIndex = 0;
+    }
+
+    void JobSystem::Enqueue ( JobHandle aJob )
+    {
+        // Count before publishing so mQueuedJobs never undercounts the queues.
+        mQueuedJobs.fetch_add ( 1 );
+        WorkQueue& queue = *mQueues[GetCurrentThreadIndex()];
+        {
+            std::lock_guard<std::mutex> lock ( queue.mMutex );
+            queue.mJobs.emplace_back ( std::move ( aJob ) );
+        }
+        // Only pay for the sleep mutex when some worker is actually parked;
+        // the sequentially consistent counters make the check race free.
+        if ( mSleepingWorkers.load() != 0 )
+        {
+            {
+                std::lock_guard<std::mutex> lock ( mSleepMutex );
+            }
+            mSleepCondition.notify_one();
+        }
+    }
+
+    JobSystem::JobHandle JobSystem::Dequeue ( size_t aThreadIndex )
+    {
+        if ( mQueuedJobs.load() == 0 )
+        {
+            return nullptr;
+        }
+        const size_t queue_count = mQueues.size();
+        // Own queue first, newest job first.
+        {
+            WorkQueue& queue = *mQueues[aThreadIndex];
+            std::lock_guard<std::mutex> lock ( queue.mMutex );
+            if ( !queue.mJobs.empty() )
+            {
+                JobHandle job{std::move ( queue.mJobs.back() ) };
+                queue.mJobs.pop_back();
+                mQueuedJobs.fetch_sub ( 1 );
+                return job;
+            }
+        }
+        // Then steal the oldest job from everybody else, starting with the
+        // next queue over so thieves spread across victims.
+        for ( size_t i = 1; i < queue_count; ++i )
+        {
+            WorkQueue& queue = *mQueues[ ( aThreadIndex + i ) % queue_count];
+            std::lock_guard<std::mutex> lock ( queue.mMutex );
+            if ( !queue.mJobs.empty() )
+            {
+                JobHandle job{std::move ( queue.mJobs.front() ) };
+                queue.mJobs.pop_front();
+                mQueuedJobs.fetch_sub ( 1 );
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Execute ( const JobHandle& aJob )
+    {
+        if ( aJob->mFunction )
+        {
+            try
+            {
+                aJob->mFunction();
+            }
+            catch ( ... )
+            {
+                std::lock_guard<std::mutex> lock ( aJob->mMutex );
+                if ( !aJob->mException )
+                {
+                    aJob->mException = std::current_exception();
+                }
+            }
+            // Release captured state now rather than when the last handle dies.
+            aJob->mFunction = nullptr;
+        }
+        Finish ( aJob );
+    }
+
+    void JobSystem::Finish ( const JobHandle& aJob )
+    {
+        if ( aJob->mUnfinished.fetch_sub ( 1 ) != 1 )
+        {
+            return;
+        }
+        std::vector<JobHandle> continuations;
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock ( aJob->mMutex );
+            continuations.swap ( aJob->mContinuations );
+            exception = aJob->mException;
+            aJob->mComplete.store ( true, std::memory_order_release );
+        }
+        for ( const JobHandle& continuation : continuations )
+        {
+            Submit ( continuation );
+        }
+        if ( JobHandle parent = std::move ( aJob->mParent ) )
+        {
+            if ( exception )
+            {
+                std::lock_guard<std::mutex> lock ( parent->mMutex );
+                if ( !parent->mException )
+                {
+                    parent->mException = exception;
+                }
+            }
+            Finish ( parent );
+        }
+    }
+
+    static std::mutex gJobSystemMutex{};
+    static std::unique_ptr<JobSystem> gJobSystem{};
+    static std::atomic<JobSystem*> gJobSystemInstance{nullptr};
+
+    void InitializeJobSystem ( size_t aWorkerCount )
+    {
+        std::lock_guard<std::mutex> lock ( gJobSystemMutex );
+        gJobSystemInstance.store ( nullptr );
+        gJobSystem.reset();
+        gJobSystem = std::make_unique<JobSystem> ( aWorkerCount );
+        gJobSystemInstance.store ( gJobSystem.get() );
+    }
+
+    JobSystem& GetJobSystem()
+    {
+        if ( JobSystem * job_system = gJobSystemInstance.load ( std::memory_order_acquire ) )
+        {
+            return *job_system;
+        }
+        std::lock_guard<std::mutex> lock ( gJobSystemMutex );
+        if ( !gJobSystem )
+        {
+            gJobSystem = std::make_unique<JobSystem>();
+            gJobSystemInstance.store ( gJobSystem.get() );
+        }
+        return *gJobSystem;
+    }
+
+    void FinalizeJobSystem()
+    {
+        std::lock_guard<std::mutex> lock ( gJobSystemMutex );
+        gJobSystemInstance.store ( nullptr );
+        gJobSystem.reset();
+    }
+}
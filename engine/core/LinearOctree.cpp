@@ -0,0 +1,371 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "aeongames/LinearOctree.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Vector3.hpp"
+#include "aeongames/Transform.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// @brief Maximum depth a 64-bit Morton code can represent (3 bits per level).
+        constexpr uint32_t kMaxMortonDepth = 21u;
+        /// @brief Same bound as Octree's traversal stack: at most seven pending
+        /// siblings per level plus the eight just pushed.
+        constexpr size_t kCellStackCapacity = 7u * kMaxMortonDepth + 8u;
+        /// @brief Result of testing a cell against a query volume.
+        enum class CellOverlap
+        {
+            Outside,
+            Intersects,
+            Inside
+        };
+        /// @brief One frame of the iterative cell-traversal stack: a cell and
+        /// the run of entries stored in its subtree.
+        struct CellFrame
+        {
+            uint64_t mCode;
+            AABB mBounds;
+            uint32_t mDepth;
+            size_t mBegin;
+            size_t mEnd;
+        };
+    }
+
+    LinearOctree::LinearOctree() = default;
+
+    LinearOctree::LinearOctree ( const AABB& aRootBounds, uint32_t aMaxDepth ) :
+        mRootBounds{aRootBounds},
+        mMaxDepth{ ( aMaxDepth > kMaxMortonDepth ) ? kMaxMortonDepth : aMaxDepth }
+    {
+    }
+
+    LinearOctree::~LinearOctree() = default;
+
+    LinearOctree::Entry LinearOctree::MakeEntry ( const Node* aNode ) const
+    {
+        const AABB world = aNode->GetGlobalTransform() * aNode->GetAABB();
+        uint64_t code = 0;
+        uint32_t depth = 0;
+        AABB bounds = mRootBounds;
+        for ( ; depth < mMaxDepth; ++depth )
+        {
+            const uint8_t octant = bounds.OctantOf ( world.GetCenter() );
+            const AABB child = bounds.GetChildOctant ( octant );
+            if ( !child.Contains ( world ) )
+            {
+                break;
+            }
+            code = ( code << 3 ) | octant;
+            bounds = child;
+        }
+        // Pad with zero octants so every code spans the same number of levels.
+        return Entry{ code << ( 3u * ( mMaxDepth - depth ) ), depth, aNode };
+    }
+
+    namespace
+    {
+        template<class E>
+        bool EntryLess ( const E& aLhs, const E& aRhs )
+        {
+            return ( aLhs.mCode != aRhs.mCode ) ? aLhs.mCode < aRhs.mCode : aLhs.mDepth < aRhs.mDepth;
+        }
+    }
+
+    void LinearOctree::Settle() const
+    {
+        if ( mSortedCount == mEntries.size() )
+        {
+            return;
+        }
+        // A node added again replaces its older entry, like Octree::AddNode
+        // does, without paying for a lookup on every append: pending nodes
+        // are sorted once and the older copies marked and dropped here.
+        mPendingNodes.clear();
+        for ( size_t i = mSortedCount; i < mEntries.size(); ++i )
+        {
+            mPendingNodes.emplace_back ( mEntries[i].mNode, i );
+        }
+        std::sort ( mPendingNodes.begin(), mPendingNodes.end() );
+        bool stale = false;
+        for ( size_t i = 0; i + 1 < mPendingNodes.size(); ++i )
+        {
+            if ( mPendingNodes[i].first == mPendingNodes[i + 1].first )
+            {
+                mEntries[mPendingNodes[i].second].mNode = nullptr;
+                stale = true;
+            }
+        }
+        for ( size_t i = 0; i < mSortedCount; ++i )
+        {
+            const auto pending = std::lower_bound ( mPendingNodes.begin(), mPendingNodes.end(), std::pair<const Node*, size_t> { mEntries[i].mNode, 0 } );
+            if ( pending != mPendingNodes.end() && pending->first == mEntries[i].mNode )
+            {
+                mEntries[i].mNode = nullptr;
+                stale = true;
+            }
+        }
+        if ( stale )
+        {
+            const auto sorted_prefix = mEntries.begin() + static_cast<std::ptrdiff_t> ( mSortedCount );
+            mSortedCount = static_cast<size_t> ( std::count_if ( mEntries.begin(), sorted_prefix, [] ( const Entry & aEntry )
+            {
+                return aEntry.mNode != nullptr;
+            } ) );
+            mEntries.erase ( std::remove_if ( mEntries.begin(), mEntries.end(), [] ( const Entry & aEntry )
+            {
+                return aEntry.mNode == nullptr;
+            } ), mEntries.end() );
+        }
+        const auto sorted_end = mEntries.begin() + static_cast<std::ptrdiff_t> ( mSortedCount );
+        std::sort ( sorted_end, mEntries.end(), EntryLess<Entry> );
+        std::inplace_merge ( mEntries.begin(), sorted_end, mEntries.end(), EntryLess<Entry> );
+        mSortedCount = mEntries.size();
+    }
+
+    std::pair<size_t, size_t> LinearOctree::FindCell ( uint64_t aCode, uint32_t aDepth ) const
+    {
+        const Entry key{ aCode, aDepth, nullptr };
+        auto range = std::equal_range ( mEntries.begin(), mEntries.end(), key, EntryLess<Entry> );
+        return { static_cast<size_t> ( range.first - mEntries.begin() ), static_cast<size_t> ( range.second - mEntries.begin() ) };
+    }
+
+    void LinearOctree::AddNode ( const Node* aNode )
+    {
+        if ( aNode == nullptr )
+        {
+            return;
+        }
+        mEntries.emplace_back ( MakeEntry ( aNode ) );
+    }
+
+    void LinearOctree::RemoveNode ( const Node* aNode )
+    {
+        if ( aNode == nullptr )
+        {
+            return;
+        }
+        Settle();
+        const Entry entry = MakeEntry ( aNode );
+        const auto [begin, end] = FindCell ( entry.mCode, entry.mDepth );
+        auto first = mEntries.begin();
+        auto found = std::find_if ( first + static_cast<std::ptrdiff_t> ( begin ), first + static_cast<std::ptrdiff_t> ( end ),
+                                    [aNode] ( const Entry & aEntry )
+        {
+            return aEntry.mNode == aNode;
+        } );
+        if ( found == first + static_cast<std::ptrdiff_t> ( end ) )
+        {
+            // The node moved since it was added, find it the slow way.
+            found = std::find_if ( mEntries.begin(), mEntries.end(), [aNode] ( const Entry & aEntry )
+            {
+                return aEntry.mNode == aNode;
+            } );
+            if ( found == mEntries.end() )
+            {
+                return;
+            }
+        }
+        mEntries.erase ( found );
+        mSortedCount = mEntries.size();
+    }
+
+    bool LinearOctree::UpdateNode ( const Node* aNode )
+    {
+        if ( aNode == nullptr )
+        {
+            return false;
+        }
+        Settle();
+        const Entry entry = MakeEntry ( aNode );
+        const auto [begin, end] = FindCell ( entry.mCode, entry.mDepth );
+        for ( size_t i = begin; i < end; ++i )
+        {
+            if ( mEntries[i].mNode == aNode )
+            {
+                return false;
+            }
+        }
+        auto found = std::find_if ( mEntries.begin(), mEntries.end(), [aNode] ( const Entry & aEntry )
+        {
+            return aEntry.mNode == aNode;
+        } );
+        if ( found != mEntries.end() )
+        {
+            mEntries.erase ( found );
+        }
+        // Insert straight into the sorted run, the tree stays settled.
+        auto position = std::upper_bound ( mEntries.begin(), mEntries.end(), entry, EntryLess<Entry> );
+        mEntries.insert ( position, entry );
+        mSortedCount = mEntries.size();
+        return true;
+    }
+
+    void LinearOctree::Reserve ( size_t aNodeCount )
+    {
+        mEntries.reserve ( aNodeCount );
+    }
+
+    template<class CellTest, class CellVisit>
+    void LinearOctree::Traverse ( CellTest&& aCellTest, CellVisit&& aCellVisit ) const
+    {
+        Settle();
+        if ( mEntries.empty() )
+        {
+            return;
+        }
+        std::array<CellFrame, kCellStackCapacity> stack;
+        size_t top = 0;
+        stack[top++] = CellFrame{ 0, mRootBounds, 0, 0, mEntries.size() };
+        while ( top != 0 )
+        {
+            const CellFrame frame = stack[--top];
+            const CellOverlap overlap = aCellTest ( frame.mBounds );
+            if ( overlap == CellOverlap::Outside )
+            {
+                continue;
+            }
+            // Entries stored in the cell itself lead its run: they carry the
+            // cell's own (zero padded) code and the shallowest depth.
+            size_t own_end = frame.mBegin;
+            while ( own_end < frame.mEnd && mEntries[own_end].mDepth == frame.mDepth &&
+                    mEntries[own_end].mCode == frame.mCode )
+            {
+                ++own_end;
+            }
+            if ( !aCellVisit ( frame, own_end, overlap ) || frame.mDepth == mMaxDepth )
+            {
+                continue;
+            }
+            // Split the rest of the run between the eight children, walking
+            // from the last octant down so each search narrows the next one.
+            const uint32_t child_shift = 3u * ( mMaxDepth - frame.mDepth - 1u );
+            size_t child_end = frame.mEnd;
+            for ( uint8_t octant = 8; octant-- > 0; )
+            {
+                const uint64_t child_code = frame.mCode | ( static_cast<uint64_t> ( octant ) << child_shift );
+                const auto child_begin = static_cast<size_t> ( std::partition_point (
+                                             mEntries.begin() + static_cast<std::ptrdiff_t> ( own_end ),
+                                             mEntries.begin() + static_cast<std::ptrdiff_t> ( child_end ),
+                                             [child_code] ( const Entry & aEntry )
+                {
+                    return aEntry.mCode < child_code;
+                } ) - mEntries.begin() );
+                if ( child_begin != child_end )
+                {
+                    stack[top++] = CellFrame{ child_code, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1, child_begin, child_end };
+                }
+                child_end = child_begin;
+            }
+        }
+    }
+
+    void LinearOctree::QueryFrustum ( const Frustum& aFrustum, const std::function<void ( const Node* ) >& aCallback ) const
+    {
+        Traverse ( [&aFrustum] ( const AABB & aBounds )
+        {
+            return aFrustum.Intersects ( aBounds ) ? CellOverlap::Intersects : CellOverlap::Outside;
+        },
+        [this, &aCallback] ( const CellFrame & aFrame, size_t aOwnEnd, CellOverlap )
+        {
+            for ( size_t i = aFrame.mBegin; i < aOwnEnd; ++i )
+            {
+                aCallback ( mEntries[i].mNode );
+            }
+            return true;
+        } );
+    }
+
+    void LinearOctree::QueryAABB ( const AABB& aBox, const std::function<void ( const Node* ) >& aCallback ) const
+    {
+        Traverse ( [&aBox] ( const AABB & aBounds )
+        {
+            if ( !aBounds.Overlaps ( aBox ) )
+            {
+                return CellOverlap::Outside;
+            }
+            return aBox.Contains ( aBounds ) ? CellOverlap::Inside : CellOverlap::Intersects;
+        },
+        [this, &aCallback] ( const CellFrame & aFrame, size_t aOwnEnd, CellOverlap aOverlap )
+        {
+            // A fully covered cell reports its whole subtree run at once.
+            const size_t end = ( aOverlap == CellOverlap::Inside ) ? aFrame.mEnd : aOwnEnd;
+            for ( size_t i = aFrame.mBegin; i < end; ++i )
+            {
+                aCallback ( mEntries[i].mNode );
+            }
+            return aOverlap != CellOverlap::Inside;
+        } );
+    }
+
+    void LinearOctree::ForEachCell ( const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const
+    {
+        Traverse ( [] ( const AABB& )
+        {
+            return CellOverlap::Intersects;
+        },
+        [&aCallback] ( const CellFrame & aFrame, size_t, CellOverlap )
+        {
+            aCallback ( aFrame.mBounds, aFrame.mDepth );
+            return true;
+        } );
+    }
+
+    void LinearOctree::ForEachCell ( const Frustum& aFrustum, const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const
+    {
+        Traverse ( [&aFrustum] ( const AABB & aBounds )
+        {
+            return aFrustum.Intersects ( aBounds ) ? CellOverlap::Intersects : CellOverlap::Outside;
+        },
+        [&aCallback] ( const CellFrame & aFrame, size_t, CellOverlap )
+        {
+            aCallback ( aFrame.mBounds, aFrame.mDepth );
+            return true;
+        } );
+    }
+
+    size_t LinearOctree::GetNodeCount() const
+    {
+        Settle();
+        return mEntries.size();
+    }
+
+    size_t LinearOctree::GetCellCount() const
+    {
+        size_t count = 0;
+        ForEachCell ( [&count] ( const AABB&, uint32_t )
+        {
+            ++count;
+        } );
+        return count;
+    }
+
+    uint32_t LinearOctree::GetMaxDepth() const
+    {
+        return mMaxDepth;
+    }
+
+    const AABB& LinearOctree::GetRootBounds() const
+    {
+        return mRootBounds;
+    }
+}
@@ -29,14 +29,42 @@ limitations under the License.
 
 namespace AeonGames
 {
+    namespace
+    {
+        /* Materials keep their textures from being evicted, since renderers
+           bind the GPU copies of a loaded material's textures up front. */
+        void AcquireSamplers ( const std::vector<Material::SamplerKeyValue>& aSamplers )
+        {
+            for ( const auto& i : aSamplers )
+            {
+                std::get<1> ( i ).Acquire();
+            }
+        }
+
+        void ReleaseSamplers ( const std::vector<Material::SamplerKeyValue>& aSamplers )
+        {
+            for ( const auto& i : aSamplers )
+            {
+                std::get<1> ( i ).Release();
+            }
+        }
+    }
+
     Material::Material()
         = default;
     Material::~Material()
-        = default;
+    {
+        ReleaseSamplers ( mSamplers );
+    }
 
-    Material::Material ( const Material& aMaterial ) : mVariables{aMaterial.mVariables}, mSamplers{aMaterial.mSamplers} {}
+    Material::Material ( const Material& aMaterial ) : mVariables{aMaterial.mVariables}, mSamplers{aMaterial.mSamplers}
+    {
+        AcquireSamplers ( mSamplers );
+    }
     Material& Material::operator= ( const Material& aMaterial )
     {
+        AcquireSamplers ( aMaterial.mSamplers );
+        ReleaseSamplers ( mSamplers );
         mVariables = aMaterial.mVariables;
         mSamplers = aMaterial.mSamplers;
         return *this;
@@ -125,6 +153,7 @@ namespace AeonGames
             mSamplers.emplace_back ( crc32i ( i.name().c_str(), i.name().size() ),
                                      ResourceId{"Texture"_crc32, GetReferenceMsgId ( i.image() ) },
                                      state );
+            std::get<1> ( mSamplers.back() ).Acquire();
         }
     }
 
@@ -171,6 +200,7 @@ namespace AeonGames
             // Referenced lazily; renderers load the texture on demand. See the
             // MaterialMsg overload above for why there is no eager Store().
             mSamplers.emplace_back ( std::get<0> ( i ), std::get<1> ( i ), std::get<2> ( i ) );
+            std::get<1> ( i ).Acquire();
         }
     }
 
@@ -261,6 +291,8 @@ namespace AeonGames
         } );
         if ( i != mSamplers.end() )
         {
+            aValue.Acquire();
+            std::get<1> ( *i ).Release();
             std::get<1> ( *i ) = aValue;
         }
     }
@@ -275,6 +307,8 @@ namespace AeonGames
         } );
         if ( i != mSamplers.end() )
         {
+            aValue.Acquire();
+            std::get<1> ( *i ).Release();
             std::get<1> ( *i ) = aValue;
             std::get<2> ( *i ) = aState;
         }
@@ -303,6 +337,7 @@ namespace AeonGames
     void Material::Unload()
     {
         mVariables.clear();
+        ReleaseSamplers ( mSamplers );
         mSamplers.clear();
         mUniformBuffer.clear();
     }
@@ -15,6 +15,9 @@ limitations under the License.
 */
 #include "aeongames/ProtoBufClasses.hpp"
 #include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
 #include "aeongames/ProtoBufHelpers.hpp"
 #ifdef _MSC_VER
 #pragma warning( push )
@@ -61,12 +64,12 @@ namespace AeonGames
         return mVertexCount;
     }
 
-    const std::vector<uint8_t>& Mesh::GetVertexBuffer() const
+    std::span<const uint8_t> Mesh::GetVertexBuffer() const
     {
         return mVertexBuffer;
     }
 
-    const std::vector<uint8_t>& Mesh::GetIndexBuffer() const
+    std::span<const uint8_t> Mesh::GetIndexBuffer() const
     {
         return mIndexBuffer;
     }
@@ -115,11 +118,138 @@ namespace AeonGames
         return stride;
     }
 
+    namespace
+    {
+        /// Blobs of flat meshes start at multiples of this from the start of the file.
+        constexpr size_t kFlatMeshAlignment = 16;
+
+        bool IsFlatMesh ( const void* aBuffer, size_t aBufferSize )
+        {
+            return aBuffer != nullptr && aBufferSize >= sizeof ( MeshFileHeader ) &&
+                   std::memcmp ( aBuffer, "AEONMSH", 7 ) == 0 &&
+                   static_cast<const char*> ( aBuffer ) [7] == kFlatMeshTag;
+        }
+
+        size_t AlignFlatMeshOffset ( size_t aOffset )
+        {
+            return ( aOffset + kFlatMeshAlignment - 1 ) & ~ ( kFlatMeshAlignment - 1 );
+        }
+    }
+
     void Mesh::LoadFromMemory ( const void* aBuffer, size_t aBufferSize )
     {
+        if ( IsFlatMesh ( aBuffer, aBufferSize ) )
+        {
+            // One copy into memory of our own, aligned like the blobs need.
+            const uint8_t* bytes = static_cast<const uint8_t*> ( aBuffer );
+            auto copy = std::make_shared<const std::vector<uint8_t>> ( bytes, bytes + aBufferSize );
+            LoadFromFlat ( *copy, copy );
+            return;
+        }
         LoadFromProtoBufObject<Mesh, MeshMsg, "AEONMSH"_mgk> ( *this, aBuffer, aBufferSize );
     }
 
+    void Mesh::LoadFromView ( std::span<const uint8_t> aBuffer, const std::shared_ptr<const void>& aOwner )
+    {
+        if ( IsFlatMesh ( aBuffer.data(), aBuffer.size() ) &&
+             reinterpret_cast<uintptr_t> ( aBuffer.data() ) % kFlatMeshAlignment == 0 )
+        {
+            LoadFromFlat ( aBuffer, aOwner );
+            return;
+        }
+        LoadFromMemory ( aBuffer.data(), aBuffer.size() );
+    }
+
+    void Mesh::LoadFromFlat ( std::span<const uint8_t> aBuffer, std::shared_ptr<const void> aOwner )
+    {
+        MeshFileHeader header;
+        std::memcpy ( &header, aBuffer.data(), sizeof ( header ) );
+        const uint64_t attributes_end = sizeof ( MeshFileHeader ) + uint64_t{header.attribute_count} * sizeof ( MeshFileAttribute );
+        if ( header.version != 1 || attributes_end > aBuffer.size() ||
+             header.vertex_offset % kFlatMeshAlignment != 0 || header.index_offset % kFlatMeshAlignment != 0 ||
+             header.vertex_offset > aBuffer.size() || header.vertex_bytes > aBuffer.size() - header.vertex_offset ||
+             header.index_offset > aBuffer.size() || header.index_bytes > aBuffer.size() - header.index_offset ||
+             header.vertex_bytes < uint64_t{header.vertex_count} * header.vertex_stride ||
+             header.index_bytes != uint64_t{header.index_count} * header.index_size )
+        {
+            std::ostringstream stream;
+            stream << "Malformed flat AEONMSH buffer (version " << header.version << ", " << aBuffer.size() << " bytes).";
+            std::cout << LogLevel::Error << stream.str() << std::endl;
+            throw std::runtime_error ( stream.str() );
+        }
+        Unload();
+        mAABB = AABB
+        {
+            { header.center[0], header.center[1], header.center[2] },
+            { header.radii[0], header.radii[1], header.radii[2] }
+        };
+        mVertexCount = header.vertex_count;
+        mVertexStride = header.vertex_stride;
+        mIndexCount = header.index_count;
+        mIndexSize = header.index_size;
+        mAttributes.reserve ( header.attribute_count );
+        for ( uint32_t i = 0; i < header.attribute_count; ++i )
+        {
+            MeshFileAttribute attribute;
+            std::memcpy ( &attribute, aBuffer.data() + sizeof ( MeshFileHeader ) + i * sizeof ( MeshFileAttribute ), sizeof ( attribute ) );
+            mAttributes.emplace_back (
+                static_cast<AttributeSemantic> ( attribute.semantic ),
+                static_cast<AttributeSize> ( attribute.size ),
+                static_cast<AttributeType> ( attribute.type ),
+                static_cast<AttributeFlags> ( attribute.flags ),
+                attribute.offset );
+        }
+        mVertexBuffer = aBuffer.subspan ( static_cast<size_t> ( header.vertex_offset ), static_cast<size_t> ( header.vertex_bytes ) );
+        mIndexBuffer = aBuffer.subspan ( static_cast<size_t> ( header.index_offset ), static_cast<size_t> ( header.index_bytes ) );
+        mStorage = std::move ( aOwner );
+    }
+
+    std::vector<uint8_t> Mesh::SaveToFlat() const
+    {
+        MeshFileHeader header{};
+        std::memcpy ( header.id, "AEONMSH", 7 );
+        header.id[7] = kFlatMeshTag;
+        header.version = 1;
+        header.attribute_count = static_cast<uint32_t> ( mAttributes.size() );
+        header.vertex_count = mVertexCount;
+        header.vertex_stride = static_cast<uint32_t> ( GetStride() );
+        header.index_count = mIndexCount;
+        header.index_size = mIndexSize;
+        for ( size_t i = 0; i < 3; ++i )
+        {
+            header.center[i] = mAABB.GetCenter() [i];
+            header.radii[i] = mAABB.GetRadii() [i];
+        }
+        header.vertex_offset = AlignFlatMeshOffset ( sizeof ( MeshFileHeader ) + mAttributes.size() * sizeof ( MeshFileAttribute ) );
+        header.vertex_bytes = mVertexBuffer.size();
+        header.index_offset = AlignFlatMeshOffset ( static_cast<size_t> ( header.vertex_offset + header.vertex_bytes ) );
+        header.index_bytes = mIndexBuffer.size();
+        std::vector<uint8_t> flat ( static_cast<size_t> ( header.index_offset + header.index_bytes ), 0 );
+        std::memcpy ( flat.data(), &header, sizeof ( header ) );
+        for ( size_t i = 0; i < mAttributes.size(); ++i )
+        {
+            const MeshFileAttribute attribute
+            {
+                static_cast<uint32_t> ( std::get<0> ( mAttributes[i] ) ),
+                std::get<1> ( mAttributes[i] ),
+                static_cast<uint8_t> ( std::get<2> ( mAttributes[i] ) ),
+                std::get<3> ( mAttributes[i] ),
+                0,
+                std::get<4> ( mAttributes[i] )
+            };
+            std::memcpy ( flat.data() + sizeof ( MeshFileHeader ) + i * sizeof ( MeshFileAttribute ), &attribute, sizeof ( attribute ) );
+        }
+        if ( !mVertexBuffer.empty() )
+        {
+            std::memcpy ( flat.data() + header.vertex_offset, mVertexBuffer.data(), mVertexBuffer.size() );
+        }
+        if ( !mIndexBuffer.empty() )
+        {
+            std::memcpy ( flat.data() + header.index_offset, mIndexBuffer.data(), mIndexBuffer.size() );
+        }
+        return flat;
+    }
+
     void Mesh::LoadFromPBMsg ( const MeshMsg& aMeshMsg )
     {
         mAABB = AABB
@@ -156,14 +286,20 @@ namespace AeonGames
         }
         mVertexStride = aMeshMsg.has_vertexstride() && aMeshMsg.vertexstride() != 0 ? aMeshMsg.vertexstride() : packed_offset;
 
-        mVertexBuffer.clear();
-        mVertexBuffer.reserve ( aMeshMsg.vertexbuffer().size() );
-        std::copy ( aMeshMsg.vertexbuffer().begin(), aMeshMsg.vertexbuffer().end(), std::back_inserter ( mVertexBuffer ) );
-
-        mIndexBuffer.clear();
-        mIndexBuffer.reserve ( aMeshMsg.indexbuffer().size() );
-        std::copy ( aMeshMsg.indexbuffer().begin(), aMeshMsg.indexbuffer().end(), std::back_inserter ( mIndexBuffer ) );
+        // Both buffers in one allocation, the index data aligned like in flat meshes.
+        const size_t index_offset = AlignFlatMeshOffset ( aMeshMsg.vertexbuffer().size() );
+        auto storage = std::make_shared<std::vector<uint8_t>> ( index_offset + aMeshMsg.indexbuffer().size() );
+        std::memcpy ( storage->data(), aMeshMsg.vertexbuffer().data(), aMeshMsg.vertexbuffer().size() );
+        std::memcpy ( storage->data() + index_offset, aMeshMsg.indexbuffer().data(), aMeshMsg.indexbuffer().size() );
+        mVertexBuffer = std::span<const uint8_t> ( storage->data(), aMeshMsg.vertexbuffer().size() );
+        mIndexBuffer = std::span<const uint8_t> ( storage->data() + index_offset, aMeshMsg.indexbuffer().size() );
+        mStorage = std::move ( storage );
     }
+    size_t Mesh::GetMemoryUsage() const
+    {
+        return mVertexBuffer.size() + mIndexBuffer.size() + mAttributes.capacity() * sizeof ( AttributeTuple );
+    }
+
     void Mesh::Unload()
     {
         mAABB = AABB{};
@@ -174,7 +310,8 @@ namespace AeonGames
         mVertexStride = 0;
 
         mAttributes.clear();
-        mVertexBuffer.clear();
-        mIndexBuffer.clear();
+        mVertexBuffer = {};
+        mIndexBuffer = {};
+        mStorage.reset();
     }
 }
@@ -44,7 +44,12 @@ namespace AeonGames
     Model::Model()
         = default;
     Model::~Model()
-        = default;
+    {
+        for ( const ResourceId& reference : mReferences )
+        {
+            reference.Release();
+        }
+    }
 
     void Model::LoadFromMemory ( const void* aBuffer, size_t aBufferSize )
     {
@@ -53,6 +58,12 @@ namespace AeonGames
 
     void Model::LoadFromPBMsg ( const ModelMsg& aModelMsg )
     {
+        auto store = [this] ( const ResourceId & aResourceId )
+        {
+            aResourceId.Store();
+            aResourceId.Acquire();
+            mReferences.emplace_back ( aResourceId );
+        };
         ResourceId default_pipeline{};
         ResourceId default_material{};
 
@@ -60,21 +71,21 @@ namespace AeonGames
         if ( aModelMsg.has_default_pipeline() )
         {
             default_pipeline = {"Pipeline"_crc32, GetReferenceMsgId ( aModelMsg.default_pipeline() ) } ;
-            default_pipeline.Store();
+            store ( default_pipeline );
         }
 
         // Default Material ---------------------------------------------------------------------
         if ( aModelMsg.has_default_material() )
         {
             default_material = {"Material"_crc32, GetReferenceMsgId ( aModelMsg.default_material() ) } ;
-            default_material.Store();
+            store ( default_material );
         }
 
         // Skeleton -----------------------------------------------------------------------------
         if ( aModelMsg.has_skeleton() )
         {
             mSkeleton = { "Skeleton"_crc32, GetReferenceMsgId ( aModelMsg.skeleton() ) };
-            mSkeleton.Store();
+            store ( mSkeleton );
         }
         // Meshes -----------------------------------------------------------------------------
         mAssemblies.reserve ( aModelMsg.assembly_size() );
@@ -87,19 +98,19 @@ namespace AeonGames
             if ( assembly.has_mesh() )
             {
                 mesh = {"Mesh"_crc32, GetReferenceMsgId ( assembly.mesh() ) } ;
-                mesh.Store();
+                store ( mesh );
             }
 
             if ( assembly.has_pipeline() )
             {
                 pipeline = {"Pipeline"_crc32, GetReferenceMsgId ( assembly.pipeline() ) } ;
-                pipeline.Store();
+                store ( pipeline );
             }
 
             if ( assembly.has_material() )
             {
                 material = {"Material"_crc32, GetReferenceMsgId ( assembly.material() ) } ;
-                material.Store();
+                store ( material );
             }
             mAssemblies.emplace_back ( mesh, pipeline, material );
         }
@@ -110,14 +121,30 @@ namespace AeonGames
         {
             mAnimationNames.emplace_back ( animation.name() );
             ResourceId resource{"Animation"_crc32, GetReferenceMsgId ( animation.reference() ) };
-            resource.Store();
+            store ( resource );
             mAnimationResources.emplace_back ( std::move ( resource ) );
         }
     }
 
+    size_t Model::GetMemoryUsage() const
+    {
+        size_t size = mAssemblies.capacity() * sizeof ( Assembly ) +
+                      mAnimationResources.capacity() * sizeof ( ResourceId ) +
+                      mReferences.capacity() * sizeof ( ResourceId );
+        for ( const std::string& name : mAnimationNames )
+        {
+            size += sizeof ( std::string ) + name.capacity();
+        }
+        return size;
+    }
+
     void Model::Unload()
     {
-        /**@todo refcount Resource Id's? */
+        for ( const ResourceId& reference : mReferences )
+        {
+            reference.Release();
+        }
+        mReferences.clear();
         mAssemblies.clear();
         mAnimationNames.clear();
         mAnimationResources.clear();
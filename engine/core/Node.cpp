@@ -154,7 +154,7 @@ namespace AeonGames
         } );
         if ( Scene * scene = GetScene() )
         {
-            scene->InvalidateSpatialIndex();
+            scene->InvalidateSpatialIndex ( this );
         }
     }
 
@@ -194,16 +194,22 @@ namespace AeonGames
         } );
         if ( Scene * scene = GetScene() )
         {
-            scene->InvalidateSpatialIndex();
+            scene->InvalidateSpatialIndex ( this );
         }
     }
 
     void Node::SetAABB ( const AABB& aAABB )
     {
+        // Components republish the same bounds every frame, which must not
+        // cost an octree update.
+        if ( mAABB.GetCenter() == aAABB.GetCenter() && mAABB.GetRadii() == aAABB.GetRadii() )
+        {
+            return;
+        }
         mAABB = aAABB;
         if ( Scene * scene = GetScene() )
         {
-            scene->InvalidateSpatialIndex();
+            scene->InvalidateSpatialIndex ( this );
         }
     }
 
@@ -377,6 +383,11 @@ namespace AeonGames
         } );
         if ( it != mNodes.end() )
         {
+            // The detached subtree must leave the scene's octree.
+            if ( Scene * scene = GetScene() )
+            {
+                scene->InvalidateSpatialIndex();
+            }
             aNode->mParent = static_cast<Node*> ( nullptr );
             // Force recalculation of transforms.
             aNode->SetLocalTransform ( aNode->mGlobalTransform );
@@ -393,6 +404,10 @@ namespace AeonGames
         {
             return nullptr;
         }
+        if ( Scene * scene = GetScene() )
+        {
+            scene->InvalidateSpatialIndex();
+        }
         mNodes[aIndex]->mParent = static_cast<Node*> ( nullptr );
         mNodes[aIndex]->SetLocalTransform ( mNodes[aIndex]->mGlobalTransform );
         auto it = mNodes.begin() + aIndex;
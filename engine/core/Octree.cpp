@@ -24,25 +24,6 @@ limitations under the License.
 
 namespace AeonGames
 {
-    namespace
-    {
-        /// @brief Maximum depth a 64-bit location code can represent (63 spare bits / 3 bits per level).
-        constexpr uint32_t kMaxLocationCodeDepth = 21u;
-        /// @brief One frame of the iterative cell-traversal stack.
-        struct CellFrame
-        {
-            uint64_t mLocationCode;
-            AABB mBounds;
-            uint32_t mDepth;
-        };
-        /// @brief Upper bound on the traversal stack depth: a depth-first walk
-        /// that pushes all eight children on each pop holds at most seven pending
-        /// siblings per level plus the eight just pushed, so the frontier never
-        /// exceeds 7 * maxDepth + 8 entries. Sized for the deepest possible tree
-        /// so the stack can live on the call stack with no heap allocation.
-        constexpr size_t kCellStackCapacity = 7u * kMaxLocationCodeDepth + 8u;
-    }
-
     Octree::Octree() = default;
 
     Octree::Octree ( const AABB& aRootBounds, uint32_t aMaxDepth ) :
@@ -53,12 +34,8 @@ namespace AeonGames
 
     Octree::~Octree() = default;
 
-    void Octree::AddNode ( const Node* aNode )
+    uint64_t Octree::GetLocationCode ( const Node* aNode ) const
     {
-        if ( aNode == nullptr )
-        {
-            return;
-        }
         const AABB world = aNode->GetGlobalTransform() * aNode->GetAABB();
         uint64_t location_code = 1;
         AABB bounds = mRootBounds;
@@ -70,35 +47,32 @@ namespace AeonGames
             {
                 break;
             }
-            mCells[location_code].mChildExists |= static_cast<uint8_t> ( 1u << octant );
             location_code = ( location_code << 3 ) | octant;
             bounds = child;
         }
-        mCells[location_code].mObjects.push_back ( aNode );
-        ++mSize;
+        return location_code;
     }
 
-    void Octree::RemoveNode ( const Node* aNode )
+    void Octree::InsertIntoCell ( const Node* aNode, uint64_t aLocationCode )
     {
-        if ( aNode == nullptr )
+        mCells[aLocationCode].mObjects.push_back ( aNode );
+        // Link the path back to the root; stop at the first ancestor that
+        // already knows about its child, everything above it does too.
+        for ( uint64_t location_code = aLocationCode; location_code != 1; location_code >>= 3 )
         {
-            return;
-        }
-        const AABB world = aNode->GetGlobalTransform() * aNode->GetAABB();
-        uint64_t location_code = 1;
-        AABB bounds = mRootBounds;
-        for ( uint32_t depth = 0; depth < mMaxDepth; ++depth )
-        {
-            const uint8_t octant = bounds.OctantOf ( world.GetCenter() );
-            const AABB child = bounds.GetChildOctant ( octant );
-            if ( !child.Contains ( world ) )
+            const uint8_t mask = static_cast<uint8_t> ( 1u << ( location_code & 7u ) );
+            Cell& parent = mCells[location_code >> 3];
+            if ( parent.mChildExists & mask )
             {
                 break;
             }
-            location_code = ( location_code << 3 ) | octant;
-            bounds = child;
+            parent.mChildExists |= mask;
         }
-        auto cell = mCells.find ( location_code );
+    }
+
+    void Octree::EraseFromCell ( const Node* aNode, uint64_t aLocationCode )
+    {
+        auto cell = mCells.find ( aLocationCode );
         if ( cell == mCells.end() )
         {
             return;
@@ -109,9 +83,11 @@ namespace AeonGames
         {
             return;
         }
-        objects.erase ( found );
-        --mSize;
+        // Order within a cell is irrelevant, swap-and-pop avoids the shift.
+        *found = objects.back();
+        objects.pop_back();
         // Prune cells that have become empty leaves, walking up to the root.
+        uint64_t location_code = aLocationCode;
         while ( location_code != 1 )
         {
             const Cell& current = mCells[location_code];
@@ -134,67 +110,73 @@ namespace AeonGames
         }
     }
 
-    void Octree::QueryFrustum ( const Frustum& aFrustum, const std::function<void ( const Node* ) >& aCallback ) const
+    void Octree::AddNode ( const Node* aNode )
     {
-        std::array<CellFrame, kCellStackCapacity> stack;
-        size_t top = 0;
-        stack[top++] = CellFrame{ 1, mRootBounds, 0 };
-        while ( top != 0 )
+        if ( aNode == nullptr )
         {
-            const CellFrame frame = stack[--top];
-            auto cell = mCells.find ( frame.mLocationCode );
-            if ( cell == mCells.end() || !aFrustum.Intersects ( frame.mBounds ) )
-            {
-                continue;
-            }
-            for ( const Node * node : cell->second.mObjects )
-            {
-                aCallback ( node );
-            }
-            const uint8_t child_exists = cell->second.mChildExists;
-            for ( uint8_t octant = 0; octant < 8; ++octant )
-            {
-                if ( child_exists & static_cast<uint8_t> ( 1u << octant ) )
-                {
-                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), 0 };
-                }
-            }
+            return;
+        }
+        auto [location, inserted] = mLocations.try_emplace ( aNode, GetLocationCode ( aNode ) );
+        if ( !inserted )
+        {
+            UpdateNode ( aNode );
+            return;
         }
+        InsertIntoCell ( aNode, location->second );
+        ++mSize;
     }
 
-    void Octree::QueryAABB ( const AABB& aBox, const std::function<void ( const Node* ) >& aCallback ) const
+    void Octree::RemoveNode ( const Node* aNode )
     {
-        std::array<CellFrame, kCellStackCapacity> stack;
-        size_t top = 0;
-        stack[top++] = CellFrame{ 1, mRootBounds, 0 };
-        while ( top != 0 )
+        auto location = mLocations.find ( aNode );
+        if ( location == mLocations.end() )
         {
-            const CellFrame frame = stack[--top];
-            auto cell = mCells.find ( frame.mLocationCode );
-            if ( cell == mCells.end() || !frame.mBounds.Overlaps ( aBox ) )
-            {
-                continue;
-            }
-            for ( const Node * node : cell->second.mObjects )
-            {
-                aCallback ( node );
-            }
-            const uint8_t child_exists = cell->second.mChildExists;
-            for ( uint8_t octant = 0; octant < 8; ++octant )
-            {
-                if ( child_exists & static_cast<uint8_t> ( 1u << octant ) )
-                {
-                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), 0 };
-                }
-            }
+            return;
+        }
+        EraseFromCell ( aNode, location->second );
+        mLocations.erase ( location );
+        --mSize;
+    }
+
+    bool Octree::UpdateNode ( const Node* aNode )
+    {
+        if ( aNode == nullptr )
+        {
+            return false;
         }
+        auto location = mLocations.find ( aNode );
+        if ( location == mLocations.end() )
+        {
+            AddNode ( aNode );
+            return true;
+        }
+        const uint64_t location_code = GetLocationCode ( aNode );
+        if ( location_code == location->second )
+        {
+            return false;
+        }
+        EraseFromCell ( aNode, location->second );
+        InsertIntoCell ( aNode, location_code );
+        location->second = location_code;
+        return true;
+    }
+
+    void Octree::QueryFrustum ( const Frustum& aFrustum, const std::function<void ( const Node* ) >& aCallback ) const
+    {
+        // The explicit argument selects the visitor overload over this one.
+        QueryFrustum<const std::function<void ( const Node* ) >&> ( aFrustum, aCallback );
+    }
+
+    void Octree::QueryAABB ( const AABB& aBox, const std::function<void ( const Node* ) >& aCallback ) const
+    {
+        QueryAABB<const std::function<void ( const Node* ) >&> ( aBox, aCallback );
     }
 
     void Octree::ForEachCell ( const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const
     {
         std::array<CellFrame, kCellStackCapacity> stack;
         size_t top = 0;
-        stack[top++] = CellFrame{ 1, mRootBounds, 0 };
+        stack[top++] = CellFrame{ 1, mRootBounds, 0, 0 };
         while ( top != 0 )
         {
             const CellFrame frame = stack[--top];
@@ -209,7 +191,7 @@ namespace AeonGames
             {
                 if ( child_exists & static_cast<uint8_t> ( 1u << octant ) )
                 {
-                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1 };
+                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1, 0 };
                 }
             }
         }
@@ -219,7 +201,7 @@ namespace AeonGames
     {
         std::array<CellFrame, kCellStackCapacity> stack;
         size_t top = 0;
-        stack[top++] = CellFrame{ 1, mRootBounds, 0 };
+        stack[top++] = CellFrame{ 1, mRootBounds, 0, 0 };
         while ( top != 0 )
         {
             const CellFrame frame = stack[--top];
@@ -234,7 +216,7 @@ namespace AeonGames
             {
                 if ( child_exists & static_cast<uint8_t> ( 1u << octant ) )
                 {
-                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1 };
+                    stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1, 0 };
                 }
             }
         }
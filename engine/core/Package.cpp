@@ -21,90 +21,114 @@ limitations under the License.
 #include <sstream>
 #include <regex>
 #include <algorithm>
+#include <atomic>
 #include <system_error>
+#include <utility>
+#include <limits>
 #include <vector>
-#include "zlib.h"
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include "aeongames/Package.hpp"
+#include "aeongames/AeonEngine.hpp"
 #include "aeongames/CRC.hpp"
+#include "aeongames/JobSystem.hpp"
+#include "BatchRead.h"
+#include "Compression.h"
 
 namespace AeonGames
 {
     namespace
     {
-        constexpr size_t kInflateChunk = 16384;
-
-        /** Decompress exactly `compressed_size` bytes starting at `offset` of
-            `file` into `buffer` (capacity `buffer_size`). Reads in chunks so we
-            don't have to load the whole compressed payload at once.
-            Returns Z_OK on success, a zlib error code otherwise. */
-        int InflateRegion ( std::ifstream& file,
-                            uint64_t offset,
-                            uint64_t compressed_size,
-                            void* buffer,
-                            size_t buffer_size )
+        /** Map a whole file read only.
+            @return The mapping, or null if the file could not be mapped. */
+        const uint8_t* MapFile ( const std::filesystem::path& aPath, size_t aSize )
         {
-            file.clear();
-            file.seekg ( static_cast<std::streamoff> ( offset ), std::ios::beg );
-            if ( !file )
+            if ( aSize == 0 )
             {
-                return Z_ERRNO;
+                return nullptr;
             }
-
-            z_stream strm{};
-            strm.zalloc = Z_NULL;
-            strm.zfree = Z_NULL;
-            strm.opaque = Z_NULL;
-            int ret = inflateInit ( &strm );
-            if ( ret != Z_OK )
+#if defined(_WIN32)
+            HANDLE file = CreateFileW ( aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+            if ( file == INVALID_HANDLE_VALUE )
+            {
+                return nullptr;
+            }
+            HANDLE mapping = CreateFileMappingW ( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+            CloseHandle ( file );
+            if ( mapping == nullptr )
+            {
+                return nullptr;
+            }
+            // The view keeps the mapping object alive.
+            const void* view = MapViewOfFile ( mapping, FILE_MAP_READ, 0, 0, aSize );
+            CloseHandle ( mapping );
+            return static_cast<const uint8_t*> ( view );
+#else
+            const int file = open ( aPath.c_str(), O_RDONLY | O_CLOEXEC );
+            if ( file < 0 )
             {
-                return ret;
+                return nullptr;
             }
-            strm.next_out = static_cast<Bytef*> ( buffer );
-            strm.avail_out = static_cast<uInt> ( buffer_size );
+            void* view = mmap ( nullptr, aSize, PROT_READ, MAP_PRIVATE, file, 0 );
+            // The mapping keeps its own reference to the file.
+            close ( file );
+            return ( view != MAP_FAILED ) ? static_cast<const uint8_t*> ( view ) : nullptr;
+#endif
+        }
 
-            unsigned char in[kInflateChunk];
-            uint64_t remaining = compressed_size;
-            while ( remaining > 0 )
-            {
-                const std::streamsize want =
-                    static_cast<std::streamsize> ( std::min<uint64_t> ( remaining, kInflateChunk ) );
-                file.read ( reinterpret_cast<char*> ( in ), want );
-                const std::streamsize got = file.gcount();
-                if ( got <= 0 )
-                {
-                    inflateEnd ( &strm );
-                    return Z_ERRNO;
-                }
-                strm.next_in = in;
-                strm.avail_in = static_cast<uInt> ( got );
-                remaining -= static_cast<uint64_t> ( got );
+        /** Whether every page the ranges touch is already in memory, so
+            copying from the mapping costs no I/O. Checks the span from the
+            first to the last range with a single call; false where the
+            platform cannot tell. */
+        bool IsResident ( const uint8_t* aMapping, std::span<const FileRange> aRanges )
+        {
+#if defined(__linux__)
+            if ( aRanges.empty() )
+            {
+                return true;
+            }
+            uint64_t begin = std::numeric_limits<uint64_t>::max();
+            uint64_t end = 0;
+            for ( const FileRange& range : aRanges )
+            {
+                begin = std::min ( begin, range.mOffset );
+                end = std::max ( end, range.mOffset + range.mSize );
+            }
+            const uint64_t page = static_cast<uint64_t> ( sysconf ( _SC_PAGESIZE ) );
+            begin -= begin % page;
+            std::vector<unsigned char> resident ( static_cast<size_t> ( ( end - begin + page - 1 ) / page ) );
+            if ( mincore ( const_cast<uint8_t*> ( aMapping + begin ), static_cast<size_t> ( end - begin ), resident.data() ) != 0 )
+            {
+                return false;
+            }
+            return std::all_of ( resident.begin(), resident.end(), [] ( unsigned char aPage )
+            {
+                return ( aPage & 1 ) != 0;
+            } );
+#else
+            ( void ) aMapping;
+            ( void ) aRanges;
+            return false;
+#endif
+        }
 
-                while ( strm.avail_in > 0 )
-                {
-                    ret = inflate ( &strm, ( remaining == 0 ) ? Z_FINISH : Z_NO_FLUSH );
-                    if ( ret == Z_STREAM_END )
-                    {
-                        break;
-                    }
-                    if ( ret != Z_OK )
-                    {
-                        inflateEnd ( &strm );
-                        return ret;
-                    }
-                    if ( strm.avail_out == 0 && strm.avail_in > 0 )
-                    {
-                        // Caller buffer is full but more compressed input remains.
-                        inflateEnd ( &strm );
-                        return Z_BUF_ERROR;
-                    }
-                }
-                if ( ret == Z_STREAM_END )
-                {
-                    break;
-                }
+        void UnmapFile ( const uint8_t* aMapping, size_t aSize )
+        {
+            if ( aMapping == nullptr )
+            {
+                return;
             }
-            inflateEnd ( &strm );
-            return ( ret == Z_STREAM_END || ret == Z_OK ) ? Z_OK : Z_DATA_ERROR;
+#if defined(_WIN32)
+            ( void ) aSize;
+            UnmapViewOfFile ( aMapping );
+#else
+            munmap ( const_cast<uint8_t*> ( aMapping ), aSize );
+#endif
         }
 
         /** On-disk header for AEONIDX index files written by aeontool index.
@@ -291,6 +315,28 @@ namespace AeonGames
                 oss << "Failed to load AEONPKG package: " << mPath.string();
                 throw std::runtime_error ( oss.str() );
             }
+            mMappingSize = static_cast<size_t> ( std::filesystem::file_size ( mPath, ec ) );
+            mMapping = ec ? nullptr : MapFile ( mPath, mMappingSize );
+            if ( mMapping == nullptr )
+            {
+                mMappingSize = 0;
+            }
+            else
+            {
+                mMappingOwner = std::shared_ptr<const void> ( mMapping, [size = mMappingSize] ( const void* aMapping )
+                {
+                    UnmapFile ( static_cast<const uint8_t*> ( aMapping ), size );
+                } );
+            }
+            if ( IsCompressionSupported ( ZSTD ) )
+            {
+                if ( const size_t dictionary_size = GetFileSize ( PKGDictionaryPath ) )
+                {
+                    std::vector<uint8_t> dictionary ( dictionary_size );
+                    LoadFile ( PKGDictionaryPath, dictionary.data(), dictionary.size() );
+                    mDictionary = std::make_shared<const CompressionDictionary> ( dictionary );
+                }
+            }
             return;
         }
         if ( std::filesystem::is_directory ( mPath ) )
@@ -324,7 +370,11 @@ namespace AeonGames
     Package::Package ( Package&& aPackage ) noexcept :
         mPath ( aPackage.mPath ),
         mIndexTable ( std::move ( aPackage.mIndexTable ) ),
-        mEntries ( std::move ( aPackage.mEntries ) ) {}
+        mEntries ( std::move ( aPackage.mEntries ) ),
+        mMapping ( std::exchange ( aPackage.mMapping, nullptr ) ),
+        mMappingSize ( std::exchange ( aPackage.mMappingSize, 0 ) ),
+        mMappingOwner ( std::move ( aPackage.mMappingOwner ) ),
+        mDictionary ( std::move ( aPackage.mDictionary ) ) {}
 
     const std::filesystem::path& Package::GetPath() const
     {
@@ -354,15 +404,20 @@ namespace AeonGames
         }
     }
 
+    uint32_t Package::GetEntryIndex ( uint32_t crc ) const
+    {
+        const PKGDirectoryEntry* e = FindEntry ( mEntries, crc );
+        return ( e != nullptr ) ? static_cast<uint32_t> ( e - mEntries.data() ) : NoEntry;
+    }
+    size_t Package::GetEntrySize ( uint32_t aEntry ) const
+    {
+        return ( aEntry < mEntries.size() ) ? static_cast<size_t> ( mEntries[aEntry].uncompressed_size ) : 0;
+    }
     size_t Package::GetFileSize ( uint32_t crc ) const
     {
         if ( !mEntries.empty() )
         {
-            if ( const PKGDirectoryEntry * e = FindEntry ( mEntries, crc ) )
-            {
-                return static_cast<size_t> ( e->uncompressed_size );
-            }
-            return 0;
+            return GetEntrySize ( GetEntryIndex ( crc ) );
         }
         if ( std::filesystem::is_directory ( mPath ) )
         {
@@ -386,59 +441,197 @@ namespace AeonGames
     {
         if ( !mEntries.empty() )
         {
-            const PKGDirectoryEntry* e = FindEntry ( mEntries, crc );
-            if ( e == nullptr )
+            const uint32_t entry = GetEntryIndex ( crc );
+            if ( entry != NoEntry )
             {
-                return;
+                LoadEntry ( entry, buffer, buffer_size );
             }
+            return;
+        }
+        if ( std::filesystem::is_directory ( mPath ) )
+        {
+            auto it = mIndexTable.find ( crc );
+            if ( it != mIndexTable.end() )
+            {
+                std::ifstream file;
+                file.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
+                file.open ( mPath / it->second, std::ifstream::in | std::ifstream::binary );
+                file.read ( reinterpret_cast<char*> ( buffer ), buffer_size );
+                file.close();
+            }
+        }
+    }
+
+    void Package::LoadEntry ( uint32_t aEntry, void* buffer, size_t buffer_size ) const
+    {
+        if ( aEntry >= mEntries.size() )
+        {
+            return;
+        }
+        const PKGDirectoryEntry* e = &mEntries[aEntry];
+        if ( mMapping != nullptr && e->data_offset + e->compressed_size > mMappingSize )
+        {
+            std::ostringstream oss;
+            oss << "Entry " << std::hex << e->crc << " runs past the end of " << mPath.string();
+            throw std::runtime_error ( oss.str() );
+        }
+        std::vector<uint8_t> staged{};
+        const uint8_t* data = mMapping ? mMapping + e->data_offset : nullptr;
+        if ( data == nullptr )
+        {
+            // Not mapped, read the stored bytes through a stream.
             std::ifstream file ( mPath, std::ios::in | std::ios::binary );
             if ( !file.is_open() )
             {
                 throw std::runtime_error ( "Could not open package file for reading." );
             }
-            switch ( e->compression )
-            {
-            case NONE:
+            staged.resize ( static_cast<size_t> ( ( e->compression == NONE ) ? std::min<uint64_t> ( e->compressed_size, buffer_size ) : e->compressed_size ) );
+            file.seekg ( static_cast<std::streamoff> ( e->data_offset ), std::ios::beg );
+            file.read ( reinterpret_cast<char*> ( staged.data() ), static_cast<std::streamsize> ( staged.size() ) );
+            if ( !file )
             {
-                file.seekg ( static_cast<std::streamoff> ( e->data_offset ), std::ios::beg );
-                const std::streamsize want = static_cast<std::streamsize> (
-                                                 std::min<uint64_t> ( e->compressed_size, buffer_size ) );
-                file.read ( reinterpret_cast<char*> ( buffer ), want );
-                break;
+                throw std::runtime_error ( "Could not read package entry." );
             }
-            case ZLIB:
+            data = staged.data();
+        }
+        if ( e->compression == NONE )
+        {
+            std::memcpy ( buffer, data, static_cast<size_t> ( std::min<uint64_t> ( e->compressed_size, buffer_size ) ) );
+        }
+        else if ( !IsCompressionSupported ( e->compression ) )
+        {
+            std::ostringstream oss;
+            oss << "Unsupported compression type " << static_cast<int> ( e->compression )
+                << " for entry " << std::hex << e->crc;
+            throw std::runtime_error ( oss.str() );
+        }
+        else if ( !DecompressBuffer ( e->compression, { data, static_cast<size_t> ( e->compressed_size ) }, buffer, buffer_size, mDictionary.get() ) )
+        {
+            std::ostringstream oss;
+            oss << GetCompressionName ( e->compression ) << " decompression failed for entry " << std::hex << e->crc;
+            throw std::runtime_error ( oss.str() );
+        }
+    }
+
+    std::span<const uint8_t> Package::GetEntryView ( uint32_t aEntry ) const
+    {
+        if ( mMapping == nullptr || aEntry >= mEntries.size() )
+        {
+            return {};
+        }
+        const PKGDirectoryEntry& e = mEntries[aEntry];
+        if ( e.compression != NONE || e.data_offset + e.compressed_size > mMappingSize )
+        {
+            return {};
+        }
+        return { mMapping + e.data_offset, static_cast<size_t> ( e.compressed_size ) };
+    }
+    std::shared_ptr<const void> Package::GetMappingOwner() const
+    {
+        return mMappingOwner;
+    }
+    std::span<const uint8_t> Package::GetFileView ( uint32_t crc ) const
+    {
+        return GetEntryView ( GetEntryIndex ( crc ) );
+    }
+    std::span<const uint8_t> Package::GetFileView ( const std::string& aFileName ) const
+    {
+        return GetFileView ( crc32i ( aFileName.data(), aFileName.size() ) );
+    }
+    void Package::LoadFiles ( std::span<ResourceRead> aReads ) const
+    {
+        if ( mEntries.empty() )
+        {
+            // Loose files, one open each.
+            for ( ResourceRead& read : aReads )
             {
-                const int ret = InflateRegion ( file, e->data_offset, e->compressed_size,
-                                                buffer, buffer_size );
-                if ( ret != Z_OK )
+                read.mBytesRead = 0;
+                if ( mIndexTable.find ( read.mCrc ) != mIndexTable.end() )
                 {
-                    std::ostringstream oss;
-                    oss << "zlib inflate failed (code " << ret << ") for entry " << std::hex << crc;
-                    throw std::runtime_error ( oss.str() );
+                    LoadFile ( read.mCrc, read.mBuffer, read.mBufferSize );
+                    read.mBytesRead = std::min ( GetFileSize ( read.mCrc ), read.mBufferSize );
                 }
-                break;
             }
-            default:
+            return;
+        }
+        struct Compressed
+        {
+            const PKGDirectoryEntry* mEntry;
+            ResourceRead* mRead;
+            std::vector<uint8_t> mData;
+        };
+        std::vector<FileRange> ranges;
+        std::vector<Compressed> compressed;
+        ranges.reserve ( aReads.size() );
+        for ( ResourceRead& read : aReads )
+        {
+            read.mBytesRead = 0;
+            const PKGDirectoryEntry* e = FindEntry ( mEntries, read.mCrc );
+            if ( e == nullptr )
+            {
+                continue;
+            }
+            if ( mMapping != nullptr && e->data_offset + e->compressed_size > mMappingSize )
+            {
+                std::ostringstream oss;
+                oss << "Entry " << std::hex << read.mCrc << " runs past the end of " << mPath.string();
+                throw std::runtime_error ( oss.str() );
+            }
+            if ( e->compression == NONE )
+            {
+                read.mBytesRead = static_cast<size_t> ( std::min<uint64_t> ( e->compressed_size, read.mBufferSize ) );
+                ranges.push_back ( FileRange{e->data_offset, read.mBuffer, read.mBytesRead} );
+            }
+            else if ( IsCompressionSupported ( e->compression ) )
+            {
+                compressed.push_back ( Compressed{e, &read, std::vector<uint8_t> ( static_cast<size_t> ( e->compressed_size ) ) } );
+            }
+            else
             {
                 std::ostringstream oss;
                 oss << "Unsupported compression type " << static_cast<int> ( e->compression )
-                    << " for entry " << std::hex << crc;
+                    << " for entry " << std::hex << read.mCrc;
                 throw std::runtime_error ( oss.str() );
             }
+        }
+        // The scratch buffers are only taken once compressed stops growing.
+        for ( Compressed& entry : compressed )
+        {
+            ranges.push_back ( FileRange{entry.mEntry->data_offset, entry.mData.data(), entry.mData.size() } );
+        }
+        if ( mMapping != nullptr && IsResident ( mMapping, ranges ) )
+        {
+            // Warm: the bytes are a copy away, any read would only add system calls.
+            for ( const FileRange& range : ranges )
+            {
+                std::memcpy ( range.mBuffer, mMapping + range.mOffset, range.mSize );
             }
-            return;
         }
-        if ( std::filesystem::is_directory ( mPath ) )
+        else
         {
-            auto it = mIndexTable.find ( crc );
-            if ( it != mIndexTable.end() )
+            ReadFileRanges ( mPath, ranges );
+        }
+        std::atomic<const Compressed*> failed{nullptr};
+        const CompressionDictionary* dictionary = mDictionary.get();
+        GetJobSystem().ParallelFor ( 0, compressed.size(), 1, [&compressed, &failed, dictionary] ( size_t aBegin, size_t aEnd )
+        {
+            for ( size_t i = aBegin; i < aEnd; ++i )
             {
-                std::ifstream file;
-                file.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
-                file.open ( mPath / it->second, std::ifstream::in | std::ifstream::binary );
-                file.read ( reinterpret_cast<char*> ( buffer ), buffer_size );
-                file.close();
+                ResourceRead& read = *compressed[i].mRead;
+                if ( !DecompressBuffer ( compressed[i].mEntry->compression, compressed[i].mData, read.mBuffer, read.mBufferSize, dictionary ) )
+                {
+                    const Compressed* expected = nullptr;
+                    failed.compare_exchange_strong ( expected, &compressed[i] );
+                    continue;
+                }
+                read.mBytesRead = static_cast<size_t> ( std::min<uint64_t> ( compressed[i].mEntry->uncompressed_size, read.mBufferSize ) );
             }
+        } );
+        if ( const Compressed* entry = failed.load() )
+        {
+            std::ostringstream oss;
+            oss << GetCompressionName ( entry->mEntry->compression ) << " decompression failed for entry " << std::hex << entry->mEntry->crc << " in " << mPath.string();
+            throw std::runtime_error ( oss.str() );
         }
     }
 }
@@ -0,0 +1,149 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "aeongames/PoseCache.hpp"
+
+namespace AeonGames
+{
+    PoseCache::PoseCache() = default;
+    PoseCache::~PoseCache() = default;
+
+    size_t PoseCache::KeyHash::operator() ( const PoseCacheKey& aKey ) const
+    {
+        size_t hash = std::hash<const void*> {} ( aKey.mSkeleton );
+        const auto combine = [&hash] ( size_t aValue )
+        {
+            hash ^= aValue + 0x9e3779b97f4a7c15ull + ( hash << 6 ) + ( hash >> 2 );
+        };
+        combine ( std::hash<const void*> {} ( aKey.mAnimation ) );
+        combine ( std::hash<double> {} ( aKey.mSample ) );
+        combine ( std::hash<uint32_t> {} ( aKey.mCulledBoneHeight ) );
+        return hash;
+    }
+
+    void PoseCache::BeginFrame()
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        mEntries.clear();
+        mPoolUsed = 0;
+        mStatistics = {};
+    }
+
+    void PoseCache::SetEnabled ( bool aEnabled )
+    {
+        mEnabled = aEnabled;
+    }
+
+    bool PoseCache::IsEnabled() const
+    {
+        return mEnabled;
+    }
+
+    void PoseCache::SetSkinSharing ( bool aSkinSharing )
+    {
+        mSkinSharing = aSkinSharing;
+    }
+
+    bool PoseCache::GetSkinSharing() const
+    {
+        return mSkinSharing;
+    }
+
+    void PoseCache::SetQuantum ( double aFrames )
+    {
+        mQuantum = std::max ( aFrames, 0.0 );
+    }
+
+    double PoseCache::GetQuantum() const
+    {
+        return mQuantum;
+    }
+
+    double PoseCache::Quantize ( double aSample ) const
+    {
+        if ( mQuantum <= 0.0 )
+        {
+            return aSample;
+        }
+        return std::floor ( aSample / mQuantum ) * mQuantum;
+    }
+
+    PoseCacheEntry* PoseCache::Find ( const PoseCacheKey& aKey )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        ++mStatistics.mPoseLookups;
+        auto it = mEntries.find ( aKey );
+        if ( it == mEntries.end() )
+        {
+            return nullptr;
+        }
+        ++mStatistics.mPoseHits;
+        return it->second;
+    }
+
+    PoseCacheEntry* PoseCache::Insert ( const PoseCacheKey& aKey, std::span<const float> aMatrices )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        auto [it, inserted] = mEntries.try_emplace ( aKey, nullptr );
+        if ( !inserted )
+        {
+            return it->second;
+        }
+        if ( mPoolUsed == mPool.size() )
+        {
+            mPool.emplace_back ( std::make_unique<PoseCacheEntry>() );
+        }
+        PoseCacheEntry* entry = mPool[mPoolUsed++].get();
+        entry->mMatrices.assign ( aMatrices.begin(), aMatrices.end() );
+        entry->mSkinnedModel = nullptr;
+        entry->mSkinnedWindow = nullptr;
+        entry->mSkinnedVertices.clear();
+        it->second = entry;
+        return entry;
+    }
+
+    std::span<const BufferAccessor> PoseCache::FindSkin ( const PoseCacheEntry& aEntry, const void* aModel, void* aWindowId )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        ++mStatistics.mSkinLookups;
+        if ( !mSkinSharing || aEntry.mSkinnedModel != aModel || aEntry.mSkinnedWindow != aWindowId )
+        {
+            return {};
+        }
+        ++mStatistics.mSkinHits;
+        return aEntry.mSkinnedVertices;
+    }
+
+    void PoseCache::InsertSkin ( PoseCacheEntry& aEntry, const void* aModel, void* aWindowId, std::span<const BufferAccessor> aSkinnedVertices )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        if ( !mSkinSharing || aEntry.mSkinnedModel != nullptr )
+        {
+            return;
+        }
+        aEntry.mSkinnedModel = aModel;
+        aEntry.mSkinnedWindow = aWindowId;
+        aEntry.mSkinnedVertices.assign ( aSkinnedVertices.begin(), aSkinnedVertices.end() );
+    }
+
+    PoseCacheStatistics PoseCache::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return mStatistics;
+    }
+}
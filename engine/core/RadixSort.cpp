@@ -0,0 +1,85 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <array>
+#include <cstddef>
+#include <utility>
+#include "aeongames/RadixSort.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// Below this many keys a stable insertion sort beats the histogram setup.
+        constexpr size_t kInsertionSortThreshold = 64;
+    }
+
+    void RadixSort ( std::vector<SortKey>& aKeys, std::vector<SortKey>& aScratch )
+    {
+        const size_t count = aKeys.size();
+        if ( count <= kInsertionSortThreshold )
+        {
+            for ( size_t i = 1; i < count; ++i )
+            {
+                const SortKey key = aKeys[i];
+                size_t j = i;
+                while ( j > 0 && aKeys[j - 1].mKey > key.mKey )
+                {
+                    aKeys[j] = aKeys[j - 1];
+                    --j;
+                }
+                aKeys[j] = key;
+            }
+            return;
+        }
+        std::array<std::array<size_t, 256>, 8> histograms{};
+        for ( const SortKey& key : aKeys )
+        {
+            for ( size_t byte = 0; byte < 8; ++byte )
+            {
+                ++histograms[byte][ ( key.mKey >> ( byte * 8 ) ) & 0xff];
+            }
+        }
+        aScratch.resize ( count );
+        SortKey* source = aKeys.data();
+        SortKey* destination = aScratch.data();
+        for ( size_t byte = 0; byte < 8; ++byte )
+        {
+            std::array<size_t, 256>& histogram = histograms[byte];
+            // Every key shares this byte, the pass would not move anything.
+            if ( histogram[ ( source[0].mKey >> ( byte * 8 ) ) & 0xff] == count )
+            {
+                continue;
+            }
+            size_t offset = 0;
+            for ( size_t& bucket : histogram )
+            {
+                const size_t bucket_count = bucket;
+                bucket = offset;
+                offset += bucket_count;
+            }
+            for ( size_t i = 0; i < count; ++i )
+            {
+                destination[histogram[ ( source[i].mKey >> ( byte * 8 ) ) & 0xff]++] = source[i];
+            }
+            std::swap ( source, destination );
+        }
+        // An odd number of passes leaves the result in the scratch buffer.
+        if ( source != aKeys.data() )
+        {
+            aKeys.swap ( aScratch );
+        }
+    }
+}
@@ -21,11 +21,15 @@ limitations under the License.
 #include "aeongames/Mesh.hpp"
 #include "aeongames/Pipeline.hpp"
 #include "aeongames/Material.hpp"
+#include "aeongames/Texture.hpp"
+#include "aeongames/ResourceCache.hpp"
 #include "aeongames/AABB.hpp"
 #include "aeongames/Transform.hpp"
 #include "aeongames/Frustum.hpp"
 #include "aeongames/CRC.hpp"
 #include <algorithm>
+#include <array>
+#include <span>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
@@ -33,7 +37,35 @@ limitations under the License.
 
 namespace AeonGames
 {
-    Renderer::~Renderer() = default;
+    namespace
+    {
+        /// Views RenderScene culls per frame: every spot and point shadow
+        /// caster, the directional shadow and the camera.
+        constexpr size_t kMaxFrameViews = MAX_SPOT_SHADOW_CASTERS + MAX_POINT_SHADOW_CASTERS + 2;
+        static_assert ( kMaxFrameViews <= Octree::kMaxQueryViews, "Frame views exceed a single multi-view cull." );
+    }
+
+    Renderer::Renderer() : mEvictionListener
+    {
+        AddResourceEvictionListener ( [this] ( uint32_t, const UniqueAnyPtr & aResource )
+        {
+            if ( aResource.HasType<Mesh>() )
+            {
+                UnloadMesh ( *aResource.Get<Mesh>() );
+            }
+            else if ( aResource.HasType<Texture>() )
+            {
+                UnloadTexture ( *aResource.Get<Texture>() );
+            }
+        } )
+    }
+    {
+    }
+
+    Renderer::~Renderer()
+    {
+        RemoveResourceEvictionListener ( mEvictionListener );
+    }
 
     std::unique_ptr<Renderer> ConstructRenderer ( uint32_t aIdentifier, void* aWindow, const RendererSettings& aSettings )
     {
@@ -89,6 +121,74 @@ namespace AeonGames
         mBenchmarkFrameRecorded = mBenchmarkActive && ( lighting != nullptr );
         BeginRender ( aWindowId, lighting );
         MaybeRecordTimestamp ( aWindowId, 0 );
+        // Every view of the frame -- each shadow caster plus the camera -- is
+        // gathered first and culled in a single scene walk, so each node is
+        // tested once against all views and collected at most once. The
+        // passes below then only select their view's queue and submit it.
+        std::array<Frustum, kMaxFrameViews> views{};
+        size_t view_count = 0;
+        GpuSpotShadowParams spot_shadow_params{};
+        uint32_t spot_caster_count = 0;
+        GpuPointShadowParams point_shadow_params{};
+        uint32_t point_caster_count = 0;
+        // Point casters whose cached cube map must be re-rendered this frame.
+        std::array<bool, MAX_POINT_SHADOW_CASTERS> point_caster_dirty{};
+        uint64_t shadow_geometry_signature = 0;
+        Matrix4x4 light_view_projection;
+        bool directional_shadow = false;
+        if ( lighting )
+        {
+            spot_caster_count = aScene.GetSpotShadowCasters ( spot_shadow_params, GetSettings().mSpotShadowMapResolution );
+            for ( uint32_t slot = 0; slot < spot_caster_count; ++slot )
+            {
+                views[view_count++] = Frustum ( spot_shadow_params.spot_light_view_projection[slot] );
+            }
+            // Each point caster's cube map is cached: it is only re-rendered when
+            // the caster's light (position/radius) or some shadow-casting geometry
+            // actually changed since it was last drawn. The depth image persists
+            // between frames, so an unchanged caster reuses its previous map and
+            // skips the pass -- on a static scene the point shadow maps are
+            // rendered once and then sampled for free every frame, even while the
+            // camera moves. Skipped casters need no view either.
+            point_caster_count = aScene.GetPointShadowCasters ( point_shadow_params, GetSettings().mPointShadowMapResolution );
+            shadow_geometry_signature = aScene.GetShadowGeometrySignature();
+            auto& point_cache = mPointShadowCache[aWindowId];
+            for ( uint32_t caster = 0; caster < point_caster_count; ++caster )
+            {
+                const PointShadowCacheEntry& entry = point_cache[caster];
+                point_caster_dirty[caster] = ! ( entry.rendered &&
+                                                 entry.geometry_signature == shadow_geometry_signature &&
+                                                 entry.light_position_radius == point_shadow_params.caster_position_radius[caster] );
+                if ( !point_caster_dirty[caster] )
+                {
+                    continue;
+                }
+                // The whole sphere is rendered in one pass, so cull once to a box
+                // that bounds the caster's shadow sphere (a point light has no
+                // single frustum; the axis-aligned box is a conservative superset).
+                const Vector4& caster_position_radius = point_shadow_params.caster_position_radius[caster];
+                const float radius = caster_position_radius.GetW();
+                Matrix4x4 caster_bounds;
+                caster_bounds.Ortho (
+                    caster_position_radius.GetX() - radius, caster_position_radius.GetX() + radius,
+                    caster_position_radius.GetZ() - radius, caster_position_radius.GetZ() + radius,
+                    caster_position_radius.GetY() - radius, caster_position_radius.GetY() + radius );
+                views[view_count++] = Frustum ( caster_bounds );
+            }
+            // The shadow map must contain every caster the light can see, NOT
+            // just what the camera sees, so the directional view is the light's
+            // orthographic frustum. Reusing the camera frustum would make casters
+            // outside the view pop in and out as the camera moves.
+            directional_shadow = aScene.GetDirectionalShadowMatrix ( light_view_projection, GetProjectionMatrix ( aWindowId ), GetSettings().mDirectionalShadowMapResolution );
+            if ( directional_shadow )
+            {
+                views[view_count++] = Frustum ( light_view_projection );
+            }
+        }
+        const size_t camera_view = view_count;
+        views[view_count++] = GetFrustum ( aWindowId );
+        aScene.BuildRenderQueues ( std::span<const Frustum> ( views.data(), view_count ) );
+        size_t view = 0;
         if ( lighting )
         {
             // Spot shadow passes: render each spot shadow caster's depth into its
@@ -97,15 +197,11 @@ namespace AeonGames
             // depth pass reuses the window's ShadowParams matrix as scratch for
             // the depth vertex shader, so the directional pass must write it LAST
             // to leave the directional matrix in place for the shading pass.
-            GpuSpotShadowParams spot_shadow_params{};
-            const uint32_t spot_caster_count = aScene.GetSpotShadowCasters ( spot_shadow_params, GetSettings().mSpotShadowMapResolution );
             SetSpotShadowParams ( aWindowId, spot_shadow_params );
             for ( uint32_t slot = 0; slot < spot_caster_count; ++slot )
             {
-                const Matrix4x4 spot_light_view_projection =
-                    spot_shadow_params.spot_light_view_projection[slot];
-                aScene.BuildRenderQueue ( Frustum ( spot_light_view_projection ) );
-                BeginSpotShadowPass ( aWindowId, slot, spot_light_view_projection );
+                aScene.SelectRenderQueue ( view++ );
+                BeginSpotShadowPass ( aWindowId, slot, spot_shadow_params.spot_light_view_projection[slot] );
                 SubmitRenderQueue ( aWindowId, aScene, RenderPass::ShadowPass );
                 EndSpotShadowPass ( aWindowId );
             }
@@ -113,67 +209,38 @@ namespace AeonGames
             // six cube faces are rendered in a single draw -- Vulkan multiview
             // (one view per face) or an OpenGL geometry shader -- into the
             // caster's six cube-map-array layers.
-            //
-            // Each caster's cube map is cached: it is only re-rendered when the
-            // caster's light (position/radius) or some shadow-casting geometry
-            // actually changed since it was last drawn. The depth image persists
-            // between frames, so an unchanged caster reuses its previous map and
-            // skips the pass -- on a static scene the point shadow maps are
-            // rendered once and then sampled for free every frame, even while the
-            // camera moves.
-            GpuPointShadowParams point_shadow_params{};
-            const uint32_t point_caster_count = aScene.GetPointShadowCasters ( point_shadow_params, GetSettings().mPointShadowMapResolution );
             SetPointShadowParams ( aWindowId, point_shadow_params );
-            const uint64_t shadow_geometry_signature = aScene.GetShadowGeometrySignature();
             auto& point_cache = mPointShadowCache[aWindowId];
             for ( uint32_t caster = 0; caster < point_caster_count; ++caster )
             {
-                PointShadowCacheEntry& entry = point_cache[caster];
-                if ( entry.rendered &&
-                     entry.geometry_signature == shadow_geometry_signature &&
-                     entry.light_position_radius == point_shadow_params.caster_position_radius[caster] )
+                if ( !point_caster_dirty[caster] )
                 {
                     // Nothing this caster sees changed; reuse its cached cube map.
                     continue;
                 }
-                // The whole sphere is rendered in one pass, so cull once to a box
-                // that bounds the caster's shadow sphere (a point light has no
-                // single frustum; the axis-aligned box is a conservative superset).
-                const Vector4& caster_position_radius = point_shadow_params.caster_position_radius[caster];
-                const float radius = caster_position_radius.GetW();
-                Matrix4x4 caster_bounds;
-                caster_bounds.Ortho (
-                    caster_position_radius.GetX() - radius, caster_position_radius.GetX() + radius,
-                    caster_position_radius.GetZ() - radius, caster_position_radius.GetZ() + radius,
-                    caster_position_radius.GetY() - radius, caster_position_radius.GetY() + radius );
-                aScene.BuildRenderQueue ( Frustum ( caster_bounds ) );
+                aScene.SelectRenderQueue ( view++ );
                 BeginPointShadowPass ( aWindowId, caster );
                 SubmitRenderQueue ( aWindowId, aScene, RenderPass::ShadowPass );
                 EndPointShadowPass ( aWindowId );
+                PointShadowCacheEntry& entry = point_cache[caster];
                 entry.light_position_radius = point_shadow_params.caster_position_radius[caster];
                 entry.geometry_signature = shadow_geometry_signature;
                 entry.rendered = true;
             }
             // Directional shadow pass: render scene depth from the sun's point of
             // view into the shadow map before shading so the fragment stage can
-            // sample it. The shadow map must contain every caster the light can
-            // see, NOT just what the camera sees, so the queue is culled to the
-            // light's orthographic frustum here. Reusing the camera frustum would
-            // make casters outside the view pop in and out as the camera moves.
-            Matrix4x4 light_view_projection;
-            if ( aScene.GetDirectionalShadowMatrix ( light_view_projection, GetProjectionMatrix ( aWindowId ), GetSettings().mDirectionalShadowMapResolution ) )
+            // sample it.
+            if ( directional_shadow )
             {
-                aScene.BuildRenderQueue ( Frustum ( light_view_projection ) );
+                aScene.SelectRenderQueue ( view++ );
                 BeginShadowPass ( aWindowId, light_view_projection );
                 SubmitRenderQueue ( aWindowId, aScene, RenderPass::ShadowPass );
                 EndShadowPass ( aWindowId );
             }
         }
-        // Collect every camera-visible draw; the queue feeds both the depth
-        // pre-pass and the shading pass, merging sorted runs into instanced
-        // draws on submit. Built after the shadow pass, which uses its own
-        // light-space queue.
-        aScene.BuildRenderQueue ( GetFrustum ( aWindowId ) );
+        // The camera queue feeds both the depth pre-pass and the shading pass,
+        // merging sorted runs into instanced draws on submit.
+        aScene.SelectRenderQueue ( camera_view );
         if ( lighting )
         {
             // Depth pre-pass: flag clusters containing visible geometry with the
@@ -14,6 +14,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include <atomic>
+#include <memory>
+#include <vector>
 #include "aeongames/Resource.hpp"
 #include "aeongames/ResourceCache.hpp"
 #include "aeongames/AeonEngine.hpp"
@@ -29,9 +31,22 @@ namespace AeonGames
 
     void Resource::LoadFromId ( uint32_t aId )
     {
-        std::vector<uint8_t> buffer ( GetResourceSize ( aId ), 0 );
-        LoadResource ( aId, buffer.data(), buffer.size() );
-        LoadFromMemory ( buffer.data(), buffer.size() );
+        std::shared_ptr<const void> owner;
+        const std::span<const uint8_t> view = GetResourceView ( aId, owner );
+        if ( !view.empty() )
+        {
+            // Parse straight out of the package mapping.
+            LoadFromView ( view, owner );
+            return;
+        }
+        auto buffer = std::make_shared<std::vector<uint8_t>> ( GetResourceSize ( aId ), 0 );
+        LoadResource ( aId, buffer->data(), buffer->size() );
+        LoadFromView ( *buffer, buffer );
+    }
+
+    void Resource::LoadFromView ( std::span<const uint8_t> aBuffer, const std::shared_ptr<const void>& )
+    {
+        LoadFromMemory ( aBuffer.data(), aBuffer.size() );
     }
 
     void Resource::LoadFromFile ( const std::string& aFilename )
@@ -44,6 +59,11 @@ namespace AeonGames
         LoadFromId ( crc );
     }
 
+    size_t Resource::GetMemoryUsage() const
+    {
+        return 0;
+    }
+
     size_t Resource::GetConsecutiveId() const
     {
         return mConsecutiveId;
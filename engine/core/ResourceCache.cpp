@@ -13,52 +13,331 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "aeongames/ResourceCache.hpp"
 #include "aeongames/ResourceFactory.hpp"
 #include "aeongames/ResourceId.hpp"
 
 namespace AeonGames
 {
-    static std::unordered_map<uint32_t, UniqueAnyPtr> gResourceStore{};
+    namespace
+    {
+        struct CacheEntry
+        {
+            CacheEntry ( UniqueAnyPtr&& aResource, uint32_t aType, size_t aSize, uint64_t aLastUse ) :
+                mResource{std::move ( aResource ) }, mType{aType}, mSize{aSize}, mLastUse{aLastUse} {}
+            UniqueAnyPtr mResource;
+            uint32_t mType;
+            /// Measured bytes; unmeasured (zero) entries are never evicted.
+            size_t mSize;
+            /// Value of gResourceClock at the last lookup, written under the shared lock.
+            std::atomic<uint64_t> mLastUse;
+        };
+
+        /** One slice of the store. Keys are CRC32 values, so their low bits
+            spread evenly over the shards and unrelated lookups on different
+            threads rarely meet on the same lock. References handed out stay
+            valid across inserts (node based maps), only lookups and
+            modifications need the lock. Resources are never destroyed with a
+            lock held: a model releases the resources it references from its
+            destructor. */
+        struct alignas ( 64 ) ResourceShard
+        {
+            std::shared_mutex mMutex{};
+            std::unordered_map<uint32_t, CacheEntry> mEntries{};
+            /// Outstanding AcquireResource counts.
+            std::unordered_map<uint32_t, uint32_t> mReferences{};
+            /// Constructions in progress, so concurrent loads of one id share a single one.
+            std::unordered_map<uint32_t, std::shared_future<void >> mLoading{};
+            std::unordered_map<uint32_t, size_t> mBytesByType{};
+            std::atomic<uint64_t> mHits{0};
+            std::atomic<uint64_t> mMisses{0};
+        };
+
+        constexpr size_t kResourceShardCount = 16;
+        static_assert ( ( kResourceShardCount & ( kResourceShardCount - 1 ) ) == 0, "Shard count must be a power of two." );
+    }
+
+    static std::array<ResourceShard, kResourceShardCount> gResourceShards{};
+    static std::atomic<size_t> gResourceBytes{0};
+    static std::atomic<size_t> gResourceBudget{0};
+    /* Advanced by every insertion and every trim rather than every lookup,
+       so lookups only read it. Entries used since the last advance tie,
+       which only blurs the order among the most recently used. */
+    static std::atomic<uint64_t> gResourceClock{0};
+    static std::atomic<uint64_t> gResourceEvictions{0};
+    static thread_local ResourceStaging* tResourceStaging{nullptr};
+    static std::mutex gEvictionListenersMutex{};
+    static std::vector<std::pair<size_t, ResourceEvictionListener >> gEvictionListeners{};
+    static size_t gNextEvictionListener{0};
+
+    static ResourceShard& GetShard ( uint32_t aKey )
+    {
+        return gResourceShards[aKey & ( kResourceShardCount - 1 )];
+    }
+
+    /// Marks an entry used; the caller holds its shard's lock, shared or exclusive.
+    static const UniqueAnyPtr& TouchResource ( ResourceShard& aShard, CacheEntry& aEntry )
+    {
+        aShard.mHits.fetch_add ( 1, std::memory_order_relaxed );
+        const uint64_t now = gResourceClock.load ( std::memory_order_relaxed );
+        // Skip the store when unchanged, so hot entries stay shared in every core's cache.
+        if ( aEntry.mLastUse.load ( std::memory_order_relaxed ) != now )
+        {
+            aEntry.mLastUse.store ( now, std::memory_order_relaxed );
+        }
+        return aEntry.mResource;
+    }
+
+    static const UniqueAnyPtr* FindResource ( uint32_t aKey )
+    {
+        if ( tResourceStaging )
+        {
+            auto i = tResourceStaging->find ( aKey );
+            if ( i != tResourceStaging->end() )
+            {
+                return &i->second.mResource;
+            }
+        }
+        ResourceShard& shard = GetShard ( aKey );
+        std::shared_lock<std::shared_mutex> lock ( shard.mMutex );
+        auto i = shard.mEntries.find ( aKey );
+        if ( i != shard.mEntries.end() )
+        {
+            return &TouchResource ( shard, i->second );
+        }
+        shard.mMisses.fetch_add ( 1, std::memory_order_relaxed );
+        return nullptr;
+    }
+
+    /// Inserts unless the key is taken; the caller holds the shard's exclusive lock.
+    static std::pair<const UniqueAnyPtr*, bool> InsertResource ( ResourceShard& aShard, uint32_t aKey, uint32_t aType, size_t aSize, UniqueAnyPtr& aResource )
+    {
+        auto i = aShard.mEntries.find ( aKey );
+        if ( i != aShard.mEntries.end() )
+        {
+            return { &i->second.mResource, false };
+        }
+        i = aShard.mEntries.try_emplace ( aKey, std::move ( aResource ), aType, aSize, gResourceClock.fetch_add ( 1, std::memory_order_relaxed ) + 1 ).first;
+        if ( aSize != 0 )
+        {
+            gResourceBytes.fetch_add ( aSize );
+            aShard.mBytesByType[aType] += aSize;
+        }
+        return { &i->second.mResource, true };
+    }
+
+    /// Unaccounts and removes an entry; the caller holds the shard's exclusive lock and destroys the result after unlocking.
+    static UniqueAnyPtr EraseResource ( ResourceShard& aShard, std::unordered_map<uint32_t, CacheEntry>::iterator aEntry )
+    {
+        UniqueAnyPtr result{};
+        result.Swap ( aEntry->second.mResource );
+        if ( aEntry->second.mSize != 0 )
+        {
+            gResourceBytes.fetch_sub ( aEntry->second.mSize );
+            auto bytes = aShard.mBytesByType.find ( aEntry->second.mType );
+            if ( ( bytes->second -= aEntry->second.mSize ) == 0 )
+            {
+                aShard.mBytesByType.erase ( bytes );
+            }
+        }
+        aShard.mEntries.erase ( aEntry );
+        return result;
+    }
+
+    void SetResourceStaging ( ResourceStaging* aStaging )
+    {
+        tResourceStaging = aStaging;
+    }
+
+    size_t CommitResourceStaging ( ResourceStaging& aStaging )
+    {
+        size_t committed = 0;
+        for ( auto& i : aStaging )
+        {
+            if ( !i.second.mResource.GetRaw() )
+            {
+                continue;
+            }
+            // Measure before taking the lock, measuring runs resource code.
+            const size_t size = MeasureResource ( i.second.mType, i.second.mResource );
+            ResourceShard& shard = GetShard ( i.first );
+            std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+            if ( InsertResource ( shard, i.first, i.second.mType, size, i.second.mResource ).second )
+            {
+                ++committed;
+            }
+        }
+        // Whatever was not moved lost the race to a synchronous load.
+        aStaging.clear();
+        return committed;
+    }
 
     void ClearAllResources()
     {
-        gResourceStore.clear();
+        for ( ResourceShard& shard : gResourceShards )
+        {
+            std::unordered_map<uint32_t, CacheEntry> entries{};
+            {
+                std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+                entries.swap ( shard.mEntries );
+                for ( const auto& bytes : shard.mBytesByType )
+                {
+                    gResourceBytes.fetch_sub ( bytes.second );
+                }
+                shard.mBytesByType.clear();
+            }
+        }
     }
 
     void EnumerateResources ( const std::function<bool ( uint32_t, const UniqueAnyPtr& ) >& aEnumerator )
     {
-        for ( auto& i : gResourceStore )
+        for ( ResourceShard& shard : gResourceShards )
         {
-            if ( !aEnumerator ( i.first, i.second ) )
+            std::shared_lock<std::shared_mutex> lock ( shard.mMutex );
+            for ( auto& i : shard.mEntries )
             {
-                return;
+                if ( !aEnumerator ( i.first, i.second.mResource ) )
+                {
+                    return;
+                }
             }
         }
     }
 
-    const UniqueAnyPtr& StoreResource ( uint32_t aKey, UniqueAnyPtr&& pointer )
+    static const UniqueAnyPtr& StoreTypedResource ( uint32_t aKey, uint32_t aType, UniqueAnyPtr&& pointer )
     {
         static const UniqueAnyPtr unique_nullptr{nullptr};
         // Don't store nullptrs
-        if ( pointer.GetRaw() )
+        if ( !pointer.GetRaw() )
         {
-            // emplace returns an iterator to the stored element, so return it
-            // directly instead of a second hash lookup via operator[].
-            return gResourceStore.emplace ( aKey, std::move ( pointer ) ).first->second;
+            return unique_nullptr;
+        }
+        if ( tResourceStaging )
+        {
+            if ( const UniqueAnyPtr* stored = FindResource ( aKey ) )
+            {
+                return *stored;
+            }
+            return tResourceStaging->emplace ( aKey, StagedResource{aType, std::move ( pointer ) } ).first->second.mResource;
+        }
+        const size_t size = aType ? MeasureResource ( aType, pointer ) : 0;
+        ResourceShard& shard = GetShard ( aKey );
+        std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+        // A resource that lost the race stays in pointer and is destroyed by the caller.
+        return *InsertResource ( shard, aKey, aType, size, pointer ).first;
+    }
+
+    const UniqueAnyPtr& StoreResource ( uint32_t aKey, UniqueAnyPtr&& pointer )
+    {
+        return StoreTypedResource ( aKey, 0, std::move ( pointer ) );
+    }
+
+    const UniqueAnyPtr& StoreResource ( const ResourceId& aResourceId, UniqueAnyPtr&& pointer )
+    {
+        return StoreTypedResource ( aResourceId.GetPath(), aResourceId.GetType(), std::move ( pointer ) );
+    }
+
+    const UniqueAnyPtr& StoreResource ( const ResourceId& aResourceId )
+    {
+        static const UniqueAnyPtr unique_nullptr{nullptr};
+        const uint32_t key = aResourceId.GetPath();
+        if ( tResourceStaging )
+        {
+            // Streaming loaders stage privately, their result is not the store's to share yet.
+            if ( const UniqueAnyPtr* stored = FindResource ( key ) )
+            {
+                return *stored;
+            }
+            return StoreTypedResource ( key, aResourceId.GetType(), ConstructResource ( aResourceId ) );
+        }
+        ResourceShard& shard = GetShard ( key );
+        // Callers look the resource up first, so the miss is already counted.
+        for ( ;; )
+        {
+            std::shared_future<void> loading;
+            std::promise<void> constructed;
+            {
+                std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+                auto i = shard.mEntries.find ( key );
+                if ( i != shard.mEntries.end() )
+                {
+                    return TouchResource ( shard, i->second );
+                }
+                auto in_progress = shard.mLoading.find ( key );
+                if ( in_progress != shard.mLoading.end() )
+                {
+                    loading = in_progress->second;
+                }
+                else
+                {
+                    shard.mLoading.emplace ( key, constructed.get_future().share() );
+                }
+            }
+            if ( loading.valid() )
+            {
+                // Someone else is constructing it; share their result or their exception.
+                loading.get();
+                continue;
+            }
+            UniqueAnyPtr resource{};
+            size_t size{};
+            try
+            {
+                resource = ConstructResource ( aResourceId );
+                size = MeasureResource ( aResourceId.GetType(), resource );
+            }
+            catch ( ... )
+            {
+                {
+                    std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+                    shard.mLoading.erase ( key );
+                }
+                constructed.set_exception ( std::current_exception() );
+                throw;
+            }
+            const UniqueAnyPtr* stored = &unique_nullptr;
+            {
+                std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+                shard.mLoading.erase ( key );
+                if ( resource.GetRaw() )
+                {
+                    stored = InsertResource ( shard, key, aResourceId.GetType(), size, resource ).first;
+                }
+            }
+            constructed.set_value();
+            return *stored;
         }
-        return unique_nullptr;
     }
 
     UniqueAnyPtr DisposeResource ( uint32_t aKey )
     {
         UniqueAnyPtr result{};
-        auto i = gResourceStore.find ( aKey );
-        if ( i != gResourceStore.end() )
+        if ( tResourceStaging )
+        {
+            auto i = tResourceStaging->find ( aKey );
+            if ( i != tResourceStaging->end() )
+            {
+                result.Swap ( ( *i ).second.mResource );
+                tResourceStaging->erase ( i );
+                return result;
+            }
+        }
+        ResourceShard& shard = GetShard ( aKey );
+        std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+        auto i = shard.mEntries.find ( aKey );
+        if ( i != shard.mEntries.end() )
         {
-            result.Swap ( ( *i ).second );
-            gResourceStore.erase ( i );
+            result = EraseResource ( shard, i );
         }
         return result;
     }
@@ -66,21 +345,150 @@ namespace AeonGames
     const UniqueAnyPtr& GetResource ( uint32_t aKey )
     {
         static const UniqueAnyPtr unique_nullptr{nullptr};
-        auto i = gResourceStore.find ( aKey );
-        if ( i != gResourceStore.end() )
+        if ( const UniqueAnyPtr* resource = FindResource ( aKey ) )
         {
-            return ( *i ).second;
+            return *resource;
         }
         return unique_nullptr;
     }
 
     const UniqueAnyPtr& GetResource ( const ResourceId& aResourceId )
     {
-        auto i = gResourceStore.find ( aResourceId.GetPath() );
-        if ( i != gResourceStore.end() )
+        if ( const UniqueAnyPtr* resource = FindResource ( aResourceId.GetPath() ) )
         {
-            return ( *i ).second;
+            return *resource;
         }
         return GetDefaultResource ( aResourceId.GetType() );
     }
+
+    void AcquireResource ( uint32_t aKey )
+    {
+        ResourceShard& shard = GetShard ( aKey );
+        std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+        ++shard.mReferences[aKey];
+    }
+
+    void ReleaseResource ( uint32_t aKey )
+    {
+        ResourceShard& shard = GetShard ( aKey );
+        std::unique_lock<std::shared_mutex> lock ( shard.mMutex );
+        auto i = shard.mReferences.find ( aKey );
+        if ( i != shard.mReferences.end() && --i->second == 0 )
+        {
+            shard.mReferences.erase ( i );
+        }
+    }
+
+    uint32_t GetResourceReferenceCount ( uint32_t aKey )
+    {
+        ResourceShard& shard = GetShard ( aKey );
+        std::shared_lock<std::shared_mutex> lock ( shard.mMutex );
+        auto i = shard.mReferences.find ( aKey );
+        return ( i != shard.mReferences.end() ) ? i->second : 0;
+    }
+
+    void SetResourceBudget ( size_t aBytes )
+    {
+        gResourceBudget.store ( aBytes );
+    }
+
+    size_t TrimResources()
+    {
+        const size_t budget = gResourceBudget.load();
+        if ( budget == 0 || gResourceBytes.load() <= budget )
+        {
+            return 0;
+        }
+        std::vector<std::pair<uint32_t, UniqueAnyPtr >> evicted;
+        {
+            // Rare and at the frame boundary, so simply hold every shard.
+            std::array<std::unique_lock<std::shared_mutex>, kResourceShardCount> locks;
+            for ( size_t i = 0; i < kResourceShardCount; ++i )
+            {
+                locks[i] = std::unique_lock<std::shared_mutex> ( gResourceShards[i].mMutex );
+            }
+            std::vector<std::pair<uint64_t, uint32_t >> candidates;
+            for ( ResourceShard& shard : gResourceShards )
+            {
+                for ( auto& i : shard.mEntries )
+                {
+                    if ( i.second.mSize != 0 && shard.mReferences.find ( i.first ) == shard.mReferences.end() )
+                    {
+                        candidates.emplace_back ( i.second.mLastUse.load ( std::memory_order_relaxed ), i.first );
+                    }
+                }
+            }
+            std::sort ( candidates.begin(), candidates.end() );
+            for ( const auto& candidate : candidates )
+            {
+                if ( gResourceBytes.load() <= budget )
+                {
+                    break;
+                }
+                ResourceShard& shard = GetShard ( candidate.second );
+                evicted.emplace_back ( candidate.second, EraseResource ( shard, shard.mEntries.find ( candidate.second ) ) );
+            }
+            gResourceClock.fetch_add ( 1, std::memory_order_relaxed );
+        }
+        gResourceEvictions.fetch_add ( evicted.size() );
+        {
+            // Renderers drop GPU copies keyed by the resources about to go.
+            std::lock_guard<std::mutex> lock ( gEvictionListenersMutex );
+            for ( const auto& listener : gEvictionListeners )
+            {
+                for ( const auto& resource : evicted )
+                {
+                    listener.second ( resource.first, resource.second );
+                }
+            }
+        }
+        // Destroying an evicted model releases its references, which takes the locks again.
+        return evicted.size();
+    }
+
+    size_t AddResourceEvictionListener ( ResourceEvictionListener aListener )
+    {
+        std::lock_guard<std::mutex> lock ( gEvictionListenersMutex );
+        gEvictionListeners.emplace_back ( ++gNextEvictionListener, std::move ( aListener ) );
+        return gNextEvictionListener;
+    }
+
+    void RemoveResourceEvictionListener ( size_t aHandle )
+    {
+        std::lock_guard<std::mutex> lock ( gEvictionListenersMutex );
+        gEvictionListeners.erase ( std::remove_if ( gEvictionListeners.begin(), gEvictionListeners.end(), [aHandle] ( const auto & aListener )
+        {
+            return aListener.first == aHandle;
+        } ), gEvictionListeners.end() );
+    }
+
+    ResourceCacheStatistics GetResourceCacheStatistics()
+    {
+        ResourceCacheStatistics statistics{};
+        statistics.mEvictions = gResourceEvictions.load();
+        statistics.mBudget = gResourceBudget.load();
+        statistics.mBytes = gResourceBytes.load();
+        for ( ResourceShard& shard : gResourceShards )
+        {
+            statistics.mHits += shard.mHits.load();
+            statistics.mMisses += shard.mMisses.load();
+            std::shared_lock<std::shared_mutex> lock ( shard.mMutex );
+            statistics.mCount += shard.mEntries.size();
+            for ( const auto& bytes : shard.mBytesByType )
+            {
+                statistics.mBytesByType[bytes.first] += bytes.second;
+            }
+        }
+        return statistics;
+    }
+
+    void ResetResourceCacheStatistics()
+    {
+        for ( ResourceShard& shard : gResourceShards )
+        {
+            shard.mHits.store ( 0 );
+            shard.mMisses.store ( 0 );
+        }
+        gResourceEvictions.store ( 0 );
+    }
 }
@@ -0,0 +1,339 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include "ResourceDirectory.h"
+#include "aeongames/Package.hpp"
+
+namespace AeonGames
+{
+    ResourceDirectory::ResourceDirectory() = default;
+    ResourceDirectory::~ResourceDirectory() = default;
+
+    // CRCs of similar paths differ in few bits, spread them with a
+    // Fibonacci multiply and keep the top bits.
+    static size_t Spread ( uint32_t aCrc, uint32_t aShift )
+    {
+        return static_cast<size_t> ( ( static_cast<uint64_t> ( aCrc ) * 0x9E3779B97F4A7C15ull ) >> aShift );
+    }
+
+    size_t ResourceDirectory::GetHome ( uint32_t aCrc ) const
+    {
+        return Spread ( aCrc, mShift );
+    }
+
+    size_t ResourceDirectory::Probe ( uint32_t aCrc ) const
+    {
+        const size_t mask = mSlots.size() - 1;
+        size_t slot = GetHome ( aCrc );
+        while ( mSlots[slot].mPackage != kEmpty && mSlots[slot].mCrc != aCrc )
+        {
+            slot = ( slot + 1 ) & mask;
+        }
+        return slot;
+    }
+
+    void ResourceDirectory::Reserve ( size_t aCount )
+    {
+        // At most half full keeps probe sequences a slot or two long.
+        if ( aCount * 2 <= mSlots.size() )
+        {
+            return;
+        }
+        const size_t capacity = std::bit_ceil ( std::max<size_t> ( aCount * 2, 16 ) );
+        std::vector<Slot> slots ( capacity, Slot{0, kEmpty, 0} );
+        std::swap ( slots, mSlots );
+        mShift = 64 - static_cast<uint32_t> ( std::countr_zero ( capacity ) );
+        for ( const Slot& slot : slots )
+        {
+            if ( slot.mPackage != kEmpty )
+            {
+                mSlots[Probe ( slot.mCrc )] = slot;
+            }
+        }
+    }
+
+    void ResourceDirectory::Insert ( uint32_t aCrc, uint32_t aPackage, uint32_t aEntry )
+    {
+        Slot& slot = mSlots[Probe ( aCrc )];
+        if ( slot.mPackage == kEmpty )
+        {
+            slot = Slot{aCrc, aPackage, aEntry};
+            ++mCount;
+        }
+        else if ( mMounted[aPackage].mRank < mMounted[slot.mPackage].mRank )
+        {
+            slot.mPackage = aPackage;
+            slot.mEntry = aEntry;
+        }
+    }
+
+    void ResourceDirectory::Erase ( size_t aSlot )
+    {
+        // Backward shift: pull later members of the probe run into the hole
+        // so lookups never need tombstones.
+        const size_t mask = mSlots.size() - 1;
+        size_t hole = aSlot;
+        size_t next = aSlot;
+        for ( ;; )
+        {
+            mSlots[hole].mPackage = kEmpty;
+            for ( ;; )
+            {
+                next = ( next + 1 ) & mask;
+                if ( mSlots[next].mPackage == kEmpty )
+                {
+                    --mCount;
+                    return;
+                }
+                const size_t home = GetHome ( mSlots[next].mCrc );
+                // Movable unless its home lies cyclically in (hole, next].
+                if ( ( hole <= next ) ? ( home <= hole || home > next ) : ( home <= hole && home > next ) )
+                {
+                    break;
+                }
+            }
+            mSlots[hole] = mSlots[next];
+            hole = next;
+        }
+    }
+
+    void ResourceDirectory::Mount ( std::unique_ptr<Package> aPackage, bool aOverride )
+    {
+        ClearAliases();
+        const bool first = std::none_of ( mMounted.begin(), mMounted.end(), [] ( const Mounted & aMounted )
+        {
+            return aMounted.mPackage != nullptr;
+        } );
+        if ( first )
+        {
+            mFront = mBack = 0;
+        }
+        const int64_t rank = first ? 0 : ( aOverride ? --mFront : ++mBack );
+        auto free = std::find_if ( mMounted.begin(), mMounted.end(), [] ( const Mounted & aMounted )
+        {
+            return aMounted.mPackage == nullptr;
+        } );
+        if ( free == mMounted.end() )
+        {
+            free = mMounted.insert ( mMounted.end(), Mounted{} );
+        }
+        const uint32_t package = static_cast<uint32_t> ( free - mMounted.begin() );
+        free->mPackage = std::move ( aPackage );
+        free->mRank = rank;
+        const Package& mounted = *free->mPackage;
+        Reserve ( mCount + mounted.GetIndexTable().size() );
+        for ( const auto& resource : mounted.GetIndexTable() )
+        {
+            Insert ( resource.first, package, mounted.GetEntryIndex ( resource.first ) );
+        }
+    }
+
+    bool ResourceDirectory::Unmount ( const std::filesystem::path& aPath )
+    {
+        auto unmounted = std::find_if ( mMounted.begin(), mMounted.end(), [&aPath] ( const Mounted & aMounted )
+        {
+            return aMounted.mPackage != nullptr && aMounted.mPackage->GetPath() == aPath;
+        } );
+        if ( unmounted == mMounted.end() )
+        {
+            return false;
+        }
+        ClearAliases();
+        const uint32_t package = static_cast<uint32_t> ( unmounted - mMounted.begin() );
+        const std::unique_ptr<Package> removed = std::move ( unmounted->mPackage );
+        for ( const auto& resource : removed->GetIndexTable() )
+        {
+            const size_t slot = Probe ( resource.first );
+            if ( mSlots[slot].mPackage != package )
+            {
+                // Shadowed by a package in front of it, nothing changes.
+                continue;
+            }
+            uint32_t fallback = kEmpty;
+            for ( uint32_t i = 0; i < mMounted.size(); ++i )
+            {
+                if ( mMounted[i].mPackage != nullptr &&
+                     ( fallback == kEmpty || mMounted[i].mRank < mMounted[fallback].mRank ) &&
+                     mMounted[i].mPackage->GetIndexTable().count ( resource.first ) != 0 )
+                {
+                    fallback = i;
+                }
+            }
+            if ( fallback == kEmpty )
+            {
+                Erase ( slot );
+            }
+            else
+            {
+                mSlots[slot].mPackage = fallback;
+                mSlots[slot].mEntry = mMounted[fallback].mPackage->GetEntryIndex ( resource.first );
+            }
+        }
+        return true;
+    }
+
+    void ResourceDirectory::Clear()
+    {
+        ClearAliases();
+        mMounted.clear();
+        mSlots.clear();
+        mCount = 0;
+        mShift = 64;
+        mFront = mBack = 0;
+    }
+
+    ResourceDirectory::Location ResourceDirectory::Find ( uint32_t aCrc ) const
+    {
+        if ( mCount == 0 )
+        {
+            return Location{nullptr, Package::NoEntry};
+        }
+        const Slot& slot = mSlots[Probe ( aCrc )];
+        if ( slot.mPackage == kEmpty )
+        {
+            return Location{nullptr, Package::NoEntry};
+        }
+        return Location{mMounted[slot.mPackage].mPackage.get(), slot.mEntry};
+    }
+
+    std::vector<const Package*> ResourceDirectory::GetPackages() const
+    {
+        std::vector<const Mounted*> mounted;
+        for ( const Mounted& i : mMounted )
+        {
+            if ( i.mPackage != nullptr )
+            {
+                mounted.push_back ( &i );
+            }
+        }
+        std::sort ( mounted.begin(), mounted.end(), [] ( const Mounted * a, const Mounted * b )
+        {
+            return a->mRank < b->mRank;
+        } );
+        std::vector<const Package*> packages;
+        packages.reserve ( mounted.size() );
+        for ( const Mounted* i : mounted )
+        {
+            packages.push_back ( i->mPackage.get() );
+        }
+        return packages;
+    }
+
+    bool ResourceDirectory::FindAlias ( uint32_t aCrc, uint32_t& aResolved ) const
+    {
+        const AliasTable* table = mAliases.load ( std::memory_order_acquire );
+        if ( table == nullptr || aCrc == 0 )
+        {
+            return false;
+        }
+        const size_t mask = table->mCapacity - 1;
+        for ( size_t slot = Spread ( aCrc, table->mShift ), probes = 0; probes < table->mCapacity; slot = ( slot + 1 ) & mask, ++probes )
+        {
+            const uint64_t alias = table->mSlots[slot].load ( std::memory_order_acquire );
+            if ( alias == 0 )
+            {
+                return false;
+            }
+            if ( static_cast<uint32_t> ( alias >> 32 ) == aCrc )
+            {
+                aResolved = static_cast<uint32_t> ( alias );
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ResourceDirectory::CacheAlias ( uint32_t aCrc, uint32_t aResolved ) const
+    {
+        // Crc zero would encode as a free slot, it is not worth a special case.
+        if ( aCrc == 0 )
+        {
+            return;
+        }
+        AliasTable* table = mAliases.load ( std::memory_order_acquire );
+        if ( table == nullptr || ( table->mCount.load ( std::memory_order_relaxed ) + 1 ) * 2 > table->mCapacity )
+        {
+            table = GrowAliases ( table );
+        }
+        const uint64_t alias = ( static_cast<uint64_t> ( aCrc ) << 32 ) | aResolved;
+        const size_t mask = table->mCapacity - 1;
+        for ( size_t slot = Spread ( aCrc, table->mShift ), probes = 0; probes < table->mCapacity; slot = ( slot + 1 ) & mask, ++probes )
+        {
+            uint64_t expected = 0;
+            if ( table->mSlots[slot].compare_exchange_strong ( expected, alias, std::memory_order_release, std::memory_order_acquire ) )
+            {
+                table->mCount.fetch_add ( 1, std::memory_order_relaxed );
+                return;
+            }
+            if ( static_cast<uint32_t> ( expected >> 32 ) == aCrc )
+            {
+                return;
+            }
+        }
+    }
+
+    ResourceDirectory::AliasTable* ResourceDirectory::GrowAliases ( AliasTable* aFull ) const
+    {
+        std::lock_guard<std::mutex> lock ( mAliasMutex );
+        AliasTable* current = mAliases.load ( std::memory_order_acquire );
+        if ( current != aFull )
+        {
+            // Another lookup grew it first.
+            return current;
+        }
+        const size_t capacity = ( aFull == nullptr ) ? 1024 : aFull->mCapacity * 2;
+        auto table = std::make_unique<AliasTable>();
+        table->mSlots = std::make_unique<std::atomic<uint64_t>[]> ( capacity );
+        table->mCapacity = capacity;
+        table->mShift = 64 - static_cast<uint32_t> ( std::countr_zero ( capacity ) );
+        table->mCount.store ( 0, std::memory_order_relaxed );
+        for ( size_t i = 0; i < capacity; ++i )
+        {
+            table->mSlots[i].store ( 0, std::memory_order_relaxed );
+        }
+        if ( aFull != nullptr )
+        {
+            // Aliases cached into the old table while copying may be missed.
+            for ( size_t i = 0; i < aFull->mCapacity; ++i )
+            {
+                const uint64_t alias = aFull->mSlots[i].load ( std::memory_order_acquire );
+                if ( alias == 0 )
+                {
+                    continue;
+                }
+                size_t slot = Spread ( static_cast<uint32_t> ( alias >> 32 ), table->mShift );
+                while ( table->mSlots[slot].load ( std::memory_order_relaxed ) != 0 )
+                {
+                    slot = ( slot + 1 ) & ( capacity - 1 );
+                }
+                table->mSlots[slot].store ( alias, std::memory_order_relaxed );
+                table->mCount.fetch_add ( 1, std::memory_order_relaxed );
+            }
+        }
+        AliasTable* grown = table.get();
+        mAliasTables.push_back ( std::move ( table ) );
+        mAliases.store ( grown, std::memory_order_release );
+        return grown;
+    }
+
+    void ResourceDirectory::ClearAliases()
+    {
+        mAliases.store ( nullptr, std::memory_order_release );
+        mAliasTables.clear();
+    }
+}
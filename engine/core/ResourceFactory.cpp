@@ -27,7 +27,7 @@ limitations under the License.
 
 namespace AeonGames
 {
-    static std::unordered_map < uint32_t, std::tuple<std::function < UniqueAnyPtr ( uint32_t ) >, UniqueAnyPtr >> Constructors;
+    static std::unordered_map < uint32_t, std::tuple<std::function < UniqueAnyPtr ( uint32_t ) >, UniqueAnyPtr, ResourceMemoryUsage >> Constructors;
 
     /** @brief Format a CRC32-identified resource component (type or path) for
         diagnostics, including its human readable name when one is known.
@@ -91,15 +91,24 @@ namespace AeonGames
                << " (resource path " << path_desc << ")";
         throw std::runtime_error ( stream.str().c_str() );
     }
-    bool RegisterResourceConstructor ( uint32_t aType, const std::function < UniqueAnyPtr ( uint32_t ) > & aConstructor, UniqueAnyPtr&& aDefaultResource )
+    bool RegisterResourceConstructor ( uint32_t aType, const std::function < UniqueAnyPtr ( uint32_t ) > & aConstructor, UniqueAnyPtr&& aDefaultResource, const ResourceMemoryUsage& aMemoryUsage )
     {
         if ( Constructors.find ( aType ) == Constructors.end() )
         {
-            Constructors[aType] = std::make_pair ( aConstructor, std::move ( aDefaultResource ) );
+            Constructors[aType] = std::make_tuple ( aConstructor, std::move ( aDefaultResource ), aMemoryUsage );
             return true;
         }
         return false;
     }
+    size_t MeasureResource ( uint32_t aType, const UniqueAnyPtr& aResource )
+    {
+        auto it = Constructors.find ( aType );
+        if ( it != Constructors.end() && std::get<2> ( it->second ) && aResource.GetRaw() )
+        {
+            return std::get<2> ( it->second ) ( aResource );
+        }
+        return 0;
+    }
     bool UnregisterResourceConstructor ( uint32_t aType )
     {
         auto it = Constructors.find ( aType );
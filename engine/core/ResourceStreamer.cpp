@@ -0,0 +1,345 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+#include "aeongames/ResourceStreamer.hpp"
+#include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceFactory.hpp"
+#include "aeongames/ResourceId.hpp"
+#include "aeongames/LogLevel.hpp"
+
+namespace AeonGames
+{
+    class ResourceStreamer::Request
+    {
+    public:
+        Request ( const ResourceId& aResourceId, ResourcePriority aPriority, Status aStatus ) :
+            mResourceId{aResourceId}, mPriority{aPriority}, mStatus{aStatus}
+        {
+        }
+        const ResourceId mResourceId;
+        /// Guarded by the streamer mutex, as is mStatus.
+        ResourcePriority mPriority;
+        Status mStatus;
+        /// Written by the loader thread while Loading, read by Commit afterwards.
+        ResourceStaging mStaged{};
+        std::string mError{};
+    };
+
+    ResourceStreamer::ResourceStreamer ( size_t aThreadCount )
+    {
+        aThreadCount = std::max<size_t> ( aThreadCount, 1 );
+        mThreads.reserve ( aThreadCount );
+        for ( size_t i = 0; i < aThreadCount; ++i )
+        {
+            mThreads.emplace_back ( &ResourceStreamer::LoaderLoop, this );
+        }
+    }
+
+    ResourceStreamer::~ResourceStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock ( mMutex );
+            mStop = true;
+            for ( auto& queue : mQueues )
+            {
+                for ( const RequestHandle& request : queue )
+                {
+                    if ( request->mStatus == Status::Queued )
+                    {
+                        request->mStatus = Status::Cancelled;
+                        --mPending;
+                    }
+                }
+                queue.clear();
+            }
+        }
+        mWorkCondition.notify_all();
+        for ( auto& thread : mThreads )
+        {
+            thread.join();
+        }
+        for ( const RequestHandle& request : mFinished )
+        {
+            if ( request->mStatus == Status::Loaded )
+            {
+                request->mStatus = Status::Cancelled;
+            }
+            request->mStaged.clear();
+        }
+    }
+
+    size_t ResourceStreamer::GetDefaultThreadCount()
+    {
+        return 2;
+    }
+
+    size_t ResourceStreamer::GetThreadCount() const
+    {
+        return mThreads.size();
+    }
+
+    ResourceStreamer::RequestHandle ResourceStreamer::Enqueue ( const ResourceId& aResourceId, ResourcePriority aPriority )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        auto active = mActive.find ( aResourceId.GetPath() );
+        if ( active != mActive.end() )
+        {
+            const RequestHandle& request = active->second;
+            if ( request->mStatus == Status::Queued && aPriority < request->mPriority )
+            {
+                request->mPriority = aPriority;
+                mQueues[static_cast<size_t> ( aPriority )].emplace_back ( request );
+                mWorkCondition.notify_one();
+            }
+            return request;
+        }
+        if ( GetResource ( aResourceId.GetPath() ).GetRaw() )
+        {
+            return std::make_shared<Request> ( aResourceId, aPriority, Status::Committed );
+        }
+        RequestHandle request = std::make_shared<Request> ( aResourceId, aPriority, Status::Queued );
+        mActive.emplace ( aResourceId.GetPath(), request );
+        mQueues[static_cast<size_t> ( aPriority )].emplace_back ( request );
+        ++mPending;
+        mWorkCondition.notify_one();
+        return request;
+    }
+
+    bool ResourceStreamer::Cancel ( const RequestHandle& aRequest )
+    {
+        if ( !aRequest )
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock ( mMutex );
+        switch ( aRequest->mStatus )
+        {
+        case Status::Queued:
+            // The queue entry stays behind and is skipped when it comes up.
+            --mPending;
+            if ( mPending == 0 )
+            {
+                mIdleCondition.notify_all();
+            }
+            break;
+        case Status::Loading:
+        case Status::Loaded:
+            break;
+        default:
+            return false;
+        }
+        aRequest->mStatus = Status::Cancelled;
+        auto active = mActive.find ( aRequest->mResourceId.GetPath() );
+        if ( active != mActive.end() && active->second == aRequest )
+        {
+            mActive.erase ( active );
+        }
+        return true;
+    }
+
+    size_t ResourceStreamer::Commit()
+    {
+        std::vector<RequestHandle> finished;
+        size_t committed = 0;
+        {
+            std::lock_guard<std::mutex> lock ( mMutex );
+            if ( mFinished.empty() )
+            {
+                return 0;
+            }
+            finished.swap ( mFinished );
+            for ( const RequestHandle& request : finished )
+            {
+                auto active = mActive.find ( request->mResourceId.GetPath() );
+                if ( active != mActive.end() && active->second == request )
+                {
+                    mActive.erase ( active );
+                }
+                if ( request->mStatus == Status::Loaded )
+                {
+                    // Still under the streamer lock so Cancel cannot slip in
+                    // between the status check and the publish.
+                    CommitResourceStaging ( request->mStaged );
+                    request->mStatus = Status::Committed;
+                    ++committed;
+                }
+            }
+        }
+        for ( const RequestHandle& request : finished )
+        {
+            if ( request->mStatus == Status::Failed )
+            {
+                std::cout << LogLevel::Error << "Streaming failed: " << request->mError << std::endl;
+            }
+            request->mStaged.clear();
+        }
+        return committed;
+    }
+
+    void ResourceStreamer::WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock ( mMutex );
+        mIdleCondition.wait ( lock, [this]
+        {
+            return mPending == 0;
+        } );
+    }
+
+    ResourceStreamer::Status ResourceStreamer::GetStatus ( const RequestHandle& aRequest ) const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return aRequest ? aRequest->mStatus : Status::Cancelled;
+    }
+
+    std::string ResourceStreamer::GetError ( const RequestHandle& aRequest ) const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return ( aRequest && aRequest->mStatus == Status::Failed ) ? aRequest->mError : std::string{};
+    }
+
+    size_t ResourceStreamer::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return mPending;
+    }
+
+    ResourceStreamer::RequestHandle ResourceStreamer::Dequeue()
+    {
+        for ( auto& queue : mQueues )
+        {
+            while ( !queue.empty() )
+            {
+                RequestHandle request{std::move ( queue.front() ) };
+                queue.pop_front();
+                // Promoted, cancelled or already loaded entries are stale.
+                if ( request->mStatus == Status::Queued )
+                {
+                    return request;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void ResourceStreamer::LoaderLoop()
+    {
+        std::unique_lock<std::mutex> lock ( mMutex );
+        for ( ;; )
+        {
+            RequestHandle request = Dequeue();
+            if ( !request )
+            {
+                if ( mStop )
+                {
+                    break;
+                }
+                mWorkCondition.wait ( lock );
+                continue;
+            }
+            request->mStatus = Status::Loading;
+            lock.unlock();
+            Load ( request );
+            lock.lock();
+            if ( request->mStatus == Status::Cancelled )
+            {
+                request->mStaged.clear();
+            }
+            else
+            {
+                request->mStatus = request->mError.empty() ? Status::Loaded : Status::Failed;
+                mFinished.emplace_back ( std::move ( request ) );
+            }
+            if ( --mPending == 0 )
+            {
+                mIdleCondition.notify_all();
+            }
+        }
+    }
+
+    void ResourceStreamer::Load ( const RequestHandle& aRequest )
+    {
+        // Everything the constructor stores, dependencies included, lands in
+        // the request's staging map instead of the shared cache.
+        SetResourceStaging ( &aRequest->mStaged );
+        try
+        {
+            if ( !StoreResource ( aRequest->mResourceId, ConstructResource ( aRequest->mResourceId ) ).GetRaw() )
+            {
+                aRequest->mError = "Constructor returned no resource for " + aRequest->mResourceId.GetPathString();
+            }
+        }
+        catch ( const std::exception& e )
+        {
+            aRequest->mError = e.what();
+        }
+        catch ( ... )
+        {
+            aRequest->mError = "Unknown exception loading " + aRequest->mResourceId.GetPathString();
+        }
+        SetResourceStaging ( nullptr );
+        if ( !aRequest->mError.empty() )
+        {
+            aRequest->mStaged.clear();
+        }
+    }
+
+    static std::mutex gResourceStreamerMutex{};
+    static std::unique_ptr<ResourceStreamer> gResourceStreamer{};
+    static std::atomic<ResourceStreamer*> gResourceStreamerInstance{nullptr};
+
+    void InitializeResourceStreamer ( size_t aThreadCount )
+    {
+        std::lock_guard<std::mutex> lock ( gResourceStreamerMutex );
+        gResourceStreamerInstance.store ( nullptr );
+        gResourceStreamer.reset();
+        gResourceStreamer = std::make_unique<ResourceStreamer> ( aThreadCount );
+        gResourceStreamerInstance.store ( gResourceStreamer.get() );
+    }
+
+    ResourceStreamer& GetResourceStreamer()
+    {
+        if ( ResourceStreamer * streamer = gResourceStreamerInstance.load ( std::memory_order_acquire ) )
+        {
+            return *streamer;
+        }
+        std::lock_guard<std::mutex> lock ( gResourceStreamerMutex );
+        if ( !gResourceStreamer )
+        {
+            gResourceStreamer = std::make_unique<ResourceStreamer>();
+            gResourceStreamerInstance.store ( gResourceStreamer.get() );
+        }
+        return *gResourceStreamer;
+    }
+
+    void FinalizeResourceStreamer()
+    {
+        std::lock_guard<std::mutex> lock ( gResourceStreamerMutex );
+        gResourceStreamerInstance.store ( nullptr );
+        gResourceStreamer.reset();
+    }
+
+    size_t CommitStreamedResources()
+    {
+        if ( ResourceStreamer * streamer = gResourceStreamerInstance.load ( std::memory_order_acquire ) )
+        {
+            return streamer->Commit();
+        }
+        return 0;
+    }
+}
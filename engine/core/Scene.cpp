@@ -28,8 +28,12 @@ limitations under the License.
 #include "aeongames/Quaternion.hpp"
 #include "aeongames/Vector3.hpp"
 #include "aeongames/GpuShadowParams.hpp"
+#include "aeongames/JobSystem.hpp"
+#include "aeongames/RadixSort.hpp"
 #include <array>
 #include <algorithm>
+#include <bit>
+#include <stdexcept>
 #include <limits>
 #include <cmath>
 #include "aeongames/ProtoBufHelpers.hpp"
@@ -85,6 +89,13 @@ namespace AeonGames
     }
     void Scene::Load ( uint32_t aId )
     {
+        std::shared_ptr<const void> owner;
+        const std::span<const uint8_t> view = GetResourceView ( aId, owner );
+        if ( !view.empty() )
+        {
+            Load ( view.data(), view.size() );
+            return;
+        }
         std::vector<uint8_t> buffer ( GetResourceSize ( aId ), 0 );
         LoadResource ( aId, buffer.data(), buffer.size() );
         try
@@ -141,8 +152,31 @@ namespace AeonGames
         return mInputSystem;
     }
 
+    namespace
+    {
+        /// @brief Light and animation buffers of the subtree the calling thread
+        /// is updating, keyed by scene so AddLight and QueueAnimation on any
+        /// other scene are unaffected.
+        struct SubtreeSink
+        {
+            const Scene* mScene{nullptr};
+            std::vector<GpuLight>* mLights{nullptr};
+            std::vector<std::pair<const Node*, Component* >>* mAnimations{nullptr};
+        };
+        thread_local SubtreeSink tSubtreeSink{};
+    }
+
     void Scene::AddLight ( const GpuLight& aLight )
     {
+        if ( tSubtreeSink.mScene == this )
+        {
+            // Lights past the frame cap would be dropped by the merge anyway.
+            if ( tSubtreeSink.mLights->size() < MAX_LIGHTS_PER_FRAME )
+            {
+                tSubtreeSink.mLights->emplace_back ( aLight );
+            }
+            return;
+        }
         mFrameLights.Add ( aLight );
     }
 
@@ -200,10 +234,7 @@ namespace AeonGames
         // BuildRenderQueue has already refreshed for this frame. It bounds the
         // shadow depth range so casters behind the camera (between the sun and
         // the visible region) still write into the map.
-        if ( mSpatialIndexDirty )
-        {
-            BuildSpatialIndex();
-        }
+        RefreshSpatialIndex();
         if ( mSpatialIndex.GetNodeCount() == 0 )
         {
             return false;
@@ -612,42 +643,144 @@ namespace AeonGames
         return const_cast<Node&> ( static_cast<const Scene&> ( *this ) [index] );
     }
 
+    namespace
+    {
+        constexpr uint64_t kFNV1aOffsetBasis{1469598103934665603ull};
+        constexpr uint64_t kFNV1aPrime{1099511628211ull};
+
+        /** Update one top-level subtree in DFS pre-order and return its partial
+         *  shadow-geometry signature: FNV-1a over each geometry node's world
+         *  pose and size. Nodes without geometry (camera, bare lights) have a
+         *  degenerate AABB and are skipped, so moving the camera leaves the
+         *  signature unchanged. Each node's world transform is final when it is
+         *  visited (parents update first in pre-order). */
+        uint64_t UpdateSubtree ( Node& aRoot, double aDelta )
+        {
+            uint64_t hash = kFNV1aOffsetBasis;
+            auto fold = [&hash] ( float aValue )
+            {
+                uint32_t bits;
+                std::memcpy ( &bits, &aValue, sizeof ( bits ) );
+                hash = ( hash ^ bits ) * kFNV1aPrime;
+            };
+            aRoot.LoopTraverseDFSPreOrder ( [aDelta, &fold] ( Node & aNode )
+            {
+                aNode.Update ( aDelta );
+                const Vector3& radii = aNode.GetAABB().GetRadii();
+                if ( radii.GetX() <= 0.0f && radii.GetY() <= 0.0f && radii.GetZ() <= 0.0f )
+                {
+                    return;
+                }
+                const Matrix4x4 world { aNode.GetGlobalTransform() };
+                const float* m = world.GetMatrix4x4();
+                for ( int i = 0; i < 16; ++i )
+                {
+                    fold ( m[i] );
+                }
+                fold ( radii.GetX() );
+                fold ( radii.GetY() );
+                fold ( radii.GetZ() );
+            } );
+            return hash;
+        }
+    }
+
     void Scene::Update ( const double delta )
     {
         mFrameLights.Reset();
-        // Recompute the shadow-geometry signature in the same traversal that
-        // updates the nodes (avoids a second full-scene walk): FNV-1a over each
-        // geometry node's world pose and size. Nodes without geometry (camera,
-        // bare lights) have a degenerate AABB and are skipped, so moving the
-        // camera leaves the signature unchanged; only a moved, resized, or
-        // added/removed shadow caster changes it. Each node's world transform is
-        // final when it is visited (parents update first in pre-order).
-        uint64_t hash = 1469598103934665603ull;
-        auto fold = [&hash] ( float aValue )
-        {
-            uint32_t bits;
-            std::memcpy ( &bits, &aValue, sizeof ( bits ) );
-            hash = ( hash ^ bits ) * 1099511628211ull;
+        mPoseCache.BeginFrame();
+        // Top-level subtrees share no nodes, so each one is updated and hashed
+        // on its own (possibly on a worker) and the partial results are merged
+        // below in child order, which keeps the outcome independent of how
+        // the subtrees were scheduled.
+        const size_t subtree_count = mNodes.size();
+        mSubtreeSignatures.resize ( subtree_count );
+        if ( mSubtreeLights.size() < subtree_count )
+        {
+            mSubtreeLights.resize ( subtree_count );
+            mSubtreeAnimations.resize ( subtree_count );
+        }
+        auto update_subtrees = [this, delta] ( size_t aBegin, size_t aEnd )
+        {
+            const SubtreeSink previous_sink{tSubtreeSink};
+            for ( size_t i = aBegin; i < aEnd; ++i )
+            {
+                mSubtreeLights[i].clear();
+                mSubtreeAnimations[i].clear();
+                tSubtreeSink = SubtreeSink{this, &mSubtreeLights[i], &mSubtreeAnimations[i]};
+                mSubtreeSignatures[i] = UpdateSubtree ( *mNodes[i], delta );
+            }
+            tSubtreeSink = previous_sink;
         };
-        LoopTraverseDFSPreOrder ( [delta, &fold] ( Node & aNode )
+        if ( mParallelUpdate && subtree_count > 1 )
         {
-            aNode.Update ( delta );
-            const Vector3& radii = aNode.GetAABB().GetRadii();
-            if ( radii.GetX() <= 0.0f && radii.GetY() <= 0.0f && radii.GetZ() <= 0.0f )
+            GetJobSystem().ParallelFor ( 0, subtree_count, 0, update_subtrees );
+        }
+        else
+        {
+            update_subtrees ( 0, subtree_count );
+        }
+        uint64_t hash = kFNV1aOffsetBasis;
+        mAnimations.clear();
+        for ( size_t i = 0; i < subtree_count; ++i )
+        {
+            hash = ( hash ^ mSubtreeSignatures[i] ) * kFNV1aPrime;
+            for ( const GpuLight& light : mSubtreeLights[i] )
             {
-                return;
+                mFrameLights.Add ( light );
             }
-            const Matrix4x4 world { aNode.GetGlobalTransform() };
-            const float* m = world.GetMatrix4x4();
-            for ( int i = 0; i < 16; ++i )
+            mAnimations.insert ( mAnimations.end(), mSubtreeAnimations[i].begin(), mSubtreeAnimations[i].end() );
+        }
+        mShadowGeometrySignature = hash;
+
+        // Animation phase: every queued component only writes its own pose
+        // buffers, so they are spread over the JobSystem one by one instead
+        // of by subtree, which balances a crowd under a single root.
+        auto animate = [this, delta] ( size_t aBegin, size_t aEnd )
+        {
+            for ( size_t i = aBegin; i < aEnd; ++i )
             {
-                fold ( m[i] );
+                mAnimations[i].second->Animate ( *mAnimations[i].first, delta );
             }
-            fold ( radii.GetX() );
-            fold ( radii.GetY() );
-            fold ( radii.GetZ() );
-        } );
-        mShadowGeometrySignature = hash;
+        };
+        if ( mParallelUpdate && mAnimations.size() > 1 )
+        {
+            GetJobSystem().ParallelFor ( 0, mAnimations.size(), 0, animate );
+        }
+        else
+        {
+            animate ( 0, mAnimations.size() );
+        }
+    }
+
+    void Scene::SetParallelUpdate ( bool aParallelUpdate )
+    {
+        mParallelUpdate = aParallelUpdate;
+    }
+
+    bool Scene::GetParallelUpdate() const
+    {
+        return mParallelUpdate;
+    }
+
+    bool Scene::QueueAnimation ( const Node& aNode, Component& aComponent )
+    {
+        if ( tSubtreeSink.mScene != this )
+        {
+            return false;
+        }
+        tSubtreeSink.mAnimations->emplace_back ( &aNode, &aComponent );
+        return true;
+    }
+
+    PoseCache& Scene::GetPoseCache()
+    {
+        return mPoseCache;
+    }
+
+    const PoseCache& Scene::GetPoseCache() const
+    {
+        return mPoseCache;
     }
 
     void Scene::InvalidateSpatialIndex()
@@ -655,6 +788,75 @@ namespace AeonGames
         mSpatialIndexDirty = true;
     }
 
+    void Scene::InvalidateSpatialIndex ( const Node* aNode )
+    {
+        // A pending full rebuild picks the node up anyway.
+        if ( mSpatialIndexDirty )
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock ( mDirtyNodesMutex );
+        mDirtyNodes.emplace_back ( aNode );
+    }
+
+    void Scene::SetSpatialIndexRebuildThreshold ( float aFraction )
+    {
+        mSpatialIndexRebuildThreshold = std::max ( aFraction, 0.0f );
+    }
+
+    float Scene::GetSpatialIndexRebuildThreshold() const
+    {
+        return mSpatialIndexRebuildThreshold;
+    }
+
+    void Scene::RefreshSpatialIndex() const
+    {
+        if ( mSpatialIndexDirty )
+        {
+            BuildSpatialIndex();
+            return;
+        }
+        std::lock_guard<std::mutex> lock ( mDirtyNodesMutex );
+        if ( mDirtyNodes.empty() )
+        {
+            return;
+        }
+        // Past the threshold re-placing nodes one by one costs more than
+        // laying the whole tree out again.
+        const float churn = static_cast<float> ( mDirtyNodes.size() );
+        if ( churn > mSpatialIndexRebuildThreshold * static_cast<float> ( mSpatialIndex.GetNodeCount() ) )
+        {
+            BuildSpatialIndex();
+            return;
+        }
+        // The root bounds are fixed, a node that left them would be skipped by
+        // queries, so that case needs a rebuild to grow the root.
+        const AABB& root_bounds = mSpatialIndex.GetRootBounds();
+        bool escaped = false;
+        for ( const Node* dirty : mDirtyNodes )
+        {
+            dirty->LoopTraverseDFSPreOrder ( [this, &root_bounds, &escaped] ( const Node & aNode )
+            {
+                if ( escaped )
+                {
+                    return;
+                }
+                if ( !root_bounds.Contains ( aNode.GetGlobalTransform() * aNode.GetAABB() ) )
+                {
+                    escaped = true;
+                    return;
+                }
+                mSpatialIndex.UpdateNode ( &aNode );
+            } );
+            if ( escaped )
+            {
+                BuildSpatialIndex();
+                return;
+            }
+        }
+        mDirtyNodes.clear();
+    }
+
     void Scene::BuildSpatialIndex() const
     {
         // Root bounds are the union of every node's world-space AABB; the depth is
@@ -685,83 +887,28 @@ namespace AeonGames
             } );
         }
         mSpatialIndexDirty = false;
+        mDirtyNodes.clear();
     }
 
     void Scene::CullVisible ( const Frustum& aFrustum, const std::function<void ( const Node& ) >& aCallback ) const
     {
-        if ( mSpatialIndexDirty )
-        {
-            BuildSpatialIndex();
-        }
-        if ( mSpatialIndex.GetNodeCount() != 0 )
-        {
-            mSpatialIndex.QueryFrustum ( aFrustum, [&aFrustum, &aCallback] ( const Node * aNode )
-            {
-                const AABB world = aNode->GetGlobalTransform() * aNode->GetAABB();
-                if ( aFrustum.Intersects ( world ) )
-                {
-                    aCallback ( *aNode );
-                }
-            } );
-            return;
-        }
-        // Fallback: empty/degenerate index (e.g. a scene with no nodes). A plain
-        // traversal keeps CullVisible's result identical to a brute-force cull.
-        LoopTraverseDFSPreOrder ( [&aFrustum, &aCallback] ( const Node & aNode )
-        {
-            const AABB world = aNode.GetGlobalTransform() * aNode.GetAABB();
-            if ( aFrustum.Intersects ( world ) )
-            {
-                aCallback ( aNode );
-            }
-        } );
+        VisitNodes ( aFrustum, aCallback );
     }
 
     void Scene::QueryAABB ( const AABB& aBox, const std::function<void ( const Node& ) >& aCallback ) const
     {
-        if ( mSpatialIndexDirty )
-        {
-            BuildSpatialIndex();
-        }
-        if ( mSpatialIndex.GetNodeCount() != 0 )
-        {
-            mSpatialIndex.QueryAABB ( aBox, [&aBox, &aCallback] ( const Node * aNode )
-            {
-                const AABB world = aNode->GetGlobalTransform() * aNode->GetAABB();
-                if ( aBox.Overlaps ( world ) )
-                {
-                    aCallback ( *aNode );
-                }
-            } );
-            return;
-        }
-        // Fallback: empty/degenerate index. A plain traversal keeps QueryAABB's
-        // result identical to a brute-force overlap scan.
-        LoopTraverseDFSPreOrder ( [&aBox, &aCallback] ( const Node & aNode )
-        {
-            const AABB world = aNode.GetGlobalTransform() * aNode.GetAABB();
-            if ( aBox.Overlaps ( world ) )
-            {
-                aCallback ( aNode );
-            }
-        } );
+        VisitNodes ( aBox, aCallback );
     }
 
     void Scene::ForEachOctreeCell ( const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const
     {
-        if ( mSpatialIndexDirty )
-        {
-            BuildSpatialIndex();
-        }
+        RefreshSpatialIndex();
         mSpatialIndex.ForEachCell ( aCallback );
     }
 
     void Scene::ForEachOctreeCell ( const Frustum& aFrustum, const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const
     {
-        if ( mSpatialIndexDirty )
-        {
-            BuildSpatialIndex();
-        }
+        RefreshSpatialIndex();
         mSpatialIndex.ForEachCell ( aFrustum, aCallback );
     }
 
@@ -770,49 +917,184 @@ namespace AeonGames
         return mShadowGeometrySignature;
     }
 
+    namespace
+    {
+        /** Render queue sort key layout, most significant first. Items sharing
+         *  pipeline, material and mesh become adjacent so ForEachRenderBatch can
+         *  merge them; skinned items sort after the non-skinned items of the
+         *  same geometry so they do not split an instanced run; within a run
+         *  items go front to back. */
+        constexpr uint32_t kPipelineKeyBits = 12;
+        constexpr uint32_t kMaterialKeyBits = 18;
+        constexpr uint32_t kMeshKeyBits = 18;
+        constexpr uint32_t kSkinnedKeyBits = 1;
+        constexpr uint32_t kDepthKeyBits = 15;
+        static_assert ( kPipelineKeyBits + kMaterialKeyBits + kMeshKeyBits + kSkinnedKeyBits + kDepthKeyBits == 64,
+                        "Render sort key fields must fill 64 bits." );
+
+        /** Dense id of a resource pointer for the sort key: 0 for null, then
+         *  1, 2, ... in the order pointers are first seen. The scene is
+         *  traversed in a fixed order, so ids (and the queue order) do not
+         *  depend on where resources happen to be allocated. Once a field is
+         *  exhausted the table restarts; ForEachRenderBatch compares the real
+         *  pointers, so a clash can only cost batching, never a wrong draw. */
+        uint64_t InternSortId ( std::unordered_map<const void*, uint32_t>& aTable, const void* aPointer, uint32_t aBits )
+        {
+            if ( aPointer == nullptr )
+            {
+                return 0;
+            }
+            const uint32_t limit = ( 1u << aBits ) - 1u;
+            auto found = aTable.find ( aPointer );
+            if ( found != aTable.end() )
+            {
+                return found->second;
+            }
+            if ( aTable.size() >= limit )
+            {
+                aTable.clear();
+            }
+            const uint32_t id = static_cast<uint32_t> ( aTable.size() ) + 1u;
+            aTable.emplace ( aPointer, id );
+            return id;
+        }
+    }
+
     void Scene::BuildRenderQueue ( const Frustum& aFrustum ) const
     {
-        // Per-node frustum culling is inherited from CullVisible; each visible
-        // node appends the draws its components contribute. clear() keeps the
-        // buffer capacity so steady-state frames perform no heap allocation.
-        mRenderQueue.clear();
-        CullVisible ( aFrustum, [this] ( const Node & aNode )
+        BuildRenderQueues ( std::span<const Frustum> ( &aFrustum, 1 ) );
+    }
+
+    void Scene::BuildRenderQueues ( std::span<const Frustum> aFrustums ) const
+    {
+        if ( aFrustums.size() > Octree::kMaxQueryViews )
         {
-            aNode.Collect ( mRenderQueue );
-        } );
-        // Sort so items sharing pipeline, material and mesh become adjacent,
-        // letting ForEachRenderBatch merge them into one instanced draw. Skinned
-        // items carry a distinct skinned-vertex pointer and sort apart, so they
-        // never merge with each other or with non-skinned items. std::sort is in
-        // place, keeping this routine allocation-free.
-        std::sort ( mRenderQueue.begin(), mRenderQueue.end(),
-                    [] ( const RenderItem & aLhs, const RenderItem & aRhs )
-        {
-            if ( aLhs.mPipeline != aRhs.mPipeline )
+            throw std::runtime_error ( "Too many views for a single render queue build." );
+        }
+        // Queues only ever grow in number; clear() keeps each buffer's capacity
+        // so steady-state frames perform no heap allocation.
+        if ( mRenderQueues.size() < aFrustums.size() )
+        {
+            mRenderQueues.resize ( aFrustums.size() );
+        }
+        for ( auto& queue : mRenderQueues )
+        {
+            queue.clear();
+        }
+        mRenderQueueCount = aFrustums.size();
+        mActiveRenderQueue = 0;
+        if ( aFrustums.empty() )
+        {
+            return;
+        }
+        // Each node is tested against every view its octree cell intersects,
+        // collected once into the scratch buffer, and the scratch items copied
+        // into every queue whose view it is visible from.
+        auto visit = [this, &aFrustums] ( const Node & aNode, uint32_t aCandidates )
+        {
+            const AABB world = aNode.GetGlobalTransform() * aNode.GetAABB();
+            uint32_t visible = 0;
+            for ( uint32_t pending = aCandidates; pending != 0; pending &= pending - 1 )
             {
-                return aLhs.mPipeline < aRhs.mPipeline;
+                const uint32_t view = static_cast<uint32_t> ( std::countr_zero ( pending ) );
+                if ( aFrustums[view].Intersects ( world ) )
+                {
+                    visible |= 1u << view;
+                }
             }
-            if ( aLhs.mMaterial != aRhs.mMaterial )
+            if ( visible == 0 )
             {
-                return aLhs.mMaterial < aRhs.mMaterial;
+                return;
             }
-            if ( aLhs.mMesh != aRhs.mMesh )
+            if ( std::has_single_bit ( visible ) )
             {
-                return aLhs.mMesh < aRhs.mMesh;
+                aNode.Collect ( mRenderQueues[std::countr_zero ( visible )] );
+                return;
             }
-            return aLhs.mSkinnedVertices < aRhs.mSkinnedVertices;
-        } );
+            mCollectScratch.clear();
+            aNode.Collect ( mCollectScratch );
+            for ( ; visible != 0; visible &= visible - 1 )
+            {
+                std::vector<RenderItem>& queue = mRenderQueues[std::countr_zero ( visible )];
+                queue.insert ( queue.end(), mCollectScratch.begin(), mCollectScratch.end() );
+            }
+        };
+        const uint32_t all_views = ( aFrustums.size() == 32 ) ? ~0u : ( ( 1u << aFrustums.size() ) - 1u );
+        RefreshSpatialIndex();
+        if ( mSpatialIndex.GetNodeCount() != 0 )
+        {
+            mSpatialIndex.QueryFrustums ( aFrustums, [&visit] ( const Node * aNode, uint32_t aMask )
+            {
+                visit ( *aNode, aMask );
+            } );
+        }
+        else
+        {
+            LoopTraverseDFSPreOrder ( [&visit, all_views] ( const Node & aNode )
+            {
+                visit ( aNode, all_views );
+            } );
+        }
+        for ( size_t view = 0; view < mRenderQueueCount; ++view )
+        {
+            SortRenderQueue ( mRenderQueues[view], aFrustums[view] );
+        }
+    }
+
+    void Scene::SortRenderQueue ( std::vector<RenderItem>& aQueue, const Frustum& aFrustum ) const
+    {
+        // Sort packed keys instead of the items so the sort is a branch-free
+        // radix pass over 16-byte records, then permute the items once. Every
+        // buffer involved keeps its capacity, so steady-state frames perform
+        // no heap allocation.
+        mSortKeys.clear();
+        constexpr float depth_scale = static_cast<float> ( ( 1u << kDepthKeyBits ) - 1u );
+        for ( size_t i = 0; i < aQueue.size(); ++i )
+        {
+            const RenderItem& item = aQueue[i];
+            const Vector3 position { item.mTransform[12], item.mTransform[13], item.mTransform[14] };
+            const uint64_t depth = static_cast<uint64_t> ( aFrustum.GetDepth ( position ) * depth_scale );
+            uint64_t key = InternSortId ( mPipelineSortIds, item.mPipeline, kPipelineKeyBits );
+            key = ( key << kMaterialKeyBits ) | InternSortId ( mMaterialSortIds, item.mMaterial, kMaterialKeyBits );
+            key = ( key << kMeshKeyBits ) | InternSortId ( mMeshSortIds, item.mMesh, kMeshKeyBits );
+            key = ( key << kSkinnedKeyBits ) | ( item.mSkinnedVertices != nullptr ? 1u : 0u );
+            key = ( key << kDepthKeyBits ) | depth;
+            mSortKeys.push_back ( SortKey{ key, static_cast<uint32_t> ( i ) } );
+        }
+        RadixSort ( mSortKeys, mSortScratch );
+        mSortedItems.clear();
+        for ( const SortKey& key : mSortKeys )
+        {
+            mSortedItems.push_back ( aQueue[key.mIndex] );
+        }
+        aQueue.swap ( mSortedItems );
+    }
+
+    size_t Scene::GetRenderQueueCount() const
+    {
+        return mRenderQueueCount;
+    }
+
+    void Scene::SelectRenderQueue ( size_t aView ) const
+    {
+        if ( aView >= mRenderQueueCount )
+        {
+            throw std::out_of_range ( "Render queue index out of range." );
+        }
+        mActiveRenderQueue = aView;
     }
 
     const std::vector<RenderItem>& Scene::GetRenderQueue() const
     {
-        return mRenderQueue;
+        static const std::vector<RenderItem> empty{};
+        return ( mActiveRenderQueue < mRenderQueueCount ) ? mRenderQueues[mActiveRenderQueue] : empty;
     }
 
     void Scene::ForEachRenderBatch ( const std::function<void ( std::span<const RenderItem> ) >& aCallback ) const
     {
-        const size_t count = mRenderQueue.size();
-        const RenderItem* const data = mRenderQueue.data();
+        const std::vector<RenderItem>& queue = GetRenderQueue();
+        const size_t count = queue.size();
+        const RenderItem* const data = queue.data();
         size_t i = 0;
         while ( i < count )
         {
@@ -1169,7 +1451,8 @@ namespace AeonGames
 
     std::string Scene::Serialize ( bool aAsBinary ) const
     {
-        static SceneMsg scene_buffer;
+        google::protobuf::Arena arena{};
+        SceneMsg& scene_buffer = *google::protobuf::Arena::Create<SceneMsg> ( &arena );
         *scene_buffer.mutable_name() = mName;
         if ( mCamera )
         {
@@ -1208,7 +1491,7 @@ namespace AeonGames
         scene_buffer.mutable_ambient()->set_w ( mAmbient.GetW() );
         std::unordered_map<const Node*, NodeMsg*> node_map;
         LoopTraverseDFSPreOrder (
-            [&node_map] ( const Node & node )
+            [&node_map, &scene_buffer] ( const Node & node )
         {
             NodeMsg* node_buffer;
             auto parent = node_map.find ( GetNodePtr ( node.GetParent() ) );
@@ -1245,14 +1528,12 @@ namespace AeonGames
             }
             serialization << text;
         }
-        scene_buffer.Clear();
         return serialization.str();
     }
     void Scene::Deserialize ( const std::string& aSerializedScene )
     {
-        static std::mutex m{};
-        static SceneMsg scene_buffer{};
-        std::lock_guard<std::mutex> hold ( m );
+        google::protobuf::Arena arena{GetDecodeArenaOptions ( aSerializedScene.size() ) };
+        SceneMsg& scene_buffer = *google::protobuf::Arena::Create<SceneMsg> ( &arena );
         LoadProtoBufObject ( scene_buffer, aSerializedScene.data(), aSerializedScene.size(), "AEONSCN"_mgk );
         mName = scene_buffer.name();
 
@@ -1315,6 +1596,5 @@ namespace AeonGames
         {
             mViewMatrix = mCamera->GetGlobalTransform().GetInvertedMatrix();
         }
-        scene_buffer.Clear();
     }
 }
@@ -103,6 +103,11 @@ namespace AeonGames
         DecodeImage ( *this, aBuffer, aBufferSize );
     }
 
+    size_t Texture::GetMemoryUsage() const
+    {
+        return mPixels.capacity();
+    }
+
     void Texture::Unload()
     {
         mPixels.clear();
@@ -0,0 +1,57 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_BATCHREAD_H
+#define AEONGAMES_BATCHREAD_H
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    /** @brief One range of a file to read into memory. */
+    struct FileRange
+    {
+        uint64_t mOffset;  ///< Byte offset within the file.
+        void* mBuffer;     ///< Destination of the bytes.
+        size_t mSize;      ///< Number of bytes to read.
+    };
+
+    /** @brief How ReadFileRanges talks to the operating system. */
+    enum class BatchReadBackend : uint8_t
+    {
+        IoUring,  ///< One io_uring per thread, every range in flight at once (Linux).
+        Preadv,   ///< Vectored positional reads spread over the job system (POSIX).
+        Stream    ///< A single file stream, ranges read in order.
+    };
+
+    /** @brief Read many ranges of one file.
+     *
+     * The file is opened once; ranges are sorted by offset and ranges that
+     * follow each other on disk are merged into a single vectored read, so
+     * the device sees one ordered sweep instead of a seek per range.
+     *  @param aPath File to read.
+     *  @param aRanges Ranges to read, reordered in place.
+     *  @throw std::system_error if the file cannot be opened or a range cannot be read whole. */
+    DLL void ReadFileRanges ( const std::filesystem::path& aPath, std::span<FileRange> aRanges );
+    /// @brief Backend ReadFileRanges will use: the fastest the platform and kernel support unless overridden.
+    DLL BatchReadBackend GetBatchReadBackend();
+    /** @brief Override the backend, for tests and benchmarks.
+     *  Asking for one the system does not support selects the next one down. */
+    DLL void SetBatchReadBackend ( BatchReadBackend aBackend );
+}
+#endif
@@ -0,0 +1,83 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_COMPRESSION_H
+#define AEONGAMES_COMPRESSION_H
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    /** @brief A zstd dictionary digested once for decompression.
+     *
+     * Small assets share most of their structure (protobuf field tags,
+     * common names), a dictionary trained on them lets each one compress as
+     * if it were part of a larger stream. */
+    class CompressionDictionary
+    {
+    public:
+        /** @brief Digest a dictionary produced by TrainCompressionDictionary.
+         *  @throw std::runtime_error if zstd is unavailable or rejects the bytes. */
+        DLL explicit CompressionDictionary ( std::span<const uint8_t> aDictionary );
+        DLL ~CompressionDictionary();
+        CompressionDictionary ( const CompressionDictionary& ) = delete;
+        CompressionDictionary& operator= ( const CompressionDictionary& ) = delete;
+        /// @brief Identifier stamped on every frame compressed with this dictionary.
+        DLL uint32_t GetId() const;
+        /// @brief Digested form handed to the decoder.
+        const void* GetHandle() const
+        {
+            return mHandle;
+        }
+    private:
+        void* mHandle{nullptr};
+        uint32_t mId{};
+    };
+
+    /// @brief Whether this build can encode and decode data stored with @p aCompression (see PKGCompressionTypes).
+    DLL bool IsCompressionSupported ( uint8_t aCompression );
+    /// @brief Lowercase name of a compression type, "raw" for NONE and "unknown" for anything unrecognized.
+    DLL const char* GetCompressionName ( uint8_t aCompression );
+    /** @brief Compress a whole buffer.
+     *  @param aCompression One of PKGCompressionTypes.
+     *  @param aInput Bytes to compress.
+     *  @param aLevel Codec specific level; for LZ4 anything above zero selects the high compression encoder.
+     *  @param aOutput Receives the compressed bytes, resized to fit.
+     *  @param aDictionary Optional trained dictionary, zstd only.
+     *  @return false if the codec is unavailable or cannot hold @p aInput, @p aOutput is then unspecified. */
+    DLL bool CompressBuffer ( uint8_t aCompression, std::span<const uint8_t> aInput, int aLevel,
+                              std::vector<uint8_t>& aOutput, std::span<const uint8_t> aDictionary = {} );
+    /** @brief Decompress a whole buffer.
+     *  Decoder state is kept per thread, so calling this for many small
+     *  entries does not allocate a context for each one.
+     *  @param aCompression One of PKGCompressionTypes other than NONE.
+     *  @param aInput Compressed bytes.
+     *  @param aBuffer Destination, must hold the entire decompressed payload.
+     *  @param aBufferSize Capacity of @p aBuffer.
+     *  @param aDictionary Dictionary for zstd frames that name one, may be null.
+     *  @return true if the payload decoded whole into @p aBuffer. */
+    DLL bool DecompressBuffer ( uint8_t aCompression, std::span<const uint8_t> aInput,
+                                void* aBuffer, size_t aBufferSize,
+                                const CompressionDictionary* aDictionary = nullptr );
+    /** @brief Train a zstd dictionary on a set of samples.
+     *  @param aSamples Representative payloads, ideally many small ones.
+     *  @param aCapacity Upper bound for the dictionary size.
+     *  @return The dictionary, empty if zstd is unavailable or the samples are too few to train on. */
+    DLL std::vector<uint8_t> TrainCompressionDictionary ( std::span<const std::span<const uint8_t>> aSamples, size_t aCapacity );
+}
+#endif
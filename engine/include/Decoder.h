@@ -48,6 +48,13 @@ namespace AeonGames
             //                              ( std::istreambuf_iterator<char>() ) );
             //file.close();
             //--------------------------------------------------------
+            // Holding the owner keeps the package mapped while decoding.
+            std::shared_ptr<const void> owner;
+            const std::span<const uint8_t> view = GetResourceView ( aId, owner );
+            if ( !view.empty() )
+            {
+                return Decode ( aOutput, view.data(), view.size() );
+            }
             size_t buffer_size = GetResourceSize ( aId );
             std::vector<uint8_t> buffer ( buffer_size );
             LoadResource ( aId, buffer.data(), buffer.size() );
@@ -0,0 +1,123 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_RESOURCEDIRECTORY_H
+#define AEONGAMES_RESOURCEDIRECTORY_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    class Package;
+    /** @brief Resource id lookup merged over every mounted package.
+     *
+     * One open addressing table maps each resource crc to the package that
+     * wins it under the mount order and to its entry in that package, so a
+     * lookup is one probe sequence no matter how many packages are mounted.
+     * Mounting and unmounting only touch the ids of the package involved.
+     * Not synchronized, callers serialize changes against lookups; the alias
+     * cache alone may be read and filled by concurrent lookups. */
+    class ResourceDirectory
+    {
+    public:
+        /// Where a resource lives, mPackage is null if no mounted package has it.
+        struct Location
+        {
+            const Package* mPackage;
+            uint32_t mEntry; ///< Package::GetEntryIndex position, Package::NoEntry for loose files.
+        };
+        DLL ResourceDirectory();
+        DLL ~ResourceDirectory();
+        ResourceDirectory ( const ResourceDirectory& ) = delete;
+        ResourceDirectory& operator= ( const ResourceDirectory& ) = delete;
+        /** @brief Mount a package.
+         *  @param aPackage Package to take ownership of.
+         *  @param aOverride In front of every mounted package, shadowing their
+         *  resources with the same ids, like a patch; otherwise behind them. */
+        DLL void Mount ( std::unique_ptr<Package> aPackage, bool aOverride );
+        /** @brief Unmount the package mounted from @p aPath.
+         *  Ids it was shadowing fall back to the next package that has them.
+         *  @return false if no package was mounted from that path. */
+        DLL bool Unmount ( const std::filesystem::path& aPath );
+        /// @brief Unmount everything.
+        DLL void Clear();
+        /// @brief Find the package a resource is loaded from.
+        DLL Location Find ( uint32_t aCrc ) const;
+        /// @brief Mounted packages, the one that wins a shared id first.
+        DLL std::vector<const Package*> GetPackages() const;
+        /** @brief Find a cached resolution of a resource id.
+         *  Lock free, safe to call concurrently with other lookups and with CacheAlias.
+         *  @param aCrc Id as referenced, typically a path without extension.
+         *  @param aResolved Receives the id it resolved to.
+         *  @return false if @p aCrc has not been cached since the last mount change. */
+        DLL bool FindAlias ( uint32_t aCrc, uint32_t& aResolved ) const;
+        /** @brief Remember what a resource id resolved to, a miss included.
+         *  Every Mount, Unmount and Clear forgets all aliases since they may
+         *  resolve differently afterwards. Safe to call concurrently with
+         *  other lookups; an alias recorded while the cache grows may be
+         *  dropped and is simply resolved again next time. */
+        DLL void CacheAlias ( uint32_t aCrc, uint32_t aResolved ) const;
+        /// @brief Number of distinct resource ids mounted.
+        size_t GetSize() const
+        {
+            return mCount;
+        }
+    private:
+        struct Mounted
+        {
+            std::unique_ptr<Package> mPackage;
+            int64_t mRank; ///< Lower ranks win, front mounts count down and back mounts up.
+        };
+        struct Slot
+        {
+            uint32_t mCrc;
+            uint32_t mPackage; ///< Index into mMounted, kEmpty for a free slot.
+            uint32_t mEntry;
+        };
+        /// Open addressing table of crc << 32 | resolved, zero marks a free slot.
+        struct AliasTable
+        {
+            std::unique_ptr<std::atomic<uint64_t>[]> mSlots;
+            size_t mCapacity;
+            uint32_t mShift;
+            std::atomic<size_t> mCount;
+        };
+        static constexpr uint32_t kEmpty = 0xffffffff;
+        size_t GetHome ( uint32_t aCrc ) const;
+        size_t Probe ( uint32_t aCrc ) const;
+        void Reserve ( size_t aCount );
+        void Insert ( uint32_t aCrc, uint32_t aPackage, uint32_t aEntry );
+        void Erase ( size_t aSlot );
+        AliasTable* GrowAliases ( AliasTable* aFull ) const;
+        void ClearAliases();
+        std::vector<Mounted> mMounted{};
+        std::vector<Slot> mSlots{};
+        size_t mCount{};
+        uint32_t mShift{64};
+        int64_t mFront{};
+        int64_t mBack{};
+        mutable std::atomic<AliasTable*> mAliases{nullptr};
+        /// Every alias table since the last mount change, lookups may still be reading the older ones.
+        mutable std::vector<std::unique_ptr<AliasTable >> mAliasTables{};
+        mutable std::mutex mAliasMutex{};
+    };
+}
+#endif
@@ -44,6 +44,7 @@ limitations under the License.
 #include <climits>
 #include <cfloat>
 #include <cstdio>
+#include <cstddef>
 
 #if 0
 /*! \name Constants */
@@ -720,312 +721,33 @@ inline float* InvertMatrix ( float *mat, float *dest )
     memcpy ( dest, dst, sizeof ( float ) * 16 );
     return dest;
 }
-#if 0
-/// Moved to Matrix4x4 Class
 /*! \brief Multiplies two 4x4 matrices.
 
 Multiplies two 4x4 matrices, returning a pointer to the resulting matrix,
 each of which should be an array of 16 float elements,
-dst may be the same as either of the two matrices in which case the matrix is overwritten,
+out may be the same as either of the two matrices in which case the matrix is overwritten,
 it must not be NULL, and should point to an array of at least 16 float elements.
+This is the scalar reference for SimdMultiply4x4Matrix in SIMD.h.
 \param A [in] Pointer or reference to left side matrix
 \param B [in] Pointer or reference to right side matrix
-\param dst [out] Pointer or reference to space in memory in which to store the result, may be the same as either m1 or m2.
-\return A pointer to the resulting matrix, same as dst.
+\param out [out] Pointer or reference to space in memory in which to store the result, may be the same as either A or B.
+\return A pointer to the resulting matrix, same as out.
 \note Multiplication is done in column mayor order.
 */
 inline float* Multiply4x4Matrix ( const float* A, const float* B, float* out )
 {
     float result[16];
-    float mx1[16];
-    float mx2[16];
-    memcpy ( mx1, A, sizeof ( float ) * 16 );
-    memcpy ( mx2, B, sizeof ( float ) * 16 );
-#if 0
-    // This code is unsafe, kept here only as reference
-    if ( bHasSSE )
+    for ( int column = 0; column < 4; ++column )
     {
-#ifdef __GNUC__
-        __asm__
-        (
-            "movss  %0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups %1,%%xmm0\n\t"
-            "mulps  %%xmm4,%%xmm0\n\t"
-            // ------+
-            "movss  4%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 16%1,%%xmm1\n\t"
-            "mulps  %%xmm4,%%xmm1\n\t"
-            // ------+
-            "movss  8%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 32%1,%%xmm2\n\t"
-            "mulps  %%xmm4,%%xmm2\n\t"
-            // ------+
-            "movss  12%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 48%1,%%xmm3\n\t"
-            "mulps  %%xmm4,%%xmm3\n\t"
-            //-------+
-            "addps %%xmm1,%%xmm0\n\t"
-            "addps %%xmm2,%%xmm0\n\t"
-            "addps %%xmm3,%%xmm0\n\t"
-            "movups %%xmm0,%2\n\t"
-            // done a side
-            "movss  16%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups %1,%%xmm0\n\t"
-            "mulps  %%xmm4,%%xmm0\n\t"
-            // ------
-            "movss 20%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 16%1,%%xmm1\n\t"
-            "mulps  %%xmm4,%%xmm1\n\t"
-            // ------
-            "movss 24%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 32%1,%%xmm2\n\t"
-            "mulps  %%xmm4,%%xmm2\n\t"
-            // ------
-            "movss 28%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 48%1,%%xmm3\n\t"
-            "mulps  %%xmm4,%%xmm3\n\t"
-            //-------
-            "addps %%xmm1,%%xmm0\n\t"
-            "addps %%xmm2,%%xmm0\n\t"
-            "addps %%xmm3,%%xmm0\n\t"
-            "movups %%xmm0,16%2\n\t"
-            // done a side
-            "movss 32%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups %1,%%xmm0\n\t"
-            "mulps  %%xmm4,%%xmm0\n\t"
-            // ------
-            "movss 36%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 16%1,%%xmm1\n\t"
-            "mulps  %%xmm4,%%xmm1\n\t"
-            // ------
-            "movss 40%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 32%1,%%xmm2\n\t"
-            "mulps  %%xmm4,%%xmm2\n\t"
-            // ------
-            "movss 44%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 48%1,%%xmm3\n\t"
-            "mulps  %%xmm4,%%xmm3\n\t"
-            //-------
-            "addps %%xmm1,%%xmm0\n\t"
-            "addps %%xmm2,%%xmm0\n\t"
-            "addps %%xmm3,%%xmm0\n\t"
-            "movups %%xmm0,32%2\n\t"
-            // done a side
-            "movss 48%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups %1,%%xmm0\n\t"
-            "mulps  %%xmm4,%%xmm0\n\t"
-            // ------
-            "movss 52%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 16%1,%%xmm1\n\t"
-            "mulps  %%xmm4,%%xmm1\n\t"
-            // ------
-            "movss 56%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 32%1,%%xmm2\n\t"
-            "mulps  %%xmm4,%%xmm2\n\t"
-            // ------
-            "movss 60%0,%%xmm4\n\t"
-            "shufps $0x0,%%xmm4,%%xmm4\n\t"
-            "movups 48%1,%%xmm3\n\t"
-            "mulps  %%xmm4,%%xmm3\n\t"
-            //-------
-            "addps %%xmm1,%%xmm0\n\t"
-            "addps %%xmm2,%%xmm0\n\t"
-            "addps %%xmm3,%%xmm0\n\t"
-            "movups %%xmm0,48%2\n\t"
-            :
-            : "m" ( mx[0] ), "m" ( m2[0] ), "m" ( result[0] )
-            : "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4"
-        );
-        //   __asm__ __volatile__ ("rdtsc" : "=A" (nElapsedTime));
-        //   fprintf(stdout,"ElapsedTime: %d\n",nElapsedTime-nCurrentTime);
-
-#elif _MSC_VER
-        __asm
+        const float* b = B + column * 4;
+        for ( int row = 0; row < 4; ++row )
         {
-            // Small preamble, MSVC Inline ASM doesn't
-            // automatically reference object variables
-            mov eax, this // avoid C4537 Warning
-            lea eax, [eax]this.mx
-            mov ecx, MX // avoid C4537 Warning
-            lea ecx, [ecx]m2
-            lea edx, result // local variables need not be moved, if they are, app crashes
-            movss  xmm4, [eax]
-            shufps xmm4, xmm4, 0
-            movups xmm0, [ecx]
-            mulps  xmm0, xmm4
-            // ------
-            movss  xmm4, [eax+ 4]
-            shufps xmm4, xmm4, 0
-            movups xmm1, [ecx+16]
-            mulps  xmm1, xmm4
-            // ------
-            movss  xmm4, [eax+ 8]
-            shufps xmm4, xmm4, 0
-            movups xmm2, [ecx+32]
-            mulps  xmm2, xmm4
-            // ------
-            movss  xmm4, [eax+ 12]
-            shufps xmm4, xmm4, 0
-            movups xmm3, [ecx+48]
-            mulps  xmm3, xmm4
-            //-------
-            addps xmm0, xmm1
-            addps xmm0, xmm2
-            addps xmm0, xmm3
-            movups [edx], xmm0
-            // done a side
-            movss  xmm4, [eax+ 16]
-            shufps xmm4, xmm4, 0
-            movups xmm0, [ecx]
-            mulps  xmm0, xmm4
-            // ------
-            movss  xmm4, [eax+ 20]
-            shufps xmm4, xmm4, 0
-            movups xmm1, [ecx+16]
-            mulps  xmm1, xmm4
-            // ------
-            movss  xmm4, [eax+ 24]
-            shufps xmm4, xmm4, 0
-            movups xmm2, [ecx+32]
-            mulps  xmm2, xmm4
-            // ------
-            movss  xmm4, [eax+ 28]
-            shufps xmm4, xmm4, 0
-            movups xmm3, [ecx+48]
-            mulps  xmm3, xmm4
-            //-------
-            addps xmm0, xmm1
-            addps xmm0, xmm2
-            addps xmm0, xmm3
-            movups [edx+16], xmm0
-            // done a side
-            movss  xmm4, [eax+ 32]
-            shufps xmm4, xmm4, 0
-            movups xmm0, [ecx]
-            mulps  xmm0, xmm4
-            // ------
-            movss  xmm4, [eax+ 36]
-            shufps xmm4, xmm4, 0
-            movups xmm1, [ecx+16]
-            mulps  xmm1, xmm4
-            // ------
-            movss  xmm4, [eax+ 40]
-            shufps xmm4, xmm4, 0
-            movups xmm2, [ecx+32]
-            mulps  xmm2, xmm4
-            // ------
-            movss  xmm4, [eax+ 44]
-            shufps xmm4, xmm4, 0
-            movups xmm3, [ecx+48]
-            mulps  xmm3, xmm4
-            //-------
-            addps xmm0, xmm1
-            addps xmm0, xmm2
-            addps xmm0, xmm3
-            movups [edx+32], xmm0
-            // done a side
-            movss  xmm4, [eax+ 48]
-            shufps xmm4, xmm4, 0
-            movups xmm0, [ecx]
-            mulps  xmm0, xmm4
-            // ------
-            movss  xmm4, [eax+ 52]
-            shufps xmm4, xmm4, 0
-            movups xmm1, [ecx+16]
-            mulps  xmm1, xmm4
-            // ------
-            movss  xmm4, [eax+ 56]
-            shufps xmm4, xmm4, 0
-            movups xmm2, [ecx+32]
-            mulps  xmm2, xmm4
-            // ------
-            movss  xmm4, [eax+ 60]
-            shufps xmm4, xmm4, 0
-            movups xmm3, [ecx+48]
-            mulps  xmm3, xmm4
-            //-------
-            addps xmm0, xmm1
-            addps xmm0, xmm2
-            addps xmm0, xmm3
-            movups [edx+48], xmm0
-            // done a side
+            result[column * 4 + row] = A[row] * b[0] + A[row + 4] * b[1] + A[row + 8] * b[2] + A[row + 12] * b[3];
         }
-#endif
     }
-    else
-    {
-#endif
-#if 0
-        // Row mayor (DX way)
-        /* In column mayor you must pre multiply
-        this means that the Model View Projection Matrix must be calculated as:
-        Model * View * Projection */
-        result[ 0] = mx1[ 0] * mx2[ 0] + mx1[ 1] * mx2[ 4] + mx1[ 2] * mx2[ 8] + mx1[ 3] * mx2[12];
-        result[ 1] = mx1[ 0] * mx2[ 1] + mx1[ 1] * mx2[ 5] + mx1[ 2] * mx2[ 9] + mx1[ 3] * mx2[13];
-        result[ 2] = mx1[ 0] * mx2[ 2] + mx1[ 1] * mx2[ 6] + mx1[ 2] * mx2[10] + mx1[ 3] * mx2[14];
-        result[ 3] = mx1[ 0] * mx2[ 3] + mx1[ 1] * mx2[ 7] + mx1[ 2] * mx2[11] + mx1[ 3] * mx2[15];
-
-        result[ 4] = mx1[ 4] * mx2[ 0] + mx1[ 5] * mx2[ 4] + mx1[ 6] * mx2[ 8] + mx1[ 7] * mx2[12];
-        result[ 5] = mx1[ 4] * mx2[ 1] + mx1[ 5] * mx2[ 5] + mx1[ 6] * mx2[ 9] + mx1[ 7] * mx2[13];
-        result[ 6] = mx1[ 4] * mx2[ 2] + mx1[ 5] * mx2[ 6] + mx1[ 6] * mx2[10] + mx1[ 7] * mx2[14];
-        result[ 7] = mx1[ 4] * mx2[ 3] + mx1[ 5] * mx2[ 7] + mx1[ 6] * mx2[11] + mx1[ 7] * mx2[15];
-
-        result[ 8] = mx1[ 8] * mx2[ 0] + mx1[ 9] * mx2[ 4] + mx1[10] * mx2[ 8] + mx1[11] * mx2[12];
-        result[ 9] = mx1[ 8] * mx2[ 1] + mx1[ 9] * mx2[ 5] + mx1[10] * mx2[ 9] + mx1[11] * mx2[13];
-        result[10] = mx1[ 8] * mx2[ 2] + mx1[ 9] * mx2[ 6] + mx1[10] * mx2[10] + mx1[11] * mx2[14];
-        result[11] = mx1[ 8] * mx2[ 3] + mx1[ 9] * mx2[ 7] + mx1[10] * mx2[11] + mx1[11] * mx2[15];
-
-        result[12] = mx1[12] * mx2[ 0] + mx1[13] * mx2[ 4] + mx1[14] * mx2[ 8] + mx1[15] * mx2[12];
-        result[13] = mx1[12] * mx2[ 1] + mx1[13] * mx2[ 5] + mx1[14] * mx2[ 9] + mx1[15] * mx2[13];
-        result[14] = mx1[12] * mx2[ 2] + mx1[13] * mx2[ 6] + mx1[14] * mx2[10] + mx1[15] * mx2[14];
-        result[15] = mx1[12] * mx2[ 3] + mx1[13] * mx2[ 7] + mx1[14] * mx2[11] + mx1[15] * mx2[15];
-#else
-        // Column mayor (OpenGL way)
-        /* In column mayor you must post multiply,
-        this means that the Model View Projection Matrix must be calculated as:
-        Projection * View * Model */
-        result[ 0] = mx1[ 0] * mx2[ 0] + mx1[ 4] * mx2[ 1] + mx1[ 8] * mx2[ 2] + mx1[12] * mx2[ 3];
-        result[ 1] = mx1[ 1] * mx2[ 0] + mx1[ 5] * mx2[ 1] + mx1[ 9] * mx2[ 2] + mx1[13] * mx2[ 3];
-        result[ 2] = mx1[ 2] * mx2[ 0] + mx1[ 6] * mx2[ 1] + mx1[10] * mx2[ 2] + mx1[14] * mx2[ 3];
-        result[ 3] = mx1[ 3] * mx2[ 0] + mx1[ 7] * mx2[ 1] + mx1[11] * mx2[ 2] + mx1[15] * mx2[ 3];
-
-        result[ 4] = mx1[ 0] * mx2[ 4] + mx1[ 4] * mx2[ 5] + mx1[ 8] * mx2[ 6] + mx1[12] * mx2[ 7];
-        result[ 5] = mx1[ 1] * mx2[ 4] + mx1[ 5] * mx2[ 5] + mx1[ 9] * mx2[ 6] + mx1[13] * mx2[ 7];
-        result[ 6] = mx1[ 2] * mx2[ 4] + mx1[ 6] * mx2[ 5] + mx1[10] * mx2[ 6] + mx1[14] * mx2[ 7];
-        result[ 7] = mx1[ 3] * mx2[ 4] + mx1[ 7] * mx2[ 5] + mx1[11] * mx2[ 6] + mx1[15] * mx2[ 7];
-
-        result[ 8] = mx1[ 0] * mx2[ 8] + mx1[ 4] * mx2[ 9] + mx1[ 8] * mx2[10] + mx1[12] * mx2[11];
-        result[ 9] = mx1[ 1] * mx2[ 8] + mx1[ 5] * mx2[ 9] + mx1[ 9] * mx2[10] + mx1[13] * mx2[11];
-        result[10] = mx1[ 2] * mx2[ 8] + mx1[ 6] * mx2[ 9] + mx1[10] * mx2[10] + mx1[14] * mx2[11];
-        result[11] = mx1[ 3] * mx2[ 8] + mx1[ 7] * mx2[ 9] + mx1[11] * mx2[10] + mx1[15] * mx2[11];
-
-        result[12] = mx1[ 0] * mx2[12] + mx1[ 4] * mx2[13] + mx1[ 8] * mx2[14] + mx1[12] * mx2[15];
-        result[13] = mx1[ 1] * mx2[12] + mx1[ 5] * mx2[13] + mx1[ 9] * mx2[14] + mx1[13] * mx2[15];
-        result[14] = mx1[ 2] * mx2[12] + mx1[ 6] * mx2[13] + mx1[10] * mx2[14] + mx1[14] * mx2[15];
-        result[15] = mx1[ 3] * mx2[12] + mx1[ 7] * mx2[13] + mx1[11] * mx2[14] + mx1[15] * mx2[15];
-#endif
-#if 0
-    }
-#endif
     memcpy ( out, result, sizeof ( float ) * 16 );
     return out;
 }
-#endif
 /*! \brief Multiplies only the 3x3 part of two 4x4 matrices.
 
 Multiplies two 4x4 matrices, returning a pointer to the resulting matrix,
@@ -2087,6 +1809,59 @@ inline float BoxDistanceToPlane ( float* plane, const float* point, const float*
         plane[2] * point[2] - dist;
 }
 
+/** @brief Tests an axis-aligned bounding box against a set of planes.
+
+    Same test as AABB::GetDistanceToPlane applied to every plane, in the
+    same operation order. This is the scalar reference for
+    SimdPlanesIntersectBox in SIMD.h.
+    @param planes Array of count 4-element plane equations, normals pointing out.
+    @param count Number of planes.
+    @param point Center of the box.
+    @param dimensions Half-extents of the box [x,y,z].
+    @return false if the box is entirely outside of any plane. */
+inline bool PlanesIntersectBox ( const float* planes, size_t count, const float* point, const float* dimensions )
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const float* plane = planes + i * 4;
+        const float corner[3] =
+        {
+            point[0] + ( ( plane[0] < 0 ) ? dimensions[0] : -dimensions[0] ),
+            point[1] + ( ( plane[1] < 0 ) ? dimensions[1] : -dimensions[1] ),
+            point[2] + ( ( plane[2] < 0 ) ? dimensions[2] : -dimensions[2] )
+        };
+        if ( plane[0] * corner[0] + plane[1] * corner[1] + plane[2] * corner[2] - plane[3] > 0.0f )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Transforms an axis-aligned bounding box, keeping it axis aligned.
+
+    Based on Real Time Collision Detection 4.2.6. This is the scalar
+    reference for SimdTransformBox in SIMD.h.
+    @param M Column major 3x3 scale-rotation matrix.
+    @param translation Translation [x,y,z].
+    @param point Center of the box.
+    @param dimensions Half-extents of the box [x,y,z].
+    @param out_point [out] Center of the transformed box.
+    @param out_dimensions [out] Half-extents of the transformed box.
+*/
+inline void TransformBox ( const float* M, const float* translation, const float* point, const float* dimensions, float* out_point, float* out_dimensions )
+{
+    float center[3];
+    float radii[3];
+    for ( int i = 0; i < 3; ++i )
+    {
+        center[i] = translation[i] + ( M[i] * point[0] + M[i + 3] * point[1] + M[i + 6] * point[2] );
+        radii[i] = std::abs ( M[i] ) * dimensions[0] + std::abs ( M[i + 3] ) * dimensions[1] + std::abs ( M[i + 6] ) * dimensions[2];
+    }
+    memcpy ( out_point, center, sizeof ( float ) * 3 );
+    memcpy ( out_dimensions, radii, sizeof ( float ) * 3 );
+}
+
 /** @brief Computes the distance from a capsule to a plane.
     @param plane 4-element plane equation.
     @param point Center of the capsule.
@@ -13,7 +13,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
-#include "3DMath.h"
+#include "SIMD.h"
 #include "aeongames/Plane.hpp"
 #include "aeongames/Frustum.hpp"
 #include "aeongames/AABB.hpp"
@@ -79,19 +79,19 @@ namespace AeonGames
     }
     }
     {
+        float planes[6 * 4];
+        for ( size_t i = 0; i < mPlanes.size(); ++i )
+        {
+            memcpy ( planes + i * 4, mPlanes[i].GetNormal().GetVector3(), sizeof ( float ) * 3 );
+            planes[i * 4 + 3] = mPlanes[i].GetDistance();
+        }
+        PackPlaneLanes ( planes, mPlanes.size(), mPlaneLanes.data() );
     }
     Frustum::~Frustum()
         = default;
     bool Frustum::Intersects ( const AABB & aAABB ) const
     {
-        for ( auto& plane : mPlanes )
-        {
-            if ( aAABB.GetDistanceToPlane ( plane ) > 0.0f )
-            {
-                return false;
-            }
-        }
-        return true;
+        return SimdPlanesIntersectBox ( mPlaneLanes.data(), aAABB.GetCenter().GetVector3(), aAABB.GetRadii().GetVector3() );
     }
     bool Frustum::Intersects ( const GpuLight & aLight ) const
     {
@@ -113,4 +113,23 @@ namespace AeonGames
         };
         return Intersects ( bounds );
     }
+    float Frustum::GetDepth ( const Vector3 & aPoint ) const
+    {
+        // The plane distances are negative inside, and neither plane is
+        // normalized, but their ratio is exactly the clip-space (w + z) / 2w.
+        const Plane& near_plane = mPlanes[4];
+        const Plane& far_plane = mPlanes[5];
+        const float from_near = near_plane.GetDistance() - Dot ( near_plane.GetNormal(), aPoint );
+        const float from_far = far_plane.GetDistance() - Dot ( far_plane.GetNormal(), aPoint );
+        const float span = from_near + from_far;
+        if ( span <= 0.0f || from_near <= 0.0f )
+        {
+            return 0.0f;
+        }
+        if ( from_far <= 0.0f )
+        {
+            return 1.0f;
+        }
+        return from_near / span;
+    }
 }
@@ -19,7 +19,7 @@ limitations under the License.
 #include "aeongames/Matrix4x4.hpp"
 #include "aeongames/Transform.hpp"
 #include "aeongames/Vector3.hpp"
-#include "3DMath.h"
+#include "SIMD.h"
 
 namespace AeonGames
 {
@@ -144,33 +144,7 @@ namespace AeonGames
 
     Matrix4x4& Matrix4x4::operator *= ( const Matrix4x4& lhs )
     {
-        // Item 22 from MEC++
-        float local[16]
-        {
-            mMatrix[0], mMatrix[1], mMatrix[2], mMatrix[3],
-            mMatrix[4], mMatrix[5], mMatrix[6], mMatrix[7],
-            mMatrix[8], mMatrix[9], mMatrix[10], mMatrix[11],
-            mMatrix[12], mMatrix[13], mMatrix[14], mMatrix[15]
-        };
-        mMatrix[0] = local[0] * lhs.mMatrix[0] + local[4] * lhs.mMatrix[1] + local[8] * lhs.mMatrix[2] + local[12] * lhs.mMatrix[3];
-        mMatrix[1] = local[1] * lhs.mMatrix[0] + local[5] * lhs.mMatrix[1] + local[9] * lhs.mMatrix[2] + local[13] * lhs.mMatrix[3];
-        mMatrix[2] = local[2] * lhs.mMatrix[0] + local[6] * lhs.mMatrix[1] + local[10] * lhs.mMatrix[2] + local[14] * lhs.mMatrix[3];
-        mMatrix[3] = local[3] * lhs.mMatrix[0] + local[7] * lhs.mMatrix[1] + local[11] * lhs.mMatrix[2] + local[15] * lhs.mMatrix[3];
-
-        mMatrix[4] = local[0] * lhs.mMatrix[4] + local[4] * lhs.mMatrix[5] + local[8] * lhs.mMatrix[6] + local[12] * lhs.mMatrix[7];
-        mMatrix[5] = local[1] * lhs.mMatrix[4] + local[5] * lhs.mMatrix[5] + local[9] * lhs.mMatrix[6] + local[13] * lhs.mMatrix[7];
-        mMatrix[6] = local[2] * lhs.mMatrix[4] + local[6] * lhs.mMatrix[5] + local[10] * lhs.mMatrix[6] + local[14] * lhs.mMatrix[7];
-        mMatrix[7] = local[3] * lhs.mMatrix[4] + local[7] * lhs.mMatrix[5] + local[11] * lhs.mMatrix[6] + local[15] * lhs.mMatrix[7];
-
-        mMatrix[8] = local[0] * lhs.mMatrix[8] + local[4] * lhs.mMatrix[9] + local[8] * lhs.mMatrix[10] + local[12] * lhs.mMatrix[11];
-        mMatrix[9] = local[1] * lhs.mMatrix[8] + local[5] * lhs.mMatrix[9] + local[9] * lhs.mMatrix[10] + local[13] * lhs.mMatrix[11];
-        mMatrix[10] = local[2] * lhs.mMatrix[8] + local[6] * lhs.mMatrix[9] + local[10] * lhs.mMatrix[10] + local[14] * lhs.mMatrix[11];
-        mMatrix[11] = local[3] * lhs.mMatrix[8] + local[7] * lhs.mMatrix[9] + local[11] * lhs.mMatrix[10] + local[15] * lhs.mMatrix[11];
-
-        mMatrix[12] = local[0] * lhs.mMatrix[12] + local[4] * lhs.mMatrix[13] + local[8] * lhs.mMatrix[14] + local[12] * lhs.mMatrix[15];
-        mMatrix[13] = local[1] * lhs.mMatrix[12] + local[5] * lhs.mMatrix[13] + local[9] * lhs.mMatrix[14] + local[13] * lhs.mMatrix[15];
-        mMatrix[14] = local[2] * lhs.mMatrix[12] + local[6] * lhs.mMatrix[13] + local[10] * lhs.mMatrix[14] + local[14] * lhs.mMatrix[15];
-        mMatrix[15] = local[3] * lhs.mMatrix[12] + local[7] * lhs.mMatrix[13] + local[11] * lhs.mMatrix[14] + local[15] * lhs.mMatrix[15];
+        SimdMultiply4x4Matrix ( mMatrix, lhs.mMatrix, mMatrix );
         return *this;
     }
 
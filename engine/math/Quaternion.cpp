@@ -20,6 +20,7 @@ limitations under the License.
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include "SIMD.h"
 
 namespace AeonGames
 {
@@ -115,11 +116,7 @@ namespace AeonGames
 
     Quaternion& Quaternion::operator*= ( const Quaternion& lhs )
     {
-        float local[4] { mQuaternion[0], mQuaternion[1], mQuaternion[2], mQuaternion[3] };
-        mQuaternion[0] = ( local[0] * lhs.mQuaternion[0] - local[1] * lhs.mQuaternion[1] - local[2] * lhs.mQuaternion[2] - local[3] * lhs.mQuaternion[3] );
-        mQuaternion[1] = ( local[0] * lhs.mQuaternion[1] + local[1] * lhs.mQuaternion[0] + local[2] * lhs.mQuaternion[3] - local[3] * lhs.mQuaternion[2] );
-        mQuaternion[2] = ( local[0] * lhs.mQuaternion[2] - local[1] * lhs.mQuaternion[3] + local[2] * lhs.mQuaternion[0] + local[3] * lhs.mQuaternion[1] );
-        mQuaternion[3] = ( local[0] * lhs.mQuaternion[3] + local[1] * lhs.mQuaternion[2] - local[2] * lhs.mQuaternion[1] + local[3] * lhs.mQuaternion[0] );
+        SimdMultQuats ( mQuaternion, lhs.mQuaternion, mQuaternion );
         return *this;
     }
 
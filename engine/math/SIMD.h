@@ -0,0 +1,460 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_SIMD_H
+#define AEONGAMES_SIMD_H
+/*! \file
+    \brief SIMD versions of the 3DMath kernels used by culling, skinning and animation.
+
+    The instruction set is picked at compile time from the target flags,
+    which the SIMD_LEVEL CMake cache variable sets: AVX2, SSE4.1, SSE2 (the
+    x86-64 baseline) or None. Every kernel falls back to its scalar
+    counterpart in 3DMath.h when no instruction set is available.
+
+    The kernels perform the same floating point operations in the same
+    order as their scalar references, so both produce identical results
+    unless the compiler fuses multiply-adds in one of them.
+*/
+#include "3DMath.h"
+
+#if !defined ( AEONGAMES_NO_SIMD )
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define AEONGAMES_SIMD_SSE2 1
+#if defined ( __SSE4_1__ ) || defined ( __AVX__ )
+#define AEONGAMES_SIMD_SSE41 1
+#endif
+#if defined ( __AVX2__ )
+#define AEONGAMES_SIMD_AVX2 1
+#endif
+#include <immintrin.h>
+#endif
+#endif
+
+/*! \brief Name of the instruction set the kernels were compiled for. */
+inline const char* GetSimdInstructionSet()
+{
+#if defined ( AEONGAMES_SIMD_AVX2 )
+    return "AVX2";
+#elif defined ( AEONGAMES_SIMD_SSE41 )
+    return "SSE4.1";
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+#if defined ( AEONGAMES_SIMD_AVX2 )
+/*! \brief Two result columns of a 4x4 matrix product, one per 128 bit lane.
+    \param a Columns of the left side matrix, each repeated in both lanes.
+    \param b Two columns of the right side matrix.
+*/
+inline __m256 SimdMultiplyColumnPair ( const __m256 a[4], __m256 b )
+{
+    __m256 result = _mm256_mul_ps ( a[0], _mm256_shuffle_ps ( b, b, 0x00 ) );
+    result = _mm256_add_ps ( result, _mm256_mul_ps ( a[1], _mm256_shuffle_ps ( b, b, 0x55 ) ) );
+    result = _mm256_add_ps ( result, _mm256_mul_ps ( a[2], _mm256_shuffle_ps ( b, b, 0xAA ) ) );
+    return _mm256_add_ps ( result, _mm256_mul_ps ( a[3], _mm256_shuffle_ps ( b, b, 0xFF ) ) );
+}
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+/*! \brief One result column of a 4x4 matrix product.
+    \param a Columns of the left side matrix.
+    \param b Column of the right side matrix.
+*/
+inline __m128 SimdMultiplyColumn ( const __m128 a[4], __m128 b )
+{
+    __m128 result = _mm_mul_ps ( a[0], _mm_shuffle_ps ( b, b, 0x00 ) );
+    result = _mm_add_ps ( result, _mm_mul_ps ( a[1], _mm_shuffle_ps ( b, b, 0x55 ) ) );
+    result = _mm_add_ps ( result, _mm_mul_ps ( a[2], _mm_shuffle_ps ( b, b, 0xAA ) ) );
+    return _mm_add_ps ( result, _mm_mul_ps ( a[3], _mm_shuffle_ps ( b, b, 0xFF ) ) );
+}
+#endif
+
+/*! \brief Multiplies two column major 4x4 matrices.
+    \param A [in] Left side matrix.
+    \param B [in] Right side matrix.
+    \param out [out] Resulting matrix, may be the same as either A or B.
+    \return A pointer to the resulting matrix, same as out.
+    \sa Multiply4x4Matrix
+*/
+inline float* SimdMultiply4x4Matrix ( const float* A, const float* B, float* out )
+{
+#if defined ( AEONGAMES_SIMD_AVX2 )
+    const __m256 a[4]
+    {
+        _mm256_broadcast_ps ( reinterpret_cast<const __m128*> ( A ) ),
+        _mm256_broadcast_ps ( reinterpret_cast<const __m128*> ( A + 4 ) ),
+        _mm256_broadcast_ps ( reinterpret_cast<const __m128*> ( A + 8 ) ),
+        _mm256_broadcast_ps ( reinterpret_cast<const __m128*> ( A + 12 ) )
+    };
+    const __m256 b01 = _mm256_loadu_ps ( B );
+    const __m256 b23 = _mm256_loadu_ps ( B + 8 );
+    const __m256 result01 = SimdMultiplyColumnPair ( a, b01 );
+    const __m256 result23 = SimdMultiplyColumnPair ( a, b23 );
+    _mm256_storeu_ps ( out, result01 );
+    _mm256_storeu_ps ( out + 8, result23 );
+    return out;
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+    const __m128 a[4] { _mm_loadu_ps ( A ), _mm_loadu_ps ( A + 4 ), _mm_loadu_ps ( A + 8 ), _mm_loadu_ps ( A + 12 ) };
+    const __m128 b[4] { _mm_loadu_ps ( B ), _mm_loadu_ps ( B + 4 ), _mm_loadu_ps ( B + 8 ), _mm_loadu_ps ( B + 12 ) };
+    for ( int column = 0; column < 4; ++column )
+    {
+        _mm_storeu_ps ( out + column * 4, SimdMultiplyColumn ( a, b[column] ) );
+    }
+    return out;
+#else
+    return Multiply4x4Matrix ( A, B, out );
+#endif
+}
+
+/*! \brief Multiplies two W,X,Y,Z quaternions.
+    \param q1 [in] Left side quaternion.
+    \param q2 [in] Right side quaternion.
+    \param out [out] Resulting quaternion, may be the same as either q1 or q2.
+    \return A pointer to the resulting quaternion, same as out.
+    \sa MultQuats
+*/
+inline float* SimdMultQuats ( const float* q1, const float* q2, float* out )
+{
+#if defined ( AEONGAMES_SIMD_SSE2 )
+    const __m128 b = _mm_loadu_ps ( q2 );
+    // q2 shuffled and signed for the X, Y and Z terms of q1, see MultQuats.
+    const __m128 x = _mm_xor_ps ( _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 2, 3, 0, 1 ) ), _mm_setr_ps ( -0.0f, 0.0f, -0.0f, 0.0f ) );
+    const __m128 y = _mm_xor_ps ( _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 1, 0, 3, 2 ) ), _mm_setr_ps ( -0.0f, 0.0f, 0.0f, -0.0f ) );
+    const __m128 z = _mm_xor_ps ( _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 0, 1, 2, 3 ) ), _mm_setr_ps ( -0.0f, -0.0f, 0.0f, 0.0f ) );
+    __m128 result = _mm_mul_ps ( _mm_set1_ps ( q1[0] ), b );
+    result = _mm_add_ps ( result, _mm_mul_ps ( _mm_set1_ps ( q1[1] ), x ) );
+    result = _mm_add_ps ( result, _mm_mul_ps ( _mm_set1_ps ( q1[2] ), y ) );
+    result = _mm_add_ps ( result, _mm_mul_ps ( _mm_set1_ps ( q1[3] ), z ) );
+    _mm_storeu_ps ( out, result );
+    return out;
+#else
+    return MultQuats ( q1, q2, out );
+#endif
+}
+
+/*! \brief Transforms an axis-aligned bounding box, keeping it axis aligned.
+    \param M Column major 3x3 scale-rotation matrix.
+    \param translation Translation [x,y,z].
+    \param point Center of the box.
+    \param dimensions Half-extents of the box [x,y,z].
+    \param out_point [out] Center of the transformed box.
+    \param out_dimensions [out] Half-extents of the transformed box.
+    \sa TransformBox
+*/
+inline void SimdTransformBox ( const float* M, const float* translation, const float* point, const float* dimensions, float* out_point, float* out_dimensions )
+{
+#if defined ( AEONGAMES_SIMD_SSE2 )
+    const __m128 sign = _mm_set1_ps ( -0.0f );
+    // The last column is gathered so the load stays inside the 9 floats.
+    const __m128 column0 = _mm_loadu_ps ( M );
+    const __m128 column1 = _mm_loadu_ps ( M + 3 );
+    const __m128 column2 = _mm_setr_ps ( M[6], M[7], M[8], 0.0f );
+    __m128 center = _mm_mul_ps ( column0, _mm_set1_ps ( point[0] ) );
+    center = _mm_add_ps ( center, _mm_mul_ps ( column1, _mm_set1_ps ( point[1] ) ) );
+    center = _mm_add_ps ( center, _mm_mul_ps ( column2, _mm_set1_ps ( point[2] ) ) );
+    center = _mm_add_ps ( _mm_setr_ps ( translation[0], translation[1], translation[2], 0.0f ), center );
+    __m128 radii = _mm_mul_ps ( _mm_andnot_ps ( sign, column0 ), _mm_set1_ps ( dimensions[0] ) );
+    radii = _mm_add_ps ( radii, _mm_mul_ps ( _mm_andnot_ps ( sign, column1 ), _mm_set1_ps ( dimensions[1] ) ) );
+    radii = _mm_add_ps ( radii, _mm_mul_ps ( _mm_andnot_ps ( sign, column2 ), _mm_set1_ps ( dimensions[2] ) ) );
+    float result[8];
+    _mm_storeu_ps ( result, center );
+    _mm_storeu_ps ( result + 4, radii );
+    memcpy ( out_point, result, sizeof ( float ) * 3 );
+    memcpy ( out_dimensions, result + 4, sizeof ( float ) * 3 );
+#else
+    TransformBox ( M, translation, point, dimensions, out_point, out_dimensions );
+#endif
+}
+
+/*! \brief Number of planes SimdPlanesIntersectBox tests at once. */
+constexpr size_t kSimdPlaneLanes = 8;
+
+/*! \brief Transposes plane equations into the layout SimdPlanesIntersectBox reads.
+
+    The output holds kSimdPlaneLanes X normal components, then as many Y,
+    Z and distance components. Unused lanes repeat the first plane, so they
+    never change the outcome of a test.
+    \param planes Array of count 4-element plane equations.
+    \param count Number of planes, between 1 and kSimdPlaneLanes.
+    \param lanes [out] Array of 4 * kSimdPlaneLanes floats.
+*/
+inline void PackPlaneLanes ( const float* planes, size_t count, float* lanes )
+{
+    assert ( count > 0 && count <= kSimdPlaneLanes );
+    for ( size_t lane = 0; lane < kSimdPlaneLanes; ++lane )
+    {
+        const float* plane = planes + ( ( lane < count ) ? lane : 0 ) * 4;
+        for ( size_t component = 0; component < 4; ++component )
+        {
+            lanes[component * kSimdPlaneLanes + lane] = plane[component];
+        }
+    }
+}
+
+#if defined ( AEONGAMES_SIMD_SSE2 ) && !defined ( AEONGAMES_SIMD_AVX2 )
+/*! \brief Signed distances from a box to four planes of a PackPlaneLanes block.
+    \return Positive lanes where the box is entirely outside of the plane.
+*/
+inline __m128 SimdBoxPlaneDistances ( const float* lanes, const __m128 point[3], const __m128 dimensions[3] )
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps ( -0.0f );
+    __m128 distance = zero;
+    for ( int axis = 0; axis < 3; ++axis )
+    {
+        const __m128 normal = _mm_loadu_ps ( lanes + axis * kSimdPlaneLanes );
+        const __m128 outward = _mm_cmplt_ps ( normal, zero );
+#if defined ( AEONGAMES_SIMD_SSE41 )
+        const __m128 offset = _mm_blendv_ps ( _mm_xor_ps ( dimensions[axis], sign ), dimensions[axis], outward );
+#else
+        const __m128 offset = _mm_xor_ps ( dimensions[axis], _mm_andnot_ps ( outward, sign ) );
+#endif
+        const __m128 product = _mm_mul_ps ( normal, _mm_add_ps ( point[axis], offset ) );
+        distance = ( axis == 0 ) ? product : _mm_add_ps ( distance, product );
+    }
+    return _mm_sub_ps ( distance, _mm_loadu_ps ( lanes + 3 * kSimdPlaneLanes ) );
+}
+#endif
+
+/*! \brief Tests an axis-aligned bounding box against up to eight planes.
+    \param lanes Planes transposed by PackPlaneLanes.
+    \param point Center of the box.
+    \param dimensions Half-extents of the box [x,y,z].
+    \return false if the box is entirely outside of any plane.
+    \sa PlanesIntersectBox
+*/
+inline bool SimdPlanesIntersectBox ( const float* lanes, const float* point, const float* dimensions )
+{
+#if defined ( AEONGAMES_SIMD_AVX2 )
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 sign = _mm256_set1_ps ( -0.0f );
+    __m256 distance = zero;
+    for ( int axis = 0; axis < 3; ++axis )
+    {
+        const __m256 normal = _mm256_loadu_ps ( lanes + axis * kSimdPlaneLanes );
+        const __m256 radius = _mm256_set1_ps ( dimensions[axis] );
+        const __m256 offset = _mm256_blendv_ps ( _mm256_xor_ps ( radius, sign ), radius, _mm256_cmp_ps ( normal, zero, _CMP_LT_OQ ) );
+        const __m256 product = _mm256_mul_ps ( normal, _mm256_add_ps ( _mm256_set1_ps ( point[axis] ), offset ) );
+        distance = ( axis == 0 ) ? product : _mm256_add_ps ( distance, product );
+    }
+    distance = _mm256_sub_ps ( distance, _mm256_loadu_ps ( lanes + 3 * kSimdPlaneLanes ) );
+    return _mm256_movemask_ps ( _mm256_cmp_ps ( distance, zero, _CMP_GT_OQ ) ) == 0;
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+    const __m128 center[3] { _mm_set1_ps ( point[0] ), _mm_set1_ps ( point[1] ), _mm_set1_ps ( point[2] ) };
+    const __m128 radii[3] { _mm_set1_ps ( dimensions[0] ), _mm_set1_ps ( dimensions[1] ), _mm_set1_ps ( dimensions[2] ) };
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 outside = _mm_or_ps ( _mm_cmpgt_ps ( SimdBoxPlaneDistances ( lanes, center, radii ), zero ),
+                                       _mm_cmpgt_ps ( SimdBoxPlaneDistances ( lanes + 4, center, radii ), zero ) );
+    return _mm_movemask_ps ( outside ) == 0;
+#else
+    for ( size_t lane = 0; lane < kSimdPlaneLanes; ++lane )
+    {
+        const float plane[4]
+        {
+            lanes[lane],
+            lanes[kSimdPlaneLanes + lane],
+            lanes[2 * kSimdPlaneLanes + lane],
+            lanes[3 * kSimdPlaneLanes + lane]
+        };
+        if ( !PlanesIntersectBox ( plane, 1, point, dimensions ) )
+        {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+/*! \brief Number of bones SimdInterpolatePose blends per call. */
+constexpr size_t kSimdPoseLanes = 8;
+
+#if defined ( AEONGAMES_SIMD_AVX2 )
+/*! \brief Catmull-Rom blend of one component row, four bones per double half.
+    \sa Spline
+*/
+inline __m256 SimdSplineRow ( __m256 p0, __m256 p1, __m256 p2, __m256 p3, const __m256d weights[4] )
+{
+    const __m256d half = _mm256_set1_pd ( 0.5 );
+    // The tangents subtract in single precision, like Spline does on Vector3 components.
+    const __m256 tangent0 = _mm256_sub_ps ( p2, p0 );
+    const __m256 tangent1 = _mm256_sub_ps ( p3, p1 );
+    __m128 result[2];
+    for ( int part = 0; part < 2; ++part )
+    {
+        auto widen = [part] ( __m256 aValue )
+        {
+            return _mm256_cvtps_pd ( part == 0 ? _mm256_castps256_ps128 ( aValue ) : _mm256_extractf128_ps ( aValue, 1 ) );
+        };
+        __m256d sum = _mm256_add_pd ( _mm256_mul_pd ( weights[0], widen ( p1 ) ), _mm256_mul_pd ( weights[1], widen ( p2 ) ) );
+        sum = _mm256_add_pd ( sum, _mm256_mul_pd ( weights[2], _mm256_mul_pd ( widen ( tangent0 ), half ) ) );
+        sum = _mm256_add_pd ( sum, _mm256_mul_pd ( weights[3], _mm256_mul_pd ( widen ( tangent1 ), half ) ) );
+        result[part] = _mm256_cvtpd_ps ( sum );
+    }
+    return _mm256_insertf128_ps ( _mm256_castps128_ps256 ( result[0] ), result[1], 1 );
+}
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+/*! \brief Catmull-Rom blend of one component row, four bones in two double pairs.
+    \sa Spline
+*/
+inline __m128 SimdSplineRow ( __m128 p0, __m128 p1, __m128 p2, __m128 p3, const __m128d weights[4] )
+{
+    const __m128d half = _mm_set1_pd ( 0.5 );
+    // The tangents subtract in single precision, like Spline does on Vector3 components.
+    const __m128 tangent0 = _mm_sub_ps ( p2, p0 );
+    const __m128 tangent1 = _mm_sub_ps ( p3, p1 );
+    __m128 result[2];
+    for ( int part = 0; part < 2; ++part )
+    {
+        auto widen = [part] ( __m128 aValue )
+        {
+            return _mm_cvtps_pd ( part == 0 ? aValue : _mm_movehl_ps ( aValue, aValue ) );
+        };
+        __m128d sum = _mm_add_pd ( _mm_mul_pd ( weights[0], widen ( p1 ) ), _mm_mul_pd ( weights[1], widen ( p2 ) ) );
+        sum = _mm_add_pd ( sum, _mm_mul_pd ( weights[2], _mm_mul_pd ( widen ( tangent0 ), half ) ) );
+        sum = _mm_add_pd ( sum, _mm_mul_pd ( weights[3], _mm_mul_pd ( widen ( tangent1 ), half ) ) );
+        result[part] = _mm_cvtpd_ps ( sum );
+    }
+    return _mm_movelh_ps ( result[0], result[1] );
+}
+#endif
+
+/*! \brief Interpolates kSimdPoseLanes bones between four frames.
+
+    Each frame is ten component rows, scale X, Y, Z, rotation W, X, Y, Z
+    and translation X, Y, Z, of kSimdPoseLanes bones each. Scale and
+    translation follow Spline and rotation follows NlerpQuats of the second
+    frame with itself, as AeonGames::Interpolate does, in the same double
+    and single precision operations.
+    \param frames The four frames around the sample, only the second one's rotation is read.
+    \param stride Floats from one component row to the next.
+    \param interpolation Position between the second and third frames, in [0,1).
+    \param out [out] Ten component rows of kSimdPoseLanes floats.
+    \sa AeonGames::Interpolate
+*/
+inline void SimdInterpolatePose ( const float* const frames[4], size_t stride, double interpolation, float* out )
+{
+    const double i2 = interpolation * interpolation;
+    const double i3 = i2 * interpolation;
+    // Hermite basis for the second point, third point and the two tangents.
+    const double weights[4] { 2 * i3 - 3 * i2 + 1, -2 * i3 + 3 * i2, i3 - 2 * i2 + interpolation, i3 - i2 };
+    constexpr size_t vector_rows[6] { 0, 1, 2, 7, 8, 9 };
+#if defined ( AEONGAMES_SIMD_AVX2 )
+    const __m256d lanes[4] { _mm256_set1_pd ( weights[0] ), _mm256_set1_pd ( weights[1] ), _mm256_set1_pd ( weights[2] ), _mm256_set1_pd ( weights[3] ) };
+    for ( size_t row : vector_rows )
+    {
+        const size_t offset = row * stride;
+        _mm256_storeu_ps ( out + row * kSimdPoseLanes, SimdSplineRow (
+                               _mm256_loadu_ps ( frames[0] + offset ), _mm256_loadu_ps ( frames[1] + offset ),
+                               _mm256_loadu_ps ( frames[2] + offset ), _mm256_loadu_ps ( frames[3] + offset ), lanes ) );
+    }
+    __m256 rotation[4];
+    for ( size_t component = 0; component < 4; ++component )
+    {
+        rotation[component] = _mm256_loadu_ps ( frames[1] + ( 3 + component ) * stride );
+        if ( interpolation > 0.0 )
+        {
+            const __m256d from = _mm256_set1_pd ( 1.0 - interpolation );
+            const __m256d to = _mm256_set1_pd ( interpolation );
+            const __m256d low = _mm256_cvtps_pd ( _mm256_castps256_ps128 ( rotation[component] ) );
+            const __m256d high = _mm256_cvtps_pd ( _mm256_extractf128_ps ( rotation[component], 1 ) );
+            rotation[component] = _mm256_insertf128_ps (
+                                      _mm256_castps128_ps256 ( _mm256_cvtpd_ps ( _mm256_add_pd ( _mm256_mul_pd ( low, from ), _mm256_mul_pd ( low, to ) ) ) ),
+                                      _mm256_cvtpd_ps ( _mm256_add_pd ( _mm256_mul_pd ( high, from ), _mm256_mul_pd ( high, to ) ) ), 1 );
+        }
+    }
+    __m256 length = _mm256_mul_ps ( rotation[0], rotation[0] );
+    length = _mm256_add_ps ( length, _mm256_mul_ps ( rotation[1], rotation[1] ) );
+    length = _mm256_add_ps ( length, _mm256_mul_ps ( rotation[2], rotation[2] ) );
+    length = _mm256_add_ps ( length, _mm256_mul_ps ( rotation[3], rotation[3] ) );
+    length = _mm256_sqrt_ps ( length );
+    // Zero length rotations are left alone, like Quaternion::Normalize does.
+    const __m256 nonzero = _mm256_cmp_ps ( length, _mm256_setzero_ps(), _CMP_NEQ_UQ );
+    const __m256 oneoverlength = _mm256_div_ps ( _mm256_set1_ps ( 1.0f ), length );
+    for ( size_t component = 0; component < 4; ++component )
+    {
+        _mm256_storeu_ps ( out + ( 3 + component ) * kSimdPoseLanes,
+                           _mm256_blendv_ps ( rotation[component], _mm256_mul_ps ( rotation[component], oneoverlength ), nonzero ) );
+    }
+#elif defined ( AEONGAMES_SIMD_SSE2 )
+    const __m128d lanes[4] { _mm_set1_pd ( weights[0] ), _mm_set1_pd ( weights[1] ), _mm_set1_pd ( weights[2] ), _mm_set1_pd ( weights[3] ) };
+    for ( size_t half = 0; half < kSimdPoseLanes; half += 4 )
+    {
+        for ( size_t row : vector_rows )
+        {
+            const size_t offset = row * stride + half;
+            _mm_storeu_ps ( out + row * kSimdPoseLanes + half, SimdSplineRow (
+                                _mm_loadu_ps ( frames[0] + offset ), _mm_loadu_ps ( frames[1] + offset ),
+                                _mm_loadu_ps ( frames[2] + offset ), _mm_loadu_ps ( frames[3] + offset ), lanes ) );
+        }
+        __m128 rotation[4];
+        for ( size_t component = 0; component < 4; ++component )
+        {
+            rotation[component] = _mm_loadu_ps ( frames[1] + ( 3 + component ) * stride + half );
+            if ( interpolation > 0.0 )
+            {
+                const __m128d from = _mm_set1_pd ( 1.0 - interpolation );
+                const __m128d to = _mm_set1_pd ( interpolation );
+                const __m128d low = _mm_cvtps_pd ( rotation[component] );
+                const __m128d high = _mm_cvtps_pd ( _mm_movehl_ps ( rotation[component], rotation[component] ) );
+                rotation[component] = _mm_movelh_ps (
+                                          _mm_cvtpd_ps ( _mm_add_pd ( _mm_mul_pd ( low, from ), _mm_mul_pd ( low, to ) ) ),
+                                          _mm_cvtpd_ps ( _mm_add_pd ( _mm_mul_pd ( high, from ), _mm_mul_pd ( high, to ) ) ) );
+            }
+        }
+        __m128 length = _mm_mul_ps ( rotation[0], rotation[0] );
+        length = _mm_add_ps ( length, _mm_mul_ps ( rotation[1], rotation[1] ) );
+        length = _mm_add_ps ( length, _mm_mul_ps ( rotation[2], rotation[2] ) );
+        length = _mm_add_ps ( length, _mm_mul_ps ( rotation[3], rotation[3] ) );
+        length = _mm_sqrt_ps ( length );
+        // Zero length rotations are left alone, like Quaternion::Normalize does.
+        const __m128 nonzero = _mm_cmpneq_ps ( length, _mm_setzero_ps() );
+        const __m128 oneoverlength = _mm_div_ps ( _mm_set1_ps ( 1.0f ), length );
+        for ( size_t component = 0; component < 4; ++component )
+        {
+            const __m128 normalized = _mm_mul_ps ( rotation[component], oneoverlength );
+            _mm_storeu_ps ( out + ( 3 + component ) * kSimdPoseLanes + half,
+                            _mm_or_ps ( _mm_and_ps ( nonzero, normalized ), _mm_andnot_ps ( nonzero, rotation[component] ) ) );
+        }
+    }
+#else
+    for ( size_t lane = 0; lane < kSimdPoseLanes; ++lane )
+    {
+        for ( size_t row : vector_rows )
+        {
+            const float* p0 = frames[0] + row * stride + lane;
+            const float* p1 = frames[1] + row * stride + lane;
+            const float* p2 = frames[2] + row * stride + lane;
+            const float* p3 = frames[3] + row * stride + lane;
+            const double tangent0 = ( *p2 - *p0 ) / 2.0;
+            const double tangent1 = ( *p3 - *p1 ) / 2.0;
+            out[row * kSimdPoseLanes + lane] = static_cast<float> ( weights[0] * *p1 + weights[1] * *p2 + weights[2] * tangent0 + weights[3] * tangent1 );
+        }
+        float rotation[4];
+        for ( size_t component = 0; component < 4; ++component )
+        {
+            const float value = frames[1][ ( 3 + component ) * stride + lane];
+            rotation[component] = ( interpolation > 0.0 ) ?
+                                  static_cast<float> ( ( value * ( 1.0 - interpolation ) ) + ( value * interpolation ) ) : value;
+        }
+        Normalize4 ( rotation );
+        for ( size_t component = 0; component < 4; ++component )
+        {
+            out[ ( 3 + component ) * kSimdPoseLanes + lane] = rotation[component];
+        }
+    }
+#endif
+}
+#endif
@@ -18,6 +18,7 @@ limitations under the License.
 #include "aeongames/AABB.hpp"
 #include "aeongames/Matrix4x4.hpp"
 #include "aeongames/Matrix3x3.hpp"
+#include "SIMD.h"
 
 namespace AeonGames
 {
@@ -210,11 +211,11 @@ namespace AeonGames
     {
         ///@note Based on Real Time Collision Detection 4.2.6
         Matrix3x3 scale_rotation{lhs.GetScaleRotationMatrix() };
-        return AABB
-        {
-            lhs.GetTranslation() + scale_rotation * rhs.GetCenter(),
-               Abs ( scale_rotation ) * rhs.GetRadii()
-        };
+        float center[3];
+        float radii[3];
+        SimdTransformBox ( scale_rotation.GetMatrix3x3(), lhs.GetTranslation().GetVector3(),
+                           rhs.GetCenter().GetVector3(), rhs.GetRadii().GetVector3(), center, radii );
+        return AABB { Vector3 { center }, Vector3 { radii } };
     }
 
     const bool operator== ( const Transform& lhs, const Transform& rhs )
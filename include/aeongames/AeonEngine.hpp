@@ -20,12 +20,21 @@ limitations under the License.
 #include <vector>
 #include <functional>
 #include <cstdint>
+#include <span>
 #include "Platform.hpp"
 
 namespace AeonGames
 {
     class Renderer;
     class InputSystem;
+    /** @brief One resource of a LoadResources batch. */
+    struct ResourceRead
+    {
+        uint32_t mCrc{};         ///< CRC32 of the resource path.
+        void* mBuffer{};         ///< Destination, GetResourceSize bytes for a whole resource.
+        size_t mBufferSize{};    ///< Capacity of mBuffer.
+        size_t mBytesRead{};     ///< Set by LoadResources, zero if the resource was not found.
+    };
     /** @brief Initialize the global engine environment.
      *  @param argc Number of command-line arguments.
      *  @param argv Array of command-line argument strings.
@@ -42,6 +51,20 @@ namespace AeonGames
      *  @param aPath A vector of directory paths to use for resource lookup.
      */
     DLL void SetResourcePath ( const std::vector<std::string>& aPath );
+    /** @brief Mount a package in front of the resource path.
+     *  Its resources shadow those with the same ids in every package already
+     *  mounted, the way a patch or mod would. A package already mounted from
+     *  the same path is replaced.
+     *  @param aPath Package file or loose directory.
+     *  @throw std::runtime_error if the package cannot be opened. */
+    DLL void MountResourcePackage ( const std::string& aPath );
+    /** @brief Unmount a package from the resource path.
+     *  Resources it was shadowing load from the next package that has them
+     *  again. Views returned by GetResourceView for its resources stay valid
+     *  until their owners are released.
+     *  @param aPath Path the package was mounted from.
+     *  @return false if no package was mounted from @p aPath. */
+    DLL bool UnmountResourcePackage ( const std::string& aPath );
     /*! Returns the resource size referenced by its CRC value. */
     DLL size_t GetResourceSize ( uint32_t crc );
     /*! Returns the resource size referenced by its file name. */
@@ -68,6 +91,24 @@ namespace AeonGames
     DLL void LoadResource ( uint32_t crc, void* buffer, size_t buffer_size );
     /*! Loads a specific resource referenced by its path into the provided buffer. */
     DLL void LoadResource ( const std::string& aFileName, void* buffer, size_t buffer_size );
+    /** @brief Get a resource's bytes without copying them, when its package allows it.
+     *  Uncompressed entries of AEONPKG packages are returned as a view into
+     *  the package's memory mapping, which stays valid for as long as a copy
+     *  of @p aOwner is held, even once the package is unmounted. Loose files
+     *  and compressed entries yield an empty view; fall back to
+     *  GetResourceSize and LoadResource for those.
+     *  @param crc CRC32 of the resource path.
+     *  @param aOwner Receives shared ownership of the memory the view points into, null if the view is empty.
+     *  @return View of the resource bytes, possibly empty. */
+    DLL std::span<const uint8_t> GetResourceView ( uint32_t crc, std::shared_ptr<const void>& aOwner );
+    /** @brief Load many resources with one request per package.
+     *  Reads are grouped by the package that holds them and sorted by file
+     *  offset, then submitted together (io_uring on Linux, vectored reads on
+     *  the job system elsewhere). Meant for level loads, where calling
+     *  LoadResource for each asset waits on the disk once per asset.
+     *  @param aReads Resources to load; mBytesRead is filled in for each.
+     *  @throw std::runtime_error after loading the rest if any resource was not found. */
+    DLL void LoadResources ( std::span<ResourceRead> aReads );
     /** @name Global Renderer
      * The idea of having a global renderer as opposed to being able to construct
      * multiple renderers at will as it used to be is to simplify renderer resource
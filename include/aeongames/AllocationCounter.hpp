@@ -0,0 +1,44 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_ALLOCATIONCOUNTER_H
+#define AEONGAMES_ALLOCATIONCOUNTER_H
+#include <cstdint>
+#include "aeongames/Platform.hpp"
+
+/*! \file
+    \brief Debug counters of global heap allocations.
+
+    When the engine is built with USE_ALLOCATION_COUNTER (the default for
+    Debug builds on platforms that allow replacing the global allocation
+    functions from a shared library) every global operator new is counted,
+    so tests can assert that steady-state per-frame paths do not touch the
+    heap. Otherwise the counters stay at zero and
+    IsAllocationCountingEnabled returns false. */
+
+namespace AeonGames
+{
+    /** @brief Whether global heap allocations are being counted in this build. */
+    DLL bool IsAllocationCountingEnabled();
+    /** @brief Global heap allocations made by the calling thread since it started. */
+    DLL uint64_t GetThreadAllocationCount();
+    /** @brief Global heap allocations made by all threads since the current frame began.
+     *
+     * A frame begins at each ResetFrameArenas (or BeginAllocationFrame) call. */
+    DLL uint64_t GetFrameAllocationCount();
+    /** @brief Start counting a new frame; called by ResetFrameArenas. */
+    DLL void BeginAllocationFrame();
+}
+#endif
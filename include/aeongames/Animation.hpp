@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef AEONGAMES_ANIMATION_H
 #define AEONGAMES_ANIMATION_H
 #include <cstdint>
+#include <span>
+#include <string>
 #include <vector>
 #include "aeongames/Platform.hpp"
 #include "aeongames/Transform.hpp"
@@ -24,6 +26,13 @@ limitations under the License.
 namespace AeonGames
 {
     class AnimationMsg;
+    /** @brief Error bounds for Animation::Compress. */
+    struct AnimationCompression
+    {
+        float mRotationTolerance{0.0005f};    ///< Radians.
+        float mTranslationTolerance{0.0005f}; ///< Model units.
+        float mScaleTolerance{0.0005f};       ///< Scale factor.
+    };
     /** @brief Stores skeletal animation data including keyframes and bone transforms. */
     class Animation : public Resource
     {
@@ -36,6 +45,8 @@ namespace AeonGames
         DLL void LoadFromMemory ( const void* aBuffer, size_t aBufferSize ) final;
         /** @brief Unload animation data and free resources. */
         DLL void Unload () final;
+        /** @brief Size in bytes of the sampled frames. */
+        DLL size_t GetMemoryUsage() const final;
         /** @brief Get the frame rate of the animation.
          *  @return Frame rate in frames per second. */
         DLL uint32_t GetFrameRate() const;
@@ -56,15 +67,71 @@ namespace AeonGames
          *  @param aSample Sample position within the animation.
          *  @return Transform for the bone at the given sample. */
         DLL const Transform GetTransform ( size_t aBoneIndex, double aSample ) const;
+        /** @brief Get the transforms of every bone at a given sample.
+         *
+         *  Bones are interpolated eight at a time and match GetTransform
+         *  bit for bit, so sampling a whole skeleton should use this.
+         *  @param aSample Sample position within the animation.
+         *  @param aPose Receives the transform of each bone, entries past GetBoneCount() are left untouched. */
+        DLL void SamplePose ( double aSample, std::span<Transform> aPose ) const;
         /** @brief Load animation data from a protobuf message.
          *  @param aAnimationMsg Protobuf message containing animation data. */
         DLL void LoadFromPBMsg ( const AnimationMsg& aAnimationMsg );
+        /** @brief Store the animation in a protobuf message, compressed or not.
+         *  @param aAnimationMsg Message to fill. */
+        DLL void Serialize ( AnimationMsg& aAnimationMsg ) const;
+        /** @brief Replace the sampled frames with compressed tracks.
+         *
+         *  Each bone gets a scale, rotation and translation track. Tracks
+         *  that stay within tolerance of their first frame keep a single
+         *  value, the rest are quantized, rotations to 48 bit smallest-three
+         *  and vectors to 16 bits per component over the track range, and
+         *  keep only the frames linear interpolation between neighbouring
+         *  keys cannot reproduce within tolerance. Every 32nd frame stays a
+         *  key so the keys of all bones for a stretch of the clip can be
+         *  stored together and sampled without searching the whole track.
+         *  @param aCompression Error bounds for dropped frames.
+         *  @throw std::runtime_error if the clip has more than 65536 frames. */
+        DLL void Compress ( const AnimationCompression& aCompression = {} );
+        /** @brief Whether the animation is sampled from compressed tracks. */
+        DLL bool IsCompressed() const;
+        /** @brief Number of frames in the animation. */
+        DLL uint32_t GetFrameCount() const;
+        /** @brief Number of bones each frame animates. */
+        DLL uint32_t GetBoneCount() const;
     private:
+        /// A compressed channel, its keys and values live in mSegmentData.
+        struct Track
+        {
+            uint32_t mAnimated{};  ///< Index among the tracks with keys, ~0 for constant tracks.
+            float mBase[4]{};      ///< Constant value, or the range minimum of vector tracks.
+            float mExtent[3]{};    ///< Range extent of vector tracks.
+        };
+        /** Lay out keys (clip frames) and their three uint16 codes segment by segment,
+            keys must include the first and last frame of every segment. */
+        void BuildSegments ( const std::vector<std::vector<uint16_t>>& aKeys, const std::vector<std::vector<uint16_t>>& aCodes );
+        /** Write the track's xyz or wxyz at consecutive, possibly wrapping, frames @p aFrameStride
+            floats apart, with components @p aComponentStride floats apart. */
+        void SampleTrack ( const Track& aTrack, bool aRotation, std::span<const uint32_t> aFrames, float* aValues, size_t aFrameStride, size_t aComponentStride ) const;
         std::string mFilename;
-        uint32_t mVersion;
-        uint32_t mFrameRate;
-        double mDuration;
-        std::vector<std::vector<Transform >> mFrames;
+        uint32_t mVersion{};
+        uint32_t mFrameRate{};
+        double mDuration{};
+        uint32_t mFrameCount{};
+        uint32_t mBoneCount{};
+        /// Bones per row of mPoses, the bone count rounded up to a multiple of eight.
+        uint32_t mBoneStride{};
+        /** Uncompressed frames, ten rows of mBoneStride floats each, the scale xyz,
+            rotation wxyz and translation xyz of every bone, padded with identities. */
+        std::vector<float> mPoses;
+        /// Scale, rotation and translation tracks of each bone, empty unless compressed.
+        std::vector<Track> mTracks;
+        uint32_t mAnimatedTracks{};
+        /// Start in mSegmentData of each animated track's record, segment by segment.
+        std::vector<uint32_t> mRecords;
+        /** Records of key count, key frames within the segment packed two
+            per element, then three codes per key. */
+        std::vector<uint16_t> mSegmentData;
     };
 }
 #endif
@@ -0,0 +1,111 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_ANIMATIONLOD_H
+#define AEONGAMES_ANIMATIONLOD_H
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    class AABB;
+    class Matrix4x4;
+    class Skeleton;
+    /** @brief One animation level of detail, see AnimationLod. */
+    struct AnimationLodLevel
+    {
+        float mScreenSize{};          ///< Smallest projected size, a fraction of the view height, the level is used for.
+        uint32_t mUpdateInterval{1};  ///< Updates from one pose sample to the next, the ones between extrapolate.
+        uint32_t mCulledBoneHeight{}; ///< Joints closer than this many links to their deepest leaf are culled, 0 keeps them all.
+    };
+
+    /** @brief Animation level of detail of a single animated instance.
+     *
+     *  Each update picks a level from the instance's projected size. Coarser
+     *  levels sample the pose only every few updates and extrapolate the
+     *  skinning matrices linearly from the last two samples in between, and
+     *  cull leaf joints such as fingers and face bones, which then reuse the
+     *  skinning matrix of their nearest kept ancestor. Instances no view saw
+     *  use the coarsest level.
+     *
+     *  There are no levels until SetLevels is called, so instances animate
+     *  at full detail unless a game opts in, e.g. with GetRecommendedLevels. */
+    class AnimationLod
+    {
+    public:
+        /** @brief Construct without levels, at full detail. */
+        DLL AnimationLod();
+        DLL ~AnimationLod();
+        /** @brief Replace the levels.
+         *  @param aLevels Levels from finest to coarsest, by decreasing screen size,
+         *  an empty list samples every update and keeps every joint. */
+        DLL void SetLevels ( std::vector<AnimationLodLevel> aLevels );
+        /** @brief Get the levels, finest first. */
+        DLL const std::vector<AnimationLodLevel>& GetLevels() const;
+        /** @brief Levels suited to crowds, the ones the model component's
+         *  "Animation LOD" property turns on. */
+        DLL static const std::vector<AnimationLodLevel>& GetRecommendedLevels();
+        /** @brief Pick the level for this update and whether it samples the pose.
+         *  @param aScreenSize Projected size of the instance, 0 if no view saw it.
+         *  @param aDelta Elapsed time since the last update, in seconds.
+         *  @param aSample Sample regardless of the level, e.g. while crossfading.
+         *  @return true if the caller should sample the pose and Store its skinning
+         *  matrices, false if it should Extrapolate them instead. */
+        DLL bool Advance ( float aScreenSize, double aDelta, bool aSample = false );
+        /** @brief Index of the level picked by the last Advance. */
+        DLL size_t GetLevel() const;
+        /** @brief Culled joint height of the level picked by the last Advance. */
+        DLL uint32_t GetCulledBoneHeight() const;
+        /** @brief Joint whose skinning matrix each joint uses at the current level.
+         *  @param aSkeleton Skeleton being animated.
+         *  @return One entry per joint, the joint itself when it is kept. */
+        DLL std::span<const uint16_t> GetBoneMap ( const Skeleton& aSkeleton );
+        /** @brief Record freshly sampled skinning matrices.
+         *  @param aMatrices Sixteen floats per joint. */
+        DLL void Store ( std::span<const float> aMatrices );
+        /** @brief Write skinning matrices extrapolated from the last two samples,
+         *  at most one sampling interval past the last one.
+         *  @param aMatrices Sixteen floats per joint, as many as were stored. */
+        DLL void Extrapolate ( std::span<float> aMatrices ) const;
+        /** @brief Forget the stored samples, so the next two updates sample.
+         *  Call when the pose jumps, e.g. on an animation switch. */
+        DLL void Reset();
+    private:
+        std::vector<AnimationLodLevel> mLevels;
+        size_t mLevel{};
+        uint32_t mUpdatesSinceSample{};
+        uint32_t mStoredSamples{};
+        double mTimeSinceSample{};
+        double mSampleInterval{};
+        std::vector<float> mPreviousSample;
+        std::vector<float> mLastSample;
+        /// Bone map cache, rebuilt when the skeleton or the culled height change.
+        const Skeleton* mMappedSkeleton{};
+        uint32_t mMappedHeight{};
+        std::vector<uint16_t> mJointHeights;
+        std::vector<uint16_t> mBoneMap;
+    };
+
+    /** @brief Projected size of world space bounds, as a fraction of the view height.
+     *  @param aBounds World space bounds.
+     *  @param aView View matrix.
+     *  @param aFieldOfView Vertical field of view in degrees.
+     *  @return Bounding sphere diameter over the view height at its distance,
+     *  infinite when the viewer is inside the sphere. */
+    DLL float GetProjectedSize ( const AABB& aBounds, const Matrix4x4& aView, float aFieldOfView );
+}
+#endif
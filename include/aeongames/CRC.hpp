@@ -32,8 +32,18 @@ namespace AeonGames
     extern "C"
     {
 #endif
-    /** Iterative non-constexpr crc32 calculation with previous CRC value.*/
+    /** Iterative non-constexpr crc32 calculation with previous CRC value.
+        Dispatches to crc32i_clmul when the CPU supports it and to
+        crc32i_slice8 otherwise, both match crc32r bit for bit.*/
     DLL uint32_t crc32i ( const char* message, size_t size, uint32_t previous_crc = 0 );
+    /** Slicing-by-8 table driven crc32, eight bytes per step.*/
+    DLL uint32_t crc32i_slice8 ( const char* message, size_t size, uint32_t previous_crc = 0 );
+    /** PCLMULQDQ folding crc32 for x86 CPUs, handing short messages and
+        tails to crc32i_slice8. Falls back to crc32i_slice8 entirely when
+        crc32_has_clmul returns 0.*/
+    DLL uint32_t crc32i_clmul ( const char* message, size_t size, uint32_t previous_crc = 0 );
+    /** Returns non zero when the running CPU supports the crc32i_clmul path.*/
+    DLL int crc32_has_clmul ( void );
 #ifdef __cplusplus
 }
 #endif
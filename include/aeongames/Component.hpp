@@ -102,6 +102,21 @@ namespace AeonGames
          *  @param aDelta Elapsed time since the last update, in seconds.
          */
         virtual void Update ( Node& aNode, double aDelta ) = 0;
+        /** @brief Evaluate the animation the component queued during Update.
+         *
+         *  Run by the scene's animation phase, once every node updated, for
+         *  components that called Scene::QueueAnimation. Queued components
+         *  animate concurrently, so implementations must only write their own
+         *  state and otherwise just read the node and the scene. The default
+         *  does nothing.
+         *  @param aNode  Node this component is attached to.
+         *  @param aDelta Elapsed time since the last update, in seconds.
+         */
+        virtual void Animate ( const Node& aNode, double aDelta )
+        {
+            ( void ) aNode;
+            ( void ) aDelta;
+        }
         /** @brief Append the draws this component contributes to the render queue.
          *
          *  Read-only: every piece of state needed to render must already be
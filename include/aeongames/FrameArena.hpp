@@ -0,0 +1,132 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_FRAMEARENA_H
+#define AEONGAMES_FRAMEARENA_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    /** @brief Linear (bump) allocator for transient CPU data that lives at most one frame.
+     *
+     * The CPU-side counterpart of MemoryPoolBuffer: allocations advance an
+     * offset into one preallocated block and are all released at once by
+     * Reset at the frame boundary, so per-frame scratch data costs no heap
+     * traffic. Unlike the GPU pools an exhausted arena does not fail; the
+     * request is served from a separate heap block and the next Reset grows
+     * the main block to the frame's high-water mark, so a frame's worth of
+     * overflow happens once and not every frame.
+     *
+     * An arena is not thread safe; each thread uses its own, see GetFrameArena. */
+    class FrameArena
+    {
+    public:
+        /** @brief Construct an arena with a preallocated block.
+         *  @param aCapacity Size in bytes of the main block. */
+        DLL explicit FrameArena ( size_t aCapacity );
+        DLL ~FrameArena();
+        FrameArena ( const FrameArena& ) = delete;
+        FrameArena& operator= ( const FrameArena& ) = delete;
+        /** @brief Allocate an uninitialized block valid until the next Reset.
+         *  @param aSize Number of bytes.
+         *  @param aAlignment Power-of-two alignment of the returned pointer.
+         *  @return Pointer to the block, never null. */
+        DLL void* Allocate ( size_t aSize, size_t aAlignment );
+        /** @brief Return a block early.
+         *
+         * Only the most recent allocation is actually reclaimed (the offset
+         * rolls back), which is what a growing std::vector needs to reuse its
+         * space; any other block stays allocated until Reset.
+         *  @param aPointer Block returned by Allocate.
+         *  @param aSize Size passed to Allocate. */
+        DLL void Deallocate ( void* aPointer, size_t aSize );
+        /** @brief Release every allocation at once. Call at the frame boundary only. */
+        DLL void Reset();
+        ///@brief Size in bytes of the main block.
+        DLL size_t GetCapacity() const;
+        ///@brief Bytes handed out since the last Reset, overflow included.
+        DLL size_t GetUsed() const;
+        ///@brief Number of allocations since the last Reset that did not fit the main block.
+        DLL size_t GetOverflowCount() const;
+    private:
+        std::unique_ptr<std::byte[]> mBlock{};
+        size_t mCapacity{0};
+        size_t mOffset{0};
+        /// @brief Furthest mOffset reached since the last Reset, LIFO
+        /// deallocations roll mOffset back but not this.
+        size_t mHighWater{0};
+        size_t mOverflowBytes{0};
+        std::vector<std::unique_ptr<std::byte[] >> mOverflow{};
+    };
+
+    /** @brief The calling thread's frame arena.
+     *
+     * Created on first use with the capacity set by SetFrameArenaCapacity, so
+     * job system workers get their own arena and never contend on one. */
+    DLL FrameArena& GetFrameArena();
+    /** @brief Reset the frame arenas of every thread and start a new frame.
+     *
+     * Must be called at the frame boundary, while no thread is using data
+     * allocated from an arena. The application loops call it before
+     * Scene::Update. */
+    DLL void ResetFrameArenas();
+    /** @brief Set the initial capacity of arenas created after this call.
+     *  @param aCapacity Size in bytes. */
+    DLL void SetFrameArenaCapacity ( size_t aCapacity );
+
+    /** @brief Standard allocator over a FrameArena.
+     *
+     * Lets std containers hold per-frame scratch data, e.g. FrameVector. A
+     * default-constructed allocator binds to the calling thread's arena. The
+     * container must not outlive the frame it was filled in. */
+    template<class T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+        FrameAllocator() : mArena{ &GetFrameArena() } {}
+        explicit FrameAllocator ( FrameArena& aArena ) : mArena{ &aArena } {}
+        template<class U>
+        FrameAllocator ( const FrameAllocator<U>& aOther ) : mArena{ aOther.GetArena() } {}
+        T* allocate ( size_t aCount )
+        {
+            return static_cast<T*> ( mArena->Allocate ( aCount * sizeof ( T ), alignof ( T ) ) );
+        }
+        void deallocate ( T* aPointer, size_t aCount )
+        {
+            mArena->Deallocate ( aPointer, aCount * sizeof ( T ) );
+        }
+        FrameArena* GetArena() const
+        {
+            return mArena;
+        }
+        template<class U>
+        bool operator== ( const FrameAllocator<U>& aOther ) const
+        {
+            return mArena == aOther.GetArena();
+        }
+    private:
+        FrameArena* mArena;
+    };
+
+    /// @brief std::vector whose storage comes from the calling thread's frame arena.
+    template<class T>
+    using FrameVector = std::vector<T, FrameAllocator<T >>;
+}
+#endif
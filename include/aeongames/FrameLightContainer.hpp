@@ -34,9 +34,10 @@ namespace AeonGames
      *  lazily and reused across frames, so steady-state frames allocate
      *  nothing.
      *
-     *  @note Not thread-safe. Safe today because Scene::Update runs a
-     *  sequential DFS traversal, so all Add() calls happen on one thread
-     *  and Get()/Reset() are only used outside the update phase. */
+     *  @note Not thread-safe. Scene::Update may run subtrees concurrently,
+     *  so Scene::AddLight buffers lights per subtree and only calls Add()
+     *  from the updating thread once every subtree finished; Get()/Reset()
+     *  are only used outside the update phase. */
     class FrameLightContainer
     {
     public:
@@ -56,9 +56,21 @@ namespace AeonGames
             @param aLight The light to test.
             @return true if the light can influence anything inside the frustum. */
         DLL bool Intersects ( const GpuLight& aLight ) const;
+        /** @brief Normalized depth of a point between the near (0) and far (1) planes.
+
+            For a perspective frustum this is the point's NDC depth remapped to
+            [0,1], for an orthographic one its linear depth; either way it grows
+            monotonically away from the viewer, which is all ordering needs.
+            Points outside the near/far range are clamped.
+            @param aPoint World-space point, in the space of the source matrix.
+            @return Depth in [0,1]. */
+        DLL float GetDepth ( const Vector3& aPoint ) const;
     private:
         /** @note Frustum planes' normals all point outward */
         std::array<Plane, 6> mPlanes;
+        /** @brief mPlanes transposed for the SIMD box test: eight X normal
+            components, then Y, Z and distances, padded with the first plane. */
+        std::array<float, 32> mPlaneLanes{};
     };
 }
 #endif
@@ -0,0 +1,185 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_JOBSYSTEM_H
+#define AEONGAMES_JOBSYSTEM_H
+/*! \file
+    \brief Header for the JobSystem work-stealing task scheduler.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    /** @brief Work-stealing job scheduler shared by the whole engine.
+     *
+     * Each worker thread owns a double ended queue: it pushes and pops jobs at
+     * the back (LIFO, cache friendly) while idle workers steal from the front
+     * of other workers' queues (FIFO, oldest and usually largest work first).
+     * Threads that are not workers (the main thread, tool threads) submit into
+     * a shared injection queue that every worker drains.
+     *
+     * There are no fibers: a thread that waits on a job does not block, it
+     * keeps executing queued jobs until the awaited job completes, so waiting
+     * from inside a job is safe. Ordering between jobs is expressed either as
+     * parent/child relationships (a parent completes only after all of its
+     * children) or as dependencies (a job is only queued once all of its
+     * prerequisites completed), which together form a task graph.
+     *
+     * With zero workers every job runs on the thread that waits for it, so
+     * single core machines degrade to plain serial execution. */
+    class JobSystem
+    {
+    public:
+        class Job;
+        /// @brief Shared handle to a job; keeps the job alive while referenced.
+        using JobHandle = std::shared_ptr<Job>;
+        /** @brief Start a scheduler.
+         *  @param aWorkerCount Number of worker threads to spawn. The default
+         *  uses one worker per hardware thread minus the calling thread. */
+        DLL explicit JobSystem ( size_t aWorkerCount = GetDefaultWorkerCount() );
+        /** @brief Drain outstanding work and join every worker. */
+        DLL ~JobSystem();
+        JobSystem ( const JobSystem& ) = delete;
+        JobSystem& operator= ( const JobSystem& ) = delete;
+        JobSystem ( JobSystem&& ) = delete;
+        JobSystem& operator= ( JobSystem&& ) = delete;
+
+        /** @brief Create an unsubmitted job.
+         *  @param aFunction Work to run; may be empty for a pure sync point.
+         *  @return Handle to the new job. */
+        DLL JobHandle CreateJob ( std::function<void() > aFunction );
+        /** @brief Create an unsubmitted child job.
+         *
+         * The parent does not complete until the child does. Children must be
+         * created before the parent completes, either before the parent is
+         * submitted or from within the parent's own function.
+         *  @param aParent Job that waits for the new child.
+         *  @param aFunction Work to run.
+         *  @return Handle to the new job. */
+        DLL JobHandle CreateJob ( const JobHandle& aParent, std::function<void() > aFunction );
+        /** @brief Make @p aJob wait for @p aPrerequisite.
+         *
+         * Must be called before @p aJob is submitted. When the prerequisite
+         * already completed this is a no-op; otherwise @p aJob becomes a
+         * continuation of it and is queued by whichever thread finishes the
+         * last prerequisite, so no thread ever blocks on the edge. */
+        DLL void AddDependency ( const JobHandle& aJob, const JobHandle& aPrerequisite );
+        /** @brief Queue a job for execution once its dependencies are met. */
+        DLL void Submit ( const JobHandle& aJob );
+        /** @brief Create and submit a job in one step.
+         *  @return Handle to the submitted job. */
+        DLL JobHandle Run ( std::function<void() > aFunction );
+        /** @brief Execute queued jobs on the calling thread until @p aJob completes.
+         *
+         * Rethrows the first exception thrown by the job or any of its children. */
+        DLL void Wait ( const JobHandle& aJob );
+        /** @brief Check whether a job and all of its children have finished. */
+        DLL bool IsComplete ( const JobHandle& aJob ) const;
+
+        /** @brief Invoke @p aFunction over [aBegin, aEnd) split in chunks.
+         *
+         * The range is divided into chunks of at most @p aGrainSize elements,
+         * each run as a job receiving its half open sub range. Returns once
+         * every chunk ran; runs inline when the range fits a single chunk or
+         * there are no workers.
+         *  @param aBegin First index.
+         *  @param aEnd One past the last index.
+         *  @param aGrainSize Maximum number of indices per job (0 picks one).
+         *  @param aFunction Callable taking ( size_t begin, size_t end ). */
+        template<class F>
+        void ParallelFor ( size_t aBegin, size_t aEnd, size_t aGrainSize, F&& aFunction )
+        {
+            if ( aEnd <= aBegin )
+            {
+                return;
+            }
+            const size_t count = aEnd - aBegin;
+            if ( aGrainSize == 0 )
+            {
+                // Four chunks per thread leaves room to balance uneven chunks.
+                aGrainSize = std::max<size_t> ( 1, count / ( GetThreadCount() * 4 ) );
+            }
+            if ( mWorkers.empty() || count <= aGrainSize )
+            {
+                aFunction ( aBegin, aEnd );
+                return;
+            }
+            JobHandle root = CreateJob ( {} );
+            for ( size_t begin = aBegin; begin < aEnd; begin += aGrainSize )
+            {
+                const size_t end = ( aEnd - begin > aGrainSize ) ? begin + aGrainSize : aEnd;
+                Submit ( CreateJob ( root, [&aFunction, begin, end]()
+                {
+                    aFunction ( begin, end );
+                } ) );
+            }
+            Submit ( root );
+            Wait ( root );
+        }
+
+        /// @brief Number of worker threads owned by the scheduler.
+        DLL size_t GetWorkerCount() const;
+        /// @brief Number of threads that execute jobs: the workers plus the waiting thread.
+        DLL size_t GetThreadCount() const;
+        /** @brief Index of the calling thread within this scheduler.
+         *  @return 1..GetWorkerCount() on a worker, 0 on any other thread. */
+        DLL size_t GetCurrentThreadIndex() const;
+        /// @brief One worker per hardware thread, leaving one for the caller.
+        DLL static size_t GetDefaultWorkerCount();
+    private:
+        /// @brief Mutex guarded deque of runnable jobs.
+        struct WorkQueue
+        {
+            std::mutex mMutex{};
+            std::deque<JobHandle> mJobs{};
+        };
+        void WorkerLoop ( size_t aIndex );
+        void Enqueue ( JobHandle aJob );
+        JobHandle Dequeue ( size_t aThreadIndex );
+        void Execute ( const JobHandle& aJob );
+        void Finish ( const JobHandle& aJob );
+        /// Queue 0 is the injection queue for non worker threads, 1..N belong to workers.
+        std::vector<std::unique_ptr<WorkQueue >> mQueues{};
+        std::vector<std::thread> mWorkers{};
+        std::atomic<size_t> mQueuedJobs{0};
+        std::atomic<size_t> mSleepingWorkers{0};
+        std::mutex mSleepMutex{};
+        std::condition_variable mSleepCondition{};
+        std::atomic<bool> mStop{false};
+    };
+    /** @brief (Re)start the engine wide job scheduler with a given worker count.
+     *  Called by InitializeGlobalEnvironment when the configuration sets
+     *  JobWorkerCount; must not race with jobs running on the previous instance.
+     *  @param aWorkerCount Number of worker threads to spawn. */
+    DLL void InitializeJobSystem ( size_t aWorkerCount = JobSystem::GetDefaultWorkerCount() );
+    /** @brief Access the engine wide job scheduler, created on first use.
+     *  @return The global JobSystem instance. */
+    DLL JobSystem& GetJobSystem();
+    /** @brief Join the engine wide job scheduler's workers.
+     *  Called by FinalizeGlobalEnvironment; a later GetJobSystem call starts a new one. */
+    DLL void FinalizeJobSystem();
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_LINEAROCTREE_H
+#define AEONGAMES_LINEAROCTREE_H
+#include "aeongames/Platform.hpp"
+#include "aeongames/AABB.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <functional>
+namespace AeonGames
+{
+    class Node;
+    class Frustum;
+    /** @brief Pointer-free linear octree stored as one Morton-sorted array.
+     *
+     * Drop-in alternative to Octree with the same interface. Instead of a hash
+     * map of cells each owning its own object list, every stored node is a
+     * single entry in one contiguous array sorted by the Morton code of the
+     * cell it lives in. A cell's code is its octant path from the root padded
+     * with zero octants down to the maximum depth, so the whole subtree below
+     * any cell occupies one contiguous run of the array, and each child's run
+     * is found by binary search inside its parent's. Cells therefore do not
+     * exist as objects at all: a cell is allocated exactly when its run is
+     * non-empty, and queries that fully contain a cell visit its entire run
+     * without descending further.
+     *
+     * Insertions are appended and merged into the sorted array lazily, on the
+     * next query or removal, so bulk loading costs a single sort. Placement
+     * rules (deepest fully containing cell, root bounds fixed at construction)
+     * are identical to Octree.
+     *
+     * @note Queries may merge pending insertions and are therefore not safe to
+     * run concurrently with each other unless the tree was queried (or
+     * otherwise settled) after the last AddNode. */
+    class LinearOctree
+    {
+    public:
+        ///@brief Default constructor. Produces an empty octree with zero-sized root bounds.
+        DLL LinearOctree();
+        /** @brief Construct an octree spanning the given world bounds.
+         *  @param aRootBounds Axis-aligned bounds of the root cell in world space.
+         *  @param aMaxDepth Maximum subdivision depth (clamped to 21 levels). */
+        DLL LinearOctree ( const AABB& aRootBounds, uint32_t aMaxDepth );
+        DLL ~LinearOctree();
+        /** @brief Insert a node into the octree.
+         *
+         * Placement follows the node's world-space AABB. Adding a node that is
+         * already stored re-places it instead, as Octree::AddNode does; the
+         * older entry is dropped when pending insertions are merged.
+         *  @param aNode Pointer to the node to add. */
+        DLL void AddNode ( const Node* aNode );
+        /** @brief Remove a node from the octree.
+         *
+         * Looks the node up in the cell its current bounds map to first and
+         * falls back to a linear scan when the node moved since it was added.
+         *  @param aNode Pointer to the node to remove. */
+        DLL void RemoveNode ( const Node* aNode );
+        /** @brief Re-place a node after its world-space AABB changed.
+         *
+         * Nodes still mapping to the cell they are stored in cost one binary
+         * search; nodes that crossed a cell boundary are removed (linear scan)
+         * and re-inserted. Nodes not yet stored are inserted.
+         *  @param aNode Pointer to the node to update.
+         *  @return True if the node was moved to a different cell or inserted. */
+        DLL bool UpdateNode ( const Node* aNode );
+        /** @brief Reserve storage for a number of nodes ahead of a bulk load.
+         *  @param aNodeCount Expected number of stored nodes. */
+        DLL void Reserve ( size_t aNodeCount );
+        /** @brief Visit every node whose cell intersects the frustum.
+         *
+         * Conservative broad phase, same contract as Octree::QueryFrustum.
+         *  @param aFrustum The frustum to test cell bounds against.
+         *  @param aCallback Invoked once per node found inside an intersecting cell. */
+        DLL void QueryFrustum ( const Frustum& aFrustum, const std::function<void ( const Node* ) >& aCallback ) const;
+        /** @brief Visit every node whose cell intersects the query box.
+         *
+         * Conservative broad phase, same contract as Octree::QueryAABB. Cells
+         * fully inside @p aBox report their whole subtree run without testing
+         * any descendant cell.
+         *  @param aBox The query box to test cell bounds against.
+         *  @param aCallback Invoked once per node found inside an intersecting cell. */
+        DLL void QueryAABB ( const AABB& aBox, const std::function<void ( const Node* ) >& aCallback ) const;
+        /** @brief Visit every allocated cell, passing its world-space bounds and depth.
+         *  @param aCallback Invoked once per allocated cell with its bounds and depth. */
+        DLL void ForEachCell ( const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const;
+        /** @brief Visit every allocated cell whose bounds intersect the frustum.
+         *  @param aFrustum The frustum to test cell bounds against.
+         *  @param aCallback Invoked once per intersecting cell with its bounds and depth. */
+        DLL void ForEachCell ( const Frustum& aFrustum, const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const;
+        ///@brief Number of nodes currently stored.
+        DLL size_t GetNodeCount() const;
+        ///@brief Number of allocated cells (occupied or on the path to an occupied cell).
+        DLL size_t GetCellCount() const;
+        ///@brief Maximum subdivision depth.
+        DLL uint32_t GetMaxDepth() const;
+        ///@brief Root cell bounds in world space.
+        DLL const AABB& GetRootBounds() const;
+    private:
+        /// @brief One stored node: the Morton code and depth of its cell.
+        struct Entry
+        {
+            uint64_t mCode;
+            uint32_t mDepth;
+            const Node* mNode;
+        };
+        Entry MakeEntry ( const Node* aNode ) const;
+        /// @brief Merge entries appended since the last sort into the sorted run.
+        void Settle() const;
+        /// @brief Iterator range [begin, end) of the entries stored exactly in a cell.
+        std::pair<size_t, size_t> FindCell ( uint64_t aCode, uint32_t aDepth ) const;
+        template<class CellTest, class CellVisit>
+        void Traverse ( CellTest&& aCellTest, CellVisit&& aCellVisit ) const;
+        AABB mRootBounds{};
+        uint32_t mMaxDepth{0};
+        mutable std::vector<Entry> mEntries{};
+        /// @brief Length of the sorted prefix of mEntries.
+        mutable size_t mSortedCount{0};
+        /// @brief Settle scratch: pending nodes and their index in mEntries.
+        mutable std::vector<std::pair<const Node*, size_t >> mPendingNodes{};
+    };
+}
+#endif
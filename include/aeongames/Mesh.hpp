@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <span>
 #include <vector>
 #include "aeongames/AABB.hpp"
 #include "aeongames/CRC.hpp"
@@ -26,6 +27,51 @@ limitations under the License.
 namespace AeonGames
 {
     class MeshMsg;
+    /** Byte 7 of the id of flat AEONMSH files, where protobuf meshes have '\0'
+        for binary or the start of the text. */
+    constexpr char kFlatMeshTag = '\x01';
+    /** Header of the flat AEONMSH layout (version 1).
+
+        On-disk layout (96 bytes, little-endian, packed naturally):
+            [0..7]   char    id[8]            "AEONMSH" followed by kFlatMeshTag
+            [8..11]  uint32  version          1
+            [12..15] uint32  attribute_count  MeshFileAttribute records after the header
+            [16..31] uint32  vertex_count, vertex_stride, index_count, index_size
+            [32..55] float   center[3], radii[3]  bounding box
+            [56..63] uint32  reserved[2]      must be zero
+            [64..95] uint64  vertex_offset, vertex_bytes, index_offset, index_bytes
+        Vertex and index blobs start at 16 byte aligned offsets from the start
+        of the file and are already in the layout renderers upload, so a
+        mapped or decompressed file is used without parsing or copying. */
+    struct MeshFileHeader
+    {
+        char     id[8];           /**< File ID, "AEONMSH" and kFlatMeshTag. */
+        uint32_t version;         /**< Layout version, 1. */
+        uint32_t attribute_count; /**< Number of MeshFileAttribute records following the header. */
+        uint32_t vertex_count;    /**< Number of vertices. */
+        uint32_t vertex_stride;   /**< Bytes per vertex. */
+        uint32_t index_count;     /**< Number of indices. */
+        uint32_t index_size;      /**< Bytes per index, 1, 2 or 4. */
+        float    center[3];       /**< Bounding box center. */
+        float    radii[3];        /**< Bounding box half extents. */
+        uint32_t reserved[2];     /**< Must be zero. */
+        uint64_t vertex_offset;   /**< Byte offset of the vertex blob from start of file, 16 byte aligned. */
+        uint64_t vertex_bytes;    /**< Size of the vertex blob. */
+        uint64_t index_offset;    /**< Byte offset of the index blob from start of file, 16 byte aligned. */
+        uint64_t index_bytes;     /**< Size of the index blob. */
+    };
+    /** Vertex attribute record of the flat AEONMSH layout. */
+    struct MeshFileAttribute
+    {
+        uint32_t semantic;        /**< Mesh::AttributeSemantic. */
+        uint8_t  size;            /**< Number of components. */
+        uint8_t  type;            /**< Mesh::AttributeType. */
+        uint8_t  flags;           /**< Mesh::AttributeFlag bits. */
+        uint8_t  reserved;        /**< Must be zero. */
+        uint32_t offset;          /**< Byte offset within a vertex. */
+    };
+    static_assert ( sizeof ( MeshFileHeader ) == 96, "MeshFileHeader must be 96 bytes" );
+    static_assert ( sizeof ( MeshFileAttribute ) == 12, "MeshFileAttribute must be 12 bytes" );
     /** @brief Represents a polygon mesh with vertex attributes and index data. */
     class Mesh final : public Resource
     {
@@ -122,12 +168,26 @@ namespace AeonGames
          */
         DLL void LoadFromPBMsg ( const MeshMsg& aMeshMsg );
         /** @brief Load mesh data from a raw memory buffer.
+         *  Accepts protobuf meshes, binary or text, and the flat layout.
          *  @param aBuffer Pointer to the buffer.
          *  @param aBufferSize Size of the buffer in bytes.
          */
         DLL void LoadFromMemory ( const void* aBuffer, size_t aBufferSize ) final;
+        /** @brief Load mesh data from a buffer the mesh may keep referencing.
+         *  Flat meshes whose blobs are 16 byte aligned in memory are used in
+         *  place and keep @p aOwner alive; anything else goes through LoadFromMemory.
+         *  @param aBuffer Mesh file contents.
+         *  @param aOwner Shared ownership of the memory @p aBuffer points into.
+         */
+        DLL void LoadFromView ( std::span<const uint8_t> aBuffer, const std::shared_ptr<const void>& aOwner ) final;
+        /** @brief Write the mesh in the flat AEONMSH layout.
+         *  @return File contents, see MeshFileHeader.
+         */
+        DLL std::vector<uint8_t> SaveToFlat() const;
         /** @brief Unload mesh data and release resources. */
         DLL void Unload() final;
+        /** @brief Size in bytes of the vertex and index buffers. */
+        DLL size_t GetMemoryUsage() const final;
         /** @brief Get the list of vertex attributes.
          *  @return Const reference to the attribute tuple vector.
          */
@@ -147,13 +207,13 @@ namespace AeonGames
          */
         DLL uint32_t GetVertexCount() const;
         /** @brief Get the raw vertex data buffer.
-         *  @return Const reference to the vertex byte vector.
+         *  @return View of the vertex bytes, valid until the mesh is unloaded.
          */
-        DLL const std::vector<uint8_t>& GetVertexBuffer() const;
+        DLL std::span<const uint8_t> GetVertexBuffer() const;
         /** @brief Get the raw index data buffer.
-         *  @return Const reference to the index byte vector.
+         *  @return View of the index bytes, valid until the mesh is unloaded.
          */
-        DLL const std::vector<uint8_t>& GetIndexBuffer() const;
+        DLL std::span<const uint8_t> GetIndexBuffer() const;
         /** @brief Get the axis-aligned bounding box of the mesh.
          *  @return Const reference to the AABB.
          */
@@ -163,9 +223,12 @@ namespace AeonGames
          */
         DLL size_t GetStride() const;
     private:
+        void LoadFromFlat ( std::span<const uint8_t> aBuffer, std::shared_ptr<const void> aOwner );
         AABB mAABB{};
-        std::vector<uint8_t> mVertexBuffer{};
-        std::vector<uint8_t> mIndexBuffer{};
+        /// Keeps the memory mVertexBuffer and mIndexBuffer point into alive.
+        std::shared_ptr<const void> mStorage{};
+        std::span<const uint8_t> mVertexBuffer{};
+        std::span<const uint8_t> mIndexBuffer{};
         std::vector<AttributeTuple> mAttributes{};
         uint32_t mVertexCount{};
         uint32_t mIndexSize{};
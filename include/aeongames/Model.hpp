@@ -45,6 +45,8 @@ namespace AeonGames
         static constexpr size_t INVALID_ANIMATION_INDEX = static_cast<size_t> ( -1 );
         DLL Model();
         DLL ~Model();
+        Model ( const Model& ) = delete;
+        Model& operator= ( const Model& ) = delete;
         /** @brief Load model data from a protobuf message.
          *  @param aModelMsg Protobuf message containing model data. */
         DLL void LoadFromPBMsg ( const ModelMsg& aModelMsg );
@@ -54,6 +56,8 @@ namespace AeonGames
         DLL void LoadFromMemory ( const void* aBuffer, size_t aBufferSize ) final;
         /** @brief Unload model data and free resources. */
         DLL void Unload () final;
+        /** @brief Size in bytes of the model's own tables, not of the resources it references. */
+        DLL size_t GetMemoryUsage() const final;
         /** @brief Get the list of assemblies that compose this model.
          *  @return Reference to the vector of assemblies. */
         DLL const std::vector<Assembly>& GetAssemblies() const;
@@ -84,6 +88,8 @@ namespace AeonGames
         std::vector<Assembly> mAssemblies{};
         std::vector<std::string> mAnimationNames{};
         std::vector<ResourceId> mAnimationResources{};
+        /// Resources the model keeps acquired so the cache cannot evict them under it.
+        std::vector<ResourceId> mReferences{};
     };
 }
 #endif
@@ -17,14 +17,18 @@ limitations under the License.
 #define AEONGAMES_OCTREE_H
 #include "aeongames/Platform.hpp"
 #include "aeongames/AABB.hpp"
+#include "aeongames/Frustum.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <array>
+#include <bit>
+#include <span>
 #include <vector>
 #include <functional>
 #include <unordered_map>
 namespace AeonGames
 {
     class Node;
-    class Frustum;
     /** @brief Linear (hashed) octree for broad-phase spatial queries.
      *
      * Cells are stored in a hash map keyed by a 64-bit @e location @e code rather
@@ -61,15 +65,25 @@ namespace AeonGames
          *
          * The node's world-space AABB (its global transform applied to its local
          * AABB) determines placement: the node is stored in the deepest cell that
-         * fully contains that box.
+         * fully contains that box. Adding a node that is already stored behaves
+         * like UpdateNode.
          *  @param aNode Pointer to the node to add. */
         DLL void AddNode ( const Node* aNode );
         /** @brief Remove a node from the octree.
          *
-         * Placement is recomputed from the node's current world-space AABB, so the
-         * node must not have moved since it was added. Empty cells are pruned.
+         * The cell a node was stored in is remembered at insertion, so the node
+         * may have moved since it was added. Empty cells are pruned.
          *  @param aNode Pointer to the node to remove. */
         DLL void RemoveNode ( const Node* aNode );
+        /** @brief Re-place a node after its world-space AABB changed.
+         *
+         * Recomputes the cell from the node's current bounds and only moves the
+         * node when that cell differs from the one it is stored in, so nodes
+         * that moved within their cell cost a single descent. Nodes not yet
+         * stored are inserted.
+         *  @param aNode Pointer to the node to update.
+         *  @return True if the node was moved to a different cell or inserted. */
+        DLL bool UpdateNode ( const Node* aNode );
         /** @brief Visit every node whose cell intersects the frustum.
          *
          * Descends from the root, skipping whole subtrees whose cell bounds fall
@@ -79,6 +93,60 @@ namespace AeonGames
          *  @param aFrustum The frustum to test cell bounds against.
          *  @param aCallback Invoked once per node found inside an intersecting cell. */
         DLL void QueryFrustum ( const Frustum& aFrustum, const std::function<void ( const Node* ) >& aCallback ) const;
+        /** @brief Visitor overload of QueryFrustum.
+         *
+         * Same traversal, but the visitor is called directly rather than through
+         * a std::function, so it can be inlined into the loop and no closure is
+         * allocated. The std::function overload wraps this one.
+         *  @param aFrustum The frustum to test cell bounds against.
+         *  @param aVisitor Callable taking a const Node*, invoked once per node. */
+        template<class Visitor>
+        void QueryFrustum ( const Frustum& aFrustum, Visitor&& aVisitor ) const
+        {
+            VisitNodes ( [&aFrustum] ( const AABB & aBounds, uint32_t )
+            {
+                return aFrustum.Intersects ( aBounds ) ? 1u : 0u;
+            }, [&aVisitor] ( const Node * aNode, uint32_t )
+            {
+                aVisitor ( aNode );
+            } );
+        }
+        /// @brief Maximum number of frustums a single QueryFrustums call can test.
+        static constexpr size_t kMaxQueryViews = 32;
+        /** @brief Visit every node whose cell intersects any of several frustums.
+         *
+         * Walks the tree once for all views instead of once per view. Each cell
+         * carries a bit mask of the views it intersects; a child is only tested
+         * against the views set in its parent's mask and the walk stops below a
+         * cell once the mask is empty, so every cell is tested at most once per
+         * view that can still see it. Same conservative contract as QueryFrustum.
+         *  @param aFrustums Up to kMaxQueryViews frustums, extra ones are ignored.
+         *  @param aVisitor Callable taking a const Node* and a uint32_t mask, bit i
+         *         set when the node's cell intersects aFrustums[i]. Invoked once
+         *         per node whose mask is non-zero. */
+        template<class Visitor>
+        void QueryFrustums ( std::span<const Frustum> aFrustums, Visitor&& aVisitor ) const
+        {
+            const size_t view_count = ( aFrustums.size() < kMaxQueryViews ) ? aFrustums.size() : kMaxQueryViews;
+            if ( view_count == 0 )
+            {
+                return;
+            }
+            const uint32_t all_views = ( view_count == 32 ) ? ~0u : ( ( 1u << view_count ) - 1u );
+            VisitNodes ( [&aFrustums, all_views] ( const AABB & aBounds, uint32_t aParentMask )
+            {
+                uint32_t mask = 0;
+                for ( uint32_t pending = aParentMask & all_views; pending != 0; pending &= pending - 1 )
+                {
+                    const uint32_t view = static_cast<uint32_t> ( std::countr_zero ( pending ) );
+                    if ( aFrustums[view].Intersects ( aBounds ) )
+                    {
+                        mask |= 1u << view;
+                    }
+                }
+                return mask;
+            }, aVisitor );
+        }
         /** @brief Visit every node whose cell intersects the query box.
          *
          * Descends from the root, skipping whole subtrees whose cell bounds fall
@@ -89,6 +157,20 @@ namespace AeonGames
          *  @param aBox The query box to test cell bounds against.
          *  @param aCallback Invoked once per node found inside an intersecting cell. */
         DLL void QueryAABB ( const AABB& aBox, const std::function<void ( const Node* ) >& aCallback ) const;
+        /** @brief Visitor overload of QueryAABB, see the QueryFrustum visitor overload.
+         *  @param aBox The query box to test cell bounds against.
+         *  @param aVisitor Callable taking a const Node*, invoked once per node. */
+        template<class Visitor>
+        void QueryAABB ( const AABB& aBox, Visitor&& aVisitor ) const
+        {
+            VisitNodes ( [&aBox] ( const AABB & aBounds, uint32_t )
+            {
+                return aBounds.Overlaps ( aBox ) ? 1u : 0u;
+            }, [&aVisitor] ( const Node * aNode, uint32_t )
+            {
+                aVisitor ( aNode );
+            } );
+        }
         /** @brief Visit every allocated cell, passing its world-space bounds and depth.
          *
          * Intended for debug visualization of the spatial subdivision (drawing the
@@ -118,10 +200,76 @@ namespace AeonGames
             std::vector<const Node*> mObjects{};
             uint8_t mChildExists{0};
         };
+        /// @brief Maximum depth a 64-bit location code can represent (63 spare bits / 3 bits per level).
+        static constexpr uint32_t kMaxLocationCodeDepth = 21u;
+        /// @brief Upper bound on the traversal stack depth: a depth-first walk
+        /// that pushes all eight children on each pop holds at most seven pending
+        /// siblings per level plus the eight just pushed, so the frontier never
+        /// exceeds 7 * maxDepth + 8 entries. Sized for the deepest possible tree
+        /// so the stack can live on the call stack with no heap allocation.
+        static constexpr size_t kCellStackCapacity = 7u * kMaxLocationCodeDepth + 8u;
+        /// @brief One frame of the iterative cell-traversal stack.
+        struct CellFrame
+        {
+            uint64_t mLocationCode;
+            AABB mBounds;
+            uint32_t mDepth;
+            /// @brief Views the parent cell passed, see QueryFrustums.
+            uint32_t mViewMask;
+        };
+        /** @brief Depth-first walk shared by every node query.
+         *
+         * @p aCellTest maps a cell's bounds and its parent's mask to the cell's
+         * own mask; cells with an empty mask are skipped along with their
+         * subtrees, and the objects of every other cell are passed to
+         * @p aVisitor together with the cell's mask. Single-volume queries use
+         * a mask of one bit. */
+        template<class CellTest, class Visitor>
+        void VisitNodes ( CellTest&& aCellTest, Visitor&& aVisitor ) const
+        {
+            if ( mCells.empty() )
+            {
+                return;
+            }
+            std::array<CellFrame, kCellStackCapacity> stack;
+            size_t top = 0;
+            stack[top++] = CellFrame{ 1, mRootBounds, 0, ~0u };
+            while ( top != 0 )
+            {
+                const CellFrame frame = stack[--top];
+                auto cell = mCells.find ( frame.mLocationCode );
+                if ( cell == mCells.end() )
+                {
+                    continue;
+                }
+                const uint32_t mask = aCellTest ( frame.mBounds, frame.mViewMask );
+                if ( mask == 0 )
+                {
+                    continue;
+                }
+                for ( const Node * node : cell->second.mObjects )
+                {
+                    aVisitor ( node, mask );
+                }
+                const uint8_t child_exists = cell->second.mChildExists;
+                for ( uint8_t octant = 0; octant < 8; ++octant )
+                {
+                    if ( child_exists & static_cast<uint8_t> ( 1u << octant ) )
+                    {
+                        stack[top++] = CellFrame{ ( frame.mLocationCode << 3 ) | octant, frame.mBounds.GetChildOctant ( octant ), frame.mDepth + 1, mask };
+                    }
+                }
+            }
+        }
+        uint64_t GetLocationCode ( const Node* aNode ) const;
+        void InsertIntoCell ( const Node* aNode, uint64_t aLocationCode );
+        void EraseFromCell ( const Node* aNode, uint64_t aLocationCode );
         AABB mRootBounds{};
         uint32_t mMaxDepth{0};
         size_t mSize{0};
         std::unordered_map<uint64_t, Cell> mCells{};
+        /// @brief Location code of the cell each stored node lives in.
+        std::unordered_map<const Node*, uint64_t> mLocations{};
     };
 }
 #endif
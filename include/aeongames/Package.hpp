@@ -21,19 +21,28 @@ limitations under the License.
 */
 #include <cstdint>
 #include <cstdio>
+#include <span>
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <filesystem>
+#include <memory>
 #include "aeongames/Platform.hpp"
 namespace AeonGames
 {
+    struct ResourceRead;
+    class CompressionDictionary;
     /** Compression types supported by PKG packages. */
     enum PKGCompressionTypes : uint8_t
     {
         NONE = 0, /**< No compression. */
-        ZLIB = 1  /**< ZLIB compression. */
+        ZLIB = 1, /**< ZLIB compression. */
+        ZSTD = 2, /**< Zstandard frame, optionally compressed against the package dictionary. */
+        LZ4 = 3   /**< LZ4 block, decoded into exactly uncompressed_size bytes. */
     };
+    /** Path of the entry holding the zstd dictionary shared by the small
+        entries of a package, present only if the package was packed with one. */
+    constexpr char PKGDictionaryPath[] = "aeonpkg.zdict";
     /** Header for AEONPKG files (version 1.x).
 
         On-disk layout (32 bytes, little-endian, packed naturally):
@@ -100,10 +109,52 @@ namespace AeonGames
          * @return const reference to the package's index table.
         */
         DLL const std::unordered_map<uint32_t, std::string>& GetIndexTable() const;
+        /// Returned by GetEntryIndex for files not in the AEONPKG directory.
+        static constexpr uint32_t NoEntry = 0xffffffff;
+        /** Position of a file in the AEONPKG directory, for callers keeping
+         * their own lookup over several packages so loads skip the search.
+         * @param crc CRC32 of the file path.
+         * @return The entry index, NoEntry if the file is missing or the package is a directory.
+         */
+        DLL uint32_t GetEntryIndex ( uint32_t crc ) const;
+        /*! Returns the uncompressed size of the entry at a GetEntryIndex position, zero if out of range. */
+        DLL size_t GetEntrySize ( uint32_t aEntry ) const;
+        /*! Loads the entry at a GetEntryIndex position into the provided buffer. */
+        DLL void LoadEntry ( uint32_t aEntry, void* buffer, size_t buffer_size ) const;
+        /*! View of the entry at a GetEntryIndex position, see GetFileView. */
+        DLL std::span<const uint8_t> GetEntryView ( uint32_t aEntry ) const;
         /*! Loads a specific file referenced by its CRC into the provided buffer. */
         DLL void LoadFile ( uint32_t crc, void* buffer, size_t buffer_size ) const;
         /*! Loads a specific file referenced by its path into the provided buffer. */
         DLL void LoadFile ( const std::string& aFileName, void* buffer, size_t buffer_size ) const;
+        /** Get the bytes of an uncompressed entry without copying them.
+         * AEONPKG files are mapped into memory once when the Package is
+         * constructed, entries stored with compression NONE are returned as a
+         * view straight into that mapping, valid for the lifetime of the Package.
+         * @param crc CRC32 of the file path.
+         * @return View of the file contents, empty if the entry is missing,
+         * compressed, or the package is a directory.
+         */
+        DLL std::span<const uint8_t> GetFileView ( uint32_t crc ) const;
+        /** Get the bytes of an uncompressed entry by path without copying them.
+         * @param aFileName Path of the file within the package.
+         * @return View of the file contents, see GetFileView(uint32_t).
+         */
+        DLL std::span<const uint8_t> GetFileView ( const std::string& aFileName ) const;
+        /** Share ownership of the memory mapping.
+         * Views returned by GetFileView and GetEntryView stay valid while a
+         * copy is held, even after the Package itself is destroyed, which lets
+         * resources keep referencing their bytes in place.
+         * @return The owner, null if the package is not mapped.
+         */
+        DLL std::shared_ptr<const void> GetMappingOwner() const;
+        /** Load several files in one batch.
+         * Stored entries are read straight into their buffers and compressed
+         * ones into scratch memory, all in a single ReadFileRanges call sorted
+         * by offset; compressed entries are then inflated in parallel.
+         * @param aReads Files to load by CRC; mBytesRead is set for each, zero if missing.
+         */
+        DLL void LoadFiles ( std::span<ResourceRead> aReads ) const;
     private:
         /// Package Path @note may be a package file or a directory
         const std::filesystem::path mPath;
@@ -112,6 +163,15 @@ namespace AeonGames
             answer GetFileSize/LoadFile without re-reading the header.
             Empty when mPath is a directory. */
         std::vector<PKGDirectoryEntry> mEntries;
+        /** Read only mapping of the whole AEONPKG file. Null for directories,
+            or if the file could not be mapped, in which case entries are read
+            through a file stream instead. */
+        const uint8_t* mMapping{nullptr};
+        size_t mMappingSize{0};
+        /// Unmaps mMapping once the package and every view holder have let go.
+        std::shared_ptr<const void> mMappingOwner{};
+        /// Digested PKGDictionaryPath entry, null if the package has none.
+        std::shared_ptr<const CompressionDictionary> mDictionary{};
     };
 }
 #endif
@@ -0,0 +1,127 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_POSECACHE_H
+#define AEONGAMES_POSECACHE_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "aeongames/Platform.hpp"
+#include "aeongames/BufferAccessor.hpp"
+
+namespace AeonGames
+{
+    /** @brief What makes two instances' poses identical. */
+    struct PoseCacheKey
+    {
+        const void* mSkeleton{};      ///< Skeleton being animated.
+        const void* mAnimation{};     ///< Clip being played, instances mid-crossfade are never cached.
+        double mSample{};             ///< Sample position, as returned by PoseCache::Quantize.
+        uint32_t mCulledBoneHeight{}; ///< Culled joints, see AnimationLodLevel.
+        bool operator== ( const PoseCacheKey& ) const = default;
+    };
+
+    /** @brief A pose sampled this frame, shared by every instance with its key. */
+    struct PoseCacheEntry
+    {
+        std::vector<float> mMatrices;                  ///< Skinning matrices, sixteen floats per joint.
+        const void* mSkinnedModel{};                   ///< Model mSkinnedVertices were skinned for.
+        void* mSkinnedWindow{};                        ///< Window mSkinnedVertices were allocated on.
+        std::vector<BufferAccessor> mSkinnedVertices;  ///< Skinned vertices of each of the model's assemblies.
+    };
+
+    /** @brief Pose cache hits since the last BeginFrame. */
+    struct PoseCacheStatistics
+    {
+        size_t mPoseLookups{};
+        size_t mPoseHits{};
+        size_t mSkinLookups{};
+        size_t mSkinHits{};
+    };
+
+    /** @brief Per frame cache of sampled poses.
+     *
+     *  Instances playing the same clip on the same skeleton at the same
+     *  time sample it once per frame: the first one to look a pose up
+     *  samples and inserts it, the rest copy its skinning matrices and may
+     *  also reuse the vertices it skinned. Lookups are thread safe so
+     *  components can use the cache from a parallel scene update.
+     *
+     *  By default only exactly equal samples are shared, which leaves every
+     *  animation untouched but only pays off for instances started in
+     *  lockstep. A non zero quantum (see SetQuantum) snaps samples to a
+     *  coarser step so instances at nearby times share too, at the cost of
+     *  every cached instance animating in visible steps of that size. */
+    class PoseCache
+    {
+    public:
+        DLL PoseCache();
+        DLL ~PoseCache();
+        /** @brief Drop the previous frame's poses and statistics. */
+        DLL void BeginFrame();
+        /** @brief Enable or disable the cache, it is enabled by default. */
+        DLL void SetEnabled ( bool aEnabled );
+        /** @brief Whether instances should look their poses up. */
+        DLL bool IsEnabled() const;
+        /** @brief Enable or disable sharing skinned vertices, enabled by default. */
+        DLL void SetSkinSharing ( bool aSkinSharing );
+        /** @brief Whether instances sharing a pose also share skinned vertices. */
+        DLL bool GetSkinSharing() const;
+        /** @brief Set the sample quantum, 0 by default.
+         *  @param aFrames Clip frames per step samples snap to, 0 only shares exactly equal samples.
+         *  A quarter frame hides the stepping at normal playback rates while
+         *  letting crowds with random start times share poses. */
+        DLL void SetQuantum ( double aFrames );
+        /** @brief Get the sample quantum in clip frames. */
+        DLL double GetQuantum() const;
+        /** @brief Snap a sample to the quantum, instances sample the snapped position
+         *  so the pose does not depend on which of them sampled it first. */
+        DLL double Quantize ( double aSample ) const;
+        /** @brief Find a pose sampled this frame.
+         *  @return The entry, or nullptr if the caller has to sample and Insert it. */
+        DLL PoseCacheEntry* Find ( const PoseCacheKey& aKey );
+        /** @brief Publish a freshly sampled pose.
+         *  @param aKey Key Find missed.
+         *  @param aMatrices Skinning matrices, sixteen floats per joint.
+         *  @return The entry, which may be another thread's if it inserted the key first. */
+        DLL PoseCacheEntry* Insert ( const PoseCacheKey& aKey, std::span<const float> aMatrices );
+        /** @brief Skinned vertices another instance produced for an entry this frame.
+         *  @return The vertices, empty if the model was not skinned on the window yet. */
+        DLL std::span<const BufferAccessor> FindSkin ( const PoseCacheEntry& aEntry, const void* aModel, void* aWindowId );
+        /** @brief Publish the vertices skinned for an entry, unless another instance already did. */
+        DLL void InsertSkin ( PoseCacheEntry& aEntry, const void* aModel, void* aWindowId, std::span<const BufferAccessor> aSkinnedVertices );
+        /** @brief Lookups and hits since the last BeginFrame. */
+        DLL PoseCacheStatistics GetStatistics() const;
+    private:
+        struct KeyHash
+        {
+            size_t operator() ( const PoseCacheKey& aKey ) const;
+        };
+        mutable std::mutex mMutex;
+        bool mEnabled{true};
+        bool mSkinSharing{true};
+        double mQuantum{0.0};
+        std::unordered_map<PoseCacheKey, PoseCacheEntry*, KeyHash> mEntries;
+        /// Entries are reused from frame to frame to keep their matrix storage.
+        std::vector<std::unique_ptr<PoseCacheEntry >> mPool;
+        size_t mPoolUsed{};
+        PoseCacheStatistics mStatistics{};
+    };
+}
+#endif
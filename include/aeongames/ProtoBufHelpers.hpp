@@ -15,15 +15,16 @@ limitations under the License.
 */
 #ifndef AEONGAMES_PROTOBUFHELPERS_H
 #define AEONGAMES_PROTOBUFHELPERS_H
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <exception>
 #include <limits>
-#include <mutex>
 #ifdef _MSC_VER
 #pragma warning( push )
 #pragma warning( disable : PROTOBUF_WARNINGS )
 #endif
+#include <google/protobuf/arena.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/io/zero_copy_stream.h>
 #ifdef _MSC_VER
@@ -213,11 +214,30 @@ namespace AeonGames
         return t;
     }
 
+    /** Arena options for decoding a message out of a buffer of @p aBufferSize bytes.
+     *
+     * A decoded message takes about as much memory as its binary encoding, so
+     * the first block is sized after the buffer, up to 64 KiB, and small
+     * resources decode with a single allocation. Bytes fields still allocate
+     * their contents outside the arena.
+     * @param aBufferSize Size of the encoded buffer in bytes.
+     * @return Options for a google::protobuf::Arena.
+     */
+    inline google::protobuf::ArenaOptions GetDecodeArenaOptions ( size_t aBufferSize )
+    {
+        google::protobuf::ArenaOptions options{};
+        options.start_block_size = std::clamp<size_t> ( aBufferSize, 1024, 64 << 10 );
+        options.max_block_size = 1 << 20;
+        return options;
+    }
+
     /** Loads a Protocol Buffer message from a buffer and populates a target object.
      *
      * Deserializes a Protocol Buffer message of type @p U from the given buffer,
-     * then calls LoadFromPBMsg on @p aTarget to populate it. Uses a static buffer
-     * protected by a mutex to reduce repeated allocations.
+     * then calls LoadFromPBMsg on @p aTarget to populate it. The message lives
+     * in an arena of its own which is released in one step once the target is
+     * loaded, so concurrent and nested loads share nothing and no memory is
+     * kept between loads.
      * @tparam T Target type that implements LoadFromPBMsg(const U&).
      * @tparam U Protocol Buffer message type.
      * @tparam Magick Magic number identifying the buffer format.
@@ -228,12 +248,10 @@ namespace AeonGames
     template<class T, class U, uint64_t Magick>
     void LoadFromProtoBufObject ( T& aTarget, const void* aBuffer, size_t aBufferSize )
     {
-        static std::mutex m{};
-        static U buffer{};
-        std::lock_guard<std::mutex> hold ( m );
-        LoadProtoBufObject ( buffer, aBuffer, aBufferSize, Magick );
-        aTarget.LoadFromPBMsg ( buffer );
-        buffer.Clear();
+        google::protobuf::Arena arena{GetDecodeArenaOptions ( aBufferSize ) };
+        U* message = google::protobuf::Arena::Create<U> ( &arena );
+        LoadProtoBufObject ( *message, aBuffer, aBufferSize, Magick );
+        aTarget.LoadFromPBMsg ( *message );
     }
 }
 #endif
@@ -0,0 +1,46 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_RADIXSORT_H
+#define AEONGAMES_RADIXSORT_H
+#include <cstdint>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    /** @brief A 64-bit sort key paired with the index of the element it orders.
+     *
+     * Sorting the keys instead of the elements themselves keeps the sort
+     * branch-free and independent of the element type; callers permute their
+     * element array through mIndex afterwards. */
+    struct SortKey
+    {
+        uint64_t mKey;
+        uint32_t mIndex;
+    };
+    /** @brief Stable LSD radix sort of keys in ascending mKey order.
+     *
+     * Sorts a byte at a time from the least significant end, counting all
+     * eight byte histograms in one pass up front and skipping every byte that
+     * holds the same value for all keys, so keys that only use a few of their
+     * bits cost only that many passes. Equal keys keep their relative order.
+     * Performs no allocation once @p aScratch has grown to the key count.
+     *  @param aKeys Keys to sort in place.
+     *  @param aScratch Ping-pong buffer reused across calls; its contents are
+     *         unspecified afterwards. */
+    DLL void RadixSort ( std::vector<SortKey>& aKeys, std::vector<SortKey>& aScratch );
+}
+#endif
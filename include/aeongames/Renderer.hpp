@@ -120,8 +120,14 @@ namespace AeonGames
     class Renderer
     {
     public:
+        /** Registers the renderer for resource cache evictions, so the GPU
+         *  copies of evicted meshes and textures are unloaded before the
+         *  resources themselves are destroyed. */
+        DLL Renderer();
         /** Virtual destructor. */
         DLL virtual ~Renderer() = 0;
+        Renderer ( const Renderer& ) = delete;
+        Renderer& operator= ( const Renderer& ) = delete;
         /** Number of GPU timestamp marks the opt-in per-pass benchmark records
          *  each frame (see RecordGpuTimestamp): frame start, before/after the
          *  depth pre-pass, after Hi-Z + light cull, after shading, and before
@@ -717,6 +723,8 @@ namespace AeonGames
         bool mDebugSettingsDirty{true};
         /** Tunable debug-geometry parameters. */
         DebugRenderSettings mDebugSettings{};
+        /** Handle of the resource eviction listener registered on construction. */
+        size_t mEvictionListener{};
         /** Bitmask of enabled light types (bit = 1u << LightType). All types
          * enabled by default; cleared bits drop that type in FilterLightsByType. */
         uint32_t mLightTypeMask{ ( 1u << static_cast<uint32_t> ( LightType::Point ) ) |
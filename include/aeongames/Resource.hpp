@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef AEONGAMES_RESOURCE_H
 #define AEONGAMES_RESOURCE_H
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
 #include "aeongames/Platform.hpp"
 
@@ -38,8 +41,18 @@ namespace AeonGames
          *  @param aBuffer     Pointer to the data buffer.
          *  @param aBufferSize Size of the data buffer in bytes. */
         virtual void LoadFromMemory ( const void* aBuffer, size_t aBufferSize ) = 0;
+        /** @brief Load the resource from a buffer it may keep referencing.
+         *  Resources whose data can be used in place override this to hold on
+         *  to @p aOwner instead of copying; the default calls LoadFromMemory.
+         *  @param aBuffer Data buffer, kept alive by @p aOwner.
+         *  @param aOwner Shared ownership of the memory @p aBuffer points into. */
+        DLL virtual void LoadFromView ( std::span<const uint8_t> aBuffer, const std::shared_ptr<const void>& aOwner );
         /** @brief Release all data held by this resource. */
         virtual void Unload () = 0;
+        /** @brief Approximate heap memory held by the resource, the data Unload releases.
+         *  Used by the resource cache to keep within its memory budget.
+         *  @return Size in bytes, zero when the resource does not report one. */
+        DLL virtual size_t GetMemoryUsage() const;
         /** @brief Load the resource identified by a numeric id.
          *  @param aId Resource identifier. */
         DLL void LoadFromId ( uint32_t aId );
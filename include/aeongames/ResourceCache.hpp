@@ -17,102 +17,52 @@ limitations under the License.
 #define AEONGAMES_RESOURCECACHE_H
 #include <cstdint>
 #include <functional>
+#include <unordered_map>
 #include "aeongames/Platform.hpp"
 #include "aeongames/UniqueAnyPtr.hpp"
 
 namespace AeonGames
 {
     class ResourceId;
-#if 0
-    template<class B, class K, class D = B, typename... Args>
-    const std::shared_ptr<B> Get ( const K& key, Args... args )
+    /** @brief A resource constructed off the cache and the type it was constructed as. */
+    struct StagedResource
     {
-        ///@todo Maybe replace unordered_map with a vector.
-        static std::unordered_map<K, std::weak_ptr<B >> cache;
-        static std::mutex m;
-        std::lock_guard<std::mutex> hold ( m );
-        auto iter = cache.find ( key );
-        if ( iter == cache.end() )
-        {
-            auto retval = std::shared_ptr<B> ( std::make_unique<D> ( args... ).release(), [key] ( B * t )
-            {
-                delete ( t );
-                cache.erase ( cache.find ( key ) );
-            } );
-            cache[key] = retval;
-            return retval;
-        }
-        return iter->second.lock();
-    }
-//----------------------------------------------------------------------------------------
-    /** Specialized resource cache class.
-    *
-    * We need a way to back track a key from a resource,
-    * and we don't want resources themselves carrying their key
-    * since we won't be retrieving this information all the time.
-    *
-    * This was inspired by the fastLoadWidget
-    * presented in Effective Modern C++ (EMC++20) by Scott Meyers,
-    * which is in turn a version of Herb Sutter's
-    * 'My Favorite C++ 10-liner' :
-    * https://channel9.msdn.com/Events/GoingNative/2013/My-Favorite-Cpp-10-Liner
-    *
-    * @param B Base class of the resource.
-    * @param K Key class for the cache map.
-    * @param D Derived class of the resource (optional).
-    * @return Shared pointer to the only instance of the resource in memory.
-    * */
-    template<class K, class B>
-    class ResourceCache
+        uint32_t mType{};           ///< Type CRC, zero when stored by key only.
+        UniqueAnyPtr mResource{};   ///< The resource itself.
+    };
+    /** @brief Resources constructed off the cache, keyed like the cache itself. */
+    using ResourceStaging = std::unordered_map<uint32_t, StagedResource>;
+    /** @brief Counters and memory accounting of the resource cache. */
+    struct ResourceCacheStatistics
     {
-    public:
-        ResourceCache() = default;
-        ~ResourceCache() = default;
-        ResourceCache ( const ResourceCache& ) = delete;
-        ResourceCache ( ResourceCache&& ) = delete;
-        ResourceCache& operator= ( const ResourceCache& ) = delete;
-        ResourceCache& operator= ( ResourceCache&& ) = delete;
-        template<class D = B, typename... Args>
-        static const std::shared_ptr<B> Get ( const K& aKey, Args... args )
-        {
-            ///@todo Maybe replace unordered_map with a vector.
-            std::lock_guard<std::mutex> hold ( mMutex );
-            auto iter = mCache.find ( aKey );
-            if ( iter == mCache.end() )
-            {
-                auto retval = std::shared_ptr<B> ( std::make_unique<D> ( args... ).release(), [aKey] ( B * t )
-                {
-                    delete ( t );
-                    mCache.erase ( mCache.find ( aKey ) );
-                } );
-                mCache[aKey] = retval;
-                return retval;
-            }
-            return iter->second.lock();
-        }
-        static const K& GetKey ( const std::shared_ptr<B>& aValue )
-        {
-            std::lock_guard<std::mutex> hold ( mMutex );
-            auto i = std::find_if ( mCache.begin(), mCache.end(), [&aValue] ( const std::pair<const K, std::weak_ptr<B >> & aPair )
-            {
-                return aPair.second.lock() == aValue;
-            } );
-            if ( i != mCache.end() )
-            {
-                return i->first;
-            }
-            throw std::runtime_error ( "Resource not found in cache." );
-        }
-
-    private:
-        static std::unordered_map<K, std::weak_ptr<B >> mCache;
-        static std::mutex mMutex;
+        uint64_t mHits{};       ///< Lookups that found their resource.
+        uint64_t mMisses{};     ///< Lookups that did not.
+        uint64_t mEvictions{};  ///< Resources dropped to stay within the budget.
+        size_t mCount{};        ///< Resources in the cache.
+        size_t mBytes{};        ///< Measured bytes of all cached resources.
+        size_t mBudget{};       ///< Byte budget, zero when unlimited.
+        std::unordered_map<uint32_t, size_t> mBytesByType{}; ///< Measured bytes per type CRC.
     };
-    template<class K, class B>
-    std::unordered_map<K, std::weak_ptr<B >> ResourceCache<K, B>::mCache;
-    template<class K, class B>
-    std::mutex ResourceCache<K, B>::mMutex;
-#endif
+    /** @brief Called with each resource TrimResources evicts, before it is destroyed.
+     *  @param aKey The evicted resource's key.
+     *  @param aResource The evicted resource, still alive.
+     */
+    using ResourceEvictionListener = std::function<void ( uint32_t aKey, const UniqueAnyPtr& aResource ) >;
+    /** @brief Redirect StoreResource on the calling thread into a staging map.
+     *
+     * Used by resource streaming threads so that a resource and everything it
+     * stores while loading only become visible together, when the staging
+     * map is committed. Lookups on the thread check the staging map first and
+     * then the shared cache.
+     *  @param aStaging Map to store into, or nullptr to store into the cache again.
+     */
+    DLL void SetResourceStaging ( ResourceStaging* aStaging );
+    /** @brief Move staged resources into the cache.
+     *  Keys already present in the cache keep their current resource.
+     *  @param aStaging Staged resources; left empty.
+     *  @return Number of resources added to the cache.
+     */
+    DLL size_t CommitResourceStaging ( ResourceStaging& aStaging );
     /** @brief Remove all resources from the cache. */
     DLL void ClearAllResources();
     /** @brief Enumerate all cached resources.
@@ -120,11 +70,35 @@ namespace AeonGames
      */
     DLL void EnumerateResources ( const std::function<bool ( uint32_t, const UniqueAnyPtr& ) >& aEnumerator );
     /** @brief Store a resource in the cache.
+     *
+     * Resources stored by key alone have no known type, are not measured
+     * and are never evicted, which suits resources that exist only in the
+     * cache and could not be constructed again from their id.
      *  @param aKey The key to associate with the resource.
      *  @param pointer The resource to store (moved in).
      *  @return Reference to the stored resource.
      */
     DLL const UniqueAnyPtr& StoreResource ( uint32_t aKey, UniqueAnyPtr&& pointer );
+    /** @brief Store a resource constructed from its identifier.
+     *
+     * The resource is measured with MeasureResource and accounted under its
+     * type. Measured resources that nobody acquired may be evicted by
+     * TrimResources, ResourceId::Get constructs them again on demand.
+     *  @param aResourceId The identifier the resource was constructed from.
+     *  @param pointer The resource to store (moved in).
+     *  @return Reference to the stored resource.
+     */
+    DLL const UniqueAnyPtr& StoreResource ( const ResourceId& aResourceId, UniqueAnyPtr&& pointer );
+    /** @brief Construct and store a resource unless it is already cached.
+     *
+     * Threads asking for the same missing resource at the same time share
+     * one construction: the first constructs it, the others wait for it and
+     * get the same resource, or the same exception if construction threw.
+     * With a staging map set the resource is constructed into it instead.
+     *  @param aResourceId The resource identifier.
+     *  @return Reference to the cached resource, null if the constructor returned none.
+     */
+    DLL const UniqueAnyPtr& StoreResource ( const ResourceId& aResourceId );
     /** @brief Remove and return a resource from the cache.
      *  @param aKey The key of the resource to dispose.
      *  @return The disposed resource.
@@ -140,5 +114,46 @@ namespace AeonGames
      *  @return Reference to the cached resource.
      */
     DLL const UniqueAnyPtr& GetResource ( const ResourceId& aResourceId );
+    /** @brief Keep a resource from being evicted; balanced by ReleaseResource.
+     *  The resource does not need to be loaded yet.
+     *  @param aKey The resource key.
+     */
+    DLL void AcquireResource ( uint32_t aKey );
+    /** @brief Drop a reference taken with AcquireResource.
+     *  @param aKey The resource key.
+     */
+    DLL void ReleaseResource ( uint32_t aKey );
+    /** @brief Number of outstanding AcquireResource calls for a key. */
+    DLL uint32_t GetResourceReferenceCount ( uint32_t aKey );
+    /** @brief Set the memory budget of the cache.
+     *  @param aBytes Budget in measured bytes, zero for no limit (the default).
+     */
+    DLL void SetResourceBudget ( size_t aBytes );
+    /** @brief Evict least recently used, unreferenced, measured resources until within budget.
+     *
+     * Callers may hold raw pointers into the cache for the duration of a
+     * frame, so this only runs when called, at the frame boundary. Eviction
+     * listeners see every evicted resource before it is destroyed.
+     *  @return Number of resources evicted.
+     */
+    DLL size_t TrimResources();
+    /** @brief Register a listener for evicted resources.
+     *
+     * Renderers use this to drop the GPU copies of evicted meshes and
+     * textures before the resources they were made from are destroyed.
+     * Listeners run on the thread calling TrimResources, after every shard
+     * lock was released, and must not add or remove listeners.
+     *  @param aListener Callable invoked once per evicted resource.
+     *  @return Handle to pass to RemoveResourceEvictionListener.
+     */
+    DLL size_t AddResourceEvictionListener ( ResourceEvictionListener aListener );
+    /** @brief Unregister a listener added with AddResourceEvictionListener.
+     *  @param aHandle Handle the listener was registered with.
+     */
+    DLL void RemoveResourceEvictionListener ( size_t aHandle );
+    /** @brief Snapshot of the cache counters and memory accounting. */
+    DLL ResourceCacheStatistics GetResourceCacheStatistics();
+    /** @brief Zero the hit, miss and eviction counters. */
+    DLL void ResetResourceCacheStatistics();
 }
 #endif
@@ -34,13 +34,31 @@ namespace AeonGames
      *  @return Reference to the default resource.
      */
     DLL const UniqueAnyPtr& GetDefaultResource ( uint32_t aType );
+    /** @brief Callable that reports the memory held by a resource of a registered type. */
+    using ResourceMemoryUsage = std::function < size_t ( const UniqueAnyPtr& ) >;
     /** @brief Register a constructor for a resource type.
      *  @param aType The resource type identifier.
      *  @param aConstructor Callable that constructs the resource given a type.
      *  @param aDefaultResource Optional default resource instance.
+     *  @param aMemoryUsage Optional callable measuring a constructed resource,
+     *  see GetResourceMemoryUsage. Unmeasured types are never evicted from the cache.
      *  @return True if registration succeeded.
      */
-    DLL bool RegisterResourceConstructor ( uint32_t aType, const std::function < UniqueAnyPtr ( uint32_t ) > & aConstructor, UniqueAnyPtr&& aDefaultResource = nullptr );
+    DLL bool RegisterResourceConstructor ( uint32_t aType, const std::function < UniqueAnyPtr ( uint32_t ) > & aConstructor, UniqueAnyPtr&& aDefaultResource = nullptr, const ResourceMemoryUsage& aMemoryUsage = {} );
+    /** @brief Measure a resource with the callable registered for its type.
+     *  @param aType The resource type identifier.
+     *  @param aResource The resource to measure.
+     *  @return Size in bytes, zero for types without a memory usage callable.
+     */
+    DLL size_t MeasureResource ( uint32_t aType, const UniqueAnyPtr& aResource );
+    /** @brief ResourceMemoryUsage for types derived from Resource.
+     *  @tparam T Concrete resource type held by the pointer. */
+    template<class T>
+    size_t GetResourceMemoryUsage ( const UniqueAnyPtr& aResource )
+    {
+        const T* resource = aResource.Get<T>();
+        return resource ? resource->GetMemoryUsage() : 0;
+    }
     /** @brief Unregister a resource constructor.
      *  @param aType The resource type identifier to unregister.
      *  @return True if unregistration succeeded.
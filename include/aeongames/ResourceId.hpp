@@ -22,6 +22,7 @@ limitations under the License.
 #include "aeongames/CRC.hpp"
 #include "aeongames/ResourceFactory.hpp"
 #include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceStreamer.hpp"
 
 namespace AeonGames
 {
@@ -111,21 +112,61 @@ namespace AeonGames
             T* t = GetResource ( *this ).Get<T>();
             if ( !t )
             {
-                t = StoreResource ( mPath, ConstructResource ( *this ) ).Get<T>();
+                t = StoreResource ( *this ).Get<T>();
             }
             return t;
         }
 
+        /** @brief Get the resource without ever loading it on the calling thread.
+         *
+         * A cached resource is returned directly; a missing one is requested
+         * from the engine resource streamer and the type's default resource
+         * is returned in its place until a later CommitStreamedResources
+         * publishes it.
+         *  @tparam T Target resource type.
+         *  @param aPriority Priority class of the request if the resource is missing.
+         *  @return Pointer to the resource, its default placeholder or nullptr. */
+        template<typename T>
+        T* GetAsync ( ResourcePriority aPriority = ResourcePriority::Visible ) const
+        {
+            if ( T * t = GetResource ( mPath ).Get<T>() )
+            {
+                return t;
+            }
+            GetResourceStreamer().Enqueue ( *this, aPriority );
+            return GetDefaultResource ( mType ).Get<T>();
+        }
+
+        /** @brief Request the resource from the engine resource streamer.
+         *  @param aPriority Priority class of the request.
+         *  @return Handle to follow or cancel the request. */
+        ResourceStreamer::RequestHandle Request ( ResourcePriority aPriority = ResourcePriority::Prefetch ) const
+        {
+            return GetResourceStreamer().Enqueue ( *this, aPriority );
+        }
+
         /** @brief Construct and store the resource in the cache if not already present. */
         void Store() const
         {
             // Don't store nullptrs
             if ( !GetResource ( *this ).GetRaw() )
             {
-                StoreResource ( mPath, ConstructResource ( *this ) );
+                StoreResource ( *this );
             }
         }
 
+        /** @brief Keep the resource from being evicted from the cache; balanced by Release. */
+        void Acquire() const
+        {
+            AcquireResource ( mPath );
+        }
+
+        /** @brief Drop a reference taken with Acquire. */
+        void Release() const
+        {
+            ReleaseResource ( mPath );
+        }
+
         /** @brief Remove the resource from the cache if present. */
         void Dispose() const
         {
@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGAMES_RESOURCESTREAMER_H
+#define AEONGAMES_RESOURCESTREAMER_H
+/*! \file
+    \brief Header for the asynchronous resource streamer.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "aeongames/Platform.hpp"
+
+namespace AeonGames
+{
+    class ResourceId;
+    /** @brief Priority class of a streaming request; lower values load first. */
+    enum class ResourcePriority : uint8_t
+    {
+        Visible = 0,   ///< Referenced by something on screen this frame.
+        Nearby = 1,    ///< Likely to be on screen soon.
+        Prefetch = 2,  ///< Speculative, load when nothing else is pending.
+        Count
+    };
+
+    /** @brief Loads resources on background threads and publishes them at frame boundaries.
+     *
+     * ResourceId::Get constructs a missing resource on the calling thread,
+     * which for the render loop means a hitch the first time a model shows up.
+     * Requests made here are read, decoded and constructed by the streamer's
+     * own threads instead, highest priority class first, while the caller
+     * keeps using the type's default resource as a placeholder.
+     *
+     * A loaded resource, together with anything it stored while loading
+     * (meshes, materials, skeletons), is kept in a staging map and only
+     * enters the resource cache when Commit is called, so the main thread
+     * sees whole resources appear between frames and never half of a model.
+     *
+     * The streamer uses dedicated threads rather than the JobSystem: loading
+     * blocks on file I/O, which would stall the frame jobs sharing a worker. */
+    class ResourceStreamer
+    {
+    public:
+        /// @brief Lifetime of a request.
+        enum class Status : uint8_t
+        {
+            Queued,     ///< Waiting for a streaming thread.
+            Loading,    ///< Being constructed.
+            Loaded,     ///< Constructed and staged, waiting for Commit.
+            Committed,  ///< In the resource cache.
+            Failed,     ///< Construction threw, see GetError.
+            Cancelled   ///< Dropped before it was committed.
+        };
+        class Request;
+        /// @brief Shared handle to a request; the streamer keeps its own reference.
+        using RequestHandle = std::shared_ptr<Request>;
+
+        /** @brief Start the streaming threads.
+         *  @param aThreadCount Number of loader threads, at least one is started. */
+        DLL explicit ResourceStreamer ( size_t aThreadCount = GetDefaultThreadCount() );
+        /** @brief Cancel queued requests, finish the ones being loaded and join the threads.
+         *  Loaded but uncommitted resources are discarded. */
+        DLL ~ResourceStreamer();
+        ResourceStreamer ( const ResourceStreamer& ) = delete;
+        ResourceStreamer& operator= ( const ResourceStreamer& ) = delete;
+        ResourceStreamer ( ResourceStreamer&& ) = delete;
+        ResourceStreamer& operator= ( ResourceStreamer&& ) = delete;
+
+        /** @brief Queue a resource for loading.
+         *
+         * Requests are deduplicated by resource path: asking again for a
+         * resource that is still queued returns the same handle and moves it
+         * up to @p aPriority if that is more urgent. A resource already in the
+         * cache yields a request that is already Committed.
+         *  @param aResourceId Resource to load.
+         *  @param aPriority Priority class of the request.
+         *  @return Handle to follow or cancel the request. */
+        DLL RequestHandle Enqueue ( const ResourceId& aResourceId, ResourcePriority aPriority );
+        /** @brief Drop a request.
+         *
+         * A queued request is never loaded; one being loaded finishes but its
+         * result is discarded. Committed or failed requests are unaffected.
+         *  @return True if the request was cancelled by this call. */
+        DLL bool Cancel ( const RequestHandle& aRequest );
+        /** @brief Publish every loaded request into the resource cache.
+         *
+         * Call once per frame from the thread that owns the cache, at the frame
+         * boundary. Failures are reported to the log here as well.
+         *  @return Number of requests committed. */
+        DLL size_t Commit();
+        /** @brief Block until no request is queued or loading. For loading screens and tests. */
+        DLL void WaitIdle();
+        /// @brief Current state of a request.
+        DLL Status GetStatus ( const RequestHandle& aRequest ) const;
+        /// @brief Error message of a Failed request, empty otherwise.
+        DLL std::string GetError ( const RequestHandle& aRequest ) const;
+        /// @brief Number of requests queued or loading.
+        DLL size_t GetPendingCount() const;
+        /// @brief Number of loader threads.
+        DLL size_t GetThreadCount() const;
+        /// @brief Two loaders, so one slow read does not hold up every request.
+        DLL static size_t GetDefaultThreadCount();
+    private:
+        void LoaderLoop();
+        /// Pops the most urgent queued request; the caller holds mMutex.
+        RequestHandle Dequeue();
+        void Load ( const RequestHandle& aRequest );
+        mutable std::mutex mMutex{};
+        std::condition_variable mWorkCondition{};
+        std::condition_variable mIdleCondition{};
+        /// One FIFO per priority class; a promoted request appears in two and the stale entry is skipped.
+        std::array<std::deque<RequestHandle>, static_cast<size_t> ( ResourcePriority::Count ) > mQueues{};
+        /// Requests not yet committed or cancelled, by resource path, for deduplication.
+        std::unordered_map<uint32_t, RequestHandle> mActive{};
+        /// Loaded or failed requests waiting for Commit.
+        std::vector<RequestHandle> mFinished{};
+        size_t mPending{0};
+        std::vector<std::thread> mThreads{};
+        bool mStop{false};
+    };
+
+    /** @brief (Re)start the engine wide resource streamer.
+     *  @param aThreadCount Number of loader threads. */
+    DLL void InitializeResourceStreamer ( size_t aThreadCount = ResourceStreamer::GetDefaultThreadCount() );
+    /** @brief Access the engine wide resource streamer, created on first use.
+     *  @return The global ResourceStreamer instance. */
+    DLL ResourceStreamer& GetResourceStreamer();
+    /** @brief Stop the engine wide resource streamer, discarding pending requests.
+     *  Called by FinalizeGlobalEnvironment before the resource cache is cleared. */
+    DLL void FinalizeResourceStreamer();
+    /** @brief Commit the engine wide streamer's loaded resources, if it was ever started.
+     *  Call at the frame boundary, next to ResetFrameArenas.
+     *  @return Number of requests committed. */
+    DLL size_t CommitStreamedResources();
+}
+#endif
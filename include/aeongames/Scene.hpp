@@ -28,11 +28,20 @@ limitations under the License.
 #include "aeongames/ResourceId.hpp"
 #include "aeongames/RenderItem.hpp"
 #include "aeongames/Octree.hpp"
+#include "aeongames/RadixSort.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/PoseCache.hpp"
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
+#include <unordered_map>
+#include <utility>
 #include <span>
 #include <string>
 #include <functional>
+#include <type_traits>
 
 namespace AeonGames
 {
@@ -110,8 +119,37 @@ namespace AeonGames
             @return Reference to the child node. */
         DLL Node& operator[] ( const std::size_t index );
         /** Update all nodes in the scene.
+
+            Each top-level child and its descendants form an independent
+            subtree; when parallel update is enabled the subtrees are updated
+            concurrently on the engine JobSystem, each one in DFS pre-order as
+            before. Component Update calls must therefore only mutate their own
+            subtree (plus scene state owned by the active camera node); lights
+            added through AddLight are buffered per subtree and published in
+            subtree order, so results are identical to the serial path.
+            Components queued through QueueAnimation are then animated, also
+            concurrently when parallel update is enabled.
             @param delta Elapsed time in seconds since the last update. */
         DLL void Update ( const double delta );
+        /** Enable or disable updating top-level subtrees concurrently.
+            @param aParallelUpdate True (the default) to use the JobSystem. */
+        DLL void SetParallelUpdate ( bool aParallelUpdate );
+        /** Check whether Update distributes subtrees across the JobSystem. */
+        DLL bool GetParallelUpdate() const;
+        /** Queue a component's Animate for the animation phase of Update.
+            Intended to be called from Component::Update, the phase runs once
+            every node updated, see Update.
+            @param aNode Node the component is attached to.
+            @param aComponent Component to animate.
+            @return false if the scene is not updating its nodes on the calling
+            thread, in which case the caller should animate right away. */
+        DLL bool QueueAnimation ( const Node& aNode, Component& aComponent );
+        /** Access the poses sampled this frame, shared by instances playing the
+            same clip at the same time. Update starts a new cache frame.
+            @return Reference to the scene's pose cache. */
+        DLL PoseCache& GetPoseCache();
+        /** @copydoc GetPoseCache() */
+        DLL const PoseCache& GetPoseCache() const;
         /** Broadcast a message to all nodes in the scene.
             @param aMessageType Type identifier for the message.
             @param aMessageData Pointer to message-specific data. */
@@ -222,7 +260,10 @@ namespace AeonGames
         /** @brief Append a light to the scene's per-frame list.
          *  Intended to be called from light components' Update(). The
          *  list is reset at the start of Scene::Update so each frame
-         *  starts empty. Calls past MAX_LIGHTS_PER_FRAME are dropped. */
+         *  starts empty. Calls past MAX_LIGHTS_PER_FRAME are dropped.
+         *  Safe to call from concurrently updating subtrees: calls made
+         *  during Update are buffered per subtree and appended in subtree
+         *  order once all subtrees finished. */
         DLL void AddLight ( const GpuLight& aLight );
         /** @brief Read-only view of the lights submitted this frame. */
         DLL std::span<const GpuLight> GetFrameLights() const;
@@ -309,6 +350,19 @@ namespace AeonGames
          *  @param aFrustum Frustum to test node bounds against.
          *  @param aCallback Invoked once per visible node. */
         DLL void CullVisible ( const Frustum& aFrustum, const std::function<void ( const Node& ) >& aCallback ) const;
+        /** @brief Visitor overload of CullVisible.
+         *
+         *  Same result as the std::function overload, but the visitor is invoked
+         *  directly from the octree walk so the per-node call can be inlined.
+         *  Preferred for hot per-frame loops; the std::function overload is a
+         *  thin wrapper over the same code.
+         *  @param aFrustum Frustum to test node bounds against.
+         *  @param aVisitor Callable taking a const Node&, invoked once per visible node. */
+        template<class Visitor>
+        void CullVisible ( const Frustum& aFrustum, Visitor&& aVisitor ) const
+        {
+            VisitNodes ( aFrustum, aVisitor );
+        }
         /** @brief Build the per-frame render queue from the frustum-visible nodes.
          *
          *  Traverses the scene, frustum-culls each node individually (via
@@ -316,16 +370,45 @@ namespace AeonGames
          *  draws they contribute (Node::Collect / Component::Collect). The
          *  resulting items are sorted so that draws sharing pipeline, material
          *  and mesh become adjacent, ready for ForEachRenderBatch to merge them
-         *  into instanced draws. Components never touch the Renderer; they only
-         *  declare what to draw here.
+         *  into instanced draws, and front to back within each such run.
+         *  Components never touch the Renderer; they only declare what to draw
+         *  here.
+         *
+         *  The sort radix-sorts packed 64-bit keys (pipeline, material and mesh
+         *  ids, a skinned flag and a depth bucket). The resource ids are handed
+         *  out in the order the scene first presents them rather than taken
+         *  from their addresses, so the same scene yields the same queue order
+         *  on every run.
          *
          *  Runs once per frame and performs no per-call heap allocation in
-         *  steady state: the queue buffer's capacity persists across calls
-         *  (clear() keeps the storage) and std::sort is in place. The queue
+         *  steady state: the queue and sort buffers keep their capacity across
+         *  calls (clear() keeps the storage). The queue
          *  stays valid until the next BuildRenderQueue call, so a single build
          *  can feed several submit passes (e.g. depth pre-pass and shading).
+         *  Equivalent to BuildRenderQueues with a single view.
          *  @param aFrustum Frustum to cull the scene against. */
         DLL void BuildRenderQueue ( const Frustum& aFrustum ) const;
+        /** @brief Build one render queue per view in a single scene walk.
+         *
+         *  Walks the octree once, testing each cell against all views at once
+         *  (Octree::QueryFrustums), then tests each candidate node exactly
+         *  against the views its cell passed. Node::Collect runs at most once
+         *  per node however many views see it; the collected items are copied
+         *  into every queue the node is visible in. Each queue is sorted as in
+         *  BuildRenderQueue and, like it, keeps its capacity across frames.
+         *
+         *  Queue @c i belongs to @c aFrustums[i]; SelectRenderQueue picks the
+         *  one GetRenderQueue, ForEachRenderBatch and SubmitRenderQueue use.
+         *  Queue 0 is selected after the build.
+         *  @param aFrustums Frustums to cull against, at most Octree::kMaxQueryViews.
+         *  @throws std::runtime_error when given more than Octree::kMaxQueryViews views. */
+        DLL void BuildRenderQueues ( std::span<const Frustum> aFrustums ) const;
+        /** @brief Number of queues built by the last BuildRenderQueue(s) call. */
+        DLL size_t GetRenderQueueCount() const;
+        /** @brief Select which built queue the queue accessors and submission use.
+         *  @param aView Index into the frustums passed to BuildRenderQueues.
+         *  @throws std::out_of_range when @p aView is not a built queue. */
+        DLL void SelectRenderQueue ( size_t aView ) const;
         /** @brief A hash of all shadow-casting geometry's world poses this frame.
          *
          *  Folds the world transform (and size) of every node that has geometry
@@ -335,9 +418,14 @@ namespace AeonGames
          *  re-rendering a shadow map whose casters and light are unchanged: the
          *  signature only differs when some shadow-casting geometry actually
          *  moved, was resized, or was added/removed. Cheap (one traversal, no
-         *  allocation); call once per frame. */
+         *  allocation); call once per frame.
+         *
+         *  Each top-level subtree hashes its own nodes in pre-order and the
+         *  per-subtree partials are then folded in child order, so the value
+         *  does not depend on whether Update ran the subtrees in parallel. */
         DLL uint64_t GetShadowGeometrySignature() const;
-        /** @brief Read-only view of the queue built by the last BuildRenderQueue. */
+        /** @brief Read-only view of the selected queue built by the last
+         *  BuildRenderQueue(s) call. */
         DLL const std::vector<RenderItem>& GetRenderQueue() const;
         /** @brief Walk the built render queue grouping consecutive items that can
          *  be drawn as a single instanced batch.
@@ -373,6 +461,14 @@ namespace AeonGames
          *  @param aBox World-space box to test node bounds against.
          *  @param aCallback Invoked once per overlapping node. */
         DLL void QueryAABB ( const AABB& aBox, const std::function<void ( const Node& ) >& aCallback ) const;
+        /** @brief Visitor overload of QueryAABB, see the CullVisible visitor overload.
+         *  @param aBox World-space box to test node bounds against.
+         *  @param aVisitor Callable taking a const Node&, invoked once per overlapping node. */
+        template<class Visitor>
+        void QueryAABB ( const AABB& aBox, Visitor&& aVisitor ) const
+        {
+            VisitNodes ( aBox, aVisitor );
+        }
         /** @brief Invoke a callback for every allocated octree cell, passing its
          *  world-space bounds and subdivision depth (root = 0).
          *
@@ -389,9 +485,27 @@ namespace AeonGames
         DLL void ForEachOctreeCell ( const Frustum& aFrustum, const std::function<void ( const AABB&, uint32_t ) >& aCallback ) const;
         /** @brief Mark the spatial index stale so it is rebuilt on the next
          *  CullVisible or QueryAABB call. Called automatically when nodes are
-         *  added, removed, or moved; expose publicly so external mutations can
+         *  added or removed; expose publicly so external mutations can
          *  request a rebuild. */
         DLL void InvalidateSpatialIndex();
+        /** @brief Mark a node (and its descendants) as moved or resized.
+         *
+         *  Called automatically by Node when its transform or AABB changes.
+         *  Before the next query only the marked subtrees are re-placed in the
+         *  octree, and only nodes whose bounds crossed a cell boundary are
+         *  actually moved. Falls back to a full rebuild when a node leaves the
+         *  root bounds or the churn exceeds the rebuild threshold. Safe to call
+         *  from concurrently updating subtrees.
+         *  @param aNode Root of the subtree whose world bounds changed. */
+        DLL void InvalidateSpatialIndex ( const Node* aNode );
+        /** @brief Set the churn above which a full octree rebuild replaces
+         *  incremental maintenance.
+         *  @param aFraction Number of subtrees marked since the last query,
+         *  as a fraction of the indexed node count (default 0.25). Zero
+         *  rebuilds on every change. */
+        DLL void SetSpatialIndexRebuildThreshold ( float aFraction );
+        /** @brief Get the incremental maintenance churn threshold. */
+        DLL float GetSpatialIndexRebuildThreshold() const;
         /**@}*/
     private:
         friend class Node;
@@ -420,6 +534,59 @@ namespace AeonGames
         InputSystem* mInputSystem {};
         /// @brief Rebuild the octree from the current node set. Lazy cache helper.
         void BuildSpatialIndex() const;
+        /// @brief Bring the octree up to date before a query, incrementally
+        /// when possible. Lazy cache helper.
+        DLL void RefreshSpatialIndex() const;
+        /// @brief Order a built queue by its packed 64-bit sort keys, see BuildRenderQueues.
+        void SortRenderQueue ( std::vector<RenderItem>& aQueue, const Frustum& aFrustum ) const;
+        /// @brief Shared body of the CullVisible and QueryAABB overloads.
+        /// @p aVolume is a Frustum or an AABB; every node whose world-space
+        /// bounds intersect it is passed to @p aVisitor.
+        template<class Volume, class Visitor>
+        void VisitNodes ( const Volume& aVolume, Visitor& aVisitor ) const
+        {
+            auto test = [&aVolume] ( const Node & aNode )
+            {
+                const AABB world = aNode.GetGlobalTransform() * aNode.GetAABB();
+                if constexpr ( std::is_same_v<Volume, Frustum> )
+                {
+                    return aVolume.Intersects ( world );
+                }
+                else
+                {
+                    return aVolume.Overlaps ( world );
+                }
+            };
+            RefreshSpatialIndex();
+            if ( mSpatialIndex.GetNodeCount() != 0 )
+            {
+                auto visit = [&test, &aVisitor] ( const Node * aNode )
+                {
+                    if ( test ( *aNode ) )
+                    {
+                        aVisitor ( *aNode );
+                    }
+                };
+                if constexpr ( std::is_same_v<Volume, Frustum> )
+                {
+                    mSpatialIndex.QueryFrustum ( aVolume, visit );
+                }
+                else
+                {
+                    mSpatialIndex.QueryAABB ( aVolume, visit );
+                }
+                return;
+            }
+            // Fallback: empty/degenerate index (e.g. a scene with no nodes). A
+            // plain traversal keeps the result identical to a brute-force scan.
+            LoopTraverseDFSPreOrder ( [&test, &aVisitor] ( const Node & aNode )
+            {
+                if ( test ( aNode ) )
+                {
+                    aVisitor ( aNode );
+                }
+            } );
+        }
         /// @brief Project the environment map's radiance into the 9 order-2 SH
         /// coefficients (mEnvironmentSH) for diffuse image-based lighting. Called
         /// lazily by GetGlobals when the environment texture changes.
@@ -427,11 +594,34 @@ namespace AeonGames
         /// @brief Octree over node world-space AABBs, used by CullVisible.
         mutable Octree mSpatialIndex{};
         /// @brief True when mSpatialIndex must be rebuilt before the next query.
-        mutable bool mSpatialIndexDirty{true};
-        /// @brief Per-frame render queue rebuilt by BuildRenderQueue. Its
+        /// Atomic because nodes invalidate it from concurrently updating subtrees.
+        mutable std::atomic<bool> mSpatialIndexDirty{true};
+        /// @brief Roots of subtrees moved since the octree was last refreshed.
+        mutable std::vector<const Node*> mDirtyNodes{};
+        /// @brief Guards mDirtyNodes against concurrently updating subtrees.
+        mutable std::mutex mDirtyNodesMutex{};
+        float mSpatialIndexRebuildThreshold{0.25f};
+        /// @brief Per-view render queues rebuilt by BuildRenderQueues. Their
         /// capacity persists across frames so steady-state collection performs
         /// no heap allocation; mutable so the build can run on a const scene.
-        mutable std::vector<RenderItem> mRenderQueue{};
+        /// Only the first mRenderQueueCount queues belong to the last build.
+        mutable std::vector<std::vector<RenderItem >> mRenderQueues{};
+        mutable size_t mRenderQueueCount{0};
+        /// @brief Queue selected by SelectRenderQueue.
+        mutable size_t mActiveRenderQueue{0};
+        /// @brief Items of a node visible in several views, collected once and
+        /// then copied into each of their queues.
+        mutable std::vector<RenderItem> mCollectScratch{};
+        /// @brief Sort keys, radix scratch and permuted items reused by
+        /// SortRenderQueue across queues and frames.
+        mutable std::vector<SortKey> mSortKeys{};
+        mutable std::vector<SortKey> mSortScratch{};
+        mutable std::vector<RenderItem> mSortedItems{};
+        /// @brief Dense sort-key ids of the resources seen by SortRenderQueue,
+        /// assigned in first-seen order so queue order is reproducible.
+        mutable std::unordered_map<const void*, uint32_t> mPipelineSortIds{};
+        mutable std::unordered_map<const void*, uint32_t> mMaterialSortIds{};
+        mutable std::unordered_map<const void*, uint32_t> mMeshSortIds{};
         /// @brief Reused scratch of per-instance transforms gathered while
         /// submitting an instanced batch, so SubmitRenderQueue allocates only
         /// when a batch grows beyond any previously seen size.
@@ -450,6 +640,17 @@ namespace AeonGames
         /// by GetShadowGeometrySignature so the renderer can skip re-rendering
         /// unchanged shadow maps without a second scene traversal.
         uint64_t mShadowGeometrySignature{0};
+        /// @brief Per top-level subtree partial signatures, reused across frames.
+        std::vector<uint64_t> mSubtreeSignatures{};
+        /// @brief Per top-level subtree lights buffered during Update, reused
+        /// across frames and merged into mFrameLights in subtree order.
+        std::vector<std::vector<GpuLight >> mSubtreeLights{};
+        /// @brief Per top-level subtree components queued for the animation
+        /// phase, merged into mAnimations in subtree order.
+        std::vector<std::vector<std::pair<const Node*, Component* >>> mSubtreeAnimations{};
+        std::vector<std::pair<const Node*, Component* >> mAnimations{};
+        bool mParallelUpdate{true};
+        PoseCache mPoseCache{};
     };
 }
 #endif
@@ -84,6 +84,8 @@ namespace AeonGames
         DLL void LoadFromMemory ( const void* aBuffer, size_t aBufferSize ) final;
         /** @brief Releases all texture data and resets the texture to an empty state. */
         DLL void Unload() final;
+        /** @brief Size in bytes of the pixel data. */
+        DLL size_t GetMemoryUsage() const final;
         /** @brief Returns the texture width in pixels. */
         DLL uint32_t GetWidth() const;
         /** @brief Returns the texture height in pixels. */
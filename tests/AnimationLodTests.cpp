@@ -0,0 +1,165 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongames/AABB.hpp"
+#include "aeongames/AnimationLod.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/ProtoBufClasses.hpp"
+#include "aeongames/Skeleton.hpp"
+#include "aeongames/Vector3.hpp"
+#include "skeleton.pb.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// Joints point at their parents, so the skeleton is filled in place.
+        void LoadSkeleton ( Skeleton& aSkeleton, const std::vector<int32_t>& aParents )
+        {
+            SkeletonMsg message;
+            for ( int32_t parent : aParents )
+            {
+                JointMsg* joint = message.add_joint();
+                joint->set_parentindex ( parent );
+                joint->mutable_rotation()->set_w ( 1.0f );
+                joint->mutable_invertedrotation()->set_w ( 1.0f );
+            }
+            aSkeleton.LoadFromPBMsg ( message );
+        }
+    }
+
+    TEST ( AnimationLodTest, StartsAtFullDetail )
+    {
+        AnimationLod lod;
+        EXPECT_TRUE ( lod.GetLevels().empty() );
+        Skeleton skeleton;
+        LoadSkeleton ( skeleton, { -1, 0, 1, 2 } );
+        const std::vector<float> matrices ( 64 );
+        // Unseen instances still sample every update and keep every joint.
+        for ( int update = 0; update < 8; ++update )
+        {
+            ASSERT_TRUE ( lod.Advance ( 0.0f, 0.01 ) );
+            lod.Store ( matrices );
+            EXPECT_EQ ( lod.GetCulledBoneHeight(), 0u );
+        }
+        const std::span<const uint16_t> bone_map = lod.GetBoneMap ( skeleton );
+        for ( size_t i = 0; i < bone_map.size(); ++i )
+        {
+            EXPECT_EQ ( bone_map[i], i );
+        }
+        EXPECT_FALSE ( AnimationLod::GetRecommendedLevels().empty() );
+    }
+
+    TEST ( AnimationLodTest, PicksLevelsByScreenSize )
+    {
+        AnimationLod lod;
+        lod.SetLevels ( { { 0.5f, 1, 0 }, { 0.1f, 2, 1 }, { 0.0f, 4, 2 } } );
+        const std::vector<float> matrices ( 16 );
+        EXPECT_TRUE ( lod.Advance ( 0.7f, 0.01 ) );
+        EXPECT_EQ ( lod.GetLevel(), 0u );
+        EXPECT_TRUE ( lod.Advance ( 0.2f, 0.01 ) );
+        EXPECT_EQ ( lod.GetLevel(), 1u );
+        EXPECT_TRUE ( lod.Advance ( 0.0f, 0.01 ) );
+        EXPECT_EQ ( lod.GetLevel(), 2u );
+
+        // Nothing to extrapolate from until two samples are stored.
+        lod.Store ( matrices );
+        EXPECT_TRUE ( lod.Advance ( 0.0f, 0.01 ) );
+        lod.Store ( matrices );
+        uint32_t samples = 0;
+        for ( int update = 0; update < 16; ++update )
+        {
+            if ( lod.Advance ( 0.0f, 0.01 ) )
+            {
+                lod.Store ( matrices );
+                ++samples;
+            }
+        }
+        EXPECT_EQ ( samples, 4u );
+        // Forced samples ignore the level.
+        EXPECT_TRUE ( lod.Advance ( 0.0f, 0.01, true ) );
+    }
+
+    TEST ( AnimationLodTest, CulledJointsFollowTheirNearestKeptAncestor )
+    {
+        // 0 and 1 a finger, 2 hand, 3 spine, 4 a face leaf, 5 head and 6 the
+        // root, children first to check parents need not come before them.
+        Skeleton skeleton;
+        LoadSkeleton ( skeleton, { 1, 2, 3, 6, 5, 3, -1 } );
+        AnimationLod lod;
+        lod.SetLevels ( { { 0.5f, 1, 0 }, { 0.1f, 1, 1 }, { 0.0f, 1, 2 } } );
+
+        lod.Advance ( 1.0f, 0.01 );
+        const std::vector<uint16_t> all { 0, 1, 2, 3, 4, 5, 6 };
+        const std::span<const uint16_t> full = lod.GetBoneMap ( skeleton );
+        EXPECT_EQ ( std::vector<uint16_t> ( full.begin(), full.end() ), all );
+
+        lod.Advance ( 0.2f, 0.01 );
+        const std::vector<uint16_t> leaves { 1, 1, 2, 3, 5, 5, 6 };
+        const std::span<const uint16_t> first = lod.GetBoneMap ( skeleton );
+        EXPECT_EQ ( std::vector<uint16_t> ( first.begin(), first.end() ), leaves );
+
+        lod.Advance ( 0.0f, 0.01 );
+        const std::vector<uint16_t> chains { 2, 2, 2, 3, 3, 3, 6 };
+        const std::span<const uint16_t> second = lod.GetBoneMap ( skeleton );
+        EXPECT_EQ ( std::vector<uint16_t> ( second.begin(), second.end() ), chains );
+
+        // Roots stay even when the whole skeleton is shallower than the cut.
+        Skeleton single;
+        LoadSkeleton ( single, { -1 } );
+        EXPECT_EQ ( lod.GetBoneMap ( single ) [0], 0u );
+    }
+
+    TEST ( AnimationLodTest, ExtrapolatesFromTheLastTwoSamples )
+    {
+        AnimationLod lod;
+        lod.SetLevels ( { { 0.0f, 4, 0 } } );
+        std::vector<float> matrices ( 32, 1.0f );
+        ASSERT_TRUE ( lod.Advance ( 1.0f, 0.1 ) );
+        lod.Store ( matrices );
+        std::fill ( matrices.begin(), matrices.end(), 2.0f );
+        ASSERT_TRUE ( lod.Advance ( 1.0f, 0.1 ) );
+        lod.Store ( matrices );
+
+        ASSERT_FALSE ( lod.Advance ( 1.0f, 0.05 ) );
+        lod.Extrapolate ( matrices );
+        EXPECT_FLOAT_EQ ( matrices[0], 2.5f );
+        // Never further than one sampling interval past the last sample.
+        ASSERT_FALSE ( lod.Advance ( 1.0f, 0.1 ) );
+        lod.Extrapolate ( matrices );
+        EXPECT_FLOAT_EQ ( matrices[31], 3.0f );
+
+        lod.Reset();
+        EXPECT_TRUE ( lod.Advance ( 1.0f, 0.1 ) );
+    }
+
+    TEST ( AnimationLodTest, ProjectedSizeShrinksWithDistance )
+    {
+        const Matrix4x4 view{};
+        const AABB near_bounds { Vector3{ 0.0f, 0.0f, -10.0f }, Vector3{ 1.0f, 1.0f, 1.0f } };
+        const AABB far_bounds { Vector3{ 0.0f, 0.0f, -20.0f }, Vector3{ 1.0f, 1.0f, 1.0f } };
+        const float near_size = GetProjectedSize ( near_bounds, view, 60.0f );
+        EXPECT_NEAR ( near_size, std::sqrt ( 3.0f ) / ( 10.0f * std::tan ( 0.5235988f ) ), 1e-5f );
+        EXPECT_NEAR ( GetProjectedSize ( far_bounds, view, 60.0f ), near_size * 0.5f, 1e-5f );
+        EXPECT_TRUE ( std::isinf ( GetProjectedSize ( AABB { Vector3{}, Vector3{ 1.0f, 1.0f, 1.0f } }, view, 60.0f ) ) );
+    }
+}
@@ -0,0 +1,181 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongames/Animation.hpp"
+#include "aeongames/ProtoBufClasses.hpp"
+#include "animation.pb.h"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// A looping clip with a still scale, smoothly rotating bones and a swaying root.
+        AnimationMsg MakeClip ( uint32_t aBoneCount, uint32_t aFrameCount )
+        {
+            AnimationMsg message;
+            message.set_version ( 1 );
+            message.set_framerate ( 30 );
+            message.set_duration ( static_cast<float> ( aFrameCount ) / 30.0f );
+            for ( uint32_t frame = 0; frame < aFrameCount; ++frame )
+            {
+                FrameMsg* frame_msg = message.add_frame();
+                const float phase = static_cast<float> ( frame ) / static_cast<float> ( aFrameCount ) * 6.2831853f;
+                for ( uint32_t bone = 0; bone < aBoneCount; ++bone )
+                {
+                    BoneMsg* bone_msg = frame_msg->add_bone();
+                    bone_msg->mutable_scale()->set_x ( 1.0f );
+                    bone_msg->mutable_scale()->set_y ( 1.0f );
+                    bone_msg->mutable_scale()->set_z ( 1.0f );
+                    const float half_angle = 0.5f * std::sin ( phase + static_cast<float> ( bone ) ) + ( frame == aFrameCount / 2 ? 0.05f : 0.0f );
+                    const float axis_length = std::sqrt ( 3.0f );
+                    bone_msg->mutable_rotation()->set_w ( std::cos ( half_angle ) );
+                    bone_msg->mutable_rotation()->set_x ( std::sin ( half_angle ) / axis_length );
+                    bone_msg->mutable_rotation()->set_y ( -std::sin ( half_angle ) / axis_length );
+                    bone_msg->mutable_rotation()->set_z ( std::sin ( half_angle ) / axis_length );
+                    bone_msg->mutable_translation()->set_x ( bone == 0 ? 2.0f * std::cos ( phase ) : 0.0f );
+                    bone_msg->mutable_translation()->set_y ( static_cast<float> ( bone ) );
+                    bone_msg->mutable_translation()->set_z ( bone == 0 ? std::sin ( 2.0f * phase ) : 0.0f );
+                }
+            }
+            return message;
+        }
+
+        float RotationError ( const Quaternion& aLhs, const Quaternion& aRhs )
+        {
+            const float sign = ( aLhs[0] * aRhs[0] + aLhs[1] * aRhs[1] + aLhs[2] * aRhs[2] + aLhs[3] * aRhs[3] ) < 0.0f ? -1.0f : 1.0f;
+            float chord = 0.0f;
+            for ( size_t i = 0; i < 4; ++i )
+            {
+                chord += ( aLhs[i] - sign * aRhs[i] ) * ( aLhs[i] - sign * aRhs[i] );
+            }
+            return 4.0f * std::asin ( std::min ( std::sqrt ( chord ) * 0.5f, 1.0f ) );
+        }
+
+        float VectorError ( const Vector3& aLhs, const Vector3& aRhs )
+        {
+            return std::sqrt ( ( aLhs[0] - aRhs[0] ) * ( aLhs[0] - aRhs[0] ) +
+                               ( aLhs[1] - aRhs[1] ) * ( aLhs[1] - aRhs[1] ) +
+                               ( aLhs[2] - aRhs[2] ) * ( aLhs[2] - aRhs[2] ) );
+        }
+    }
+
+    TEST ( AnimationTest, CompressedClipStaysWithinTolerance )
+    {
+        const AnimationMsg message = MakeClip ( 16, 120 );
+        Animation raw;
+        raw.LoadFromPBMsg ( message );
+        Animation compressed;
+        compressed.LoadFromPBMsg ( message );
+        const AnimationCompression compression{};
+        compressed.Compress ( compression );
+        ASSERT_TRUE ( compressed.IsCompressed() );
+        EXPECT_EQ ( compressed.GetFrameCount(), 120u );
+        EXPECT_EQ ( compressed.GetBoneCount(), 16u );
+        EXPECT_LT ( compressed.GetMemoryUsage() * 4, raw.GetMemoryUsage() );
+
+        // 16 bit quantization of the 4 unit root sway adds up to 0.0001 on top of the tolerance.
+        const float translation_bound = compression.mTranslationTolerance + 0.0001f;
+        const float rotation_bound = compression.mRotationTolerance + 0.0001f;
+        float max_rotation_error = 0.0f;
+        float max_translation_error = 0.0f;
+        float max_scale_error = 0.0f;
+        for ( uint32_t step = 0; step < 120 * 4; ++step )
+        {
+            const double sample = step * 0.25;
+            // Splines through the frames may overshoot the per frame error by a quarter.
+            const float spline = ( step % 4 ) == 0 ? 1.0f : 1.25f;
+            for ( size_t bone = 0; bone < 16; ++bone )
+            {
+                const Transform expected = raw.GetTransform ( bone, sample );
+                const Transform actual = compressed.GetTransform ( bone, sample );
+                max_rotation_error = std::max ( max_rotation_error, RotationError ( expected.GetRotation(), actual.GetRotation() ) );
+                max_translation_error = std::max ( max_translation_error, VectorError ( expected.GetTranslation(), actual.GetTranslation() ) / spline );
+                max_scale_error = std::max ( max_scale_error, VectorError ( expected.GetScale(), actual.GetScale() ) / spline );
+            }
+        }
+        EXPECT_LE ( max_rotation_error, rotation_bound );
+        EXPECT_LE ( max_translation_error, translation_bound );
+        EXPECT_LE ( max_scale_error, compression.mScaleTolerance );
+    }
+
+    TEST ( AnimationTest, CompressedClipSerializes )
+    {
+        Animation compressed;
+        compressed.LoadFromPBMsg ( MakeClip ( 4, 60 ) );
+        compressed.Compress();
+        AnimationMsg message;
+        compressed.Serialize ( message );
+        EXPECT_EQ ( message.frame_size(), 0 );
+        EXPECT_EQ ( message.track_size(), 12 );
+        // Scale never moves and is stored as a single value.
+        EXPECT_TRUE ( message.track ( 0 ).keys().empty() );
+        EXPECT_EQ ( message.track ( 0 ).constant_size(), 3 );
+
+        Animation loaded;
+        loaded.LoadFromPBMsg ( message );
+        ASSERT_TRUE ( loaded.IsCompressed() );
+        for ( uint32_t frame = 0; frame < 60; ++frame )
+        {
+            for ( size_t bone = 0; bone < 4; ++bone )
+            {
+                EXPECT_EQ ( loaded.GetTransform ( bone, frame ), compressed.GetTransform ( bone, frame ) );
+            }
+        }
+    }
+
+    TEST ( AnimationTest, SamplePoseMatchesGetTransform )
+    {
+        // 13 bones leave a partial block of eight.
+        const AnimationMsg message = MakeClip ( 13, 70 );
+        Animation raw;
+        raw.LoadFromPBMsg ( message );
+        Animation compressed;
+        compressed.LoadFromPBMsg ( message );
+        compressed.Compress();
+        for ( const Animation* animation : { &raw, &compressed } )
+        {
+            std::vector<Transform> pose ( 14 );
+            for ( uint32_t step = 0; step < 70 * 3; ++step )
+            {
+                const double sample = step / 3.0;
+                animation->SamplePose ( sample, pose );
+                for ( size_t bone = 0; bone < 13; ++bone )
+                {
+                    EXPECT_EQ ( pose[bone], animation->GetTransform ( bone, sample ) ) << "bone " << bone << " sample " << sample;
+                }
+                // Entries past the skeleton are left alone.
+                EXPECT_EQ ( pose[13], Transform{} );
+            }
+        }
+    }
+
+    TEST ( AnimationTest, RejectsMalformedTracks )
+    {
+        Animation compressed;
+        compressed.LoadFromPBMsg ( MakeClip ( 2, 30 ) );
+        compressed.Compress();
+        AnimationMsg message;
+        compressed.Serialize ( message );
+        message.mutable_track ( 1 )->mutable_values()->pop_back();
+        Animation loaded;
+        EXPECT_THROW ( loaded.LoadFromPBMsg ( message ), std::runtime_error );
+    }
+}
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 #include "aeongames/CRC.hpp"
 #include "gtest/gtest.h"
 
@@ -33,4 +34,59 @@ namespace AeonGames
     {
         EXPECT_TRUE ( crc64i ( "AeonGames", 9 ) == 0x187936cc3eca327f );
     }
+
+    namespace
+    {
+        std::vector<char> MakeCrcMessage ( size_t aSize )
+        {
+            std::vector<char> message ( aSize );
+            uint32_t state = 0x9E3779B9u;
+            for ( char& byte : message )
+            {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<char> ( state >> 24 );
+            }
+            return message;
+        }
+    }
+
+    // Every length around the 8 byte slices and the 16/64 byte folds, at
+    // every misalignment, against the recursive constexpr reference.
+    TEST ( CRC, FastPathsMatchConstexprReference )
+    {
+        const std::vector<char> message = MakeCrcMessage ( 600 );
+        for ( size_t offset = 0; offset < 16; ++offset )
+        {
+            for ( size_t size = 0; size + offset <= 300; ++size )
+            {
+                const char* data = message.data() + offset;
+                const uint32_t expected = crc32r ( data, size );
+                ASSERT_EQ ( crc32i ( data, size ), expected ) << "offset " << offset << " size " << size;
+                ASSERT_EQ ( crc32i_slice8 ( data, size ), expected ) << "offset " << offset << " size " << size;
+                ASSERT_EQ ( crc32i_clmul ( data, size ), expected ) << "offset " << offset << " size " << size;
+                ASSERT_EQ ( crc64i ( data, size ), crc64r ( data, size ) ) << "offset " << offset << " size " << size;
+            }
+        }
+    }
+
+    TEST ( CRC, LargeMessagesAgreeAcrossPaths )
+    {
+        const std::vector<char> message = MakeCrcMessage ( 1 << 20 );
+        const uint32_t slice8 = crc32i_slice8 ( message.data(), message.size() );
+        EXPECT_EQ ( crc32i_clmul ( message.data(), message.size() ), slice8 );
+        EXPECT_EQ ( crc32i ( message.data(), message.size() ), slice8 );
+        EXPECT_EQ ( crc32i_clmul ( message.data() + 3, message.size() - 3 ), crc32i_slice8 ( message.data() + 3, message.size() - 3 ) );
+    }
+
+    TEST ( CRC, ContinuationMatchesSinglePass )
+    {
+        const std::vector<char> message = MakeCrcMessage ( 5000 );
+        for ( size_t split : { 0u, 1u, 7u, 64u, 100u, 4999u, 5000u } )
+        {
+            const uint32_t first = crc32i ( message.data(), split );
+            EXPECT_EQ ( crc32i ( message.data() + split, message.size() - split, first ), crc32i ( message.data(), message.size() ) );
+            const uint64_t first64 = crc64i ( message.data(), split );
+            EXPECT_EQ ( crc64i ( message.data() + split, message.size() - split, first64 ), crc64i ( message.data(), message.size() ) );
+        }
+    }
 }
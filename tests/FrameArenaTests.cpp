@@ -0,0 +1,130 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "aeongames/FrameArena.hpp"
+#include "aeongames/AllocationCounter.hpp"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+
+namespace AeonGames
+{
+    TEST ( FrameArenaTest, AllocationsAreAlignedAndBumpTheOffset )
+    {
+        FrameArena arena { 1024 };
+        void* first = arena.Allocate ( 3, 1 );
+        void* second = arena.Allocate ( 8, 8 );
+        EXPECT_EQ ( reinterpret_cast<uintptr_t> ( second ) % 8, 0u );
+        EXPECT_GT ( second, first );
+        EXPECT_EQ ( arena.GetUsed(), 16u );
+        arena.Reset();
+        EXPECT_EQ ( arena.GetUsed(), 0u );
+        EXPECT_EQ ( arena.Allocate ( 3, 1 ), first );
+    }
+
+    TEST ( FrameArenaTest, DeallocatingTheLastBlockRollsBack )
+    {
+        FrameArena arena { 1024 };
+        arena.Allocate ( 16, 8 );
+        void* top = arena.Allocate ( 32, 8 );
+        arena.Deallocate ( top, 32 );
+        EXPECT_EQ ( arena.GetUsed(), 16u );
+        EXPECT_EQ ( arena.Allocate ( 32, 8 ), top );
+    }
+
+    TEST ( FrameArenaTest, OverflowGrowsOnReset )
+    {
+        FrameArena arena { 64 };
+        void* fits = arena.Allocate ( 48, 8 );
+        void* overflow = arena.Allocate ( 100, 16 );
+        EXPECT_NE ( overflow, nullptr );
+        EXPECT_EQ ( reinterpret_cast<uintptr_t> ( overflow ) % 16, 0u );
+        EXPECT_EQ ( arena.GetOverflowCount(), 1u );
+        // Frame vectors free in LIFO order before the frame ends.
+        arena.Deallocate ( overflow, 100 );
+        arena.Deallocate ( fits, 48 );
+        arena.Reset();
+        EXPECT_EQ ( arena.GetOverflowCount(), 0u );
+        EXPECT_GE ( arena.GetCapacity(), 148u );
+        fits = arena.Allocate ( 48, 8 );
+        overflow = arena.Allocate ( 100, 16 );
+        EXPECT_EQ ( arena.GetOverflowCount(), 0u );
+        arena.Deallocate ( overflow, 100 );
+        arena.Deallocate ( fits, 48 );
+        // A smaller frame never shrinks the block back.
+        arena.Reset();
+        arena.Allocate ( 200, 8 );
+        arena.Reset();
+        EXPECT_GE ( arena.GetCapacity(), 200u );
+        arena.Allocate ( 8, 8 );
+        arena.Allocate ( 300, 8 );
+        arena.Reset();
+        EXPECT_GE ( arena.GetCapacity(), 308u );
+    }
+
+    TEST ( FrameArenaTest, FrameVectorUsesTheThreadArena )
+    {
+        ResetFrameArenas();
+        const size_t used = GetFrameArena().GetUsed();
+        {
+            FrameVector<uint32_t> values;
+            values.reserve ( 100 );
+            for ( uint32_t i = 0; i < 100; ++i )
+            {
+                values.push_back ( i );
+            }
+            EXPECT_EQ ( values[99], 99u );
+            EXPECT_GE ( GetFrameArena().GetUsed(), used + 100 * sizeof ( uint32_t ) );
+        }
+        // The vector was the last allocation, so destroying it rolled back.
+        EXPECT_EQ ( GetFrameArena().GetUsed(), used );
+        ResetFrameArenas();
+    }
+
+    TEST ( FrameArenaTest, EachThreadHasItsOwnArena )
+    {
+        FrameArena* main_arena = &GetFrameArena();
+        FrameArena* worker_arena = nullptr;
+        std::thread worker ( [&worker_arena]()
+        {
+            worker_arena = &GetFrameArena();
+        } );
+        worker.join();
+        EXPECT_NE ( worker_arena, nullptr );
+        EXPECT_NE ( worker_arena, main_arena );
+    }
+
+    TEST ( AllocationCounterTest, CountsGlobalHeapAllocations )
+    {
+        if ( !IsAllocationCountingEnabled() )
+        {
+            GTEST_SKIP() << "Built without USE_ALLOCATION_COUNTER.";
+        }
+        ResetFrameArenas();
+        const uint64_t thread_before = GetThreadAllocationCount();
+        auto value = std::make_unique<int> ( 42 );
+        EXPECT_EQ ( GetThreadAllocationCount(), thread_before + 1 );
+        EXPECT_GE ( GetFrameAllocationCount(), 1u );
+        // Arena allocations do not reach the heap.
+        const uint64_t arena_before = GetThreadAllocationCount();
+        FrameVector<int> values;
+        values.resize ( 64 );
+        EXPECT_EQ ( GetThreadAllocationCount(), arena_before );
+    }
+}
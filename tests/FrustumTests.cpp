@@ -98,4 +98,23 @@ namespace AeonGames
         EXPECT_TRUE ( frustum.Intersects ( inside ) );
         EXPECT_FALSE ( frustum.Intersects ( outside ) );
     }
+
+    // Depth grows monotonically from the near plane (0) to the far plane (1)
+    // along the view direction and clamps outside that range.
+    TEST ( FrustumDepth, IncreasesFromNearToFar )
+    {
+        const Frustum frustum = MakeFrustum();
+        EXPECT_NEAR ( frustum.GetDepth ( Vector3 { 0.0f, 1.0f, 0.0f } ), 0.0f, 1e-6f );
+        EXPECT_NEAR ( frustum.GetDepth ( Vector3 { 0.0f, 100.0f, 0.0f } ), 1.0f, 1e-6f );
+        float previous = 0.0f;
+        for ( float distance : { 2.0f, 5.0f, 20.0f, 50.0f, 99.0f } )
+        {
+            const float depth = frustum.GetDepth ( Vector3 { 0.0f, distance, 0.0f } );
+            EXPECT_GT ( depth, previous );
+            EXPECT_LT ( depth, 1.0f );
+            previous = depth;
+        }
+        EXPECT_EQ ( frustum.GetDepth ( Vector3 { 0.0f, -10.0f, 0.0f } ), 0.0f );
+        EXPECT_EQ ( frustum.GetDepth ( Vector3 { 0.0f, 500.0f, 0.0f } ), 1.0f );
+    }
 }
@@ -0,0 +1,297 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "aeongames/JobSystem.hpp"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+
+namespace AeonGames
+{
+    // Always exercise real concurrency, even on single core CI runners.
+    static constexpr size_t kStressWorkers = 4;
+
+    TEST ( JobSystemTest, ZeroWorkersRunsOnWaitingThread )
+    {
+        JobSystem job_system{0};
+        EXPECT_EQ ( job_system.GetWorkerCount(), 0u );
+        EXPECT_EQ ( job_system.GetThreadCount(), 1u );
+        int value = 0;
+        auto job = job_system.Run ( [&value]()
+        {
+            value = 42;
+        } );
+        job_system.Wait ( job );
+        EXPECT_TRUE ( job_system.IsComplete ( job ) );
+        EXPECT_EQ ( value, 42 );
+    }
+
+    TEST ( JobSystemTest, ThreadIndexIsZeroOutsideWorkers )
+    {
+        JobSystem job_system{kStressWorkers};
+        EXPECT_EQ ( job_system.GetCurrentThreadIndex(), 0u );
+        std::atomic<bool> in_range{true};
+        job_system.ParallelFor ( 0, 1024, 1, [&job_system, &in_range] ( size_t, size_t )
+        {
+            if ( job_system.GetCurrentThreadIndex() >= job_system.GetThreadCount() )
+            {
+                in_range = false;
+            }
+        } );
+        EXPECT_TRUE ( in_range );
+    }
+
+    TEST ( JobSystemTest, ManyIndependentJobs )
+    {
+        JobSystem job_system{kStressWorkers};
+        constexpr size_t kJobCount = 20000;
+        std::atomic<size_t> counter{0};
+        std::vector<JobSystem::JobHandle> jobs;
+        jobs.reserve ( kJobCount );
+        for ( size_t i = 0; i < kJobCount; ++i )
+        {
+            jobs.emplace_back ( job_system.Run ( [&counter]()
+            {
+                counter.fetch_add ( 1, std::memory_order_relaxed );
+            } ) );
+        }
+        for ( auto& job : jobs )
+        {
+            job_system.Wait ( job );
+        }
+        EXPECT_EQ ( counter.load(), kJobCount );
+    }
+
+    TEST ( JobSystemTest, ChildrenSpawnedFromRunningJobsGateTheRoot )
+    {
+        JobSystem job_system{kStressWorkers};
+        std::atomic<size_t> counter{0};
+        auto root = job_system.CreateJob ( {} );
+        for ( size_t i = 0; i < 64; ++i )
+        {
+            // Each child attaches more children to the root from inside its own
+            // function, which is legal because the root cannot complete first.
+            job_system.Submit ( job_system.CreateJob ( root, [&job_system, &counter, root]()
+            {
+                for ( size_t j = 0; j < 64; ++j )
+                {
+                    job_system.Submit ( job_system.CreateJob ( root, [&counter]()
+                    {
+                        counter.fetch_add ( 1, std::memory_order_relaxed );
+                    } ) );
+                }
+            } ) );
+        }
+        job_system.Submit ( root );
+        job_system.Wait ( root );
+        EXPECT_EQ ( counter.load(), 64u * 64u );
+    }
+
+    TEST ( JobSystemTest, GrandchildrenGateTheRoot )
+    {
+        JobSystem job_system{kStressWorkers};
+        std::atomic<size_t> counter{0};
+        auto root = job_system.CreateJob ( {} );
+        for ( size_t i = 0; i < 64; ++i )
+        {
+            auto child = job_system.CreateJob ( root, {} );
+            for ( size_t j = 0; j < 64; ++j )
+            {
+                job_system.Submit ( job_system.CreateJob ( child, [&counter]()
+                {
+                    counter.fetch_add ( 1, std::memory_order_relaxed );
+                } ) );
+            }
+            job_system.Submit ( child );
+        }
+        job_system.Submit ( root );
+        job_system.Wait ( root );
+        EXPECT_EQ ( counter.load(), 64u * 64u );
+    }
+
+    TEST ( JobSystemTest, DependencyChainRunsInOrder )
+    {
+        JobSystem job_system{kStressWorkers};
+        constexpr size_t kChainLength = 2000;
+        std::vector<size_t> order;
+        order.reserve ( kChainLength );
+        std::vector<JobSystem::JobHandle> chain;
+        chain.reserve ( kChainLength );
+        for ( size_t i = 0; i < kChainLength; ++i )
+        {
+            chain.emplace_back ( job_system.CreateJob ( [&order, i]()
+            {
+                order.push_back ( i );
+            } ) );
+            if ( i > 0 )
+            {
+                job_system.AddDependency ( chain[i], chain[i - 1] );
+            }
+        }
+        // Submit back to front so nothing can start early by accident.
+        for ( size_t i = kChainLength; i-- > 0; )
+        {
+            job_system.Submit ( chain[i] );
+        }
+        job_system.Wait ( chain.back() );
+        ASSERT_EQ ( order.size(), kChainLength );
+        for ( size_t i = 0; i < kChainLength; ++i )
+        {
+            EXPECT_EQ ( order[i], i );
+        }
+    }
+
+    TEST ( JobSystemTest, DiamondGraphJoinsAfterAllBranches )
+    {
+        JobSystem job_system{kStressWorkers};
+        for ( size_t iteration = 0; iteration < 200; ++iteration )
+        {
+            std::atomic<int> branches{0};
+            int seen_at_join = -1;
+            auto source = job_system.CreateJob ( {} );
+            auto join = job_system.CreateJob ( [&branches, &seen_at_join]()
+            {
+                seen_at_join = branches.load();
+            } );
+            std::vector<JobSystem::JobHandle> middle;
+            for ( size_t i = 0; i < 16; ++i )
+            {
+                middle.emplace_back ( job_system.CreateJob ( [&branches]()
+                {
+                    branches.fetch_add ( 1 );
+                } ) );
+                job_system.AddDependency ( middle.back(), source );
+                job_system.AddDependency ( join, middle.back() );
+            }
+            job_system.Submit ( join );
+            for ( auto& job : middle )
+            {
+                job_system.Submit ( job );
+            }
+            job_system.Submit ( source );
+            job_system.Wait ( join );
+            EXPECT_EQ ( seen_at_join, 16 );
+        }
+    }
+
+    TEST ( JobSystemTest, DependencyOnCompletedJobIsNoOp )
+    {
+        JobSystem job_system{kStressWorkers};
+        auto first = job_system.Run ( {} );
+        job_system.Wait ( first );
+        bool ran = false;
+        auto second = job_system.CreateJob ( [&ran]()
+        {
+            ran = true;
+        } );
+        job_system.AddDependency ( second, first );
+        job_system.Submit ( second );
+        job_system.Wait ( second );
+        EXPECT_TRUE ( ran );
+    }
+
+    TEST ( JobSystemTest, ParallelForCoversRangeExactlyOnce )
+    {
+        JobSystem job_system{kStressWorkers};
+        for ( size_t grain : {0u, 1u, 7u, 64u, 100000u} )
+        {
+            std::vector<std::atomic<uint32_t >> hits ( 10007 );
+            job_system.ParallelFor ( 0, hits.size(), grain, [&hits] ( size_t aBegin, size_t aEnd )
+            {
+                for ( size_t i = aBegin; i < aEnd; ++i )
+                {
+                    hits[i].fetch_add ( 1, std::memory_order_relaxed );
+                }
+            } );
+            for ( auto& hit : hits )
+            {
+                ASSERT_EQ ( hit.load(), 1u );
+            }
+        }
+    }
+
+    TEST ( JobSystemTest, NestedParallelForDoesNotDeadlock )
+    {
+        JobSystem job_system{kStressWorkers};
+        std::atomic<uint64_t> sum{0};
+        job_system.ParallelFor ( 0, 64, 1, [&job_system, &sum] ( size_t aOuterBegin, size_t aOuterEnd )
+        {
+            for ( size_t outer = aOuterBegin; outer < aOuterEnd; ++outer )
+            {
+                job_system.ParallelFor ( 0, 256, 16, [&sum] ( size_t aBegin, size_t aEnd )
+                {
+                    uint64_t local = 0;
+                    for ( size_t i = aBegin; i < aEnd; ++i )
+                    {
+                        local += i;
+                    }
+                    sum.fetch_add ( local, std::memory_order_relaxed );
+                } );
+            }
+        } );
+        EXPECT_EQ ( sum.load(), 64u * ( 255u * 256u / 2u ) );
+    }
+
+    TEST ( JobSystemTest, ExceptionPropagatesToWaiter )
+    {
+        JobSystem job_system{kStressWorkers};
+        auto root = job_system.CreateJob ( {} );
+        for ( size_t i = 0; i < 32; ++i )
+        {
+            job_system.Submit ( job_system.CreateJob ( root, [i]()
+            {
+                if ( i == 17 )
+                {
+                    throw std::runtime_error ( "job failure" );
+                }
+            } ) );
+        }
+        job_system.Submit ( root );
+        EXPECT_THROW ( job_system.Wait ( root ), std::runtime_error );
+        EXPECT_TRUE ( job_system.IsComplete ( root ) );
+    }
+
+    TEST ( JobSystemTest, DestructorDrainsQueuedJobs )
+    {
+        std::atomic<size_t> counter{0};
+        {
+            JobSystem job_system{kStressWorkers};
+            for ( size_t i = 0; i < 1000; ++i )
+            {
+                job_system.Run ( [&counter]()
+                {
+                    counter.fetch_add ( 1, std::memory_order_relaxed );
+                } );
+            }
+        }
+        EXPECT_EQ ( counter.load(), 1000u );
+    }
+
+    TEST ( JobSystemTest, GlobalJobSystemIsReusable )
+    {
+        std::atomic<size_t> counter{0};
+        GetJobSystem().ParallelFor ( 0, 1000, 10, [&counter] ( size_t aBegin, size_t aEnd )
+        {
+            counter.fetch_add ( aEnd - aBegin );
+        } );
+        EXPECT_EQ ( counter.load(), 1000u );
+        EXPECT_EQ ( &GetJobSystem(), &GetJobSystem() );
+    }
+}
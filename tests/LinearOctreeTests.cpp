@@ -0,0 +1,233 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aeongames/LinearOctree.hpp"
+#include "aeongames/Octree.hpp"
+#include "aeongames/Node.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Vector3.hpp"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+
+namespace AeonGames
+{
+    static std::unique_ptr<Node> MakeLinearTestNode ( const Vector3& aCenter, const Vector3& aRadii )
+    {
+        auto node = std::make_unique<Node>();
+        node->SetAABB ( AABB { aCenter, aRadii } );
+        return node;
+    }
+
+    // Deterministic scatter of small and large boxes across [-64,64]^3 so nodes
+    // land at every depth, including the root.
+    static std::vector<std::unique_ptr<Node >> MakeScatteredNodes ( size_t aCount )
+    {
+        std::vector<std::unique_ptr<Node >> nodes;
+        uint32_t state = 12345u;
+        auto next = [&state]()
+        {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<float> ( state >> 8 ) / static_cast<float> ( 1u << 24 );
+        };
+        for ( size_t i = 0; i < aCount; ++i )
+        {
+            const Vector3 center { next() * 128.0f - 64.0f, next() * 128.0f - 64.0f, next() * 128.0f - 64.0f };
+            const float radius = ( i % 10 == 0 ) ? next() * 30.0f : next() * 2.0f;
+            nodes.emplace_back ( MakeLinearTestNode ( center, Vector3 { radius, radius, radius } ) );
+        }
+        return nodes;
+    }
+
+    template<class Tree>
+    static std::vector<const Node*> QueryBoxSet ( const Tree& aTree, const AABB& aBox )
+    {
+        std::vector<const Node*> hits;
+        aTree.QueryAABB ( aBox, [&hits] ( const Node * aNode )
+        {
+            hits.push_back ( aNode );
+        } );
+        std::sort ( hits.begin(), hits.end() );
+        return hits;
+    }
+
+    template<class Tree>
+    static std::vector<const Node*> QueryFrustumSet ( const Tree& aTree, const Frustum& aFrustum )
+    {
+        std::vector<const Node*> hits;
+        aTree.QueryFrustum ( aFrustum, [&hits] ( const Node * aNode )
+        {
+            hits.push_back ( aNode );
+        } );
+        std::sort ( hits.begin(), hits.end() );
+        return hits;
+    }
+
+    static const AABB kLinearTestRoot { Vector3 {}, Vector3 { 64.0f, 64.0f, 64.0f } };
+
+    TEST ( LinearOctreeTest, DefaultConstructorIsEmpty )
+    {
+        LinearOctree octree;
+        EXPECT_EQ ( octree.GetNodeCount(), 0u );
+        EXPECT_EQ ( octree.GetCellCount(), 0u );
+        EXPECT_EQ ( octree.GetMaxDepth(), 0u );
+    }
+
+    TEST ( LinearOctreeTest, MaxDepthIsClampedToMortonCodeLimit )
+    {
+        LinearOctree octree { kLinearTestRoot, 1000 };
+        EXPECT_EQ ( octree.GetMaxDepth(), 21u );
+    }
+
+    TEST ( LinearOctreeTest, SmallNodeDescendsToDeepestCell )
+    {
+        LinearOctree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        auto node = MakeLinearTestNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        octree.AddNode ( node.get() );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+        EXPECT_EQ ( octree.GetCellCount(), 4u );
+    }
+
+    TEST ( LinearOctreeTest, MatchesHashedOctree )
+    {
+        const std::vector<std::unique_ptr<Node >> nodes = MakeScatteredNodes ( 2000 );
+        Octree hashed { kLinearTestRoot, 6 };
+        LinearOctree linear { kLinearTestRoot, 6 };
+        for ( const auto& node : nodes )
+        {
+            hashed.AddNode ( node.get() );
+            linear.AddNode ( node.get() );
+        }
+        EXPECT_EQ ( linear.GetNodeCount(), hashed.GetNodeCount() );
+        EXPECT_EQ ( linear.GetCellCount(), hashed.GetCellCount() );
+        const AABB boxes[] =
+        {
+            kLinearTestRoot,
+            AABB { Vector3 { 10.0f, -20.0f, 5.0f }, Vector3 { 4.0f, 4.0f, 4.0f } },
+            AABB { Vector3 { -40.0f, 40.0f, 0.0f }, Vector3 { 20.0f, 1.0f, 30.0f } },
+            AABB { Vector3 { 100.0f, 100.0f, 100.0f }, Vector3 { 1.0f, 1.0f, 1.0f } },
+        };
+        for ( const AABB& box : boxes )
+        {
+            EXPECT_EQ ( QueryBoxSet ( linear, box ), QueryBoxSet ( hashed, box ) );
+        }
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 4.0f / 3.0f, 1.0f, 100.0f );
+        const Frustum frustum { projection };
+        EXPECT_EQ ( QueryFrustumSet ( linear, frustum ), QueryFrustumSet ( hashed, frustum ) );
+    }
+
+    TEST ( LinearOctreeTest, RemoveAndUpdateMatchHashedOctree )
+    {
+        std::vector<std::unique_ptr<Node >> nodes = MakeScatteredNodes ( 500 );
+        Octree hashed { kLinearTestRoot, 5 };
+        LinearOctree linear { kLinearTestRoot, 5 };
+        for ( const auto& node : nodes )
+        {
+            hashed.AddNode ( node.get() );
+            linear.AddNode ( node.get() );
+        }
+        for ( size_t i = 0; i < nodes.size(); i += 3 )
+        {
+            hashed.RemoveNode ( nodes[i].get() );
+            linear.RemoveNode ( nodes[i].get() );
+        }
+        // Move some of the remaining nodes, half of them far enough to change cell.
+        for ( size_t i = 1; i < nodes.size(); i += 6 )
+        {
+            const AABB& aabb = nodes[i]->GetAABB();
+            const float shift = ( i % 12 == 1 ) ? 0.01f : 40.0f;
+            nodes[i]->SetAABB ( AABB { Vector3 { -aabb.GetCenter() [0] + shift, aabb.GetCenter() [1], aabb.GetCenter() [2] }, aabb.GetRadii() } );
+            EXPECT_EQ ( linear.UpdateNode ( nodes[i].get() ), hashed.UpdateNode ( nodes[i].get() ) );
+        }
+        EXPECT_EQ ( linear.GetNodeCount(), hashed.GetNodeCount() );
+        EXPECT_EQ ( linear.GetCellCount(), hashed.GetCellCount() );
+        EXPECT_EQ ( QueryBoxSet ( linear, kLinearTestRoot ), QueryBoxSet ( hashed, kLinearTestRoot ) );
+        const AABB box { Vector3 { 20.0f, 0.0f, -10.0f }, Vector3 { 16.0f, 16.0f, 16.0f } };
+        EXPECT_EQ ( QueryBoxSet ( linear, box ), QueryBoxSet ( hashed, box ) );
+    }
+
+    TEST ( LinearOctreeTest, RemoveAfterMoveFallsBackToScan )
+    {
+        LinearOctree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        auto node = MakeLinearTestNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        auto other = MakeLinearTestNode ( Vector3 { -7.0f, -7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        octree.AddNode ( node.get() );
+        octree.AddNode ( other.get() );
+        node->SetAABB ( AABB { Vector3 { -7.0f, 7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } } );
+        octree.RemoveNode ( node.get() );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+        EXPECT_EQ ( QueryBoxSet ( octree, AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } } ),
+                    std::vector<const Node*> { other.get() } );
+    }
+
+    TEST ( LinearOctreeTest, AddingAStoredNodeReplacesItLikeOctree )
+    {
+        Octree hashed { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        LinearOctree linear { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        auto node = MakeLinearTestNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        auto other = MakeLinearTestNode ( Vector3 { -7.0f, -7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        // Twice while pending, then again once settled and moved.
+        hashed.AddNode ( node.get() );
+        hashed.AddNode ( node.get() );
+        hashed.AddNode ( other.get() );
+        linear.AddNode ( node.get() );
+        linear.AddNode ( node.get() );
+        linear.AddNode ( other.get() );
+        EXPECT_EQ ( linear.GetNodeCount(), hashed.GetNodeCount() );
+        node->SetAABB ( AABB { Vector3 { -7.0f, 7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } } );
+        hashed.AddNode ( node.get() );
+        linear.AddNode ( node.get() );
+        EXPECT_EQ ( linear.GetNodeCount(), 2u );
+        EXPECT_EQ ( linear.GetNodeCount(), hashed.GetNodeCount() );
+        const AABB old_corner { Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.5f, 0.5f, 0.5f } };
+        const AABB new_corner { Vector3 { -7.0f, 7.0f, -7.0f }, Vector3 { 0.5f, 0.5f, 0.5f } };
+        EXPECT_TRUE ( QueryBoxSet ( linear, old_corner ).empty() );
+        EXPECT_EQ ( QueryBoxSet ( linear, new_corner ), std::vector<const Node*> { node.get() } );
+        EXPECT_EQ ( QueryBoxSet ( linear, new_corner ), QueryBoxSet ( hashed, new_corner ) );
+    }
+
+    TEST ( LinearOctreeTest, ForEachCellVisitsEveryAllocatedCell )
+    {
+        const std::vector<std::unique_ptr<Node >> nodes = MakeScatteredNodes ( 300 );
+        Octree hashed { kLinearTestRoot, 4 };
+        LinearOctree linear { kLinearTestRoot, 4 };
+        for ( const auto& node : nodes )
+        {
+            hashed.AddNode ( node.get() );
+            linear.AddNode ( node.get() );
+        }
+        std::vector<uint32_t> hashed_depths;
+        std::vector<uint32_t> linear_depths;
+        hashed.ForEachCell ( [&hashed_depths] ( const AABB&, uint32_t aDepth )
+        {
+            hashed_depths.push_back ( aDepth );
+        } );
+        linear.ForEachCell ( [&linear_depths] ( const AABB&, uint32_t aDepth )
+        {
+            linear_depths.push_back ( aDepth );
+        } );
+        std::sort ( hashed_depths.begin(), hashed_depths.end() );
+        std::sort ( linear_depths.begin(), linear_depths.end() );
+        EXPECT_EQ ( linear_depths, hashed_depths );
+    }
+}
@@ -14,6 +14,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "gtest/gtest.h"
 #include "aeongames/Mesh.hpp"
 #include "aeongames/ProtoBufClasses.hpp"
@@ -65,4 +69,74 @@ namespace AeonGames
         EXPECT_EQ ( mesh.GetAttributeOffset ( mesh.GetAttributes() [1] ), 0u );
         EXPECT_EQ ( mesh.GetStride(), 32u );
     }
-}
\ No newline at end of file
+
+    namespace
+    {
+        MeshMsg MakeTriangleMsg()
+        {
+            MeshMsg message;
+            auto* position = message.add_attribute();
+            position->set_semantic ( AttributeMsg_AttributeSemantic_POSITION );
+            position->set_size ( 3 );
+            position->set_type ( AttributeMsg_AttributeType_FLOAT );
+            const float vertices[] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+            const uint16_t indices[] = { 0, 1, 2 };
+            message.set_vertexcount ( 3 );
+            message.set_indexsize ( 2 );
+            message.set_indexcount ( 3 );
+            message.set_vertexbuffer ( vertices, sizeof ( vertices ) );
+            message.set_indexbuffer ( indices, sizeof ( indices ) );
+            return message;
+        }
+    }
+
+    TEST ( MeshLayoutTests, FlatRoundTrip )
+    {
+        Mesh source;
+        source.LoadFromPBMsg ( MakeTriangleMsg() );
+        std::vector<uint8_t> flat = source.SaveToFlat();
+        ASSERT_GE ( flat.size(), sizeof ( MeshFileHeader ) );
+        EXPECT_EQ ( flat[7], static_cast<uint8_t> ( kFlatMeshTag ) );
+
+        Mesh mesh;
+        mesh.LoadFromMemory ( flat.data(), flat.size() );
+        EXPECT_EQ ( mesh.GetVertexCount(), 3u );
+        EXPECT_EQ ( mesh.GetIndexCount(), 3u );
+        EXPECT_EQ ( mesh.GetIndexSize(), 2u );
+        EXPECT_EQ ( mesh.GetStride(), 12u );
+        ASSERT_EQ ( mesh.GetAttributes().size(), 1u );
+        ASSERT_EQ ( mesh.GetVertexBuffer().size(), source.GetVertexBuffer().size() );
+        EXPECT_EQ ( std::memcmp ( mesh.GetVertexBuffer().data(), source.GetVertexBuffer().data(), source.GetVertexBuffer().size() ), 0 );
+        ASSERT_EQ ( mesh.GetIndexBuffer().size(), source.GetIndexBuffer().size() );
+        EXPECT_EQ ( std::memcmp ( mesh.GetIndexBuffer().data(), source.GetIndexBuffer().data(), source.GetIndexBuffer().size() ), 0 );
+    }
+
+    TEST ( MeshLayoutTests, FlatViewIsUsedInPlace )
+    {
+        Mesh source;
+        source.LoadFromPBMsg ( MakeTriangleMsg() );
+        auto flat = std::make_shared<std::vector<uint8_t>> ( source.SaveToFlat() );
+        std::weak_ptr<std::vector<uint8_t>> watch = flat;
+        const uint8_t* begin = flat->data();
+        const uint8_t* end = begin + flat->size();
+
+        Mesh mesh;
+        mesh.LoadFromView ( *flat, flat );
+        flat.reset();
+        EXPECT_FALSE ( watch.expired() );
+        EXPECT_GE ( mesh.GetVertexBuffer().data(), begin );
+        EXPECT_LE ( mesh.GetIndexBuffer().data() + mesh.GetIndexBuffer().size(), end );
+        mesh.Unload();
+        EXPECT_TRUE ( watch.expired() );
+    }
+
+    TEST ( MeshLayoutTests, FlatRejectsTruncatedBlobs )
+    {
+        Mesh source;
+        source.LoadFromPBMsg ( MakeTriangleMsg() );
+        std::vector<uint8_t> flat = source.SaveToFlat();
+        flat.resize ( flat.size() - 1 );
+        Mesh mesh;
+        EXPECT_THROW ( mesh.LoadFromMemory ( flat.data(), flat.size() ), std::runtime_error );
+    }
+}
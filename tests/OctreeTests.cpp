@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include "aeongames/Octree.hpp"
 #include "aeongames/Node.hpp"
@@ -156,6 +157,60 @@ namespace AeonGames
         EXPECT_EQ ( octree.GetNodeCount(), 1u );
     }
 
+    TEST ( OctreeTest, UpdateNodeWithinCellKeepsPlacement )
+    {
+        Octree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        Node node = MakeNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        octree.AddNode ( &node );
+        // A nudge that stays inside the same depth-3 cell ([6,8]^3) is a no-op.
+        node.SetAABB ( AABB { Vector3 { 7.2f, 6.9f, 7.1f }, Vector3 { 0.1f, 0.1f, 0.1f } } );
+        EXPECT_FALSE ( octree.UpdateNode ( &node ) );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+        EXPECT_EQ ( octree.GetCellCount(), 4u );
+    }
+
+    TEST ( OctreeTest, UpdateNodeMovesAcrossCells )
+    {
+        Octree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        Node node = MakeNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        octree.AddNode ( &node );
+        node.SetAABB ( AABB { Vector3 { -7.0f, -7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } } );
+        EXPECT_TRUE ( octree.UpdateNode ( &node ) );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+        // The old branch was pruned, only the new root-to-leaf path remains.
+        EXPECT_EQ ( octree.GetCellCount(), 4u );
+        std::vector<const Node*> hits;
+        octree.QueryAABB ( AABB { Vector3 { -7.0f, -7.0f, -7.0f }, Vector3 { 0.5f, 0.5f, 0.5f } }, [&hits] ( const Node * aNode )
+        {
+            hits.push_back ( aNode );
+        } );
+        ASSERT_EQ ( hits.size(), 1u );
+        EXPECT_EQ ( hits.front(), &node );
+    }
+
+    TEST ( OctreeTest, RemoveNodeAfterMoveUsesStoredCell )
+    {
+        Octree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        Node node = MakeNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        octree.AddNode ( &node );
+        // Moved without telling the octree: removal must still find it.
+        node.SetAABB ( AABB { Vector3 { -7.0f, -7.0f, -7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } } );
+        octree.RemoveNode ( &node );
+        EXPECT_EQ ( octree.GetNodeCount(), 0u );
+        EXPECT_EQ ( octree.GetCellCount(), 0u );
+    }
+
+    TEST ( OctreeTest, UpdateUnknownNodeInserts )
+    {
+        Octree octree { AABB { Vector3 {}, Vector3 { 8.0f, 8.0f, 8.0f } }, 3 };
+        Node node = MakeNode ( Vector3 { 7.0f, 7.0f, 7.0f }, Vector3 { 0.1f, 0.1f, 0.1f } );
+        EXPECT_TRUE ( octree.UpdateNode ( &node ) );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+        // Adding it again must not duplicate it.
+        octree.AddNode ( &node );
+        EXPECT_EQ ( octree.GetNodeCount(), 1u );
+    }
+
     TEST ( OctreeTest, QueryFrustumReturnsAllVisibleNodes )
     {
         // Root sits in front of the camera (around +Y 50), so every cell intersects
@@ -209,6 +264,54 @@ namespace AeonGames
         EXPECT_EQ ( count, 0u );
     }
 
+    TEST ( OctreeTest, QueryFrustumsMatchesPerViewQueries )
+    {
+        // One perspective view in front of the camera (+Y) and one box view
+        // behind it (-Y); the root spans both so each view prunes a different half.
+        Octree octree { AABB { Vector3 {}, Vector3 { 64.0f, 64.0f, 64.0f } }, 4 };
+        std::vector<std::unique_ptr<Node >> nodes;
+        for ( int i = 0; i < 64; ++i )
+        {
+            const float x = static_cast<float> ( ( i * 37 ) % 120 - 60 );
+            const float y = static_cast<float> ( ( i * 53 ) % 120 - 60 );
+            nodes.emplace_back ( std::make_unique<Node>() );
+            nodes.back()->SetAABB ( AABB { Vector3 { x, y, x * 0.5f }, Vector3 { 0.5f, 0.5f, 0.5f } } );
+            octree.AddNode ( nodes.back().get() );
+        }
+        Matrix4x4 box {};
+        box.Ortho ( -30.0f, 30.0f, -30.0f, 30.0f, -60.0f, -10.0f );
+        const Frustum views[] { MakeFrustum(), Frustum { box } };
+
+        std::vector<const Node*> expected[2];
+        for ( size_t view = 0; view < 2; ++view )
+        {
+            octree.QueryFrustum ( views[view], [&expected, view] ( const Node * node )
+            {
+                expected[view].push_back ( node );
+            } );
+            std::sort ( expected[view].begin(), expected[view].end() );
+        }
+        std::vector<const Node*> visited[2];
+        octree.QueryFrustums ( views, [&visited] ( const Node * node, uint32_t mask )
+        {
+            EXPECT_NE ( mask, 0u );
+            for ( size_t view = 0; view < 2; ++view )
+            {
+                if ( mask & ( 1u << view ) )
+                {
+                    visited[view].push_back ( node );
+                }
+            }
+        } );
+        for ( size_t view = 0; view < 2; ++view )
+        {
+            std::sort ( visited[view].begin(), visited[view].end() );
+            EXPECT_EQ ( visited[view], expected[view] );
+        }
+        EXPECT_FALSE ( expected[0].empty() );
+        EXPECT_FALSE ( expected[1].empty() );
+    }
+
     TEST ( OctreeTest, QueryAABBReturnsOverlappingNodes )
     {
         // A query box covering the whole root reaches every stored node.
@@ -21,12 +21,18 @@ limitations under the License.
 #include <cstring>
 #include <functional>
 #include <filesystem>
+#include <span>
 #include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 #include "zlib.h"
 #include "aeongames/AeonEngine.hpp"
 #include "aeongames/Package.hpp"
 #include "aeongames/CRC.hpp"
+#include "BatchRead.h"
+#include "Compression.h"
+#include "ResourceDirectory.h"
 #include "gtest/gtest.h"
 
 using namespace ::testing;
@@ -139,6 +145,23 @@ namespace AeonGames
     {
         EXPECT_EQ ( GetResourceSize ( "shaders/missing" ), 0u );
     }
+    TEST_F ( ResourceResolveTest, MountChangesResolveAgain )
+    {
+        // Resolve both once so the outcomes, the miss too, are cached.
+        EXPECT_EQ ( GetResourceSize ( "shaders/missing" ), 0u );
+        EXPECT_EQ ( GetResourceSize ( "meshes/binonly" ), 10u );
+        std::filesystem::create_directories ( "resolve_patch/shaders" );
+        std::filesystem::create_directories ( "resolve_patch/meshes" );
+        std::ofstream ( "resolve_patch/shaders/missing.msh", std::ios::binary ) << "PATCHED";  // 7 bytes
+        std::ofstream ( "resolve_patch/meshes/binonly.txt", std::ios::binary ) << "T";         // 1 byte
+        MountResourcePackage ( "resolve_patch" );
+        EXPECT_EQ ( GetResourceSize ( "shaders/missing" ), 7u );
+        EXPECT_EQ ( GetResourceSize ( "meshes/binonly" ), 1u );
+        EXPECT_TRUE ( UnmountResourcePackage ( "resolve_patch" ) );
+        EXPECT_EQ ( GetResourceSize ( "shaders/missing" ), 0u );
+        EXPECT_EQ ( GetResourceSize ( "meshes/binonly" ), 10u );
+        std::filesystem::remove_all ( "resolve_patch" );
+    }
 
     TEST ( PackageFileTest, AeonPkgRoundTrip )
     {
@@ -269,6 +292,432 @@ namespace AeonGames
         package.LoadFile ( crc_raw, got_raw.data(), got_raw.size() );
         EXPECT_EQ ( std::string ( got_raw.data(), got_raw.size() ), raw_payload );
 
+        // Stored entries are viewed in place, compressed ones have to be loaded.
+        const std::span<const uint8_t> view = package.GetFileView ( raw_path );
+        EXPECT_EQ ( std::string ( reinterpret_cast<const char*> ( view.data() ), view.size() ), raw_payload );
+        EXPECT_TRUE ( package.GetFileView ( crc_text ).empty() );
+        EXPECT_TRUE ( package.GetFileView ( "missing.txt" ).empty() );
+        {
+            // Moving the package hands the mapping over with it.
+            Package moved ( std::move ( package ) );
+            EXPECT_EQ ( moved.GetFileView ( crc_raw ).data(), view.data() );
+        }
+
         std::filesystem::remove ( pkg_path );
     }
+
+    namespace
+    {
+        struct PackedFile
+        {
+            std::string mPath;
+            std::string mPayload;
+            uint8_t mCompression;
+        };
+
+        /** Writes an AEONPKG holding @p aFiles, data laid out in CRC order like aeontool pack does.
+            With @p aDictionary zstd files are compressed against it and it is stored as PKGDictionaryPath. */
+        void WritePackage ( const std::string& aPackagePath, std::vector<PackedFile> aFiles, const std::vector<uint8_t>& aDictionary = {} )
+        {
+            if ( !aDictionary.empty() )
+            {
+                aFiles.push_back ( PackedFile{PKGDictionaryPath, std::string ( aDictionary.begin(), aDictionary.end() ), NONE} );
+            }
+            std::vector<char> blob;
+            std::vector<PKGDirectoryEntry> entries ( aFiles.size() );
+            std::vector<std::string> data ( aFiles.size() );
+            for ( size_t i = 0; i < aFiles.size(); ++i )
+            {
+                PKGDirectoryEntry& e = entries[i];
+                e.crc = crc32i ( aFiles[i].mPath.data(), aFiles[i].mPath.size() );
+                e.path_offset = static_cast<uint32_t> ( blob.size() );
+                e.uncompressed_size = aFiles[i].mPayload.size();
+                e.compression = aFiles[i].mCompression;
+                blob.insert ( blob.end(), aFiles[i].mPath.begin(), aFiles[i].mPath.end() );
+                blob.push_back ( '\0' );
+                data[i] = aFiles[i].mPayload;
+                if ( aFiles[i].mCompression != NONE )
+                {
+                    std::vector<uint8_t> compressed;
+                    const std::span<const uint8_t> payload ( reinterpret_cast<const uint8_t*> ( aFiles[i].mPayload.data() ), aFiles[i].mPayload.size() );
+                    EXPECT_TRUE ( CompressBuffer ( aFiles[i].mCompression, payload, 6, compressed,
+                                                   aFiles[i].mCompression == ZSTD ? std::span<const uint8_t> ( aDictionary ) : std::span<const uint8_t>() ) );
+                    data[i].assign ( compressed.begin(), compressed.end() );
+                }
+                e.compressed_size = data[i].size();
+            }
+            std::vector<size_t> order ( aFiles.size() );
+            for ( size_t i = 0; i < order.size(); ++i )
+            {
+                order[i] = i;
+            }
+            std::sort ( order.begin(), order.end(), [&entries] ( size_t a, size_t b )
+            {
+                return entries[a].crc < entries[b].crc;
+            } );
+            PKGHeader header{};
+            std::memcpy ( header.id, "AEONPKG", 8 );
+            header.version[0] = 1;
+            header.file_count = static_cast<uint32_t> ( aFiles.size() );
+            header.index_offset = sizeof ( PKGHeader );
+            header.strings_offset = static_cast<uint32_t> ( header.index_offset + aFiles.size() * sizeof ( PKGDirectoryEntry ) );
+            uint64_t cursor = header.strings_offset + blob.size();
+            for ( size_t i : order )
+            {
+                entries[i].data_offset = cursor;
+                cursor += entries[i].compressed_size;
+            }
+            std::ofstream f ( aPackagePath, std::ios::out | std::ios::binary | std::ios::trunc );
+            f.write ( reinterpret_cast<const char*> ( &header ), sizeof ( header ) );
+            for ( size_t i : order )
+            {
+                f.write ( reinterpret_cast<const char*> ( &entries[i] ), sizeof ( PKGDirectoryEntry ) );
+            }
+            f.write ( blob.data(), static_cast<std::streamsize> ( blob.size() ) );
+            for ( size_t i : order )
+            {
+                f.write ( data[i].data(), static_cast<std::streamsize> ( data[i].size() ) );
+            }
+        }
+
+        /** A packed AEONPKG of stored and deflated files next to a loose
+            directory, both on the resource path. */
+        class BatchLoadTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                mPreviousResourcePath = GetResourcePath();
+                for ( size_t i = 0; i < 40; ++i )
+                {
+                    const std::string payload ( 1000 + i * 37, static_cast<char> ( 'a' + i % 26 ) );
+                    mFiles.push_back ( PackedFile{"batch/file" + std::to_string ( i ) + ".bin", payload + std::to_string ( i ), i % 3 == 0 ? ZLIB : NONE} );
+                }
+                WritePackage ( "batch.pkg", mFiles );
+                std::filesystem::create_directory ( "batch_loose" );
+                std::ofstream ( "batch_loose/loose.txt" ) << "LOOSE";
+                SetResourcePath ( {"batch.pkg", "batch_loose"} );
+            }
+            void TearDown() override
+            {
+                SetBatchReadBackend ( BatchReadBackend::IoUring );
+                SetResourcePath ( mPreviousResourcePath );
+                std::filesystem::remove ( "batch.pkg" );
+                std::filesystem::remove_all ( "batch_loose" );
+            }
+            std::vector<PackedFile> mFiles{};
+        private:
+            std::vector<std::string> mPreviousResourcePath{};
+        };
+    }
+
+    TEST ( BatchReadTest, ReadsRangesWithEachBackend )
+    {
+        std::string file_contents ( 1 << 20, '\0' );
+        for ( size_t i = 0; i < file_contents.size(); ++i )
+        {
+            file_contents[i] = static_cast<char> ( ( i * 131 ) >> 7 );
+        }
+        std::ofstream ( "batch_ranges.bin", std::ios::binary ).write ( file_contents.data(), static_cast<std::streamsize> ( file_contents.size() ) );
+        for ( BatchReadBackend backend : { BatchReadBackend::IoUring, BatchReadBackend::Preadv, BatchReadBackend::Stream } )
+        {
+            SetBatchReadBackend ( backend );
+            // Out of order, some adjacent so they merge, some apart, one empty.
+            const std::vector<std::pair<uint64_t, size_t >> layout
+            {
+                { 500000, 4096 }, { 0, 100 }, { 100, 4000 }, { 4100, 1 }, { 700000, 0 }, { 1000000, 48576 }, { 9000, 70000 }
+            };
+            std::vector<std::string> buffers;
+            std::vector<FileRange> ranges;
+            for ( const auto& range : layout )
+            {
+                buffers.emplace_back ( range.second, '\0' );
+            }
+            for ( size_t i = 0; i < layout.size(); ++i )
+            {
+                ranges.push_back ( FileRange{layout[i].first, buffers[i].data(), buffers[i].size() } );
+            }
+            ReadFileRanges ( "batch_ranges.bin", ranges );
+            for ( size_t i = 0; i < layout.size(); ++i )
+            {
+                EXPECT_EQ ( buffers[i], file_contents.substr ( layout[i].first, layout[i].second ) ) << static_cast<int> ( backend ) << " " << i;
+            }
+            // Reading past the end is an error, not a silent short read.
+            std::string past_end ( 16, '\0' );
+            FileRange beyond{file_contents.size() - 8, past_end.data(), past_end.size() };
+            EXPECT_THROW ( ReadFileRanges ( "batch_ranges.bin", { &beyond, 1 } ), std::system_error );
+        }
+        SetBatchReadBackend ( BatchReadBackend::IoUring );
+        std::filesystem::remove ( "batch_ranges.bin" );
+    }
+
+    TEST_F ( BatchLoadTest, LoadsEveryResourceWithEachBackend )
+    {
+        for ( BatchReadBackend backend : { BatchReadBackend::IoUring, BatchReadBackend::Preadv, BatchReadBackend::Stream } )
+        {
+            SetBatchReadBackend ( backend );
+            std::vector<std::string> contents;
+            std::vector<ResourceRead> reads;
+            // Reverse order, so the batch has to sort to read sequentially.
+            for ( auto file = mFiles.rbegin(); file != mFiles.rend(); ++file )
+            {
+                contents.emplace_back ( file->mPayload.size(), '\0' );
+            }
+            contents.emplace_back ( 5, '\0' );
+            for ( size_t i = 0; i < mFiles.size(); ++i )
+            {
+                const std::string& path = mFiles[mFiles.size() - 1 - i].mPath;
+                reads.push_back ( ResourceRead{crc32i ( path.data(), path.size() ), contents[i].data(), contents[i].size() } );
+            }
+            reads.push_back ( ResourceRead{"loose.txt"_crc32, contents.back().data(), contents.back().size() } );
+            LoadResources ( reads );
+            for ( size_t i = 0; i < mFiles.size(); ++i )
+            {
+                EXPECT_EQ ( contents[i], mFiles[mFiles.size() - 1 - i].mPayload ) << static_cast<int> ( backend );
+                EXPECT_EQ ( reads[i].mBytesRead, contents[i].size() );
+            }
+            EXPECT_EQ ( contents.back(), "LOOSE" );
+            EXPECT_EQ ( reads.back().mBytesRead, 5u );
+        }
+    }
+
+    TEST_F ( BatchLoadTest, MissingResourcesThrowAfterTheRestLoad )
+    {
+        std::string first ( mFiles[0].mPayload.size(), '\0' );
+        std::string missing ( 16, '\0' );
+        ResourceRead reads[]
+        {
+            { "missing.bin"_crc32, missing.data(), missing.size() },
+            { crc32i ( mFiles[0].mPath.data(), mFiles[0].mPath.size() ), first.data(), first.size() }
+        };
+        EXPECT_THROW ( LoadResources ( reads ), std::runtime_error );
+        EXPECT_EQ ( reads[0].mBytesRead, 0u );
+        EXPECT_EQ ( first, mFiles[0].mPayload );
+    }
+
+    namespace
+    {
+        /// Small text assets alike enough that a dictionary learns their shared bits.
+        std::string MakeMaterialText ( size_t aIndex )
+        {
+            return "name: \"material" + std::to_string ( aIndex ) + "\"\n"
+                   "property { name: \"Diffuse\" vector4 { x: " + std::to_string ( aIndex % 7 ) + " y: 0.5 z: 0.25 w: 1 } }\n"
+                   "property { name: \"Roughness\" scalar_float: 0." + std::to_string ( aIndex % 10 ) + " }\n"
+                   "sampler { name: \"DiffuseMap\" image: \"textures/material" + std::to_string ( aIndex ) + ".png\" }\n"
+                   "pipeline: \"shaders/lit.prg\"\n";
+        }
+    }
+
+    TEST ( PackageFileTest, CompressionRoundTrip )
+    {
+        std::string large;
+        for ( size_t i = 0; large.size() < ( 1 << 20 ); ++i )
+        {
+            large += MakeMaterialText ( i );
+        }
+        for ( uint8_t codec : { ZLIB, ZSTD, LZ4 } )
+        {
+            if ( !IsCompressionSupported ( codec ) )
+            {
+                std::cout << GetCompressionName ( codec ) << " not built in, skipped." << std::endl;
+                continue;
+            }
+            const std::vector<PackedFile> files
+            {
+                { "codec/empty.txt", "", codec },
+                { "codec/small.txt", MakeMaterialText ( 1 ), codec },
+                { "codec/large.txt", large, codec },
+                { "codec/stored.txt", MakeMaterialText ( 2 ), NONE },
+            };
+            WritePackage ( "codec.pkg", files );
+            {
+                Package package ( "codec.pkg" );
+                std::vector<std::string> batch;
+                std::vector<ResourceRead> reads;
+                for ( const PackedFile& file : files )
+                {
+                    ASSERT_EQ ( package.GetFileSize ( file.mPath ), file.mPayload.size() );
+                    std::string contents ( file.mPayload.size(), '\0' );
+                    package.LoadFile ( file.mPath, contents.data(), contents.size() );
+                    EXPECT_EQ ( contents, file.mPayload ) << GetCompressionName ( codec ) << " " << file.mPath;
+                    batch.emplace_back ( file.mPayload.size(), '\0' );
+                }
+                for ( size_t i = 0; i < files.size(); ++i )
+                {
+                    reads.push_back ( ResourceRead{crc32i ( files[i].mPath.data(), files[i].mPath.size() ), batch[i].data(), batch[i].size() } );
+                }
+                package.LoadFiles ( reads );
+                for ( size_t i = 0; i < files.size(); ++i )
+                {
+                    EXPECT_EQ ( batch[i], files[i].mPayload ) << GetCompressionName ( codec ) << " batched " << files[i].mPath;
+                    EXPECT_EQ ( reads[i].mBytesRead, files[i].mPayload.size() );
+                }
+                // A buffer too small for the payload is an error, not a truncated copy.
+                std::string truncated ( large.size() / 2, '\0' );
+                EXPECT_THROW ( package.LoadFile ( "codec/large.txt", truncated.data(), truncated.size() ), std::runtime_error ) << GetCompressionName ( codec );
+            }
+            std::filesystem::remove ( "codec.pkg" );
+        }
+    }
+
+    TEST ( PackageFileTest, ZstdDictionaryRoundTrip )
+    {
+        if ( !IsCompressionSupported ( ZSTD ) )
+        {
+            GTEST_SKIP() << "Built without zstd.";
+        }
+        std::vector<std::string> samples;
+        for ( size_t i = 0; i < 400; ++i )
+        {
+            samples.push_back ( MakeMaterialText ( i ) );
+        }
+        std::vector<std::span<const uint8_t>> views;
+        for ( const std::string& sample : samples )
+        {
+            views.emplace_back ( reinterpret_cast<const uint8_t*> ( sample.data() ), sample.size() );
+        }
+        const std::vector<uint8_t> dictionary = TrainCompressionDictionary ( views, 4096 );
+        ASSERT_FALSE ( dictionary.empty() );
+
+        // Assets the dictionary was not trained on still share its structure.
+        std::vector<PackedFile> files;
+        size_t plain_size = 0;
+        size_t dictionary_size = 0;
+        for ( size_t i = 1000; i < 1020; ++i )
+        {
+            files.push_back ( PackedFile{"materials/material" + std::to_string ( i ) + ".txt", MakeMaterialText ( i ), ZSTD} );
+            const std::span<const uint8_t> payload ( reinterpret_cast<const uint8_t*> ( files.back().mPayload.data() ), files.back().mPayload.size() );
+            std::vector<uint8_t> compressed;
+            ASSERT_TRUE ( CompressBuffer ( ZSTD, payload, 6, compressed ) );
+            plain_size += compressed.size();
+            ASSERT_TRUE ( CompressBuffer ( ZSTD, payload, 6, compressed, dictionary ) );
+            dictionary_size += compressed.size();
+        }
+        EXPECT_LT ( dictionary_size * 2, plain_size );
+
+        WritePackage ( "dictionary.pkg", files, dictionary );
+        {
+            Package package ( "dictionary.pkg" );
+            for ( const PackedFile& file : files )
+            {
+                std::string contents ( file.mPayload.size(), '\0' );
+                package.LoadFile ( file.mPath, contents.data(), contents.size() );
+                EXPECT_EQ ( contents, file.mPayload ) << file.mPath;
+            }
+        }
+        // Frames that name a dictionary cannot be decoded without it.
+        std::vector<uint8_t> frame;
+        const std::span<const uint8_t> payload ( reinterpret_cast<const uint8_t*> ( files[0].mPayload.data() ), files[0].mPayload.size() );
+        ASSERT_TRUE ( CompressBuffer ( ZSTD, payload, 6, frame, dictionary ) );
+        std::string contents ( files[0].mPayload.size(), '\0' );
+        EXPECT_FALSE ( DecompressBuffer ( ZSTD, frame, contents.data(), contents.size() ) );
+        CompressionDictionary digested ( dictionary );
+        EXPECT_TRUE ( DecompressBuffer ( ZSTD, frame, contents.data(), contents.size(), &digested ) );
+        EXPECT_EQ ( contents, files[0].mPayload );
+        std::filesystem::remove ( "dictionary.pkg" );
+    }
+
+    TEST ( ResourceDirectoryTest, OverrideOrderAndUnmountFallback )
+    {
+        WritePackage ( "base.pkg", {{"shared.txt", "BASE", NONE}, {"base.txt", "ONLY BASE", NONE}} );
+        WritePackage ( "dlc.pkg", {{"shared.txt", "DLC", NONE}, {"dlc.txt", "ONLY DLC", NONE}} );
+        WritePackage ( "patch.pkg", {{"shared.txt", "PATCH", NONE}} );
+        const std::vector<std::string> previous = GetResourcePath();
+        auto load = [] ( const std::string & aPath )
+        {
+            std::string contents ( GetResourceSize ( aPath ), '\0' );
+            LoadResource ( aPath, contents.data(), contents.size() );
+            return contents;
+        };
+
+        // Earlier resource path entries win.
+        SetResourcePath ( {"base.pkg", "dlc.pkg"} );
+        EXPECT_EQ ( load ( "shared.txt" ), "BASE" );
+        EXPECT_EQ ( load ( "dlc.txt" ), "ONLY DLC" );
+
+        // Mounts go in front of everything.
+        MountResourcePackage ( "patch.pkg" );
+        EXPECT_EQ ( load ( "shared.txt" ), "PATCH" );
+        EXPECT_EQ ( GetResourcePath().front(), std::filesystem::path ( "patch.pkg" ).string() );
+        std::shared_ptr<const void> owner;
+        const std::span<const uint8_t> view = GetResourceView ( crc32i ( "shared.txt", 10 ), owner );
+        EXPECT_EQ ( view.size(), 5u );
+
+        // Unmounting falls back to the next package holding each id.
+        EXPECT_TRUE ( UnmountResourcePackage ( "patch.pkg" ) );
+        EXPECT_EQ ( load ( "shared.txt" ), "BASE" );
+        // Views held with their owner outlive the unmount.
+        EXPECT_EQ ( std::string ( view.begin(), view.end() ), "PATCH" );
+        owner.reset();
+        EXPECT_TRUE ( UnmountResourcePackage ( "base.pkg" ) );
+        EXPECT_EQ ( load ( "shared.txt" ), "DLC" );
+        EXPECT_EQ ( GetResourceSize ( "base.txt" ), 0u );
+        EXPECT_FALSE ( UnmountResourcePackage ( "base.pkg" ) );
+        EXPECT_EQ ( GetResourcePath().size(), 1u );
+
+        SetResourcePath ( previous );
+        std::filesystem::remove ( "base.pkg" );
+        std::filesystem::remove ( "dlc.pkg" );
+        std::filesystem::remove ( "patch.pkg" );
+    }
+
+    TEST ( ResourceDirectoryTest, ManyIdsSurviveUnmount )
+    {
+        // Enough ids to grow the table several times and cluster probe runs,
+        // the odd package shares every other id with the even one before it.
+        std::vector<std::vector<PackedFile>> contents ( 6 );
+        for ( size_t p = 0; p < contents.size(); ++p )
+        {
+            for ( size_t i = 0; i < 500; ++i )
+            {
+                const size_t id = ( p / 2 ) * 1000 + ( ( p % 2 ) ? i * 2 : i );
+                contents[p].push_back ( PackedFile{"many/" + std::to_string ( id ), std::to_string ( p ), NONE} );
+            }
+            WritePackage ( "many" + std::to_string ( p ) + ".pkg", contents[p] );
+        }
+        ResourceDirectory directory;
+        for ( size_t p = 0; p < contents.size(); ++p )
+        {
+            directory.Mount ( std::make_unique<Package> ( "many" + std::to_string ( p ) + ".pkg" ), false );
+        }
+        auto winner = [&directory] ( const std::string & aPath ) -> std::string
+        {
+            const ResourceDirectory::Location location = directory.Find ( crc32i ( aPath.data(), aPath.size() ) );
+            if ( location.mPackage == nullptr )
+            {
+                return {};
+            }
+            const std::span<const uint8_t> view = location.mPackage->GetEntryView ( location.mEntry );
+            return std::string ( view.begin(), view.end() );
+        };
+        EXPECT_EQ ( directory.GetSize(), 3u * 750u );
+        EXPECT_EQ ( winner ( "many/2" ), "0" );
+        EXPECT_EQ ( winner ( "many/998" ), "1" );
+
+        // Dropping the even packages hands shared ids to the odd ones and
+        // erases the rest, the survivors must still be found.
+        for ( size_t p = 0; p < contents.size(); p += 2 )
+        {
+            EXPECT_TRUE ( directory.Unmount ( "many" + std::to_string ( p ) + ".pkg" ) );
+        }
+        EXPECT_EQ ( directory.GetSize(), 3u * 500u );
+        for ( size_t p = 1; p < contents.size(); p += 2 )
+        {
+            for ( const PackedFile& file : contents[p] )
+            {
+                EXPECT_EQ ( winner ( file.mPath ), file.mPayload ) << file.mPath;
+            }
+        }
+        EXPECT_EQ ( winner ( "many/1" ), "" );
+
+        // Mounted in front again, an even package wins its ids back.
+        directory.Mount ( std::make_unique<Package> ( "many0.pkg" ), true );
+        EXPECT_EQ ( winner ( "many/2" ), "0" );
+        EXPECT_EQ ( directory.GetPackages().front()->GetPath(), std::filesystem::path ( "many0.pkg" ) );
+        directory.Clear();
+        for ( size_t p = 0; p < contents.size(); ++p )
+        {
+            std::filesystem::remove ( "many" + std::to_string ( p ) + ".pkg" );
+        }
+    }
 }
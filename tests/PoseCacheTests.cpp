@@ -0,0 +1,113 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongames/BufferAccessor.hpp"
+#include "aeongames/PoseCache.hpp"
+
+namespace AeonGames
+{
+    namespace
+    {
+        /// What a model component does for one instance, returns whether it sampled.
+        bool LookUp ( PoseCache& aCache, const PoseCacheKey& aKey, PoseCacheEntry*& aEntry )
+        {
+            aEntry = aCache.Find ( aKey );
+            if ( aEntry != nullptr )
+            {
+                return false;
+            }
+            const std::vector<float> matrices ( 16, static_cast<float> ( aKey.mSample ) );
+            aEntry = aCache.Insert ( aKey, matrices );
+            return true;
+        }
+    }
+
+    TEST ( PoseCacheTest, SamplesOncePerUniquePose )
+    {
+        const int skeleton{};
+        const int animation{};
+        PoseCache cache;
+        cache.BeginFrame();
+        // A thousand instances spread over a handful of phases.
+        constexpr size_t kInstances = 1000;
+        constexpr size_t kPhases = 16;
+        std::vector<PoseCacheEntry*> entries ( kInstances );
+        size_t samples = 0;
+        for ( size_t i = 0; i < kInstances; ++i )
+        {
+            const PoseCacheKey key{ &skeleton, &animation, cache.Quantize ( static_cast<double> ( i % kPhases ) + 0.1 ), 0 };
+            samples += LookUp ( cache, key, entries[i] ) ? 1 : 0;
+        }
+        EXPECT_EQ ( samples, kPhases );
+        EXPECT_EQ ( entries[0], entries[kPhases] );
+        EXPECT_NE ( entries[0], entries[1] );
+        EXPECT_FLOAT_EQ ( entries[kPhases + 3]->mMatrices[0], 3.1f );
+        const PoseCacheStatistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.mPoseLookups, kInstances );
+        EXPECT_EQ ( statistics.mPoseHits, kInstances - kPhases );
+
+        // Any other part of the key keeps poses apart.
+        const int other_skeleton{};
+        PoseCacheEntry* entry{};
+        EXPECT_TRUE ( LookUp ( cache, { &other_skeleton, &animation, 0.0, 0 }, entry ) );
+        EXPECT_TRUE ( LookUp ( cache, { &skeleton, &animation, 0.0, 1 }, entry ) );
+
+        cache.BeginFrame();
+        EXPECT_EQ ( cache.GetStatistics().mPoseLookups, 0u );
+        EXPECT_TRUE ( LookUp ( cache, { &skeleton, &animation, 0.0, 0 }, entry ) );
+    }
+
+    TEST ( PoseCacheTest, QuantizesSamples )
+    {
+        PoseCache cache;
+        // Sharing is exact unless quantization is asked for.
+        EXPECT_DOUBLE_EQ ( cache.GetQuantum(), 0.0 );
+        EXPECT_DOUBLE_EQ ( cache.Quantize ( 3.2 ), 3.2 );
+        cache.SetQuantum ( 0.5 );
+        EXPECT_DOUBLE_EQ ( cache.Quantize ( 3.2 ), 3.0 );
+        EXPECT_DOUBLE_EQ ( cache.Quantize ( 3.7 ), 3.5 );
+        cache.SetQuantum ( 0.0 );
+        EXPECT_DOUBLE_EQ ( cache.Quantize ( 3.2 ), 3.2 );
+    }
+
+    TEST ( PoseCacheTest, SharesSkinnedVerticesPerModelAndWindow )
+    {
+        const int skeleton{};
+        const int model{};
+        const int other_model{};
+        int window{};
+        PoseCache cache;
+        cache.BeginFrame();
+        PoseCacheEntry* entry{};
+        LookUp ( cache, { &skeleton, nullptr, 0.0, 0 }, entry );
+        EXPECT_TRUE ( cache.FindSkin ( *entry, &model, &window ).empty() );
+
+        const std::vector<BufferAccessor> skinned ( 2 );
+        cache.InsertSkin ( *entry, &model, &window, skinned );
+        EXPECT_EQ ( cache.FindSkin ( *entry, &model, &window ).size(), 2u );
+        EXPECT_TRUE ( cache.FindSkin ( *entry, &other_model, &window ).empty() );
+        EXPECT_TRUE ( cache.FindSkin ( *entry, &model, nullptr ).empty() );
+        const PoseCacheStatistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.mSkinLookups, 4u );
+        EXPECT_EQ ( statistics.mSkinHits, 1u );
+
+        cache.SetSkinSharing ( false );
+        EXPECT_TRUE ( cache.FindSkin ( *entry, &model, &window ).empty() );
+    }
+}
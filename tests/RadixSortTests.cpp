@@ -0,0 +1,84 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "aeongames/RadixSort.hpp"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+
+namespace AeonGames
+{
+    // Keys drawn from a small alphabet under a mask, so many compare equal and
+    // the bytes outside the mask are constant (exercising the skipped passes).
+    static std::vector<SortKey> MakeKeys ( size_t aCount, uint64_t aMask )
+    {
+        std::vector<SortKey> keys;
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        for ( size_t i = 0; i < aCount; ++i )
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            keys.push_back ( SortKey{ ( state % 97u ) * 0x0101010101010101ull & aMask, static_cast<uint32_t> ( i ) } );
+        }
+        return keys;
+    }
+
+    static void ExpectMatchesStableSort ( std::vector<SortKey> aKeys )
+    {
+        std::vector<SortKey> expected = aKeys;
+        std::stable_sort ( expected.begin(), expected.end(), [] ( const SortKey & aLhs, const SortKey & aRhs )
+        {
+            return aLhs.mKey < aRhs.mKey;
+        } );
+        std::vector<SortKey> scratch;
+        RadixSort ( aKeys, scratch );
+        ASSERT_EQ ( aKeys.size(), expected.size() );
+        for ( size_t i = 0; i < aKeys.size(); ++i )
+        {
+            EXPECT_EQ ( aKeys[i].mKey, expected[i].mKey );
+            EXPECT_EQ ( aKeys[i].mIndex, expected[i].mIndex );
+        }
+    }
+
+    TEST ( RadixSortTest, EmptyAndSingleKey )
+    {
+        ExpectMatchesStableSort ( {} );
+        ExpectMatchesStableSort ( { SortKey{ 42, 0 } } );
+    }
+
+    TEST ( RadixSortTest, SmallInputsAreStable )
+    {
+        ExpectMatchesStableSort ( MakeKeys ( 50, ~0ull ) );
+    }
+
+    TEST ( RadixSortTest, LargeInputsAreStable )
+    {
+        ExpectMatchesStableSort ( MakeKeys ( 5000, ~0ull ) );
+    }
+
+    TEST ( RadixSortTest, OddAndEvenPassCounts )
+    {
+        // One and two varying bytes leave the result in opposite buffers.
+        ExpectMatchesStableSort ( MakeKeys ( 1000, 0x0000ff0000000000ull ) );
+        ExpectMatchesStableSort ( MakeKeys ( 1000, 0xff000000000000ffull ) );
+        // All keys equal: every pass is skipped and the order is unchanged.
+        ExpectMatchesStableSort ( MakeKeys ( 1000, 0 ) );
+    }
+}
@@ -1,5 +1,5 @@
 /*
-Copyright (C) 2018,2025 Rodrigo Jose Hernandez Cordoba
+Copyright (C) 2018,2025,2026 Rodrigo Jose Hernandez Cordoba
 
 Licensed under the Apache License, Version 2.0 (the "License");
 you may not use this file except in compliance with the License.
@@ -14,11 +14,26 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
 #include <iostream>
+#include <atomic>
 #include <cstdint>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "aeongames/CRC.hpp"
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Mesh.hpp"
+#include "aeongames/Renderer.hpp"
+#include "aeongames/Texture.hpp"
+#include "aeongames/BufferAccessor.hpp"
 #include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceFactory.hpp"
+#include "aeongames/ResourceId.hpp"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -28,4 +43,382 @@ namespace AeonGames
     TEST ( ResourceCache, HappyPath )
     {
     }
+
+    namespace
+    {
+        struct CachedBlob
+        {
+            explicit CachedBlob ( size_t aSize ) : mSize{aSize} {}
+            size_t mSize;
+        };
+
+        /** Registers a measured "CacheTest" type and leaves the cache
+            unbudgeted and free of test resources afterwards. */
+        class ResourceCacheBudgetTest : public Test
+        {
+        protected:
+            void SetUp() override
+            {
+                RegisterResourceConstructor ( mType, [] ( uint32_t )
+                {
+                    return UniqueAnyPtr{std::make_unique<CachedBlob> ( 100 ) };
+                }, nullptr, [] ( const UniqueAnyPtr & aResource )
+                {
+                    return aResource.Get<CachedBlob>()->mSize;
+                } );
+                ResetResourceCacheStatistics();
+            }
+            void TearDown() override
+            {
+                SetResourceBudget ( 0 );
+                for ( const char* path : { "a", "b", "c", "unmeasured" } )
+                {
+                    DisposeResource ( Id ( path ).GetPath() );
+                }
+                UnregisterResourceConstructor ( mType );
+            }
+            ResourceId Id ( const std::string& aPath ) const
+            {
+                return ResourceId{mType, aPath};
+            }
+            size_t GetTypeBytes() const
+            {
+                const ResourceCacheStatistics statistics = GetResourceCacheStatistics();
+                auto bytes = statistics.mBytesByType.find ( mType );
+                return ( bytes != statistics.mBytesByType.end() ) ? bytes->second : 0;
+            }
+            const uint32_t mType{crc32i ( "CacheTest", 9 ) };
+        };
+    }
+
+    TEST_F ( ResourceCacheBudgetTest, CountsHitsAndMisses )
+    {
+        const ResourceId a = Id ( "a" );
+        EXPECT_EQ ( a.Cast<CachedBlob>(), nullptr );
+        ASSERT_NE ( a.Get<CachedBlob>(), nullptr );
+        EXPECT_EQ ( a.Get<CachedBlob>()->mSize, 100u );
+        const ResourceCacheStatistics statistics = GetResourceCacheStatistics();
+        // Cast misses, Get misses then hits its own store, the last Get hits.
+        EXPECT_EQ ( statistics.mMisses, 2u );
+        EXPECT_EQ ( statistics.mHits, 1u );
+        EXPECT_EQ ( GetTypeBytes(), 100u );
+    }
+
+    TEST_F ( ResourceCacheBudgetTest, EvictsLeastRecentlyUsedFirst )
+    {
+        for ( const char* path : { "a", "b", "c" } )
+        {
+            Id ( path ).Store();
+        }
+        EXPECT_EQ ( GetTypeBytes(), 300u );
+        // Unlimited by default.
+        EXPECT_EQ ( TrimResources(), 0u );
+        // "a" is the oldest store but the most recent use.
+        EXPECT_NE ( Id ( "a" ).Cast<CachedBlob>(), nullptr );
+        SetResourceBudget ( 250 );
+        EXPECT_EQ ( TrimResources(), 1u );
+        EXPECT_EQ ( GetResource ( Id ( "b" ).GetPath() ).GetRaw(), nullptr );
+        EXPECT_NE ( GetResource ( Id ( "a" ).GetPath() ).GetRaw(), nullptr );
+        EXPECT_NE ( GetResource ( Id ( "c" ).GetPath() ).GetRaw(), nullptr );
+        EXPECT_EQ ( GetTypeBytes(), 200u );
+        EXPECT_EQ ( GetResourceCacheStatistics().mEvictions, 1u );
+        // Within budget, nothing else goes.
+        EXPECT_EQ ( TrimResources(), 0u );
+        // Evicted resources are constructed again on demand.
+        EXPECT_NE ( Id ( "b" ).Get<CachedBlob>(), nullptr );
+    }
+
+    TEST_F ( ResourceCacheBudgetTest, KeepsReferencedAndUnmeasuredResources )
+    {
+        const ResourceId a = Id ( "a" );
+        const ResourceId b = Id ( "b" );
+        a.Store();
+        b.Store();
+        StoreResource ( Id ( "unmeasured" ).GetPath(), std::make_unique<CachedBlob> ( 100 ) );
+        b.Acquire();
+        b.Acquire();
+        EXPECT_EQ ( GetResourceReferenceCount ( b.GetPath() ), 2u );
+        SetResourceBudget ( 1 );
+        EXPECT_EQ ( TrimResources(), 1u );
+        EXPECT_EQ ( GetResource ( a.GetPath() ).GetRaw(), nullptr );
+        EXPECT_NE ( GetResource ( b.GetPath() ).GetRaw(), nullptr );
+        EXPECT_NE ( GetResource ( Id ( "unmeasured" ).GetPath() ).GetRaw(), nullptr );
+        b.Release();
+        EXPECT_EQ ( TrimResources(), 0u );
+        b.Release();
+        EXPECT_EQ ( GetResourceReferenceCount ( b.GetPath() ), 0u );
+        EXPECT_EQ ( TrimResources(), 1u );
+        EXPECT_EQ ( GetResource ( b.GetPath() ).GetRaw(), nullptr );
+        EXPECT_EQ ( GetTypeBytes(), 0u );
+    }
+
+    TEST_F ( ResourceCacheBudgetTest, NotifiesListenersBeforeDestroying )
+    {
+        std::vector<std::pair<uint32_t, size_t >> evicted;
+        const size_t listener = AddResourceEvictionListener ( [&evicted] ( uint32_t aKey, const UniqueAnyPtr & aResource )
+        {
+            evicted.emplace_back ( aKey, aResource.Get<CachedBlob>()->mSize );
+        } );
+        Id ( "a" ).Store();
+        SetResourceBudget ( 1 );
+        EXPECT_EQ ( TrimResources(), 1u );
+        ASSERT_EQ ( evicted.size(), 1u );
+        EXPECT_EQ ( evicted[0].first, Id ( "a" ).GetPath() );
+        EXPECT_EQ ( evicted[0].second, 100u );
+        RemoveResourceEvictionListener ( listener );
+        Id ( "a" ).Store();
+        EXPECT_EQ ( TrimResources(), 1u );
+        EXPECT_EQ ( evicted.size(), 1u );
+    }
+
+    namespace
+    {
+        /** Records what the cache asks it to unload, draws nothing. */
+        class UnloadRecordingRenderer final : public Renderer
+        {
+        public:
+            void LoadMesh ( const Mesh& aMesh ) final
+            {
+                mMeshes.push_back ( aMesh.GetConsecutiveId() );
+            }
+            void UnloadMesh ( const Mesh& aMesh ) final
+            {
+                mMeshes.erase ( std::remove ( mMeshes.begin(), mMeshes.end(), aMesh.GetConsecutiveId() ), mMeshes.end() );
+            }
+            void LoadPipeline ( const Pipeline& ) final {}
+            void UnloadPipeline ( const Pipeline& ) final {}
+            void LoadMaterial ( const Material& ) final {}
+            void UnloadMaterial ( const Material& ) final {}
+            void LoadTexture ( const Texture& aTexture ) final
+            {
+                mTextures.push_back ( aTexture.GetConsecutiveId() );
+            }
+            void UnloadTexture ( const Texture& aTexture ) final
+            {
+                mTextures.erase ( std::remove ( mTextures.begin(), mTextures.end(), aTexture.GetConsecutiveId() ), mTextures.end() );
+            }
+            const RendererSettings& GetSettings() const final
+            {
+                return mSettings;
+            }
+            void AttachWindow ( void* ) final {}
+            void DetachWindow ( void* ) final {}
+            void SetProjectionMatrix ( void*, const Matrix4x4& ) final {}
+            void SetViewMatrix ( void*, const Matrix4x4& ) final {}
+            void SetLights ( void*, std::span<const GpuLight> ) final {}
+            void SetClearColor ( void*, float, float, float, float ) final {}
+            void ResizeViewport ( void*, int32_t, int32_t, uint32_t, uint32_t ) final {}
+            void BeginRender ( void*, const Pipeline* ) final {}
+            void BeginFrame ( void* ) final {}
+            void BeginRenderPass ( void* ) final {}
+            void BeginShadowPass ( void*, const Matrix4x4& ) final {}
+            void EndShadowPass ( void* ) final {}
+            void EndDepthPrePass ( void*, const Pipeline* ) final {}
+            void EndRender ( void* ) final {}
+            void Finish ( void* ) final {}
+            void Render ( void*, const Matrix4x4&, const Mesh&, const Pipeline&, const Material*, Topology,
+                          uint32_t, uint32_t, uint32_t, uint32_t, const BufferAccessor*, RenderPass ) const final {}
+            void Dispatch ( void*, const Pipeline&, uint32_t, uint32_t, uint32_t,
+                            std::span<const StorageBufferBinding>, uint32_t ) const final {}
+            void Skin ( void*, const Pipeline&, const Mesh&, const BufferAccessor&, const BufferAccessor& ) const final {}
+            void Barrier ( void* ) const final {}
+            const Frustum& GetFrustum ( void* ) const final
+            {
+                return mFrustum;
+            }
+            const Matrix4x4& GetProjectionMatrix ( void* ) const final
+            {
+                return mMatrix;
+            }
+            const BufferAccessor* GetFrameLightGrid ( void* ) const final
+            {
+                return nullptr;
+            }
+            const BufferAccessor* GetFrameClusterActive ( void* ) const final
+            {
+                return nullptr;
+            }
+            BufferAccessor AllocateSingleFrameUniformMemory ( void*, size_t ) final
+            {
+                return {};
+            }
+            BufferAccessor AllocateSingleFrameStorageMemory ( void*, size_t ) final
+            {
+                return {};
+            }
+            void RenderOverlay ( void*, const GuiOverlay& ) final {}
+            std::string_view GetName() const final
+            {
+                return "UnloadRecording";
+            }
+            void SubmitRenderQueue ( void*, const Scene&, RenderPass ) final {}
+            bool IsValidWindow ( void* ) const final
+            {
+                return false;
+            }
+            std::vector<size_t> mMeshes{};
+            std::vector<size_t> mTextures{};
+        private:
+            RendererSettings mSettings{};
+            Frustum mFrustum{};
+            Matrix4x4 mMatrix{};
+        };
+    }
+
+    TEST_F ( ResourceCacheBudgetTest, UnloadsEvictedResourcesFromRenderers )
+    {
+        const uint32_t mesh_type = crc32i ( "CacheTestMesh", 13 );
+        const uint32_t texture_type = crc32i ( "CacheTestTexture", 16 );
+        RegisterResourceConstructor ( mesh_type, [] ( uint32_t )
+        {
+            return UniqueAnyPtr{std::make_unique<Mesh>() };
+        }, nullptr, [] ( const UniqueAnyPtr& )
+        {
+            return size_t{100};
+        } );
+        RegisterResourceConstructor ( texture_type, [] ( uint32_t )
+        {
+            return UniqueAnyPtr{std::make_unique<Texture>() };
+        }, nullptr, [] ( const UniqueAnyPtr& )
+        {
+            return size_t{100};
+        } );
+        const ResourceId mesh_id{mesh_type, "mesh"};
+        const ResourceId texture_id{texture_type, "texture"};
+        {
+            UnloadRecordingRenderer renderer;
+            renderer.LoadMesh ( *mesh_id.Get<Mesh>() );
+            renderer.LoadTexture ( *texture_id.Get<Texture>() );
+            ASSERT_EQ ( renderer.mMeshes.size(), 1u );
+            ASSERT_EQ ( renderer.mTextures.size(), 1u );
+            SetResourceBudget ( 1 );
+            EXPECT_EQ ( TrimResources(), 2u );
+            EXPECT_TRUE ( renderer.mMeshes.empty() );
+            EXPECT_TRUE ( renderer.mTextures.empty() );
+        }
+        // Destroyed renderers are no longer notified.
+        mesh_id.Store();
+        EXPECT_EQ ( TrimResources(), 1u );
+        UnregisterResourceConstructor ( mesh_type );
+        UnregisterResourceConstructor ( texture_type );
+    }
+
+    namespace
+    {
+        /** Registers a "ConcurrentTest" type whose constructor counts calls
+            per path, yields to widen the race window, loads a shared
+            dependency like a model loads its meshes, and throws for "broken". */
+        class ResourceCacheConcurrencyTest : public Test
+        {
+        protected:
+            static constexpr size_t kIdCount = 24;
+            static constexpr size_t kThreadCount = 8;
+            void SetUp() override
+            {
+                RegisterResourceConstructor ( mType, [this] ( uint32_t aPath )
+                {
+                    return Construct ( aPath );
+                } );
+                for ( size_t i = 0; i < kIdCount; ++i )
+                {
+                    mIds.emplace_back ( mType, "resource" + std::to_string ( i ) );
+                    mIds.emplace_back ( mType, "dependency" + std::to_string ( i % 4 ) );
+                }
+                mIds.emplace_back ( mType, "broken" );
+            }
+            void TearDown() override
+            {
+                for ( const ResourceId& id : mIds )
+                {
+                    DisposeResource ( id.GetPath() );
+                }
+                UnregisterResourceConstructor ( mType );
+            }
+            size_t GetConstructionCount ( const ResourceId& aId )
+            {
+                std::lock_guard<std::mutex> lock ( mMutex );
+                auto i = mConstructions.find ( aId.GetPath() );
+                return ( i != mConstructions.end() ) ? i->second : 0;
+            }
+            const uint32_t mType{crc32i ( "ConcurrentTest", 14 ) };
+            std::vector<ResourceId> mIds{};
+        private:
+            UniqueAnyPtr Construct ( uint32_t aPath )
+            {
+                {
+                    std::lock_guard<std::mutex> lock ( mMutex );
+                    ++mConstructions[aPath];
+                }
+                std::this_thread::yield();
+                const std::string path = GetResourcePath ( aPath );
+                if ( path == "broken" )
+                {
+                    throw std::runtime_error ( "broken on purpose" );
+                }
+                if ( path.rfind ( "resource", 0 ) == 0 )
+                {
+                    const size_t index = std::stoul ( path.substr ( 8 ) );
+                    ResourceId{mType, "dependency" + std::to_string ( index % 4 ) } .Store();
+                }
+                return std::make_unique<CachedBlob> ( path.size() );
+            }
+            std::mutex mMutex{};
+            std::unordered_map<uint32_t, size_t> mConstructions{};
+        };
+    }
+
+    TEST_F ( ResourceCacheConcurrencyTest, ConcurrentGetsConstructOnce )
+    {
+        std::atomic<size_t> failures{0};
+        std::atomic<size_t> mismatches{0};
+        std::vector<std::thread> threads;
+        for ( size_t t = 0; t < kThreadCount; ++t )
+        {
+            threads.emplace_back ( [this, t, &failures, &mismatches]
+            {
+                // Every thread walks the same ids from a different start, so
+                // each id is wanted by several threads at about the same time.
+                for ( size_t i = 0; i < mIds.size(); ++i )
+                {
+                    const ResourceId& id = mIds[ ( i + t * 3 ) % mIds.size()];
+                    try
+                    {
+                        id.Acquire();
+                        CachedBlob* blob = id.Get<CachedBlob>();
+                        if ( !blob || blob->mSize != id.GetPathString().size() )
+                        {
+                            ++mismatches;
+                        }
+                        id.Release();
+                    }
+                    catch ( const std::runtime_error& )
+                    {
+                        id.Release();
+                        ++failures;
+                    }
+                    GetResourceCacheStatistics();
+                }
+            } );
+        }
+        for ( auto& thread : threads )
+        {
+            thread.join();
+        }
+        EXPECT_EQ ( mismatches.load(), 0u );
+        for ( const ResourceId& id : mIds )
+        {
+            const bool broken = id.GetPathString() == "broken";
+            EXPECT_EQ ( GetResource ( id.GetPath() ).GetRaw() == nullptr, broken ) << id.GetPathString();
+            EXPECT_EQ ( GetResourceReferenceCount ( id.GetPath() ), 0u );
+            if ( !broken )
+            {
+                EXPECT_EQ ( GetConstructionCount ( id ), 1u ) << id.GetPathString();
+            }
+        }
+        // Failures are not cached: threads that arrived while it was being
+        // constructed share the exception, later ones try again.
+        EXPECT_EQ ( failures.load(), kThreadCount );
+        EXPECT_GE ( GetConstructionCount ( ResourceId{mType, "broken"} ), 1u );
+        EXPECT_LE ( GetConstructionCount ( ResourceId{mType, "broken"} ), kThreadCount );
+    }
 }
@@ -0,0 +1,222 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "aeongames/CRC.hpp"
+#include "aeongames/ResourceCache.hpp"
+#include "aeongames/ResourceFactory.hpp"
+#include "aeongames/ResourceId.hpp"
+#include "aeongames/ResourceStreamer.hpp"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+namespace AeonGames
+{
+    namespace
+    {
+        struct StreamedValue
+        {
+            explicit StreamedValue ( int aValue ) : mValue{aValue} {}
+            int mValue;
+        };
+
+        constexpr int kPlaceholderValue = -1;
+
+        /** Registers a "StreamTest" resource type whose constructor records
+            the order it was called in and, for the "blocker" path, holds the
+            loader thread until Release is called. */
+        class ResourceStreamerTest : public Test
+        {
+        protected:
+            void SetUp() override
+            {
+                RegisterResourceConstructor ( mType, [this] ( uint32_t aPath )
+                {
+                    return Construct ( aPath );
+                }, std::make_unique<StreamedValue> ( kPlaceholderValue ) );
+            }
+            void TearDown() override
+            {
+                Release();
+                FinalizeResourceStreamer();
+                for ( const char* path : { "blocker", "a", "b", "c", "model", "model/mesh", "broken" } )
+                {
+                    DisposeResource ( Id ( path ).GetPath() );
+                }
+                UnregisterResourceConstructor ( mType );
+            }
+
+            ResourceId Id ( const std::string& aPath ) const
+            {
+                return ResourceId{mType, aPath};
+            }
+
+            void WaitUntilBlocked()
+            {
+                std::unique_lock<std::mutex> lock ( mMutex );
+                mCondition.wait ( lock, [this]
+                {
+                    return mBlocked;
+                } );
+            }
+
+            void Release()
+            {
+                {
+                    std::lock_guard<std::mutex> lock ( mMutex );
+                    mReleased = true;
+                }
+                mCondition.notify_all();
+            }
+
+            std::vector<std::string> GetOrder()
+            {
+                std::lock_guard<std::mutex> lock ( mMutex );
+                return mOrder;
+            }
+
+            const uint32_t mType{crc32i ( "StreamTest", 10 ) };
+        private:
+            UniqueAnyPtr Construct ( uint32_t aPath )
+            {
+                const std::string path = GetResourcePath ( aPath );
+                std::unique_lock<std::mutex> lock ( mMutex );
+                mOrder.push_back ( path );
+                if ( path == "blocker" )
+                {
+                    mBlocked = true;
+                    mCondition.notify_all();
+                    mCondition.wait ( lock, [this]
+                    {
+                        return mReleased;
+                    } );
+                }
+                else if ( path == "broken" )
+                {
+                    throw std::runtime_error ( "broken on purpose" );
+                }
+                else if ( path == "model" )
+                {
+                    // A dependency stored while loading, like a model's meshes.
+                    StoreResource ( Id ( "model/mesh" ).GetPath(), std::make_unique<StreamedValue> ( 7 ) );
+                }
+                return std::make_unique<StreamedValue> ( static_cast<int> ( path.size() ) );
+            }
+            std::mutex mMutex{};
+            std::condition_variable mCondition{};
+            bool mBlocked{false};
+            bool mReleased{false};
+            std::vector<std::string> mOrder{};
+        };
+    }
+
+    TEST_F ( ResourceStreamerTest, FrameNeverBlocksOnMissingResource )
+    {
+        InitializeResourceStreamer ( 1 );
+        const ResourceId blocker = Id ( "blocker" );
+        // The loader is stuck inside the constructor for as long as the test
+        // wants; every simulated frame must still get its placeholder back.
+        ASSERT_EQ ( blocker.GetAsync<StreamedValue>()->mValue, kPlaceholderValue );
+        WaitUntilBlocked();
+        for ( int frame = 0; frame < 3; ++frame )
+        {
+            EXPECT_EQ ( CommitStreamedResources(), 0u );
+            StreamedValue* value = blocker.GetAsync<StreamedValue>();
+            ASSERT_NE ( value, nullptr );
+            EXPECT_EQ ( value->mValue, kPlaceholderValue );
+        }
+        Release();
+        GetResourceStreamer().WaitIdle();
+        // Loaded but not yet published: the current frame still sees the placeholder.
+        EXPECT_EQ ( blocker.GetAsync<StreamedValue>()->mValue, kPlaceholderValue );
+        EXPECT_EQ ( CommitStreamedResources(), 1u );
+        EXPECT_EQ ( blocker.GetAsync<StreamedValue>()->mValue, 7 );
+        EXPECT_EQ ( GetOrder().size(), 1u );
+    }
+
+    TEST_F ( ResourceStreamerTest, HigherPrioritiesLoadFirst )
+    {
+        ResourceStreamer streamer{1};
+        streamer.Enqueue ( Id ( "blocker" ), ResourcePriority::Visible );
+        WaitUntilBlocked();
+        const ResourceStreamer::RequestHandle a = streamer.Enqueue ( Id ( "a" ), ResourcePriority::Prefetch );
+        streamer.Enqueue ( Id ( "b" ), ResourcePriority::Nearby );
+        streamer.Enqueue ( Id ( "c" ), ResourcePriority::Visible );
+        // Asking again deduplicates and promotes the prefetch.
+        EXPECT_EQ ( streamer.Enqueue ( Id ( "a" ), ResourcePriority::Visible ), a );
+        EXPECT_EQ ( streamer.GetPendingCount(), 4u );
+        Release();
+        streamer.WaitIdle();
+        EXPECT_EQ ( GetOrder(), ( std::vector<std::string> { "blocker", "c", "a", "b" } ) );
+        EXPECT_EQ ( streamer.GetStatus ( a ), ResourceStreamer::Status::Loaded );
+        EXPECT_EQ ( streamer.Commit(), 4u );
+        EXPECT_EQ ( streamer.GetStatus ( a ), ResourceStreamer::Status::Committed );
+        // Already cached resources are not loaded again.
+        EXPECT_EQ ( streamer.GetStatus ( streamer.Enqueue ( Id ( "a" ), ResourcePriority::Visible ) ), ResourceStreamer::Status::Committed );
+        EXPECT_EQ ( streamer.GetPendingCount(), 0u );
+    }
+
+    TEST_F ( ResourceStreamerTest, CancelledRequestsAreNeverLoaded )
+    {
+        ResourceStreamer streamer{1};
+        const ResourceStreamer::RequestHandle blocker = streamer.Enqueue ( Id ( "blocker" ), ResourcePriority::Visible );
+        WaitUntilBlocked();
+        const ResourceStreamer::RequestHandle a = streamer.Enqueue ( Id ( "a" ), ResourcePriority::Visible );
+        EXPECT_TRUE ( streamer.Cancel ( a ) );
+        EXPECT_FALSE ( streamer.Cancel ( a ) );
+        // Cancelling mid load lets the constructor finish but drops the result.
+        EXPECT_TRUE ( streamer.Cancel ( blocker ) );
+        Release();
+        streamer.WaitIdle();
+        EXPECT_EQ ( streamer.Commit(), 0u );
+        EXPECT_EQ ( streamer.GetStatus ( a ), ResourceStreamer::Status::Cancelled );
+        EXPECT_EQ ( streamer.GetStatus ( blocker ), ResourceStreamer::Status::Cancelled );
+        EXPECT_EQ ( GetOrder(), ( std::vector<std::string> { "blocker" } ) );
+        EXPECT_EQ ( GetResource ( Id ( "blocker" ).GetPath() ).GetRaw(), nullptr );
+    }
+
+    TEST_F ( ResourceStreamerTest, DependenciesAppearWithTheirResource )
+    {
+        ResourceStreamer streamer{1};
+        streamer.Enqueue ( Id ( "model" ), ResourcePriority::Visible );
+        streamer.WaitIdle();
+        EXPECT_EQ ( GetResource ( Id ( "model" ).GetPath() ).GetRaw(), nullptr );
+        EXPECT_EQ ( GetResource ( Id ( "model/mesh" ).GetPath() ).GetRaw(), nullptr );
+        EXPECT_EQ ( streamer.Commit(), 1u );
+        EXPECT_EQ ( GetResource ( Id ( "model" ).GetPath() ).Get<StreamedValue>()->mValue, 5 );
+        EXPECT_EQ ( GetResource ( Id ( "model/mesh" ).GetPath() ).Get<StreamedValue>()->mValue, 7 );
+    }
+
+    TEST_F ( ResourceStreamerTest, FailuresKeepThePlaceholder )
+    {
+        ResourceStreamer streamer{1};
+        const ResourceStreamer::RequestHandle broken = streamer.Enqueue ( Id ( "broken" ), ResourcePriority::Visible );
+        streamer.WaitIdle();
+        EXPECT_EQ ( streamer.GetStatus ( broken ), ResourceStreamer::Status::Failed );
+        EXPECT_NE ( streamer.GetError ( broken ).find ( "broken on purpose" ), std::string::npos );
+        EXPECT_EQ ( streamer.Commit(), 0u );
+        EXPECT_EQ ( GetResource ( Id ( "broken" ) ).Get<StreamedValue>()->mValue, kPlaceholderValue );
+        // A failed request can be retried once it has been reported.
+        EXPECT_NE ( streamer.Enqueue ( Id ( "broken" ), ResourcePriority::Visible ), broken );
+        streamer.WaitIdle();
+    }
+}
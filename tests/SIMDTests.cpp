@@ -0,0 +1,269 @@
+/*
+Copyright (C) 2026 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include "aeongames/Frustum.hpp"
+#include "aeongames/Plane.hpp"
+#include "aeongames/AABB.hpp"
+#include "aeongames/Matrix4x4.hpp"
+#include "aeongames/Transform.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/Vector3.hpp"
+#include "../engine/math/SIMD.h"
+#include "gtest/gtest.h"
+
+using namespace ::testing;
+
+// The kernels repeat the scalar operations in the same order, so results
+// are compared bit for bit rather than within a tolerance.
+namespace AeonGames
+{
+    namespace
+    {
+        constexpr int kSimdSamples = 20000;
+
+        /// Deterministic floats in [-aRange, aRange), with exact zeros of
+        /// both signs mixed in to exercise the sign dependent selects.
+        class SampleSource
+        {
+        public:
+            float Next ( float aRange )
+            {
+                mState = mState * 1664525u + 1013904223u;
+                switch ( mState >> 29 )
+                {
+                case 0:
+                    return 0.0f;
+                case 1:
+                    return -0.0f;
+                default:
+                    return ( static_cast<float> ( mState & 0xffffffu ) / static_cast<float> ( 1u << 24 ) * 2.0f - 1.0f ) * aRange;
+                }
+            }
+            void Fill ( float* aValues, size_t aCount, float aRange )
+            {
+                for ( size_t i = 0; i < aCount; ++i )
+                {
+                    aValues[i] = Next ( aRange );
+                }
+            }
+        private:
+            uint32_t mState{ 2463534242u };
+        };
+
+        template<size_t N>
+        bool SameBits ( const float ( &aLhs ) [N], const float ( &aRhs ) [N] )
+        {
+            return memcmp ( aLhs, aRhs, sizeof ( aLhs ) ) == 0;
+        }
+    }
+
+    TEST ( SIMDTest, ReportsItsInstructionSet )
+    {
+        EXPECT_NE ( GetSimdInstructionSet(), nullptr );
+        RecordProperty ( "instruction_set", GetSimdInstructionSet() );
+    }
+
+    TEST ( SIMDTest, Multiply4x4MatrixMatchesScalar )
+    {
+        SampleSource source;
+        for ( int i = 0; i < kSimdSamples; ++i )
+        {
+            float a[16];
+            float b[16];
+            source.Fill ( a, 16, 100.0f );
+            source.Fill ( b, 16, 100.0f );
+            float scalar[16];
+            float simd[16];
+            Multiply4x4Matrix ( a, b, scalar );
+            SimdMultiply4x4Matrix ( a, b, simd );
+            ASSERT_TRUE ( SameBits ( scalar, simd ) ) << "sample " << i;
+            // The output may alias either input.
+            SimdMultiply4x4Matrix ( a, b, a );
+            ASSERT_TRUE ( SameBits ( scalar, a ) ) << "sample " << i;
+        }
+    }
+
+    TEST ( SIMDTest, MultQuatsMatchesScalar )
+    {
+        SampleSource source;
+        for ( int i = 0; i < kSimdSamples; ++i )
+        {
+            float q1[4];
+            float q2[4];
+            source.Fill ( q1, 4, 2.0f );
+            source.Fill ( q2, 4, 2.0f );
+            float scalar[4];
+            float simd[4];
+            MultQuats ( q1, q2, scalar );
+            SimdMultQuats ( q1, q2, simd );
+            ASSERT_TRUE ( SameBits ( scalar, simd ) ) << "sample " << i;
+            SimdMultQuats ( q1, q2, q2 );
+            ASSERT_TRUE ( SameBits ( scalar, q2 ) ) << "sample " << i;
+        }
+    }
+
+    TEST ( SIMDTest, TransformBoxMatchesScalar )
+    {
+        SampleSource source;
+        for ( int i = 0; i < kSimdSamples; ++i )
+        {
+            float matrix[9];
+            float translation[3];
+            float center[3];
+            float radii[3];
+            source.Fill ( matrix, 9, 4.0f );
+            source.Fill ( translation, 3, 1000.0f );
+            source.Fill ( center, 3, 100.0f );
+            source.Fill ( radii, 3, 50.0f );
+            float scalar_center[3];
+            float scalar_radii[3];
+            float simd_center[3];
+            float simd_radii[3];
+            TransformBox ( matrix, translation, center, radii, scalar_center, scalar_radii );
+            SimdTransformBox ( matrix, translation, center, radii, simd_center, simd_radii );
+            ASSERT_TRUE ( SameBits ( scalar_center, simd_center ) ) << "sample " << i;
+            ASSERT_TRUE ( SameBits ( scalar_radii, simd_radii ) ) << "sample " << i;
+        }
+    }
+
+    TEST ( SIMDTest, PlanesIntersectBoxMatchesScalar )
+    {
+        SampleSource source;
+        size_t inside = 0;
+        for ( int i = 0; i < kSimdSamples; ++i )
+        {
+            // Walk every plane count the lanes can hold, padding included.
+            const size_t count = 1 + static_cast<size_t> ( i ) % kSimdPlaneLanes;
+            float planes[kSimdPlaneLanes * 4];
+            float lanes[kSimdPlaneLanes * 4];
+            source.Fill ( planes, count * 4, 1.0f );
+            for ( size_t plane = 0; plane < count; ++plane )
+            {
+                planes[plane * 4 + 3] *= 20.0f;
+            }
+            PackPlaneLanes ( planes, count, lanes );
+            float center[3];
+            float radii[3];
+            source.Fill ( center, 3, 20.0f );
+            source.Fill ( radii, 3, 5.0f );
+            const bool scalar = PlanesIntersectBox ( planes, count, center, radii );
+            ASSERT_EQ ( SimdPlanesIntersectBox ( lanes, center, radii ), scalar ) << "sample " << i;
+            inside += scalar ? 1 : 0;
+        }
+        // Both outcomes must be well represented for the comparison to mean anything.
+        EXPECT_GT ( inside, static_cast<size_t> ( kSimdSamples / 10 ) );
+        EXPECT_LT ( inside, static_cast<size_t> ( kSimdSamples - kSimdSamples / 10 ) );
+    }
+
+    TEST ( SIMDTest, FrustumMatchesPerPlaneDistances )
+    {
+        Matrix4x4 projection {};
+        projection.Perspective ( 60.0f, 4.0f / 3.0f, 1.0f, 100.0f );
+        const Frustum frustum { projection };
+        // The planes of the same matrix, extracted the way Frustum does it.
+        const float* m = projection.GetMatrix4x4();
+        const Plane planes[6]
+        {
+            Plane { - ( m[3] + m[0] ), - ( m[7] + m[4] ), - ( m[11] + m[8] ), ( m[15] + m[12] ) },
+            Plane { - ( m[3] - m[0] ), - ( m[7] - m[4] ), - ( m[11] - m[8] ), ( m[15] - m[12] ) },
+            Plane { - ( m[3] + m[1] ), - ( m[7] + m[5] ), - ( m[11] + m[9] ), ( m[15] + m[13] ) },
+            Plane { - ( m[3] - m[1] ), - ( m[7] - m[5] ), - ( m[11] - m[9] ), ( m[15] - m[13] ) },
+            Plane { - ( m[3] + m[2] ), - ( m[7] + m[6] ), - ( m[11] + m[10] ), ( m[15] + m[14] ) },
+            Plane { - ( m[3] - m[2] ), - ( m[7] - m[6] ), - ( m[11] - m[10] ), ( m[15] - m[14] ) }
+        };
+        SampleSource source;
+        for ( int i = 0; i < kSimdSamples; ++i )
+        {
+            const AABB box
+            {
+                Vector3 { source.Next ( 150.0f ), source.Next ( 150.0f ), source.Next ( 150.0f ) },
+                Vector3 { source.Next ( 10.0f ) + 10.0f, source.Next ( 10.0f ) + 10.0f, source.Next ( 10.0f ) + 10.0f }
+            };
+            bool expected = true;
+            for ( const Plane& plane : planes )
+            {
+                expected = expected && box.GetDistanceToPlane ( plane ) <= 0.0f;
+            }
+            ASSERT_EQ ( frustum.Intersects ( box ), expected ) << "sample " << i;
+        }
+    }
+
+    TEST ( SIMDTest, InterpolatePoseMatchesScalar )
+    {
+        // Rows padded past the lane count, as Animation pads its frames.
+        constexpr size_t kStride = kSimdPoseLanes + 3;
+        SampleSource source;
+        for ( int i = 0; i < kSimdSamples / 100; ++i )
+        {
+            float frames[4][10 * kStride];
+            for ( auto& frame : frames )
+            {
+                source.Fill ( frame, 10 * kStride, 4.0f );
+            }
+            // A zero length rotation is left as it is.
+            for ( size_t component = 3; component < 7; ++component )
+            {
+                frames[1][component * kStride + 5] = 0.0f;
+            }
+            const float* const rows[4] { frames[0], frames[1], frames[2], frames[3] };
+            const double interpolation = ( i % 10 ) == 0 ? 0.0 : ( source.Next ( 0.5f ) + 0.5f );
+            float pose[10 * kSimdPoseLanes];
+            SimdInterpolatePose ( rows, kStride, interpolation, pose );
+            for ( size_t lane = 0; lane < kSimdPoseLanes; ++lane )
+            {
+                float bones[4][10];
+                for ( size_t frame = 0; frame < 4; ++frame )
+                {
+                    for ( size_t component = 0; component < 10; ++component )
+                    {
+                        bones[frame][component] = frames[frame][component * kStride + lane];
+                    }
+                }
+                const Transform transform = Interpolate ( Transform { bones[0] }, Transform { bones[1] }, Transform { bones[2] }, Transform { bones[3] }, interpolation );
+                float expected[10];
+                float actual[10];
+                for ( size_t component = 0; component < 3; ++component )
+                {
+                    expected[component] = transform.GetScale() [component];
+                    expected[7 + component] = transform.GetTranslation() [component];
+                }
+                for ( size_t component = 0; component < 4; ++component )
+                {
+                    expected[3 + component] = transform.GetRotation() [component];
+                }
+                for ( size_t component = 0; component < 10; ++component )
+                {
+                    actual[component] = pose[component * kSimdPoseLanes + lane];
+                }
+                ASSERT_TRUE ( SameBits ( expected, actual ) ) << "sample " << i << " lane " << lane;
+            }
+        }
+    }
+
+    TEST ( SIMDTest, TransformCompositionMatchesMatrixProduct )
+    {
+        const Transform parent { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion { 0.9238795f, 0.0f, 0.3826834f, 0.0f }, Vector3 { 10.0f, 0.0f, -4.0f } };
+        const Transform child { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion { 0.7071068f, 0.7071068f, 0.0f, 0.0f }, Vector3 { 0.0f, 3.0f, 0.0f } };
+        const Matrix4x4 composed = ( parent * child ).GetMatrix();
+        const Matrix4x4 product = parent.GetMatrix() * child.GetMatrix();
+        for ( size_t i = 0; i < 16; ++i )
+        {
+            EXPECT_NEAR ( composed[i], product[i], 1e-4f ) << "element " << i;
+        }
+    }
+}
@@ -13,10 +13,14 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <algorithm>
 #include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 #include "aeongames/CRC.hpp"
@@ -28,6 +32,20 @@ limitations under the License.
 #include "aeongames/Matrix4x4.hpp"
 #include "aeongames/Vector3.hpp"
 #include "aeongames/Transform.hpp"
+#include "aeongames/Quaternion.hpp"
+#include "aeongames/GpuLight.hpp"
+#include "aeongames/JobSystem.hpp"
+#include "aeongames/AllocationCounter.hpp"
+#include "aeongames/Animation.hpp"
+#include "aeongames/Model.hpp"
+#include "aeongames/PoseCache.hpp"
+#include "aeongames/ProtoBufClasses.hpp"
+#include "aeongames/ResourceCache.hpp"
+#include "aeongames/Skeleton.hpp"
+#include "animation.pb.h"
+#include "model.pb.h"
+#include "skeleton.pb.h"
+#include "ModelComponent.h"
 
 using namespace ::testing;
 namespace AeonGames
@@ -350,6 +368,33 @@ namespace AeonGames
         scene.Deserialize ( serialized );
         EXPECT_EQ ( scene.Serialize(), serialized );
     }
+    TEST_F ( SceneTest, DeserializeConcurrently )
+    {
+        // Each call decodes into its own message, scenes load side by side.
+        const std::string serialized = mScene.Serialize ();
+        std::vector<std::string> results ( 4 );
+        std::vector<std::thread> threads;
+        for ( std::string& result : results )
+        {
+            threads.emplace_back ( [&serialized, &result]
+            {
+                for ( size_t i = 0; i < 16; ++i )
+                {
+                    Scene scene;
+                    scene.Deserialize ( serialized );
+                    result = scene.Serialize();
+                }
+            } );
+        }
+        for ( std::thread& thread : threads )
+        {
+            thread.join();
+        }
+        for ( const std::string& result : results )
+        {
+            EXPECT_EQ ( result, serialized );
+        }
+    }
 
     /** What the Blender scene exporter emits for an empty parented to a mesh:
         a marker node nested under its parent, addressable by name. */
@@ -540,6 +585,73 @@ namespace AeonGames
         EXPECT_EQ ( CullVisibleSet ( scene, frustum ), BruteForceVisible ( scene, frustum ) );
     }
 
+    TEST ( SceneCullVisible, IncrementalUpdatesMatchBruteForce )
+    {
+        Scene scene;
+        std::vector<Node*> nodes;
+        for ( int i = 0; i < 64; ++i )
+        {
+            nodes.push_back ( AddPositioned ( scene, Vector3 { static_cast<float> ( ( i % 8 ) * 6 - 24 ), 50.0f, static_cast<float> ( ( i / 8 ) * 6 - 24 ) } ) );
+        }
+        // Two far corners pin the root bounds so the moves below stay inside.
+        AddPositioned ( scene, Vector3 { -200.0f, -200.0f, -200.0f } );
+        AddPositioned ( scene, Vector3 { 200.0f, 200.0f, 200.0f } );
+        const Frustum frustum = MakeCullFrustum();
+        ASSERT_EQ ( CullVisibleSet ( scene, frustum ), BruteForceVisible ( scene, frustum ) );
+        for ( int frame = 1; frame <= 8; ++frame )
+        {
+            // A handful of movers per frame stays under the churn threshold.
+            for ( int i = frame; i < 64; i += 16 )
+            {
+                const float offset = static_cast<float> ( frame * 7 );
+                nodes[i]->SetGlobalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {},
+                                                           Vector3 { offset - 30.0f, 50.0f - offset, offset * 0.5f } } );
+            }
+            EXPECT_EQ ( CullVisibleSet ( scene, frustum ), BruteForceVisible ( scene, frustum ) );
+        }
+    }
+
+    TEST ( SceneCullVisible, NodeLeavingRootBoundsIsStillFound )
+    {
+        Scene scene;
+        AddPositioned ( scene, Vector3 { 0.0f, 50.0f, 0.0f } );
+        Node* mover = AddPositioned ( scene, Vector3 { 0.0f, 60.0f, 0.0f } );
+        const Frustum frustum = MakeCullFrustum();
+        ASSERT_EQ ( CullVisibleSet ( scene, frustum ).size(), 2u );
+        // Far outside the original root bounds but still inside the frustum.
+        mover->SetGlobalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { 20.0f, 90.0f, 0.0f } } );
+        EXPECT_EQ ( CullVisibleSet ( scene, frustum ), BruteForceVisible ( scene, frustum ) );
+        EXPECT_EQ ( CullVisibleSet ( scene, frustum ).size(), 2u );
+    }
+
+    TEST ( SceneCullVisible, DetachedChildLeavesIndex )
+    {
+        Scene scene;
+        Node* parent = AddPositioned ( scene, Vector3 { 0.0f, 50.0f, 0.0f } );
+        Node* child = parent->Add ( std::make_unique<Node>() );
+        child->SetAABB ( AABB { Vector3 {}, Vector3 { 1.0f, 1.0f, 1.0f } } );
+        const Frustum frustum = MakeCullFrustum();
+        ASSERT_EQ ( CullVisibleSet ( scene, frustum ).size(), 2u );
+        std::unique_ptr<Node> detached = parent->Remove ( child );
+        ASSERT_EQ ( detached.get(), child );
+        const std::vector<const Node*> visible = CullVisibleSet ( scene, frustum );
+        ASSERT_EQ ( visible.size(), 1u );
+        EXPECT_EQ ( visible.front(), parent );
+    }
+
+    TEST ( SceneCullVisible, ZeroThresholdAlwaysRebuilds )
+    {
+        Scene scene;
+        scene.SetSpatialIndexRebuildThreshold ( 0.0f );
+        EXPECT_EQ ( scene.GetSpatialIndexRebuildThreshold(), 0.0f );
+        Node* mover = AddPositioned ( scene, Vector3 { 0.0f, -50.0f, 0.0f } );
+        AddPositioned ( scene, Vector3 { 0.0f, 50.0f, 0.0f } );
+        const Frustum frustum = MakeCullFrustum();
+        ASSERT_EQ ( CullVisibleSet ( scene, frustum ).size(), 1u );
+        mover->SetGlobalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { 5.0f, 40.0f, 0.0f } } );
+        EXPECT_EQ ( CullVisibleSet ( scene, frustum ), BruteForceVisible ( scene, frustum ) );
+    }
+
     // ---- QueryAABB (octree-backed broad-phase for collision) ------------------
 
     TEST ( SceneQueryAABB, MatchesBruteForceMixedScene )
@@ -610,8 +722,9 @@ namespace AeonGames
         {
         public:
             FakeRenderComponent ( const Mesh* aMesh, const Pipeline* aPipeline,
-                                  const Material* aMaterial, const BufferAccessor* aSkinned )
-                : mMesh{aMesh}, mPipeline{aPipeline}, mMaterial{aMaterial}, mSkinned{aSkinned} {}
+                                  const Material* aMaterial, const BufferAccessor* aSkinned,
+                                  size_t* aCollectCount = nullptr )
+                : mMesh{aMesh}, mPipeline{aPipeline}, mMaterial{aMaterial}, mSkinned{aSkinned}, mCollectCount{aCollectCount} {}
             const StringId& GetId() const final
             {
                 static const StringId id{ "FakeRenderComponent" };
@@ -634,6 +747,10 @@ namespace AeonGames
             void Collect ( const Node& aNode, std::vector<RenderItem>& aQueue ) const final
             {
                 aQueue.push_back ( RenderItem{ mMesh, mPipeline, mMaterial, mSkinned, aNode.GetGlobalTransform() } );
+                if ( mCollectCount )
+                {
+                    ++*mCollectCount;
+                }
             }
             void ProcessMessage ( Node&, uint32_t, const void* ) final {}
         private:
@@ -641,6 +758,7 @@ namespace AeonGames
             const Pipeline* mPipeline;
             const Material* mMaterial;
             const BufferAccessor* mSkinned;
+            size_t* mCollectCount;
         };
 
         // Add a visible unit-AABB node that declares one draw of the given
@@ -731,4 +849,588 @@ namespace AeonGames
         } );
         EXPECT_EQ ( count, 0u );
     }
+
+    namespace
+    {
+        // The meshes of the selected queue, in queue order.
+        std::vector<const Mesh*> QueueMeshes ( const Scene& aScene )
+        {
+            std::vector<const Mesh*> meshes;
+            for ( const RenderItem& item : aScene.GetRenderQueue() )
+            {
+                meshes.push_back ( item.mMesh );
+            }
+            return meshes;
+        }
+    }
+
+    namespace
+    {
+        // World positions of the selected queue's items, in queue order.
+        std::vector<Vector3> QueuePositions ( const Scene& aScene )
+        {
+            std::vector<Vector3> positions;
+            for ( const RenderItem& item : aScene.GetRenderQueue() )
+            {
+                positions.push_back ( Vector3 { item.mTransform[12], item.mTransform[13], item.mTransform[14] } );
+            }
+            return positions;
+        }
+    }
+
+    TEST ( SceneRenderQueue, OrderDoesNotDependOnResourceAddresses )
+    {
+        // Two identical scenes whose resources live at swapped addresses, as
+        // they might from one run to the next. Sorting by address would put
+        // the groups in opposite orders; the queue order must be the same.
+        const Vector3 positions[] =
+        {
+            Vector3 { 0.0f, 50.0f, 0.0f }, Vector3 { 10.0f, 40.0f, 5.0f },
+            Vector3 { -8.0f, 60.0f, -4.0f }, Vector3 { 4.0f, 30.0f, 2.0f }
+        };
+        Scene first;
+        Scene second;
+        for ( size_t i = 0; i < 4; ++i )
+        {
+            AddDrawable ( first, positions[i], ( i % 2 ) ? kMeshA : kMeshB, kPipeline, kMaterial );
+            AddDrawable ( second, positions[i], ( i % 2 ) ? kMeshB : kMeshA, kPipeline, kMaterial );
+        }
+        first.BuildRenderQueue ( MakeCullFrustum() );
+        second.BuildRenderQueue ( MakeCullFrustum() );
+        const std::vector<Vector3> order = QueuePositions ( first );
+        ASSERT_EQ ( order.size(), 4u );
+        EXPECT_EQ ( QueuePositions ( second ), order );
+        // Rebuilding is stable too.
+        first.BuildRenderQueue ( MakeCullFrustum() );
+        EXPECT_EQ ( QueuePositions ( first ), order );
+        EXPECT_EQ ( RenderBatchSizes ( first ), ( std::vector<size_t> { 2u, 2u } ) );
+    }
+
+    TEST ( SceneRenderQueue, BatchesAreOrderedFrontToBack )
+    {
+        Scene scene;
+        AddDrawable ( scene, Vector3 { 0.0f, 80.0f, 0.0f }, kMeshA, kPipeline, kMaterial );
+        AddDrawable ( scene, Vector3 { 0.0f, 20.0f, 0.0f }, kMeshA, kPipeline, kMaterial );
+        AddDrawable ( scene, Vector3 { 0.0f, 50.0f, 0.0f }, kMeshA, kPipeline, kMaterial );
+        scene.BuildRenderQueue ( MakeCullFrustum() );
+        const std::vector<Vector3> order = QueuePositions ( scene );
+        ASSERT_EQ ( order.size(), 3u );
+        EXPECT_FLOAT_EQ ( order[0][1], 20.0f );
+        EXPECT_FLOAT_EQ ( order[1][1], 50.0f );
+        EXPECT_FLOAT_EQ ( order[2][1], 80.0f );
+    }
+
+    TEST ( SceneRenderQueue, MultiViewBuildMatchesPerViewBuilds )
+    {
+        Scene scene;
+        size_t collects = 0;
+        // A distinct fake mesh per node identifies it in the queues. Nodes sit
+        // in front of the camera, behind it, and in the region both views share.
+        const Vector3 positions[] =
+        {
+            Vector3 { 0.0f, 50.0f, 0.0f }, Vector3 { 10.0f, 50.0f, 5.0f },
+            Vector3 { 0.0f, -50.0f, 0.0f }, Vector3 { 5.0f, 20.0f, 0.0f },
+            Vector3 { 1000.0f, 50.0f, 0.0f }
+        };
+        uintptr_t mesh = 0x10000;
+        for ( const Vector3& position : positions )
+        {
+            Node* node = AddPositioned ( scene, position );
+            node->AddComponent ( std::make_unique<FakeRenderComponent> ( reinterpret_cast<const Mesh*> ( mesh ), kPipeline, kMaterial, nullptr, &collects ) );
+            mesh += 0x1000;
+        }
+        Matrix4x4 box {};
+        box.Ortho ( -30.0f, 30.0f, -30.0f, 30.0f, -60.0f, 30.0f );
+        const Frustum views[] { MakeCullFrustum(), Frustum { box } };
+
+        std::vector<const Mesh*> expected[2];
+        for ( size_t view = 0; view < 2; ++view )
+        {
+            scene.BuildRenderQueue ( views[view] );
+            expected[view] = QueueMeshes ( scene );
+        }
+        collects = 0;
+        scene.BuildRenderQueues ( views );
+        ASSERT_EQ ( scene.GetRenderQueueCount(), 2u );
+        for ( size_t view = 0; view < 2; ++view )
+        {
+            scene.SelectRenderQueue ( view );
+            EXPECT_EQ ( QueueMeshes ( scene ), expected[view] );
+        }
+        // The node at y=20 is in both views but is collected only once.
+        EXPECT_EQ ( expected[0].size(), 3u );
+        EXPECT_EQ ( expected[1].size(), 2u );
+        EXPECT_EQ ( collects, 4u );
+        EXPECT_THROW ( scene.SelectRenderQueue ( 2 ), std::out_of_range );
+    }
+
+    TEST ( SceneRenderQueue, SingleViewBuildSelectsItsQueue )
+    {
+        Scene scene;
+        AddDrawable ( scene, Vector3 { 0.0f, 50.0f, 0.0f }, kMeshA, kPipeline, kMaterial );
+        Matrix4x4 box {};
+        box.Ortho ( -30.0f, 30.0f, -30.0f, 30.0f, -60.0f, -10.0f );
+        const Frustum views[] { Frustum { box }, MakeCullFrustum() };
+        scene.BuildRenderQueues ( views );
+        scene.SelectRenderQueue ( 1 );
+        EXPECT_EQ ( scene.GetRenderQueue().size(), 1u );
+        // A later single-view build replaces both queues with its own.
+        scene.BuildRenderQueue ( MakeCullFrustum() );
+        EXPECT_EQ ( scene.GetRenderQueueCount(), 1u );
+        EXPECT_EQ ( scene.GetRenderQueue().size(), 1u );
+    }
+
+    TEST ( SceneRenderQueue, SteadyStateBuildDoesNotTouchTheHeap )
+    {
+        if ( !IsAllocationCountingEnabled() )
+        {
+            GTEST_SKIP() << "Built without USE_ALLOCATION_COUNTER.";
+        }
+        Scene scene;
+        for ( int i = 0; i < 16; ++i )
+        {
+            AddDrawable ( scene, Vector3 { static_cast<float> ( i % 4 ) * 5.0f, 50.0f, static_cast<float> ( i / 4 ) * 5.0f },
+                          ( i % 2 ) ? kMeshA : kMeshB, kPipeline, kMaterial );
+        }
+        const Frustum frustum = MakeCullFrustum();
+        // The first build sizes the queue, sort and index buffers.
+        scene.BuildRenderQueue ( frustum );
+        const uint64_t before = GetThreadAllocationCount();
+        scene.BuildRenderQueue ( frustum );
+        EXPECT_EQ ( GetThreadAllocationCount(), before );
+        EXPECT_EQ ( scene.GetRenderQueue().size(), 16u );
+    }
+
+    namespace
+    {
+        // Animates its node like a gameplay component would: accumulates time,
+        // rewrites the local transform (which cascades to the subtree below)
+        // and publishes a light derived from the resulting world position.
+        class SpinningLightComponent : public Component
+        {
+        public:
+            explicit SpinningLightComponent ( float aRate ) : mRate{aRate} {}
+            const StringId& GetId() const final
+            {
+                static const StringId id{ "SpinningLightComponent" };
+                return id;
+            }
+            size_t GetPropertyCount() const final
+            {
+                return 0;
+            }
+            const StringId* GetPropertyInfoArray() const final
+            {
+                return nullptr;
+            }
+            Property GetProperty ( const StringId& ) const final
+            {
+                return Property{};
+            }
+            void SetProperty ( uint32_t, const Property& ) final {}
+            void Update ( Node& aNode, double aDelta ) final
+            {
+                mTime += static_cast<float> ( aDelta ) * mRate;
+                Transform local{aNode.GetLocalTransform() };
+                local.SetRotation ( Quaternion::GetFromAxisAngle ( mTime, 0.0f, 0.0f, 1.0f ) );
+                aNode.SetLocalTransform ( local );
+                const Vector3& world = aNode.GetGlobalTransform().GetTranslation();
+                GpuLight light{};
+                light.position_radius = Vector4{ world.GetX(), world.GetY(), world.GetZ(), mRate };
+                aNode.GetScene()->AddLight ( light );
+            }
+            void ProcessMessage ( Node&, uint32_t, const void* ) final {}
+        private:
+            float mRate;
+            float mTime{0.0f};
+        };
+
+        // Build a forest of small animated hierarchies; identical for equal seeds.
+        void BuildAnimatedForest ( Scene& aScene, size_t aTreeCount )
+        {
+            for ( size_t tree = 0; tree < aTreeCount; ++tree )
+            {
+                const float offset = static_cast<float> ( tree );
+                Node* root = aScene.Add ( std::make_unique<Node>() );
+                root->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { offset, 0.0f, 0.0f } } );
+                root->AddComponent ( std::make_unique<SpinningLightComponent> ( 0.5f + offset * 0.01f ) );
+                Node* parent = root;
+                for ( size_t depth = 0; depth < 4; ++depth )
+                {
+                    Node* child = parent->Add ( std::make_unique<Node>() );
+                    child->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { 0.0f, 1.0f + offset * 0.1f, 0.0f } } );
+                    // Leave some nodes without geometry so both branches of the
+                    // signature fold are exercised.
+                    if ( ( tree + depth ) % 3 != 0 )
+                    {
+                        child->SetAABB ( AABB { Vector3 {}, Vector3 { 0.5f, 0.5f, 0.5f } } );
+                    }
+                    if ( depth % 2 == 1 )
+                    {
+                        child->AddComponent ( std::make_unique<SpinningLightComponent> ( 1.5f + offset * 0.02f ) );
+                    }
+                    parent = child;
+                }
+            }
+        }
+
+        std::vector<Matrix4x4> CollectWorldMatrices ( const Scene& aScene )
+        {
+            std::vector<Matrix4x4> matrices;
+            aScene.LoopTraverseDFSPreOrder ( [&matrices] ( const Node & aNode )
+            {
+                matrices.emplace_back ( aNode.GetGlobalTransform() );
+            } );
+            return matrices;
+        }
+    }
+
+    TEST ( SceneParallelUpdate, MatchesSerialUpdateBitForBit )
+    {
+        // Force real concurrency even on single core runners.
+        InitializeJobSystem ( 4 );
+        Scene serial;
+        Scene parallel;
+        serial.SetParallelUpdate ( false );
+        EXPECT_TRUE ( parallel.GetParallelUpdate() );
+        BuildAnimatedForest ( serial, 256 );
+        BuildAnimatedForest ( parallel, 256 );
+        for ( size_t frame = 0; frame < 16; ++frame )
+        {
+            serial.Update ( 1.0 / 60.0 );
+            parallel.Update ( 1.0 / 60.0 );
+            EXPECT_EQ ( serial.GetShadowGeometrySignature(), parallel.GetShadowGeometrySignature() );
+            const std::span<const GpuLight> serial_lights = serial.GetFrameLights();
+            const std::span<const GpuLight> parallel_lights = parallel.GetFrameLights();
+            ASSERT_EQ ( serial_lights.size(), 256u * 3u );
+            ASSERT_EQ ( serial_lights.size(), parallel_lights.size() );
+            EXPECT_EQ ( std::memcmp ( serial_lights.data(), parallel_lights.data(), serial_lights.size_bytes() ), 0 );
+            const std::vector<Matrix4x4> serial_world = CollectWorldMatrices ( serial );
+            const std::vector<Matrix4x4> parallel_world = CollectWorldMatrices ( parallel );
+            ASSERT_EQ ( serial_world.size(), parallel_world.size() );
+            EXPECT_EQ ( std::memcmp ( serial_world.data(), parallel_world.data(), serial_world.size() * sizeof ( Matrix4x4 ) ), 0 );
+        }
+        InitializeJobSystem();
+    }
+
+    TEST ( SceneParallelUpdate, SignatureTracksGeometryNotCamera )
+    {
+        Scene scene;
+        Node* geometry = AddPositioned ( scene, Vector3 { 0.0f, 50.0f, 0.0f } );
+        Node* camera = scene.Add ( std::make_unique<Node>() );
+        scene.Update ( 0.0 );
+        const uint64_t initial = scene.GetShadowGeometrySignature();
+        camera->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { 5.0f, 0.0f, 0.0f } } );
+        scene.Update ( 0.0 );
+        EXPECT_EQ ( scene.GetShadowGeometrySignature(), initial );
+        geometry->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {}, Vector3 { 0.0f, 60.0f, 0.0f } } );
+        scene.Update ( 0.0 );
+        EXPECT_NE ( scene.GetShadowGeometrySignature(), initial );
+    }
+
+    namespace
+    {
+        // Poses a made up skeleton from its node's world position and its own
+        // clock, deferring the work to the scene's animation phase the way
+        // ModelComponent does.
+        class PosingComponent : public Component
+        {
+        public:
+            static constexpr size_t kJoints = 24;
+            explicit PosingComponent ( float aRate ) : mRate{aRate} {}
+            const StringId& GetId() const final
+            {
+                static const StringId id{ "PosingComponent" };
+                return id;
+            }
+            size_t GetPropertyCount() const final
+            {
+                return 0;
+            }
+            const StringId* GetPropertyInfoArray() const final
+            {
+                return nullptr;
+            }
+            Property GetProperty ( const StringId& ) const final
+            {
+                return Property{};
+            }
+            void SetProperty ( uint32_t, const Property& ) final {}
+            void Update ( Node& aNode, double aDelta ) final
+            {
+                Scene* scene = aNode.GetScene();
+                if ( scene == nullptr || !scene->QueueAnimation ( aNode, *this ) )
+                {
+                    Animate ( aNode, aDelta );
+                }
+            }
+            void Animate ( const Node& aNode, double aDelta ) final
+            {
+                mTime += static_cast<float> ( aDelta ) * mRate;
+                const Vector3& world = aNode.GetGlobalTransform().GetTranslation();
+                for ( size_t joint = 0; joint < kJoints; ++joint )
+                {
+                    const float offset = static_cast<float> ( joint );
+                    const Matrix4x4 matrix { Transform { Vector3 { 1.0f, 1.0f, 1.0f },
+                                                         Quaternion::GetFromAxisAngle ( mTime * ( offset + 1.0f ), 0.0f, 1.0f, 0.0f ),
+                                                         world + Vector3 { 0.0f, offset, 0.0f } } };
+                    std::memcpy ( mPose.data() + joint * 16, matrix.GetMatrix4x4(), sizeof ( float ) * 16 );
+                }
+                ++mAnimations;
+            }
+            void ProcessMessage ( Node&, uint32_t, const void* ) final {}
+            const std::vector<float>& GetPose() const
+            {
+                return mPose;
+            }
+            size_t GetAnimations() const
+            {
+                return mAnimations;
+            }
+        private:
+            float mRate;
+            float mTime{0.0f};
+            std::vector<float> mPose = std::vector<float> ( kJoints * 16 );
+            size_t mAnimations{};
+        };
+
+        // A couple of roots with a crowd under each, so the subtrees alone
+        // would leave most workers idle.
+        std::vector<const PosingComponent*> BuildCrowd ( Scene& aScene, size_t aRootCount, size_t aCrowdSize )
+        {
+            std::vector<const PosingComponent*> crowd;
+            for ( size_t root_index = 0; root_index < aRootCount; ++root_index )
+            {
+                Node* root = aScene.Add ( std::make_unique<Node>() );
+                for ( size_t member = 0; member < aCrowdSize; ++member )
+                {
+                    Node* node = root->Add ( std::make_unique<Node>() );
+                    node->SetLocalTransform ( Transform { Vector3 { 1.0f, 1.0f, 1.0f }, Quaternion {},
+                                                          Vector3 { static_cast<float> ( member ), 0.0f, static_cast<float> ( root_index ) } } );
+                    crowd.emplace_back ( static_cast<const PosingComponent*> ( node->AddComponent (
+                                             std::make_unique<PosingComponent> ( 0.5f + static_cast<float> ( member % 17 ) * 0.1f ) ) ) );
+                }
+            }
+            return crowd;
+        }
+    }
+
+    TEST ( SceneAnimationPhase, MatchesSerialAnimationBitForBit )
+    {
+        InitializeJobSystem ( 4 );
+        Scene serial;
+        Scene parallel;
+        serial.SetParallelUpdate ( false );
+        const std::vector<const PosingComponent*> serial_crowd = BuildCrowd ( serial, 2, 300 );
+        const std::vector<const PosingComponent*> parallel_crowd = BuildCrowd ( parallel, 2, 300 );
+        for ( size_t frame = 0; frame < 8; ++frame )
+        {
+            serial.Update ( 1.0 / 60.0 );
+            parallel.Update ( 1.0 / 60.0 );
+            for ( size_t i = 0; i < serial_crowd.size(); ++i )
+            {
+                ASSERT_EQ ( parallel_crowd[i]->GetAnimations(), frame + 1 );
+                EXPECT_EQ ( std::memcmp ( serial_crowd[i]->GetPose().data(), parallel_crowd[i]->GetPose().data(),
+                                          serial_crowd[i]->GetPose().size() * sizeof ( float ) ), 0 );
+            }
+        }
+        InitializeJobSystem();
+    }
+
+    TEST ( SceneAnimationPhase, AnimatesRightAwayOutsideSceneUpdate )
+    {
+        Scene scene;
+        Node* node = scene.Add ( std::make_unique<Node>() );
+        PosingComponent component { 1.0f };
+        EXPECT_FALSE ( scene.QueueAnimation ( *node, component ) );
+
+        Node detached;
+        const auto* posing = static_cast<const PosingComponent*> ( detached.AddComponent ( std::make_unique<PosingComponent> ( 1.0f ) ) );
+        detached.Update ( 1.0 / 60.0 );
+        EXPECT_EQ ( posing->GetAnimations(), 1u );
+    }
+
+    namespace
+    {
+        /// A looping clip of @p aJointCount joints, @p aPhase tells clips apart.
+        AnimationMsg MakeCrowdClip ( uint32_t aJointCount, float aPhase )
+        {
+            constexpr uint32_t kFrames = 48;
+            AnimationMsg message;
+            message.set_version ( 1 );
+            message.set_framerate ( 30 );
+            message.set_duration ( static_cast<float> ( kFrames ) / 30.0f );
+            for ( uint32_t frame = 0; frame < kFrames; ++frame )
+            {
+                FrameMsg* frame_msg = message.add_frame();
+                const float phase = aPhase + static_cast<float> ( frame ) / static_cast<float> ( kFrames ) * 6.2831853f;
+                for ( uint32_t joint = 0; joint < aJointCount; ++joint )
+                {
+                    BoneMsg* bone = frame_msg->add_bone();
+                    bone->mutable_scale()->set_x ( 1.0f );
+                    bone->mutable_scale()->set_y ( 1.0f );
+                    bone->mutable_scale()->set_z ( 1.0f );
+                    const float half_angle = 0.4f * std::sin ( phase + static_cast<float> ( joint ) );
+                    bone->mutable_rotation()->set_w ( std::cos ( half_angle ) );
+                    bone->mutable_rotation()->set_y ( std::sin ( half_angle ) );
+                    bone->mutable_translation()->set_x ( joint == 0 ? std::cos ( phase ) : 0.0f );
+                    bone->mutable_translation()->set_y ( joint == 0 ? 0.0f : 1.0f );
+                }
+            }
+            return message;
+        }
+
+        /** A skinned model built in memory: a skeleton with a spine and two
+            arms, two clips, and no meshes, so animating it needs no renderer.
+            The resources go straight into the cache under made up ids. */
+        class SceneModelAnimation : public ::testing::Test
+        {
+        protected:
+            static constexpr uint32_t kSkeleton = "SceneTests/crowd.skl"_crc32;
+            static constexpr uint32_t kWalk = "SceneTests/walk.anm"_crc32;
+            static constexpr uint32_t kRun = "SceneTests/run.anm"_crc32;
+            static constexpr uint32_t kModel = "SceneTests/crowd.mdl"_crc32;
+            void SetUp() override
+            {
+                std::vector<int32_t> parents { -1, 0, 1, 2, 3, 4 };
+                for ( int32_t arm = 0; arm < 2; ++arm )
+                {
+                    const auto shoulder = static_cast<int32_t> ( parents.size() );
+                    parents.insert ( parents.end(), { 3, shoulder, shoulder + 1, shoulder + 2, shoulder + 2, shoulder + 2 } );
+                }
+                SkeletonMsg skeleton_msg;
+                for ( int32_t parent : parents )
+                {
+                    JointMsg* joint = skeleton_msg.add_joint();
+                    joint->set_parentindex ( parent );
+                    joint->mutable_scale()->set_x ( 1.0f );
+                    joint->mutable_scale()->set_y ( 1.0f );
+                    joint->mutable_scale()->set_z ( 1.0f );
+                    joint->mutable_rotation()->set_w ( 1.0f );
+                    joint->mutable_invertedscale()->set_x ( 1.0f );
+                    joint->mutable_invertedscale()->set_y ( 1.0f );
+                    joint->mutable_invertedscale()->set_z ( 1.0f );
+                    joint->mutable_invertedrotation()->set_w ( 1.0f );
+                }
+                // Joints point at their parents, so the skeleton is loaded in place.
+                auto skeleton = std::make_unique<Skeleton>();
+                skeleton->LoadFromPBMsg ( skeleton_msg );
+                StoreResource ( kSkeleton, UniqueAnyPtr{ std::move ( skeleton ) } );
+                const auto joint_count = static_cast<uint32_t> ( parents.size() );
+                auto walk = std::make_unique<Animation>();
+                walk->LoadFromPBMsg ( MakeCrowdClip ( joint_count, 0.0f ) );
+                StoreResource ( kWalk, UniqueAnyPtr{ std::move ( walk ) } );
+                auto run = std::make_unique<Animation>();
+                run->LoadFromPBMsg ( MakeCrowdClip ( joint_count, 1.5f ) );
+                StoreResource ( kRun, UniqueAnyPtr{ std::move ( run ) } );
+
+                ModelMsg model_msg;
+                model_msg.mutable_skeleton()->set_id ( kSkeleton );
+                for ( const auto& [name, id] : { std::pair<const char*, uint32_t> { "walk", kWalk }, std::pair<const char*, uint32_t> { "run", kRun } } )
+                {
+                    AnimationRefMsg* animation = model_msg.add_animation();
+                    animation->set_name ( name );
+                    animation->mutable_reference()->set_id ( id );
+                }
+                auto model = std::make_unique<Model>();
+                model->LoadFromPBMsg ( model_msg );
+                StoreResource ( kModel, UniqueAnyPtr{ std::move ( model ) } );
+            }
+            void TearDown() override
+            {
+                DisposeResource ( kModel );
+                DisposeResource ( kRun );
+                DisposeResource ( kWalk );
+                DisposeResource ( kSkeleton );
+            }
+            /** A couple of roots with a crowd under each. Members share
+                starting frames in groups so the pose cache gets hits, and
+                cycle through no LOD, every other update with culled hands,
+                and every third update with culled arms. */
+            std::vector<ModelComponent*> BuildCrowd ( Scene& aScene, std::vector<Node*>& aNodes )
+            {
+                std::vector<ModelComponent*> crowd;
+                for ( size_t root_index = 0; root_index < 2; ++root_index )
+                {
+                    Node* root = aScene.Add ( std::make_unique<Node>() );
+                    for ( size_t member = 0; member < 150; ++member )
+                    {
+                        Node* node = root->Add ( std::make_unique<Node>() );
+                        auto* model = static_cast<ModelComponent*> ( node->AddComponent ( std::make_unique<ModelComponent>() ) );
+                        model->SetModel ( { "Model"_crc32, kModel } );
+                        model->SetStartingFrame ( static_cast<double> ( member % 7 ) * 2.5 );
+                        model->SetActiveAnimation ( "walk" );
+                        switch ( member % 3 )
+                        {
+                        case 1:
+                            model->SetAnimationLod ( { { 0.0f, 2, 1 } } );
+                            break;
+                        case 2:
+                            model->SetAnimationLod ( { { 0.0f, 3, 3 } } );
+                            break;
+                        default:
+                            model->SetAnimationLod ( {} );
+                            break;
+                        }
+                        aNodes.emplace_back ( node );
+                        crowd.emplace_back ( model );
+                    }
+                }
+                return crowd;
+            }
+        };
+    }
+
+    TEST_F ( SceneModelAnimation, MatchesSerialAndInlineAnimationBitForBit )
+    {
+        InitializeJobSystem ( 4 );
+        Scene serial;
+        Scene parallel;
+        Scene direct;
+        serial.SetParallelUpdate ( false );
+        std::vector<Node*> serial_nodes;
+        std::vector<Node*> parallel_nodes;
+        std::vector<Node*> direct_nodes;
+        const std::vector<ModelComponent*> serial_crowd = BuildCrowd ( serial, serial_nodes );
+        const std::vector<ModelComponent*> parallel_crowd = BuildCrowd ( parallel, parallel_nodes );
+        const std::vector<ModelComponent*> direct_crowd = BuildCrowd ( direct, direct_nodes );
+        ASSERT_EQ ( parallel_crowd.front()->GetSkinningMatrices().size(), 18u * 16u );
+        size_t pose_hits = 0;
+        for ( size_t frame = 0; frame < 16; ++frame )
+        {
+            if ( frame == 6 )
+            {
+                // Crossfade every other member, those sample on their own.
+                for ( size_t i = 0; i < parallel_crowd.size(); i += 2 )
+                {
+                    serial_crowd[i]->SetActiveAnimation ( "run" );
+                    parallel_crowd[i]->SetActiveAnimation ( "run" );
+                    direct_crowd[i]->SetActiveAnimation ( "run" );
+                }
+            }
+            serial.Update ( 1.0 / 60.0 );
+            parallel.Update ( 1.0 / 60.0 );
+            pose_hits += parallel.GetPoseCache().GetStatistics().mPoseHits;
+            // Outside Scene::Update models animate as soon as their node updates.
+            direct.GetPoseCache().BeginFrame();
+            for ( Node* node : direct_nodes )
+            {
+                node->Update ( 1.0 / 60.0 );
+            }
+            for ( size_t i = 0; i < parallel_crowd.size(); ++i )
+            {
+                const std::span<const float> expected = serial_crowd[i]->GetSkinningMatrices();
+                ASSERT_EQ ( std::memcmp ( parallel_crowd[i]->GetSkinningMatrices().data(), expected.data(), expected.size_bytes() ), 0 )
+                        << "frame " << frame << ", member " << i;
+                ASSERT_EQ ( std::memcmp ( direct_crowd[i]->GetSkinningMatrices().data(), expected.data(), expected.size_bytes() ), 0 )
+                        << "frame " << frame << ", member " << i;
+            }
+        }
+        EXPECT_GT ( pose_hits, 0u );
+        // Members really animated, each from its own starting frame.
+        const std::span<const float> first = parallel_crowd[0]->GetSkinningMatrices();
+        EXPECT_NE ( std::memcmp ( first.data(), parallel_crowd[1]->GetSkinningMatrices().data(), first.size_bytes() ), 0 );
+        EXPECT_NE ( first[12], 0.0f );
+        InitializeJobSystem();
+    }
 }
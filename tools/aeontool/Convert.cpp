@@ -50,6 +50,8 @@ limitations under the License.
 #if defined(__unix__) || defined(__MINGW32__)
 #include "sys/stat.h"
 #endif
+#include "aeongames/Mesh.hpp"
+#include "aeongames/Animation.hpp"
 #include "Convert.h"
 #include "CodeFieldValuePrinter.hpp"
 
@@ -426,6 +428,34 @@ namespace AeonGames
         }
     }
 
+    /// Fill a MeshMsg from a flat mesh so it can be written out as text or protobuf binary.
+    void SaveMeshToPBMsg ( const Mesh& aMesh, MeshMsg& aMeshMsg )
+    {
+        aMeshMsg.Clear();
+        aMeshMsg.set_version ( 1 );
+        aMeshMsg.mutable_center()->set_x ( aMesh.GetAABB().GetCenter() [0] );
+        aMeshMsg.mutable_center()->set_y ( aMesh.GetAABB().GetCenter() [1] );
+        aMeshMsg.mutable_center()->set_z ( aMesh.GetAABB().GetCenter() [2] );
+        aMeshMsg.mutable_radii()->set_x ( aMesh.GetAABB().GetRadii() [0] );
+        aMeshMsg.mutable_radii()->set_y ( aMesh.GetAABB().GetRadii() [1] );
+        aMeshMsg.mutable_radii()->set_z ( aMesh.GetAABB().GetRadii() [2] );
+        for ( const Mesh::AttributeTuple& i : aMesh.GetAttributes() )
+        {
+            AttributeMsg* attribute = aMeshMsg.add_attribute();
+            attribute->set_semantic ( static_cast<AttributeMsg_AttributeSemantic> ( std::get<0> ( i ) ) );
+            attribute->set_size ( std::get<1> ( i ) );
+            attribute->set_type ( static_cast<AttributeMsg_AttributeType> ( std::get<2> ( i ) ) );
+            attribute->set_flags ( static_cast<AttributeMsg_AttributeFlags> ( std::get<3> ( i ) ) );
+            attribute->set_offset ( std::get<4> ( i ) );
+        }
+        aMeshMsg.set_vertexcount ( aMesh.GetVertexCount() );
+        aMeshMsg.set_indexsize ( aMesh.GetIndexSize() );
+        aMeshMsg.set_indexcount ( aMesh.GetIndexCount() );
+        aMeshMsg.set_vertexstride ( static_cast<uint32_t> ( aMesh.GetStride() ) );
+        aMeshMsg.set_vertexbuffer ( aMesh.GetVertexBuffer().data(), aMesh.GetVertexBuffer().size() );
+        aMeshMsg.set_indexbuffer ( aMesh.GetIndexBuffer().data(), aMesh.GetIndexBuffer().size() );
+    }
+
     Convert::Convert()
         = default;
     Convert::~Convert()
@@ -455,6 +485,14 @@ namespace AeonGames
                         i++;
                         mOutputFile = argv[i];
                     }
+                    else if ( strncmp ( &argv[i][2], "flat", sizeof ( "flat" ) ) == 0 )
+                    {
+                        mFlat = true;
+                    }
+                    else if ( strncmp ( &argv[i][2], "compress", sizeof ( "compress" ) ) == 0 )
+                    {
+                        mCompress = true;
+                    }
                 }
                 else
                 {
@@ -468,6 +506,12 @@ namespace AeonGames
                         i++;
                         mOutputFile = argv[i];
                         break;
+                    case 'f':
+                        mFlat = true;
+                        break;
+                    case 'c':
+                        mCompress = true;
+                        break;
                     }
                 }
             }
@@ -539,6 +583,10 @@ namespace AeonGames
             case FileType::AEONMSHT:
                 message = &mesh_buffer;
                 break;
+            case FileType::AEONMSHF:
+                binary_input = true;
+                message = &mesh_buffer;
+                break;
             /* coverity[unterminated_case] */
             case FileType::AEONSKLB:
                 binary_input = true;
@@ -584,7 +632,16 @@ namespace AeonGames
             assert ( message && "Message is null." );
 
             // Read and parse Input
-            if ( binary_input )
+            if ( GetFileType ( magick_number ) == FileType::AEONMSHF )
+            {
+                file.seekg ( 0, std::ios::beg );
+                const std::vector<uint8_t> flat ( ( std::istreambuf_iterator<char> ( file ) ), std::istreambuf_iterator<char>() );
+                Mesh mesh;
+                mesh.LoadFromMemory ( flat.data(), flat.size() );
+                SaveMeshToPBMsg ( mesh, mesh_buffer );
+                magick_number[7] = '\0';
+            }
+            else if ( binary_input )
             {
                 if ( !message->ParseFromIstream ( &file ) )
                 {
@@ -619,9 +676,34 @@ namespace AeonGames
             }
             file.close();
         }
+        if ( mCompress )
+        {
+            if ( message != &animation_buffer )
+            {
+                throw std::runtime_error ( "Only animations can be compressed." );
+            }
+            Animation animation;
+            animation.LoadFromPBMsg ( animation_buffer );
+            animation.Compress();
+            animation_buffer.Clear();
+            animation.Serialize ( animation_buffer );
+        }
         // Write Output
         {
-            if ( binary_input )
+            if ( mFlat )
+            {
+                if ( message != &mesh_buffer )
+                {
+                    throw std::runtime_error ( "Only meshes have a flat layout." );
+                }
+                Mesh mesh;
+                mesh.LoadFromPBMsg ( mesh_buffer );
+                const std::vector<uint8_t> flat = mesh.SaveToFlat();
+                std::ofstream flat_file ( mOutputFile, std::ifstream::out | std::ifstream::binary );
+                flat_file.write ( reinterpret_cast<const char*> ( flat.data() ), static_cast<std::streamsize> ( flat.size() ) );
+                flat_file.close();
+            }
+            else if ( binary_input )
             {
                 // Write Text Version
                 google::protobuf::TextFormat::Printer printer;
@@ -702,6 +784,7 @@ namespace AeonGames
             else if ( strncmp ( type, "MSH", 3 ) == 0 )
             {
                 retval = ( type[3] == '\0' ) ? Convert::FileType::AEONMSHB :
+                         ( type[3] == kFlatMeshTag ) ? Convert::FileType::AEONMSHF :
                          Convert::FileType::AEONMSHT;
             }
             else if ( strncmp ( type, "SKL", 3 ) == 0 )
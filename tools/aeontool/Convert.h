@@ -47,6 +47,7 @@ namespace AeonGames
             AEONMTLT,
             AEONMSHB,
             AEONMSHT,
+            AEONMSHF,
             AEONSKLB,
             AEONSKLT,
             AEONSCNB,
@@ -61,6 +62,10 @@ namespace AeonGames
         FileType GetFileType ( const char* aMagic ) const;
         std::string mInputFile;
         std::string mOutputFile;
+        /// Write meshes in the flat AEONMSH layout instead of flipping between binary and text.
+        bool mFlat{false};
+        /// Compress animations into quantized, key reduced tracks, see Animation::Compress.
+        bool mCompress{false};
     };
 }
 #endif
\ No newline at end of file
@@ -16,17 +16,20 @@ limitations under the License.
 #include "Pack.h"
 #include "aeongames/CRC.hpp"
 #include "aeongames/Package.hpp"
-#include "zlib.h"
+#include "aeongames/JobSystem.hpp"
+#include "Compression.h"
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -37,7 +40,26 @@ namespace AeonGames
     namespace
     {
         constexpr int kZlibLevel = 5;
-        constexpr size_t kChunk = 16384;
+        constexpr int kZstdLevel = 12;
+        constexpr int kLz4Level = 9;
+        /// Input read and compressed at once before it is written out.
+        constexpr uint64_t kPackWindow = uint64_t{256} << 20;
+        /// Files up to this size are trained on and compressed with the dictionary.
+        constexpr uint64_t kDictionarySampleSize = 16384;
+        constexpr size_t kDictionaryCapacity = 112640;
+
+        int GetDefaultLevel ( uint8_t aCompression )
+        {
+            switch ( aCompression )
+            {
+            case ZSTD:
+                return kZstdLevel;
+            case LZ4:
+                return kLz4Level;
+            default:
+                return kZlibLevel;
+            }
+        }
 
         /** Lowercase the string in place (ASCII only). */
         std::string ToLowerExt ( const std::filesystem::path& p )
@@ -70,81 +92,18 @@ namespace AeonGames
             return false;
         }
 
-        /** Deflate the contents of `in` into `out`. Updates `compressed_size`
-            with the number of bytes written.
-            @return Z_OK on success or a zlib error code. */
-        int WriteDeflated ( std::ifstream& in, std::ofstream& out, int level,
-                            uint64_t& compressed_size )
-        {
-            compressed_size = 0;
-            z_stream strm{};
-            strm.zalloc = Z_NULL;
-            strm.zfree = Z_NULL;
-            strm.opaque = Z_NULL;
-            int ret = deflateInit ( &strm, level );
-            if ( ret != Z_OK )
-            {
-                return ret;
-            }
-
-            unsigned char inbuf[kChunk];
-            unsigned char outbuf[kChunk];
-            int flush = Z_NO_FLUSH;
-            do
-            {
-                in.read ( reinterpret_cast<char*> ( inbuf ), kChunk );
-                std::streamsize got = in.gcount();
-                if ( in.bad() )
-                {
-                    deflateEnd ( &strm );
-                    return Z_ERRNO;
-                }
-                strm.avail_in = static_cast<uInt> ( got );
-                strm.next_in = inbuf;
-                flush = in.eof() ? Z_FINISH : Z_NO_FLUSH;
-                do
-                {
-                    strm.avail_out = kChunk;
-                    strm.next_out = outbuf;
-                    ret = deflate ( &strm, flush );
-                    assert ( ret != Z_STREAM_ERROR );
-                    const uInt have = kChunk - strm.avail_out;
-                    if ( have != 0 )
-                    {
-                        out.write ( reinterpret_cast<const char*> ( outbuf ), have );
-                        if ( !out )
-                        {
-                            deflateEnd ( &strm );
-                            return Z_ERRNO;
-                        }
-                        compressed_size += have;
-                    }
-                }
-                while ( strm.avail_out == 0 );
-                assert ( strm.avail_in == 0 );
-            }
-            while ( flush != Z_FINISH );
-            deflateEnd ( &strm );
-            return ( ret == Z_STREAM_END ) ? Z_OK : Z_DATA_ERROR;
-        }
-
-        /** Copy the entire contents of `in` to `out`, returning the number of
-            bytes copied. */
-        uint64_t CopyRaw ( std::ifstream& in, std::ofstream& out )
+        /** Read a whole file into `aContents`.
+            @return false if the file could not be read. */
+        bool ReadWholeFile ( const std::filesystem::path& aPath, uint64_t aSize, std::vector<uint8_t>& aContents )
         {
-            uint64_t copied = 0;
-            char buf[kChunk];
-            while ( in )
+            std::ifstream in ( aPath, std::ios::in | std::ios::binary );
+            if ( !in.is_open() )
             {
-                in.read ( buf, kChunk );
-                std::streamsize got = in.gcount();
-                if ( got > 0 )
-                {
-                    out.write ( buf, got );
-                    copied += static_cast<uint64_t> ( got );
-                }
+                return false;
             }
-            return copied;
+            aContents.resize ( static_cast<size_t> ( aSize ) );
+            in.read ( reinterpret_cast<char*> ( aContents.data() ), static_cast<std::streamsize> ( aContents.size() ) );
+            return static_cast<bool> ( in );
         }
 
         struct PackEntry
@@ -154,6 +113,9 @@ namespace AeonGames
             std::filesystem::path absolute_path;
             uint64_t uncompressed_size;
             std::string ext_lower;
+            bool use_dictionary{false};
+            /// Contents made up by the tool rather than read from absolute_path.
+            const std::vector<uint8_t>* generated{nullptr};
         };
     }
 
@@ -207,6 +169,45 @@ namespace AeonGames
                     {
                         mCompress = false;
                     }
+                    else if ( strcmp ( &argv[i][2], "codec" ) == 0 )
+                    {
+                        if ( ++i >= argc )
+                        {
+                            throw std::runtime_error ( "Missing value for --codec." );
+                        }
+                        mCompression = NONE;
+                        for ( uint8_t codec : { ZLIB, ZSTD, LZ4 } )
+                        {
+                            if ( strcmp ( argv[i], GetCompressionName ( codec ) ) == 0 )
+                            {
+                                mCompression = codec;
+                            }
+                        }
+                        if ( mCompression == NONE )
+                        {
+                            std::ostringstream stream;
+                            stream << "Unknown codec " << argv[i] << ", expected zlib, zstd or lz4.";
+                            throw std::runtime_error ( stream.str().c_str() );
+                        }
+                        if ( !IsCompressionSupported ( mCompression ) )
+                        {
+                            std::ostringstream stream;
+                            stream << "This build has no " << argv[i] << " support.";
+                            throw std::runtime_error ( stream.str().c_str() );
+                        }
+                    }
+                    else if ( strcmp ( &argv[i][2], "level" ) == 0 )
+                    {
+                        if ( ++i >= argc )
+                        {
+                            throw std::runtime_error ( "Missing value for --level." );
+                        }
+                        mLevel = std::atoi ( argv[i] );
+                    }
+                    else if ( strcmp ( &argv[i][2], "dictionary" ) == 0 )
+                    {
+                        mDictionary = true;
+                    }
                     else if ( strcmp ( &argv[i][2], "help" ) == 0 )
                     {
                         std::cout << "Usage: aeontool pack [options] <input>\n"
@@ -215,7 +216,10 @@ namespace AeonGames
                                   << "  -e, --extract    Extract a package back to a directory\n"
                                   << "  -i, --in <path>  Input directory (compress) or package (extract/dir)\n"
                                   << "  -o, --out <path> Output package file (compress) or directory (extract)\n"
-                                  << "      --store      Store files raw (no zlib compression)\n"
+                                  << "      --store      Store files raw (no compression)\n"
+                                  << "      --codec <c>  zstd (default when available), lz4 or zlib\n"
+                                  << "      --level <n>  Codec level, defaults to zstd 12, lz4 9, zlib 5\n"
+                                  << "      --dictionary Train a zstd dictionary for files up to 16 KiB\n"
                                   << "      --help       Show this help" << std::endl;
                         return;
                     }
@@ -265,6 +269,18 @@ namespace AeonGames
         {
             mAction = Action::Compress;
         }
+        if ( mCompression == NONE )
+        {
+            mCompression = IsCompressionSupported ( ZSTD ) ? ZSTD : ZLIB;
+        }
+        if ( mLevel == 0 )
+        {
+            mLevel = GetDefaultLevel ( mCompression );
+        }
+        if ( mDictionary && mCompression != ZSTD )
+        {
+            throw std::runtime_error ( "--dictionary requires the zstd codec." );
+        }
     }
 
     int Pack::operator() ( int argc, char** argv )
@@ -303,8 +319,14 @@ namespace AeonGames
 
         Package package{mInputPath};
         const auto& index = package.GetIndexTable();
+        size_t extracted = 0;
         for ( const auto& [crc, relative] : index )
         {
+            if ( relative == PKGDictionaryPath )
+            {
+                // Made by pack, not part of the input.
+                continue;
+            }
             const fs::path target = out_dir / relative;
             std::error_code ec;
             fs::create_directories ( target.parent_path(), ec );
@@ -321,8 +343,9 @@ namespace AeonGames
             std::cout << std::setfill ( '0' ) << std::setw ( 8 ) << std::hex
                       << crc << std::dec << " -> " << target.string()
                       << " (" << sz << " bytes)" << std::endl;
+            ++extracted;
         }
-        std::cout << "Extracted " << index.size() << " files to " << out_dir.string() << std::endl;
+        std::cout << "Extracted " << extracted << " files to " << out_dir.string() << std::endl;
         return 0;
     }
 
@@ -400,6 +423,60 @@ namespace AeonGames
             e.ext_lower = ToLowerExt ( it.path() );
             entries.push_back ( std::move ( e ) );
         }
+
+        // Small assets share most of their bytes with each other but have
+        // too little of their own to compress well, train a dictionary on
+        // them and store it as one more entry.
+        std::vector<uint8_t> dictionary;
+        if ( mCompress && mDictionary )
+        {
+            std::vector<PackEntry*> small;
+            for ( PackEntry& e : entries )
+            {
+                if ( e.uncompressed_size != 0 && e.uncompressed_size <= kDictionarySampleSize && !ShouldStoreRaw ( e.ext_lower ) )
+                {
+                    small.push_back ( &e );
+                }
+            }
+            std::vector<std::vector<uint8_t>> samples ( small.size() );
+            GetJobSystem().ParallelFor ( 0, small.size(), 64, [&small, &samples] ( size_t aBegin, size_t aEnd )
+            {
+                for ( size_t i = aBegin; i < aEnd; ++i )
+                {
+                    if ( !ReadWholeFile ( small[i]->absolute_path, small[i]->uncompressed_size, samples[i] ) )
+                    {
+                        samples[i].clear();
+                    }
+                }
+            } );
+            std::vector<std::span<const uint8_t>> views;
+            for ( const std::vector<uint8_t>& sample : samples )
+            {
+                if ( !sample.empty() )
+                {
+                    views.emplace_back ( sample );
+                }
+            }
+            dictionary = TrainCompressionDictionary ( views, kDictionaryCapacity );
+            if ( dictionary.empty() )
+            {
+                std::cout << "Not enough small files to train a dictionary on (" << small.size() << "), packing without one." << std::endl;
+            }
+            else
+            {
+                for ( PackEntry* e : small )
+                {
+                    e->use_dictionary = true;
+                }
+                PackEntry e;
+                e.relative_path = PKGDictionaryPath;
+                e.crc = crc32i ( e.relative_path.c_str(), e.relative_path.size() );
+                e.uncompressed_size = dictionary.size();
+                e.generated = &dictionary;
+                entries.push_back ( std::move ( e ) );
+                std::cout << "Trained a " << dictionary.size() << " byte dictionary on " << small.size() << " files." << std::endl;
+            }
+        }
         std::sort ( entries.begin(), entries.end(),
                     [] ( const PackEntry & a, const PackEntry & b )
         {
@@ -463,42 +540,82 @@ namespace AeonGames
 
         assert ( static_cast<uint64_t> ( out.tellp() ) == static_cast<uint64_t> ( header.strings_offset ) + string_blob.size() );
 
-        // Pass 2: write payloads.
-        for ( size_t i = 0; i < entries.size(); ++i )
+        // Pass 2: read and compress a window of payloads in parallel, then
+        // append them in table order so data stays sorted by crc on disk.
+        for ( size_t begin = 0; begin < entries.size(); )
         {
-            const PackEntry& e = entries[i];
-            std::ifstream in ( e.absolute_path, std::ios::in | std::ios::binary );
-            if ( !in.is_open() )
+            size_t end = begin;
+            uint64_t window = 0;
+            do
             {
-                std::cout << "WARNING, could not read " << e.absolute_path.string() << std::endl;
-                table[i].data_offset = static_cast<uint64_t> ( out.tellp() );
-                table[i].compressed_size = 0;
-                table[i].compression = NONE;
-                continue;
+                window += entries[end++].uncompressed_size;
             }
-            table[i].data_offset = static_cast<uint64_t> ( out.tellp() );
-            const bool deflate_it = mCompress && !ShouldStoreRaw ( e.ext_lower );
-            if ( deflate_it )
+            while ( end < entries.size() && window < kPackWindow );
+
+            std::vector<std::vector<uint8_t>> payloads ( end - begin );
+            std::vector<uint8_t> unreadable ( end - begin, 0 );
+            GetJobSystem().ParallelFor ( begin, end, 1, [&, begin] ( size_t aBegin, size_t aEnd )
             {
-                uint64_t cs = 0;
-                int ret = WriteDeflated ( in, out, kZlibLevel, cs );
-                if ( ret != Z_OK )
+                std::vector<uint8_t> contents;
+                for ( size_t i = aBegin; i < aEnd; ++i )
                 {
-                    std::cout << "Deflate failed (" << ret << ") on " << e.absolute_path.string() << std::endl;
+                    const PackEntry& e = entries[i];
+                    std::vector<uint8_t>& payload = payloads[i - begin];
+                    if ( e.generated != nullptr )
+                    {
+                        contents = *e.generated;
+                    }
+                    else if ( !ReadWholeFile ( e.absolute_path, e.uncompressed_size, contents ) )
+                    {
+                        unreadable[i - begin] = 1;
+                        table[i].compression = NONE;
+                        continue;
+                    }
+                    table[i].compression = ( mCompress && e.generated == nullptr && !ShouldStoreRaw ( e.ext_lower ) ) ? mCompression : NONE;
+                    if ( table[i].compression != NONE )
+                    {
+                        const std::span<const uint8_t> with = e.use_dictionary ? std::span<const uint8_t> ( dictionary ) : std::span<const uint8_t>();
+                        // Keep whichever is smaller, a codec that cannot shrink
+                        // the file would only cost time at load.
+                        if ( !CompressBuffer ( table[i].compression, contents, mLevel, payload, with ) || payload.size() >= contents.size() )
+                        {
+                            table[i].compression = NONE;
+                        }
+                    }
+                    if ( table[i].compression == NONE )
+                    {
+                        payload.swap ( contents );
+                    }
                 }
-                table[i].compressed_size = cs;
-                table[i].compression = ZLIB;
-            }
-            else
+            } );
+
+            for ( size_t i = begin; i < end; ++i )
             {
-                table[i].compressed_size = CopyRaw ( in, out );
-                table[i].compression = NONE;
+                const PackEntry& e = entries[i];
+                const std::vector<uint8_t>& payload = payloads[i - begin];
+                if ( table[i].compression == NONE )
+                {
+                    // Stored entries are used in place from the mapping, keep
+                    // them 16 byte aligned like flat mesh blobs expect.
+                    static constexpr char padding[16] {};
+                    out.write ( padding, static_cast<std::streamsize> ( ( 16 - out.tellp() % 16 ) % 16 ) );
+                }
+                table[i].data_offset = static_cast<uint64_t> ( out.tellp() );
+                table[i].compressed_size = payload.size();
+                if ( unreadable[i - begin] )
+                {
+                    std::cout << "WARNING, could not read " << e.absolute_path.string() << std::endl;
+                    continue;
+                }
+                out.write ( reinterpret_cast<const char*> ( payload.data() ), static_cast<std::streamsize> ( payload.size() ) );
+                std::cout << std::setfill ( '0' ) << std::setw ( 8 ) << std::hex
+                          << e.crc << std::dec << " " << e.relative_path
+                          << " (" << table[i].compressed_size << "/" << e.uncompressed_size
+                          << " " << GetCompressionName ( table[i].compression )
+                          << ( e.use_dictionary && table[i].compression == ZSTD ? "+dictionary" : "" )
+                          << ")" << std::endl;
             }
-            std::cout << std::setfill ( '0' ) << std::setw ( 8 ) << std::hex
-                      << e.crc << std::dec << " " << e.relative_path
-                      << " (" << table[i].compressed_size << "/" << e.uncompressed_size
-                      << ( table[i].compression == ZLIB ? " zlib" : " raw" )
-                      << ")" << std::endl;
+            begin = end;
         }
 
         // Rewrite the entry table with populated fields.
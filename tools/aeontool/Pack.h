@@ -53,7 +53,10 @@ namespace AeonGames
         Action mAction{};
         std::string mInputPath;
         std::string mOutputFile;
-        bool mCompress{true};   /**< If true, deflate eligible files; otherwise store raw. */
+        bool mCompress{true};   /**< If true, compress eligible files; otherwise store raw. */
+        uint8_t mCompression{}; /**< Codec for eligible files (see PKGCompressionTypes), zstd when available. */
+        int mLevel{};           /**< Codec level, zero for the codec's default. */
+        bool mDictionary{false}; /**< Train a zstd dictionary on the small files and compress them against it. */
     };
 }
 #endif
@@ -30,6 +30,8 @@ limitations under the License.
 #include "aeongames/Mesh.hpp"
 #include "aeongames/ResourceCache.hpp"
 #include "aeongames/Frustum.hpp"
+#include "aeongames/FrameArena.hpp"
+#include "aeongames/ResourceStreamer.hpp"
 #include "aeongames/CRC.hpp"
 #include "aeongames/Node.hpp"
 #include "aeongames/Scene.hpp"
@@ -300,6 +302,12 @@ namespace AeonGames
                         delta = 1.0 / 30.0;
                     }
                 }
+                // Last frame's transient allocations are dead by now.
+                ResetFrameArenas();
+                // Streamed resources become visible between frames, never mid frame.
+                CommitStreamedResources();
+                // Over budget, drop least recently used resources nobody holds on to.
+                TrimResources();
                 if ( mScene )
                 {
                     const_cast<Scene*> ( mScene )->Update ( delta );